@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "hash_table_helpers.h"
+#include "occupancy_filter.h"
 
 namespace falconn {
 namespace core {
@@ -115,6 +116,9 @@ class BasicCompositeHashTable {
     if (!tables_[l_ - 1]) {
       throw CompositeHashTableError("Error adding a table");
     }
+    if (use_occupancy_filters_) {
+      filters_.resize(l_);
+    }
   }
 
   void serialize(FILE* output) {
@@ -147,10 +151,29 @@ class BasicCompositeHashTable {
     return tables_[table]->retrieve(key);
   }
 
+  // Only for inner hash tables that support prefix lookups (e.g.,
+  // StaticPrefixHashTable).
+  std::pair<typename InnerHashTable::Iterator,
+            typename InnerHashTable::Iterator>
+  retrieve_prefix_individual(const KeyType& key, int_fast32_t prefix_length,
+                             int_fast32_t table) const {
+    return tables_[table]->retrieve_prefix(key, prefix_length);
+  }
+
+  bool has_occupancy_filters() const { return use_occupancy_filters_; }
+
+  // False only if the bucket of the key in the given table is empty. Always
+  // true without occupancy filters.
+  bool may_contain(const KeyType& key, int_fast32_t table) const {
+    return !use_occupancy_filters_ || filters_[table].may_contain(key);
+  }
+
  protected:
   int_fast32_t l_;
   typename InnerHashTable::Factory* factory_;
   std::vector<std::unique_ptr<InnerHashTable>> tables_;
+  bool use_occupancy_filters_ = false;
+  std::vector<OccupancyFilter<KeyType>> filters_;
 
   Iterator make_first_iterator(
       const std::vector<std::vector<KeyType>>& keys) const {
@@ -175,6 +198,17 @@ class StaticCompositeHashTable
       : BasicCompositeHashTable<KeyType, ValueType, InnerHashTable>(l,
                                                                     factory) {}
 
+  // If enabled (before any entries are added), each table also gets an
+  // occupancy filter of its keys, so that probes of empty buckets can be
+  // skipped without a lookup in the table (see may_contain).
+  void set_use_occupancy_filters(bool use_occupancy_filters) {
+    this->use_occupancy_filters_ = use_occupancy_filters;
+    this->filters_.clear();
+    if (use_occupancy_filters) {
+      this->filters_.resize(this->l_);
+    }
+  }
+
   void add_entries_for_table(const std::vector<KeyType>& keys,
                              int_fast32_t table) {
     if (table < 0 || table >= this->l_) {
@@ -182,6 +216,9 @@ class StaticCompositeHashTable
     }
 
     this->tables_[table]->add_entries(keys);
+    if (this->use_occupancy_filters_) {
+      this->filters_[table].build(keys);
+    }
   }
 };
 
@@ -6,6 +6,9 @@
 
 #include <Eigen/Dense>
 
+#include "cpu_dispatch.h"
+#include "sparse_scatter.h"
+
 namespace falconn {
 namespace core {
 
@@ -20,7 +23,10 @@ template <typename CoordinateType = float, typename IndexType = int32_t>
 struct CosineDistanceSparse {
   typedef std::vector<std::pair<IndexType, CoordinateType>> VectorType;
 
-  CoordinateType operator()(const VectorType& p1, const VectorType& p2) {
+  // The arguments can also be sparse vectors with the same interface as
+  // VectorType (e.g., SparseVectorView from data_storage.h).
+  template <typename VectorType1, typename VectorType2>
+  CoordinateType operator()(const VectorType1& p1, const VectorType2& p2) {
     CoordinateType res = 0.0;
     IndexType ii1 = 0, ii2 = 0;
     IndexType p1size = p1.size();
@@ -32,7 +38,7 @@ struct CosineDistanceSparse {
       }
 
       if (ii1 == p1size) {
-        return res;
+        return -res;
       }
 
       while (ii2 < p2size && p2[ii2].first < p1[ii1].first) {
@@ -40,7 +46,7 @@ struct CosineDistanceSparse {
       }
 
       if (ii2 == p2size) {
-        return res;
+        return -res;
       }
 
       if (p1[ii1].first == p2[ii2].first) {
@@ -56,6 +62,37 @@ struct CosineDistanceSparse {
   }
 };
 
+// Computes the same distance as CosineDistanceSparse, but scatters the query
+// into a dense buffer once (see SparseScatterQuery) so that each distance
+// computation is a gather over the nonzeros of the data point instead of a
+// merge. This pays off when a query is compared to many candidates.
+// NearestNeighborQuery calls load_query before scoring the candidates of a
+// query; other callers get the query loaded on the first call.
+template <typename CoordinateType = float, typename IndexType = int32_t>
+struct CosineDistanceSparseScatter {
+  typedef std::vector<std::pair<IndexType, CoordinateType>> VectorType;
+
+  template <typename QueryType>
+  void load_query(const QueryType& q) {
+    scatter_.load_query(q);
+  }
+
+  template <typename VectorType1, typename VectorType2>
+  CoordinateType operator()(const VectorType1& q, const VectorType2& p) {
+    if (!scatter_.is_loaded(&q)) {
+      scatter_.load_query(q);
+    }
+    CoordinateType dot, sqnorm;
+    scatter_.gather(p, &dot, &sqnorm);
+    // negate the result because LSHTable assumes that smaller distances
+    // are better
+    return -dot;
+  }
+
+ private:
+  SparseScatterQuery<CoordinateType, IndexType> scatter_;
+};
+
 // The Dense functions assume that the data points are stored as dense
 // Eigen column vectors.
 
@@ -64,13 +101,24 @@ struct CosineDistanceDense {
   typedef Eigen::Matrix<CoordinateType, Eigen::Dynamic, 1, Eigen::ColMajor>
       VectorType;
 
+  CosineDistanceDense() : kernels_(&cpu_kernels()) {}
+
+  // Uses the kernels specialized for vectors of the given dimension if there
+  // are any (see cpu_kernels(dimension)). All points must have this
+  // dimension then.
+  explicit CosineDistanceDense(int_fast64_t dimension)
+      : kernels_(&cpu_kernels(dimension)) {}
+
   template <typename Derived1, typename Derived2>
   CoordinateType operator()(const Eigen::MatrixBase<Derived1>& p1,
                             const Eigen::MatrixBase<Derived2>& p2) {
     // negate the result because LSHTable assumes that smaller distances
     // are better
-    return -p1.dot(p2);
+    return -cpu_dispatch_helpers::dot_product(*kernels_, p1, p2);
   }
+
+ private:
+  const CpuKernels* kernels_;
 };
 
 }  // namespace core
@@ -0,0 +1,611 @@
+#ifndef __CPU_DISPATCH_H__
+#define __CPU_DISPATCH_H__
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+#include <Eigen/Dense>
+
+// With GCC or clang on x86, the kernels below are compiled for several
+// instruction sets (using target attributes, so independently of -march) and
+// the best one the CPU supports is picked at runtime. This way, a single
+// binary runs at full speed on every CPU of a heterogeneous fleet. Define
+// FALCONN_NO_RUNTIME_DISPATCH to rely on the compiler flags instead (the
+// dense distances then use Eigen directly).
+#if !defined(FALCONN_NO_RUNTIME_DISPATCH) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define FALCONN_RUNTIME_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace falconn {
+namespace core {
+
+// Instruction sets of the kernels, from the most to the least preferred.
+enum class InstructionSet {
+  AVX512 = 0,  // AVX-512F (plus AVX2, FMA and POPCNT)
+  AVX2 = 1,    // AVX2, FMA and POPCNT
+  Generic = 2
+};
+
+// The kernels for one instruction set.
+struct CpuKernels {
+  // Inner product of two float vectors of length n.
+  float (*dot_product)(const float*, const float*, int_fast64_t n);
+  // Squared Euclidean distance between two float vectors of length n.
+  float (*squared_distance)(const float*, const float*, int_fast64_t n);
+  // The cross-polytope hash of a rotated vector of length n: i if entry i
+  // has the largest absolute value and is non-negative, i + n if it is
+  // negative (the first such entry on ties).
+  int_fast64_t (*decode_cp)(const float*, int_fast64_t n);
+  // Hamming distance between two bit vectors of num_chunks 64-bit words.
+  int_fast32_t (*hamming_distance)(const uint64_t*, const uint64_t*,
+                                   int_fast32_t num_chunks);
+};
+
+namespace cpu_dispatch_helpers {
+
+inline float dot_product_generic(const float* a, const float* b,
+                                 int_fast64_t n) {
+  float res = 0.0;
+  for (int_fast64_t ii = 0; ii < n; ++ii) {
+    res += a[ii] * b[ii];
+  }
+  return res;
+}
+
+inline float squared_distance_generic(const float* a, const float* b,
+                                      int_fast64_t n) {
+  float res = 0.0;
+  for (int_fast64_t ii = 0; ii < n; ++ii) {
+    float diff = a[ii] - b[ii];
+    res += diff * diff;
+  }
+  return res;
+}
+
+template <typename CoordinateType>
+int_fast64_t decode_cp_generic(const CoordinateType* data, int_fast64_t n) {
+  int_fast64_t res = 0;
+  CoordinateType best = data[0];
+  if (-data[0] > best) {
+    best = -data[0];
+    res = n;
+  }
+  for (int_fast64_t ii = 1; ii < n; ++ii) {
+    if (data[ii] > best) {
+      best = data[ii];
+      res = ii;
+    } else if (-data[ii] > best) {
+      best = -data[ii];
+      res = ii + n;
+    }
+  }
+  return res;
+}
+
+inline int_fast64_t decode_cp_float_generic(const float* data,
+                                            int_fast64_t n) {
+  return decode_cp_generic(data, n);
+}
+
+inline int_fast32_t hamming_distance_generic(const uint64_t* a,
+                                             const uint64_t* b,
+                                             int_fast32_t num_chunks) {
+  int_fast32_t res = 0;
+  for (int_fast32_t ii = 0; ii < num_chunks; ++ii) {
+    res += __builtin_popcountll(a[ii] ^ b[ii]);
+  }
+  return res;
+}
+
+#ifdef FALCONN_RUNTIME_DISPATCH
+
+// Returns the first index in [from, n) whose entry has absolute value best
+// (n if there is none) and turns it into the cross-polytope hash.
+inline int_fast64_t finish_decode_cp(const float* data, int_fast64_t n,
+                                     int_fast64_t from, float best) {
+  for (int_fast64_t ii = from; ii < n; ++ii) {
+    if (data[ii] == best) {
+      return ii;
+    } else if (-data[ii] == best) {
+      return ii + n;
+    }
+  }
+  // only reachable if all entries are NaN
+  return 0;
+}
+
+__attribute__((target("popcnt"))) inline int_fast32_t hamming_distance_popcnt(
+    const uint64_t* a, const uint64_t* b, int_fast32_t num_chunks) {
+  int_fast32_t res = 0;
+  for (int_fast32_t ii = 0; ii < num_chunks; ++ii) {
+    res += __builtin_popcountll(a[ii] ^ b[ii]);
+  }
+  return res;
+}
+
+__attribute__((target("avx2,fma"))) inline float horizontal_sum_avx2(
+    __m256 v) {
+  __m128 lo = _mm256_castps256_ps128(v);
+  __m128 hi = _mm256_extractf128_ps(v, 1);
+  lo = _mm_add_ps(lo, hi);
+  lo = _mm_hadd_ps(lo, lo);
+  lo = _mm_hadd_ps(lo, lo);
+  return _mm_cvtss_f32(lo);
+}
+
+__attribute__((target("avx2,fma"))) inline float dot_product_avx2(
+    const float* a, const float* b, int_fast64_t n) {
+  __m256 acc0 = _mm256_setzero_ps();
+  __m256 acc1 = _mm256_setzero_ps();
+  int_fast64_t ii = 0;
+  for (; ii + 16 <= n; ii += 16) {
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + ii), _mm256_loadu_ps(b + ii),
+                           acc0);
+    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + ii + 8),
+                           _mm256_loadu_ps(b + ii + 8), acc1);
+  }
+  if (ii + 8 <= n) {
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + ii), _mm256_loadu_ps(b + ii),
+                           acc0);
+    ii += 8;
+  }
+  float res = horizontal_sum_avx2(_mm256_add_ps(acc0, acc1));
+  for (; ii < n; ++ii) {
+    res += a[ii] * b[ii];
+  }
+  return res;
+}
+
+__attribute__((target("avx2,fma"))) inline float squared_distance_avx2(
+    const float* a, const float* b, int_fast64_t n) {
+  __m256 acc0 = _mm256_setzero_ps();
+  __m256 acc1 = _mm256_setzero_ps();
+  int_fast64_t ii = 0;
+  for (; ii + 16 <= n; ii += 16) {
+    __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(a + ii), _mm256_loadu_ps(b + ii));
+    __m256 d1 = _mm256_sub_ps(_mm256_loadu_ps(a + ii + 8),
+                              _mm256_loadu_ps(b + ii + 8));
+    acc0 = _mm256_fmadd_ps(d0, d0, acc0);
+    acc1 = _mm256_fmadd_ps(d1, d1, acc1);
+  }
+  if (ii + 8 <= n) {
+    __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(a + ii), _mm256_loadu_ps(b + ii));
+    acc0 = _mm256_fmadd_ps(d0, d0, acc0);
+    ii += 8;
+  }
+  float res = horizontal_sum_avx2(_mm256_add_ps(acc0, acc1));
+  for (; ii < n; ++ii) {
+    float diff = a[ii] - b[ii];
+    res += diff * diff;
+  }
+  return res;
+}
+
+// Two passes: the maximum absolute value first, then its first occurrence.
+// This gives exactly the result of decode_cp_generic.
+__attribute__((target("avx2,fma"))) inline int_fast64_t decode_cp_avx2(
+    const float* data, int_fast64_t n) {
+  const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+  __m256 max_abs = _mm256_setzero_ps();
+  int_fast64_t ii = 0;
+  for (; ii + 8 <= n; ii += 8) {
+    __m256 abs = _mm256_andnot_ps(sign_mask, _mm256_loadu_ps(data + ii));
+    // returns the second operand if the first one is NaN
+    max_abs = _mm256_max_ps(abs, max_abs);
+  }
+  __m128 m = _mm_max_ps(_mm256_castps256_ps128(max_abs),
+                        _mm256_extractf128_ps(max_abs, 1));
+  m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+  m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+  float best = _mm_cvtss_f32(m);
+  for (int_fast64_t jj = ii; jj < n; ++jj) {
+    if (data[jj] > best) {
+      best = data[jj];
+    } else if (-data[jj] > best) {
+      best = -data[jj];
+    }
+  }
+  __m256 best_vec = _mm256_set1_ps(best);
+  for (ii = 0; ii + 8 <= n; ii += 8) {
+    __m256 abs = _mm256_andnot_ps(sign_mask, _mm256_loadu_ps(data + ii));
+    int mask = _mm256_movemask_ps(_mm256_cmp_ps(abs, best_vec, _CMP_EQ_OQ));
+    if (mask != 0) {
+      break;
+    }
+  }
+  return finish_decode_cp(data, n, ii, best);
+}
+
+// (_mm512_reduce_add_ps and _mm512_reduce_max_ps trigger spurious
+// uninitialized warnings with some versions of GCC.)
+__attribute__((target("avx512f"))) inline float horizontal_sum_avx512(
+    __m512 v) {
+  alignas(64) float lanes[16];
+  _mm512_store_ps(lanes, v);
+  float res = 0.0;
+  for (int ii = 0; ii < 16; ++ii) {
+    res += lanes[ii];
+  }
+  return res;
+}
+
+__attribute__((target("avx512f"))) inline float horizontal_max_avx512(
+    __m512 v) {
+  alignas(64) float lanes[16];
+  _mm512_store_ps(lanes, v);
+  float res = lanes[0];
+  for (int ii = 1; ii < 16; ++ii) {
+    res = std::max(res, lanes[ii]);
+  }
+  return res;
+}
+
+__attribute__((target("avx512f"))) inline float dot_product_avx512(
+    const float* a, const float* b, int_fast64_t n) {
+  __m512 acc0 = _mm512_setzero_ps();
+  __m512 acc1 = _mm512_setzero_ps();
+  int_fast64_t ii = 0;
+  for (; ii + 32 <= n; ii += 32) {
+    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + ii), _mm512_loadu_ps(b + ii),
+                           acc0);
+    acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + ii + 16),
+                           _mm512_loadu_ps(b + ii + 16), acc1);
+  }
+  if (ii + 16 <= n) {
+    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + ii), _mm512_loadu_ps(b + ii),
+                           acc0);
+    ii += 16;
+  }
+  if (ii < n) {
+    __mmask16 tail = static_cast<__mmask16>((1u << (n - ii)) - 1);
+    acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, a + ii),
+                           _mm512_maskz_loadu_ps(tail, b + ii), acc1);
+  }
+  return horizontal_sum_avx512(_mm512_add_ps(acc0, acc1));
+}
+
+__attribute__((target("avx512f"))) inline float squared_distance_avx512(
+    const float* a, const float* b, int_fast64_t n) {
+  __m512 acc0 = _mm512_setzero_ps();
+  __m512 acc1 = _mm512_setzero_ps();
+  int_fast64_t ii = 0;
+  for (; ii + 32 <= n; ii += 32) {
+    __m512 d0 = _mm512_sub_ps(_mm512_loadu_ps(a + ii), _mm512_loadu_ps(b + ii));
+    __m512 d1 = _mm512_sub_ps(_mm512_loadu_ps(a + ii + 16),
+                              _mm512_loadu_ps(b + ii + 16));
+    acc0 = _mm512_fmadd_ps(d0, d0, acc0);
+    acc1 = _mm512_fmadd_ps(d1, d1, acc1);
+  }
+  if (ii + 16 <= n) {
+    __m512 d0 = _mm512_sub_ps(_mm512_loadu_ps(a + ii), _mm512_loadu_ps(b + ii));
+    acc0 = _mm512_fmadd_ps(d0, d0, acc0);
+    ii += 16;
+  }
+  if (ii < n) {
+    __mmask16 tail = static_cast<__mmask16>((1u << (n - ii)) - 1);
+    __m512 d1 = _mm512_sub_ps(_mm512_maskz_loadu_ps(tail, a + ii),
+                              _mm512_maskz_loadu_ps(tail, b + ii));
+    acc1 = _mm512_fmadd_ps(d1, d1, acc1);
+  }
+  return horizontal_sum_avx512(_mm512_add_ps(acc0, acc1));
+}
+
+__attribute__((target("avx512f"))) inline int_fast64_t decode_cp_avx512(
+    const float* data, int_fast64_t n) {
+  __m512 max_abs = _mm512_setzero_ps();
+  int_fast64_t ii = 0;
+  // NaNs never compare greater, so they are skipped as in decode_cp_generic
+  for (; ii + 16 <= n; ii += 16) {
+    __m512 abs = _mm512_abs_ps(_mm512_loadu_ps(data + ii));
+    max_abs = _mm512_mask_mov_ps(
+        max_abs, _mm512_cmp_ps_mask(abs, max_abs, _CMP_GT_OQ), abs);
+  }
+  if (ii < n) {
+    __mmask16 tail = static_cast<__mmask16>((1u << (n - ii)) - 1);
+    __m512 abs = _mm512_abs_ps(_mm512_maskz_loadu_ps(tail, data + ii));
+    max_abs = _mm512_mask_mov_ps(
+        max_abs, _mm512_cmp_ps_mask(abs, max_abs, _CMP_GT_OQ), abs);
+  }
+  float best = horizontal_max_avx512(max_abs);
+  __m512 best_vec = _mm512_set1_ps(best);
+  for (ii = 0; ii + 16 <= n; ii += 16) {
+    __mmask16 mask = _mm512_cmp_ps_mask(
+        _mm512_abs_ps(_mm512_loadu_ps(data + ii)), best_vec, _CMP_EQ_OQ);
+    if (mask != 0) {
+      break;
+    }
+  }
+  return finish_decode_cp(data, n, ii, best);
+}
+
+inline bool instruction_set_supported(InstructionSet isa) {
+  __builtin_cpu_init();
+  switch (isa) {
+    case InstructionSet::AVX512:
+      return __builtin_cpu_supports("avx512f") &&
+             __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") &&
+             __builtin_cpu_supports("popcnt");
+    case InstructionSet::AVX2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") &&
+             __builtin_cpu_supports("popcnt");
+    case InstructionSet::Generic:
+      return true;
+  }
+  return false;
+}
+
+#else
+
+inline bool instruction_set_supported(InstructionSet isa) {
+  return isa == InstructionSet::Generic;
+}
+
+#endif
+
+inline InstructionSet detect_instruction_set() {
+  if (instruction_set_supported(InstructionSet::AVX512)) {
+    return InstructionSet::AVX512;
+  } else if (instruction_set_supported(InstructionSet::AVX2)) {
+    return InstructionSet::AVX2;
+  } else {
+    return InstructionSet::Generic;
+  }
+}
+
+}  // namespace cpu_dispatch_helpers
+
+// Returns true if the kernels for isa are compiled in and the CPU supports
+// them.
+inline bool instruction_set_supported(InstructionSet isa) {
+  return cpu_dispatch_helpers::instruction_set_supported(isa);
+}
+
+// The most preferred supported instruction set (detected once).
+inline InstructionSet best_instruction_set() {
+  static const InstructionSet isa =
+      cpu_dispatch_helpers::detect_instruction_set();
+  return isa;
+}
+
+// The kernels for the given instruction set, which must be supported.
+inline CpuKernels get_cpu_kernels(InstructionSet isa) {
+  namespace ch = cpu_dispatch_helpers;
+  switch (isa) {
+#ifdef FALCONN_RUNTIME_DISPATCH
+    case InstructionSet::AVX512:
+      return {ch::dot_product_avx512, ch::squared_distance_avx512,
+              ch::decode_cp_avx512, ch::hamming_distance_popcnt};
+    case InstructionSet::AVX2:
+      return {ch::dot_product_avx2, ch::squared_distance_avx2,
+              ch::decode_cp_avx2, ch::hamming_distance_popcnt};
+#endif
+    default:
+      return {ch::dot_product_generic, ch::squared_distance_generic,
+              ch::decode_cp_float_generic, ch::hamming_distance_generic};
+  }
+}
+
+// The kernels for best_instruction_set().
+inline const CpuKernels& cpu_kernels() {
+  static const CpuKernels kernels = get_cpu_kernels(best_instruction_set());
+  return kernels;
+}
+
+namespace cpu_dispatch_helpers {
+
+// Dense distance kernels with the vector length as a compile-time constant:
+// the length checks for the tails are gone and the compiler can unroll the
+// loops completely. The length argument is ignored.
+template <int_fast64_t Dim>
+float dot_product_generic_fixed(const float* a, const float* b, int_fast64_t) {
+  return dot_product_generic(a, b, Dim);
+}
+
+template <int_fast64_t Dim>
+float squared_distance_generic_fixed(const float* a, const float* b,
+                                     int_fast64_t) {
+  return squared_distance_generic(a, b, Dim);
+}
+
+#ifdef FALCONN_RUNTIME_DISPATCH
+
+template <int_fast64_t Dim>
+__attribute__((target("avx2,fma"))) float dot_product_avx2_fixed(
+    const float* a, const float* b, int_fast64_t) {
+  return dot_product_avx2(a, b, Dim);
+}
+
+template <int_fast64_t Dim>
+__attribute__((target("avx2,fma"))) float squared_distance_avx2_fixed(
+    const float* a, const float* b, int_fast64_t) {
+  return squared_distance_avx2(a, b, Dim);
+}
+
+template <int_fast64_t Dim>
+__attribute__((target("avx512f"))) float dot_product_avx512_fixed(
+    const float* a, const float* b, int_fast64_t) {
+  return dot_product_avx512(a, b, Dim);
+}
+
+template <int_fast64_t Dim>
+__attribute__((target("avx512f"))) float squared_distance_avx512_fixed(
+    const float* a, const float* b, int_fast64_t) {
+  return squared_distance_avx512(a, b, Dim);
+}
+
+#endif
+
+template <int_fast64_t Dim>
+CpuKernels get_fixed_dimension_kernels(InstructionSet isa) {
+  CpuKernels res = get_cpu_kernels(isa);
+  switch (isa) {
+#ifdef FALCONN_RUNTIME_DISPATCH
+    case InstructionSet::AVX512:
+      res.dot_product = dot_product_avx512_fixed<Dim>;
+      res.squared_distance = squared_distance_avx512_fixed<Dim>;
+      break;
+    case InstructionSet::AVX2:
+      res.dot_product = dot_product_avx2_fixed<Dim>;
+      res.squared_distance = squared_distance_avx2_fixed<Dim>;
+      break;
+#endif
+    default:
+      res.dot_product = dot_product_generic_fixed<Dim>;
+      res.squared_distance = squared_distance_generic_fixed<Dim>;
+  }
+  return res;
+}
+
+}  // namespace cpu_dispatch_helpers
+
+// The common dimensions for which get_cpu_kernels(isa, dimension) has dense
+// distance kernels specialized at compile time.
+const int_fast64_t kFixedDimensions[] = {64,  96,  100, 128, 256,
+                                         384, 512, 768, 960, 1024};
+const int kNumFixedDimensions =
+    sizeof(kFixedDimensions) / sizeof(kFixedDimensions[0]);
+
+// The kernels for the given instruction set (which must be supported). If
+// dimension is one of kFixedDimensions, dot_product and squared_distance are
+// specialized for vectors of exactly this length and must only be called with
+// it.
+inline CpuKernels get_cpu_kernels(InstructionSet isa, int_fast64_t dimension) {
+  namespace ch = cpu_dispatch_helpers;
+  switch (dimension) {
+    case 64:
+      return ch::get_fixed_dimension_kernels<64>(isa);
+    case 96:
+      return ch::get_fixed_dimension_kernels<96>(isa);
+    case 100:
+      return ch::get_fixed_dimension_kernels<100>(isa);
+    case 128:
+      return ch::get_fixed_dimension_kernels<128>(isa);
+    case 256:
+      return ch::get_fixed_dimension_kernels<256>(isa);
+    case 384:
+      return ch::get_fixed_dimension_kernels<384>(isa);
+    case 512:
+      return ch::get_fixed_dimension_kernels<512>(isa);
+    case 768:
+      return ch::get_fixed_dimension_kernels<768>(isa);
+    case 960:
+      return ch::get_fixed_dimension_kernels<960>(isa);
+    case 1024:
+      return ch::get_fixed_dimension_kernels<1024>(isa);
+    default:
+      return get_cpu_kernels(isa);
+  }
+}
+
+// The kernels for best_instruction_set() and the given dimension.
+inline const CpuKernels& cpu_kernels(int_fast64_t dimension) {
+  static const struct FixedDimensionKernels {
+    FixedDimensionKernels() {
+      for (int ii = 0; ii < kNumFixedDimensions; ++ii) {
+        kernels[ii] =
+            get_cpu_kernels(best_instruction_set(), kFixedDimensions[ii]);
+      }
+    }
+    CpuKernels kernels[kNumFixedDimensions];
+  } fixed;
+  for (int ii = 0; ii < kNumFixedDimensions; ++ii) {
+    if (kFixedDimensions[ii] == dimension) {
+      return fixed.kernels[ii];
+    }
+  }
+  return cpu_kernels();
+}
+
+namespace cpu_dispatch_helpers {
+
+// True if the Eigen expression is a contiguous float vector, so the dense
+// distances can pass its data to the dispatched kernels.
+template <typename Derived>
+struct IsContiguousFloatVector {
+  static const bool value =
+      std::is_same<typename Derived::Scalar, float>::value &&
+      (Derived::Flags & Eigen::DirectAccessBit) != 0 &&
+      Derived::InnerStrideAtCompileTime == 1 &&
+      (Derived::ColsAtCompileTime == 1 || Derived::RowsAtCompileTime == 1);
+};
+
+template <typename Derived1, typename Derived2>
+struct UseDenseKernels {
+#ifdef FALCONN_RUNTIME_DISPATCH
+  static const bool value = IsContiguousFloatVector<Derived1>::value &&
+                            IsContiguousFloatVector<Derived2>::value;
+#else
+  static const bool value = false;
+#endif
+};
+
+// The dense distances with the given kernels (if the vectors are contiguous
+// float vectors, see cpu_kernels(dimension)) or Eigen.
+template <typename Derived1, typename Derived2>
+typename std::enable_if<UseDenseKernels<Derived1, Derived2>::value,
+                        typename Derived1::Scalar>::type
+dot_product(const CpuKernels& kernels, const Eigen::MatrixBase<Derived1>& p1,
+            const Eigen::MatrixBase<Derived2>& p2) {
+  return kernels.dot_product(p1.derived().data(), p2.derived().data(),
+                             p1.size());
+}
+
+template <typename Derived1, typename Derived2>
+typename std::enable_if<!UseDenseKernels<Derived1, Derived2>::value,
+                        typename Derived1::Scalar>::type
+dot_product(const CpuKernels&, const Eigen::MatrixBase<Derived1>& p1,
+            const Eigen::MatrixBase<Derived2>& p2) {
+  return p1.dot(p2);
+}
+
+template <typename Derived1, typename Derived2>
+typename std::enable_if<UseDenseKernels<Derived1, Derived2>::value,
+                        typename Derived1::Scalar>::type
+squared_distance(const CpuKernels& kernels,
+                 const Eigen::MatrixBase<Derived1>& p1,
+                 const Eigen::MatrixBase<Derived2>& p2) {
+  return kernels.squared_distance(p1.derived().data(), p2.derived().data(),
+                                  p1.size());
+}
+
+template <typename Derived1, typename Derived2>
+typename std::enable_if<!UseDenseKernels<Derived1, Derived2>::value,
+                        typename Derived1::Scalar>::type
+squared_distance(const CpuKernels&, const Eigen::MatrixBase<Derived1>& p1,
+                 const Eigen::MatrixBase<Derived2>& p2) {
+  return (p1 - p2).squaredNorm();
+}
+
+template <typename Derived1, typename Derived2>
+typename Derived1::Scalar dot_product(const Eigen::MatrixBase<Derived1>& p1,
+                                      const Eigen::MatrixBase<Derived2>& p2) {
+  return dot_product(cpu_kernels(), p1, p2);
+}
+
+template <typename Derived1, typename Derived2>
+typename Derived1::Scalar squared_distance(
+    const Eigen::MatrixBase<Derived1>& p1,
+    const Eigen::MatrixBase<Derived2>& p2) {
+  return squared_distance(cpu_kernels(), p1, p2);
+}
+
+template <typename CoordinateType>
+int_fast64_t decode_cp(const CoordinateType* data, int_fast64_t n) {
+  return decode_cp_generic(data, n);
+}
+
+#ifdef FALCONN_RUNTIME_DISPATCH
+inline int_fast64_t decode_cp(const float* data, int_fast64_t n) {
+  return cpu_kernels().decode_cp(data, n);
+}
+#endif
+
+}  // namespace cpu_dispatch_helpers
+
+}  // namespace core
+}  // namespace falconn
+
+#endif
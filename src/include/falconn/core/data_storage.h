@@ -1,6 +1,7 @@
 #ifndef __DATA_STORAGE_H__
 #define __DATA_STORAGE_H__
 
+#include <algorithm>
 #include <cstdint>
 #include <type_traits>
 #include <utility>
@@ -336,6 +337,199 @@ class PlainArrayDataStorage<DenseVector<CoordinateType>, KeyType> {
   int_fast64_t dim_;
 };
 
+// A read-only view of a sparse vector whose indices and values are stored in
+// two separate arrays (as in the CSR format). It provides the parts of the
+// interface of std::vector<std::pair<IndexType, CoordinateType>> that the
+// sparse hash and distance functions use: size() and operator[] returning an
+// (index, value) pair.
+template <typename CoordinateType, typename IndexType = int32_t>
+class SparseVectorView {
+ public:
+  typedef std::pair<IndexType, CoordinateType> EntryType;
+
+  SparseVectorView(const IndexType* indices, const CoordinateType* values,
+                   int_fast64_t size)
+      : indices_(indices), values_(values), size_(size) {}
+
+  int_fast64_t size() const { return size_; }
+
+  EntryType operator[](int_fast64_t ii) const {
+    return EntryType(indices_[ii], values_[ii]);
+  }
+
+  const IndexType* indices() const { return indices_; }
+
+  const CoordinateType* values() const { return values_; }
+
+ private:
+  const IndexType* indices_;
+  const CoordinateType* values_;
+  int_fast64_t size_;
+};
+
+// A data storage for sparse points in CSR format (see CSRPointSet in
+// falconn_global.h). All points share three arrays, so there is no per-point
+// allocation. The iterators return SparseVectorView objects pointing into the
+// arrays.
+template <typename CoordinateType, typename IndexType = int32_t,
+          typename KeyType = int32_t>
+class CSRDataStorage {
+ public:
+  typedef SparseVectorView<CoordinateType, IndexType> ViewType;
+
+  class FullSequenceIterator {
+   public:
+    FullSequenceIterator(const CSRDataStorage& parent)
+        : parent_(&parent), tmp_view_(nullptr, nullptr, 0) {
+      if (parent_->size() == 0) {
+        parent_ = nullptr;
+        index_ = -1;
+      } else {
+        index_ = 0;
+        // TODO: try different prefetching steps
+        parent_->prefetch_point(0, &prefetcher_);
+        if (parent_->size() >= 2) {
+          parent_->prefetch_point(1, &prefetcher_);
+
+          if (parent_->size() >= 3) {
+            parent_->prefetch_point(2, &prefetcher_);
+          }
+        }
+      }
+    }
+
+    FullSequenceIterator() : tmp_view_(nullptr, nullptr, 0) {}
+
+    const ViewType& get_point() {
+      tmp_view_ = parent_->get_view(index_);
+      return tmp_view_;
+    }
+
+    const KeyType& get_key() const { return index_; }
+
+    bool is_valid() const { return parent_ != nullptr; }
+
+    void operator++() {
+      if (index_ >= 0 &&
+          index_ + 1 < static_cast<int_fast64_t>(parent_->size())) {
+        index_ += 1;
+        if (index_ + 2 < static_cast<int_fast64_t>(parent_->size())) {
+          // TODO: try different prefetching steps
+          parent_->prefetch_point(index_ + 2, &prefetcher_);
+        }
+      } else {
+        if (index_ == -1) {
+          throw DataStorageError("Advancing invalid FullSequenceIterator.");
+        } else {
+          parent_ = nullptr;
+          index_ = -1;
+        }
+      }
+    }
+
+   private:
+    KeyType index_ = -1;
+    const CSRDataStorage* parent_ = nullptr;
+    ViewType tmp_view_;
+    CSRPrefetcher<CoordinateType, IndexType> prefetcher_;
+  };
+
+  class SubsequenceIterator {
+   public:
+    SubsequenceIterator(const std::vector<KeyType>& keys,
+                        const CSRDataStorage& parent)
+        : keys_(&keys), parent_(&parent), tmp_view_(nullptr, nullptr, 0) {
+      if (keys_->size() == 0) {
+        keys_ = nullptr;
+        parent_ = nullptr;
+        index_ = -1;
+      } else {
+        index_ = 0;
+        // TODO: try different prefetching steps
+        parent_->prefetch_point((*keys_)[0], &prefetcher_);
+        if (keys_->size() >= 2) {
+          parent_->prefetch_point((*keys_)[1], &prefetcher_);
+
+          if (keys_->size() >= 3) {
+            parent_->prefetch_point((*keys_)[2], &prefetcher_);
+          }
+        }
+      }
+    }
+
+    SubsequenceIterator() : tmp_view_(nullptr, nullptr, 0) {}
+
+    const ViewType& get_point() {
+      tmp_view_ = parent_->get_view((*keys_)[index_]);
+      return tmp_view_;
+    }
+
+    const KeyType& get_key() const { return (*keys_)[index_]; }
+
+    bool is_valid() const { return parent_ != nullptr; }
+
+    void operator++() {
+      if (index_ >= 0 &&
+          index_ + 1 < static_cast<int_fast64_t>(keys_->size())) {
+        index_ += 1;
+        if (index_ + 2 < static_cast<int_fast64_t>(keys_->size())) {
+          // TODO: try different prefetching steps
+          parent_->prefetch_point((*keys_)[index_ + 2], &prefetcher_);
+        }
+      } else {
+        if (index_ == -1) {
+          throw DataStorageError("Advancing invalid SubsequenceIterator.");
+        }
+        keys_ = nullptr;
+        parent_ = nullptr;
+        index_ = -1;
+      }
+    }
+
+   private:
+    int_fast64_t index_ = -1;
+    const std::vector<KeyType>* keys_ = nullptr;
+    const CSRDataStorage* parent_ = nullptr;
+    ViewType tmp_view_;
+    CSRPrefetcher<CoordinateType, IndexType> prefetcher_;
+  };
+
+  CSRDataStorage(const int64_t* indptr, const IndexType* indices,
+                 const CoordinateType* values, int_fast64_t num_points)
+      : indptr_(indptr),
+        indices_(indices),
+        values_(values),
+        num_points_(num_points) {}
+
+  int_fast64_t size() const { return num_points_; }
+
+  SubsequenceIterator get_subsequence(const std::vector<KeyType>& keys) const {
+    return SubsequenceIterator(keys, *this);
+  }
+
+  FullSequenceIterator get_full_sequence() const {
+    return FullSequenceIterator(*this);
+  }
+
+ private:
+  ViewType get_view(int_fast64_t index) const {
+    int64_t begin = indptr_[index];
+    return ViewType(indices_ + begin, values_ + begin,
+                    indptr_[index + 1] - begin);
+  }
+
+  void prefetch_point(int_fast64_t index,
+                      CSRPrefetcher<CoordinateType, IndexType>* prefetcher)
+      const {
+    prefetcher->prefetch(indices_, values_, indptr_[index]);
+  }
+
+  const int64_t* indptr_;
+  const IndexType* indices_;
+  const CoordinateType* values_;
+  int_fast64_t num_points_;
+};
+
 template <typename PointType, typename Transformation,
           typename InnerDataStorage, typename KeyType = int32_t>
 class TransformedDataStorage {
@@ -410,6 +604,30 @@ class TransformedDataStorage {
   const InnerDataStorage& storage_;
 };
 
+// Computes an order of the points in which all points with the same hash are
+// adjacent: the points are sorted by hash value, and points with equal hashes
+// keep their relative order. After the call, (*order)[ii] is the key of the
+// point that should be stored at position ii. Storing the points in this
+// order (e.g., by the hashes of the first table) places the points of a bucket
+// in adjacent memory, which makes the candidate reads in NearestNeighborQuery
+// more local.
+template <typename HashType, typename KeyType>
+void compute_bucket_order(const std::vector<HashType>& hashes,
+                          std::vector<KeyType>* order) {
+  if (order == nullptr) {
+    throw DataStorageError("Order vector pointer is nullptr.");
+  }
+  order->resize(hashes.size());
+  for (int_fast64_t ii = 0; ii < static_cast<int_fast64_t>(hashes.size());
+       ++ii) {
+    (*order)[ii] = ii;
+  }
+  std::stable_sort(order->begin(), order->end(),
+                   [&hashes](KeyType a, KeyType b) {
+                     return hashes[a] < hashes[b];
+                   });
+}
+
 }  // namespace core
 }  // namespace falconn
 
@@ -1,11 +1,15 @@
 #ifndef __EUCLIDEAN_DISTANCE_H__
 #define __EUCLIDEAN_DISTANCE_H__
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
 #include <Eigen/Dense>
 
+#include "cpu_dispatch.h"
+#include "sparse_scatter.h"
+
 namespace falconn {
 namespace core {
 
@@ -15,7 +19,10 @@ template <typename CoordinateType = float, typename IndexType = int32_t>
 struct EuclideanDistanceSparse {
   typedef std::vector<std::pair<IndexType, CoordinateType>> VectorType;
 
-  CoordinateType operator()(const VectorType& p1, const VectorType& p2) {
+  // The arguments can also be sparse vectors with the same interface as
+  // VectorType (e.g., SparseVectorView from data_storage.h).
+  template <typename VectorType1, typename VectorType2>
+  CoordinateType operator()(const VectorType1& p1, const VectorType2& p2) {
     CoordinateType res = 0.0;
     IndexType ii1 = 0, ii2 = 0;
     IndexType p1size = p1.size();
@@ -58,6 +65,35 @@ struct EuclideanDistanceSparse {
   }
 };
 
+// Computes the same distance as EuclideanDistanceSparse via
+// |q - p|^2 = |q|^2 + |p|^2 - 2 <q, p>, where the inner product is a gather
+// over the nonzeros of p from the scattered query (see
+// CosineDistanceSparseScatter).
+template <typename CoordinateType = float, typename IndexType = int32_t>
+struct EuclideanDistanceSparseScatter {
+  typedef std::vector<std::pair<IndexType, CoordinateType>> VectorType;
+
+  template <typename QueryType>
+  void load_query(const QueryType& q) {
+    scatter_.load_query(q);
+  }
+
+  template <typename VectorType1, typename VectorType2>
+  CoordinateType operator()(const VectorType1& q, const VectorType2& p) {
+    if (!scatter_.is_loaded(&q)) {
+      scatter_.load_query(q);
+    }
+    CoordinateType dot, sqnorm;
+    scatter_.gather(p, &dot, &sqnorm);
+    // the expansion can be slightly negative due to rounding
+    return std::max<CoordinateType>(
+        0.0, scatter_.query_sqnorm() + sqnorm - 2 * dot);
+  }
+
+ private:
+  SparseScatterQuery<CoordinateType, IndexType> scatter_;
+};
+
 // The Dense functions assume that the data points are stored as dense
 // Eigen column vectors.
 
@@ -66,11 +102,22 @@ struct EuclideanDistanceDense {
   typedef Eigen::Matrix<CoordinateType, Eigen::Dynamic, 1, Eigen::ColMajor>
       VectorType;
 
+  EuclideanDistanceDense() : kernels_(&cpu_kernels()) {}
+
+  // Uses the kernels specialized for vectors of the given dimension if there
+  // are any (see cpu_kernels(dimension)). All points must have this
+  // dimension then.
+  explicit EuclideanDistanceDense(int_fast64_t dimension)
+      : kernels_(&cpu_kernels(dimension)) {}
+
   template <typename Derived1, typename Derived2>
   CoordinateType operator()(const Eigen::MatrixBase<Derived1>& p1,
                             const Eigen::MatrixBase<Derived2>& p2) {
-    return (p1 - p2).squaredNorm();
+    return cpu_dispatch_helpers::squared_distance(*kernels_, p1, p2);
   }
+
+ private:
+  const CpuKernels* kernels_;
 };
 
 }  // namespace core
@@ -1,6 +1,9 @@
 #ifndef __HASH_TABLE_HELPERS_H__
 #define __HASH_TABLE_HELPERS_H__
 
+#include <cstdint>
+#include <functional>
+
 #include "../falconn_global.h"
 
 namespace falconn {
@@ -11,6 +14,83 @@ class HashTableError : public FalconnError {
   HashTableError(const char* msg) : FalconnError(msg) {}
 };
 
+namespace hash_table_helpers {
+
+// The key as a 64-bit integer for hashing (128-bit keys are folded so that
+// all bits matter).
+template <typename KeyType>
+uint64_t fold_key(const KeyType& key) {
+  return static_cast<uint64_t>(key);
+}
+
+#ifdef FALCONN_HAVE_UINT128
+inline uint64_t fold_key(const uint128_t& key) {
+  return static_cast<uint64_t>(key) ^
+         (static_cast<uint64_t>(key >> 64) * 0x9e3779b97f4a7c15ULL);
+}
+#endif
+
+// Hash functor for the keys in the STL containers (std::hash does not
+// support 128-bit integers).
+struct KeyHash {
+  template <typename KeyType>
+  size_t operator()(const KeyType& key) const {
+    return std::hash<uint64_t>()(fold_key(key));
+  }
+};
+
+// Number of entries in a bucket given by a pair of iterators (constant time if
+// the iterators are pointers, as for the flat and linear probing tables).
+template <typename Iterator>
+int_fast64_t bucket_size(Iterator first, Iterator last) {
+  int_fast64_t size = 0;
+  for (; first != last; ++first) {
+    size += 1;
+  }
+  return size;
+}
+
+template <typename T>
+int_fast64_t bucket_size(T* first, T* last) {
+  return last - first;
+}
+
+// Calls process_entry for at most max_num_entries entries of a bucket until
+// process_entry returns false. If the bucket is larger, the entries are spread
+// evenly over the bucket if the iterators are pointers and are the first
+// entries of the bucket otherwise.
+template <typename Iterator, typename ProcessEntry>
+void sample_bucket(Iterator first, Iterator last, int_fast64_t max_num_entries,
+                   ProcessEntry process_entry) {
+  for (int_fast64_t ii = 0; ii < max_num_entries && first != last;
+       ++ii, ++first) {
+    if (!process_entry(*first)) {
+      return;
+    }
+  }
+}
+
+template <typename T, typename ProcessEntry>
+void sample_bucket(T* first, T* last, int_fast64_t max_num_entries,
+                   ProcessEntry process_entry) {
+  int_fast64_t size = last - first;
+  if (size <= max_num_entries) {
+    for (; first != last; ++first) {
+      if (!process_entry(*first)) {
+        return;
+      }
+    }
+    return;
+  }
+  for (int_fast64_t ii = 0; ii < max_num_entries; ++ii) {
+    if (!process_entry(first[ii * size / max_num_entries])) {
+      return;
+    }
+  }
+}
+
+}  // namespace hash_table_helpers
+
 }  // namespace core
 }  // namespace falconn
 
@@ -64,6 +64,9 @@ class HeapBase {
 
   void resize(size_t new_size) { v_.resize(new_size); }
 
+  // Unlike resize, does not construct any items (insert adds them as needed).
+  void reserve(size_t new_capacity) { v_.reserve(new_capacity); }
+
  protected:
   int_fast32_t lchild(int_fast32_t x) { return 2 * x + 1; }
 
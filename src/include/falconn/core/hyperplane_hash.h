@@ -1,6 +1,8 @@
 #ifndef __HYPERPLANE_HASH_H__
 #define __HYPERPLANE_HASH_H__
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <ctime>
 #include <iterator>
@@ -17,6 +19,83 @@
 namespace falconn {
 namespace core {
 
+namespace hp_hash_helpers {
+
+// E[z_j^2] for j = 1, ..., k, where z_1 <= ... <= z_k are the sorted absolute
+// values of k independent standard Gaussians (the projections of a random
+// query onto the k hyperplanes of a table, up to scaling). Computed by
+// numerical integration over the density of the order statistics.
+inline std::vector<double> expected_squared_order_statistics(int_fast32_t k) {
+  const double max_x = 10.0;
+  const int_fast32_t num_steps = 4000;  // even (Simpson's rule)
+  const double h = max_x / num_steps;
+  const double pi = std::acos(-1.0);
+
+  std::vector<double> result(k, 0.0);
+  for (int_fast32_t step = 0; step <= num_steps; ++step) {
+    double x = step * h;
+    double weight = (step == 0 || step == num_steps) ? 1.0
+                                                     : (step % 2 ? 4.0 : 2.0);
+    // CDF and density of the absolute value of a standard Gaussian
+    double cdf = std::erf(x / std::sqrt(2.0));
+    double density = std::sqrt(2.0 / pi) * std::exp(-x * x / 2.0);
+    for (int_fast32_t jj = 1; jj <= k; ++jj) {
+      double log_binomial =
+          std::lgamma(k + 1.0) - std::lgamma(jj) - std::lgamma(k - jj + 1.0);
+      double order_density = std::exp(log_binomial) *
+                             std::pow(cdf, jj - 1.0) *
+                             std::pow(1.0 - cdf, k - jj + 0.0) * density;
+      result[jj - 1] += weight * x * x * order_density;
+    }
+  }
+  for (double& e : result) {
+    e *= h / 3.0;
+  }
+  return result;
+}
+
+// The first size non-empty sets of flipped bits in the order of their
+// expected score (the sum of the expected squared projections of the flipped
+// hyperplanes, see expected_squared_order_statistics). Bit r of an entry
+// stands for the hyperplane with the r-th smallest absolute projection, so
+// the template is the same for all queries and tables. The sets are generated
+// with the same shift / expand heap as the per-query probing sequence.
+template <typename HashType>
+void compute_probing_template(int_fast32_t k, int_fast64_t size,
+                              std::vector<HashType>* result) {
+  result->clear();
+  if (k < 8 * static_cast<int_fast32_t>(sizeof(int_fast64_t)) - 1) {
+    size = std::min(size, (int_fast64_t(1) << k) - 1);
+  }
+  if (size <= 0) {
+    return;
+  }
+  result->reserve(size);
+  std::vector<double> scores = expected_squared_order_statistics(k);
+
+  SimpleHeap<double, std::pair<HashType, int_fast32_t>> heap;
+  heap.insert(scores[0], std::make_pair(HashType(1), 0));
+  while (static_cast<int_fast64_t>(result->size()) < size) {
+    double cur_score;
+    std::pair<HashType, int_fast32_t> cur;
+    heap.extract_min(&cur_score, &cur);
+    result->push_back(cur.first);
+    int_fast32_t last = cur.second;
+    if (last != k - 1) {
+      HashType next_bit = HashType(1) << (last + 1);
+      // swapping out the last flipped index
+      heap.insert(cur_score - scores[last] + scores[last + 1],
+                  std::make_pair((cur.first ^ (HashType(1) << last)) | next_bit,
+                                 last + 1));
+      // adding a new flipped index
+      heap.insert(cur_score + scores[last + 1],
+                  std::make_pair(cur.first | next_bit, last + 1));
+    }
+  }
+}
+
+}  // namespace hp_hash_helpers
+
 // Base class for both the dense and spare hyperplane hash classes.
 // The derived classes only have to define how to multiply an input vector
 // with the hyperplanes. Everything else (next step in the hash computation,
@@ -41,14 +120,23 @@ class HyperplaneHashBase {
 
   class HashTransformation {
    public:
-    HashTransformation(const Derived& parent) : parent_(parent) {}
+    HashTransformation(const Derived& parent)
+        : parent_(parent), tmp_vector_(parent.get_k()) {}
 
     void apply(const VectorT& v, TransformedVectorType* result) const {
       parent_.get_multiplied_vector_all_tables(v, result);
     }
 
+    // Only multiplies with the hyperplanes of table l.
+    HashType hash_single_table(const VectorT& v, int_fast32_t l,
+                               TransformedVectorType*) {
+      parent_.get_multiplied_vector_single_table(v, l, &tmp_vector_);
+      return compute_hash_single_table(tmp_vector_);
+    }
+
    private:
     const Derived& parent_;
+    TransformedVectorType tmp_vector_;
   };
 
   // TODO: specialize template for faster batch hyperplane setup (if the batch
@@ -133,7 +221,7 @@ class HyperplaneHashBase {
 
  protected:
   HyperplaneHashBase(int dim, int_fast32_t k, int_fast32_t l,
-                     uint_fast64_t seed)
+                     uint_fast64_t seed, int_fast64_t probing_template_size)
       : dim_(dim), k_(k), l_(l), seed_(seed), gen_(seed) {
     if (dim_ < 1) {
       throw LSHFunctionError("Dimension must be at least 1.");
@@ -155,6 +243,13 @@ class HyperplaneHashBase {
       throw LSHFunctionError("Number of hash tables must be at least 1.");
     }
 
+    if (probing_template_size < 0) {
+      throw LSHFunctionError("Probing template size must be non-negative.");
+    }
+
+    hp_hash_helpers::compute_probing_template(k_, probing_template_size,
+                                              &probing_template_);
+
     std::normal_distribution<CoordinateType> gauss(0.0, 1.0);
 
     hyperplanes_.resize(k_ * l_, dim_);
@@ -187,6 +282,10 @@ class HyperplaneHashBase {
   std::mt19937_64 gen_;
   Eigen::Matrix<CoordinateType, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>
       hyperplanes_;
+  // Probes (beyond the main one) of every table in the order of their
+  // expected score, as sets of ranks of the absolute projections (see
+  // hp_hash_helpers::compute_probing_template). Empty if disabled.
+  std::vector<HashType> probing_template_;
 
  private:
   friend Query;
@@ -198,8 +297,11 @@ class HyperplaneHashBase {
           l_(parent.l_),
           num_probes_(0),
           cur_probe_counter_(0),
+          use_template_(false),
           sorted_hyperplane_indices_(parent.l_),
-          main_table_probe_(parent.l_) {
+          main_table_probe_(parent.l_),
+          probing_template_(parent.probing_template_),
+          rank_masks_(parent.k_ * parent.l_) {
       for (int_fast32_t ii = 0; ii < l_; ++ii) {
         sorted_hyperplane_indices_[ii].resize(k_);
         for (int_fast32_t jj = 0; jj < k_; ++jj) {
@@ -233,6 +335,22 @@ class HyperplaneHashBase {
                   sorted_hyperplane_indices_[ii].end(), comp);
       }
 
+      // If the probing template is long enough, the probes are the template
+      // entries (round robin over the tables) with the ranks mapped to the
+      // hyperplanes of this query. Otherwise, we use the heap below.
+      int_fast64_t template_size = probing_template_.size();
+      use_template_ =
+          num_probes_ >= 0 && (num_probes_ - 1) / l_ <= template_size;
+      if (use_template_) {
+        for (int_fast32_t ii = 0; ii < l_; ++ii) {
+          for (int_fast32_t jj = 0; jj < k_; ++jj) {
+            rank_masks_[ii * k_ + jj] =
+                HashType(1) << (k_ - sorted_hyperplane_indices_[ii][jj] - 1);
+          }
+        }
+        return;
+      }
+
       if (num_probes_ >= 0) {
         heap_.resize(2 * num_probes_);
       }
@@ -263,6 +381,22 @@ class HyperplaneHashBase {
         return true;
       }
 
+      if (use_template_) {
+        int_fast64_t index = cur_probe_counter_ - l_;
+        *cur_table = index % l_;
+        HashType ranks = probing_template_[index / l_];
+        const HashType* masks = &rank_masks_[*cur_table * k_];
+        HashType probe = main_table_probe_[*cur_table];
+        // the template entries mostly flip the first few ranks
+        for (; ranks != 0; ranks >>= 1, ++masks) {
+          if (ranks & 1) {
+            probe ^= *masks;
+          }
+        }
+        *cur_probe = probe;
+        return true;
+      }
+
       if (heap_.empty()) {
         return false;
       }
@@ -342,8 +476,13 @@ class HyperplaneHashBase {
     int_fast32_t l_;
     int_fast64_t num_probes_;
     int_fast64_t cur_probe_counter_;
+    bool use_template_;
     std::vector<std::vector<int_fast32_t>> sorted_hyperplane_indices_;
     std::vector<HashType> main_table_probe_;
+    const std::vector<HashType>& probing_template_;
+    // rank_masks_[ii * k + jj] is the bit of the hyperplane with the jj-th
+    // smallest absolute projection in table ii.
+    std::vector<HashType> rank_masks_;
     SimpleHeap<CoordinateType, ProbeCandidate> heap_;
     const TransformedVectorType* hash_vector_;
   };
@@ -363,11 +502,16 @@ class HyperplaneHashDense
   typedef Eigen::Matrix<CoordinateType, Eigen::Dynamic, 1, Eigen::ColMajor>
       DerivedVectorT;
 
+  // If probing_template_size is positive, the multiprobe sequences of up to
+  // l * (probing_template_size + 1) probes follow a precomputed template (see
+  // HyperplaneHashBase::probing_template_) instead of the exact scores of
+  // the query.
   HyperplaneHashDense(int dim, int_fast32_t k, int_fast32_t l,
-                      uint_fast64_t seed)
+                      uint_fast64_t seed,
+                      int_fast64_t probing_template_size = 0)
       : HyperplaneHashBase<HyperplaneHashDense<CoordinateType, HashType>,
-                           DerivedVectorT, CoordinateType, HashType>(dim, k, l,
-                                                                     seed) {}
+                           DerivedVectorT, CoordinateType, HashType>(
+            dim, k, l, seed, probing_template_size) {}
 
   void get_multiplied_vector_all_tables(const DerivedVectorT& point,
                                         DerivedVectorT* res) const {
@@ -399,13 +543,19 @@ class HyperplaneHashSparse
   typedef Eigen::Matrix<CoordinateType, Eigen::Dynamic, 1, Eigen::ColMajor>
       DerivedTransformedVectorT;
 
+  // See HyperplaneHashDense for probing_template_size.
   HyperplaneHashSparse(IndexType dim, int_fast32_t k, int_fast32_t l,
-                       uint_fast64_t seed)
+                       uint_fast64_t seed,
+                       int_fast64_t probing_template_size = 0)
       : HyperplaneHashBase<
             HyperplaneHashSparse<CoordinateType, HashType, IndexType>,
-            DerivedVectorT, CoordinateType, HashType>(dim, k, l, seed) {}
+            DerivedVectorT, CoordinateType, HashType>(
+            dim, k, l, seed, probing_template_size) {}
 
-  void get_multiplied_vector_all_tables(const DerivedVectorT& point,
+  // SparseVectorT is DerivedVectorT or a type with the same interface (e.g.,
+  // SparseVectorView for points in a CSRDataStorage).
+  template <typename SparseVectorT>
+  void get_multiplied_vector_all_tables(const SparseVectorT& point,
                                         DerivedTransformedVectorT* res) const {
     // TODO: would row-major be a better storage order for sparse vectors?
     res->setZero();
@@ -414,8 +564,9 @@ class HyperplaneHashSparse
     }
   }
 
+  template <typename SparseVectorT>
   void get_multiplied_vector_single_table(
-      const DerivedVectorT& point, int_fast32_t l,
+      const SparseVectorT& point, int_fast32_t l,
       DerivedTransformedVectorT* res) const {
     res->setZero();
     for (IndexType ii = 0; ii < static_cast<IndexType>(point.size()); ++ii) {
@@ -8,19 +8,26 @@
 namespace falconn {
 namespace core {
 
+// Sorts a range lazily: get(index) sorts only as far as needed (in blocks of
+// doubling size).
 template <typename T>
 class IncrementalSorter {
  public:
   void reset(std::vector<T>* data, int_fast32_t block_size) {
-    data_ = data;
+    reset(data->data(), data->data() + data->size(), block_size);
+  }
+
+  // The range [begin, end) must stay valid until the next call to reset.
+  void reset(T* begin, T* end, int_fast32_t block_size) {
+    begin_ = begin;
+    end_ = end;
     cur_block_size_ = block_size;
-    if (static_cast<size_t>(cur_block_size_) >= data_->size()) {
-      std::sort(data_->begin(), data_->end());
-      sorted_to_ = data_->size();
+    if (cur_block_size_ >= end_ - begin_) {
+      std::sort(begin_, end_);
+      sorted_to_ = end_ - begin_;
     } else {
-      std::nth_element(data_->begin(), data_->begin() + cur_block_size_ - 1,
-                       data_->end());
-      std::sort(data_->begin(), data_->begin() + cur_block_size_);
+      std::nth_element(begin_, begin_ + cur_block_size_ - 1, end_);
+      std::sort(begin_, begin_ + cur_block_size_);
       sorted_to_ = cur_block_size_;
       cur_block_size_ *= 2;
     }
@@ -28,29 +35,30 @@ class IncrementalSorter {
 
   const T& get(int_fast32_t index) {
     if (index < sorted_to_) {
-      return (*data_)[index];
+      return begin_[index];
     } else {
       int_fast32_t next_sorted_to = sorted_to_;
       while (index >= next_sorted_to) {
         next_sorted_to += cur_block_size_;
         cur_block_size_ *= 2;
       }
-      if (next_sorted_to >= static_cast<int_fast32_t>(data_->size()) - 1) {
-        std::sort(data_->begin() + sorted_to_, data_->end());
-        sorted_to_ = data_->size();
+      if (next_sorted_to >= end_ - begin_ - 1) {
+        std::sort(begin_ + sorted_to_, end_);
+        sorted_to_ = end_ - begin_;
       } else {
-        std::nth_element(data_->begin() + sorted_to_,
-                         data_->begin() + next_sorted_to - 1, data_->end());
-        std::sort(data_->begin() + sorted_to_, data_->begin() + next_sorted_to);
+        std::nth_element(begin_ + sorted_to_, begin_ + next_sorted_to - 1,
+                         end_);
+        std::sort(begin_ + sorted_to_, begin_ + next_sorted_to);
         sorted_to_ = next_sorted_to;
       }
       // printf("now sorted to %d\n", sorted_to_);
-      return (*data_)[index];
+      return begin_[index];
     }
   };
 
  private:
-  std::vector<T>* data_;
+  T* begin_;
+  T* end_;
   int_fast32_t cur_block_size_;
   int_fast32_t sorted_to_;
 };
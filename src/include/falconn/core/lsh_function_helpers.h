@@ -93,6 +93,19 @@ class HashObjectQuery {
   void get_probes_by_table(const VectorType& point,
                            std::vector<std::vector<HashType>>* probes,
                            int_fast64_t num_probes) {
+    get_probes_by_table(point, probes, num_probes, num_probes,
+                        [](HashType, int_fast32_t) { return true; });
+  }
+
+  // Only the probes for which is_useful_probe(probe, table) returns true count
+  // toward num_probes (the others are dropped). At most
+  // max_num_generated_probes probes of the probing sequence are considered.
+  template <typename ProbeFilter>
+  void get_probes_by_table(const VectorType& point,
+                           std::vector<std::vector<HashType>>* probes,
+                           int_fast64_t num_probes,
+                           int_fast64_t max_num_generated_probes,
+                           ProbeFilter is_useful_probe) {
     if (num_probes < parent_.l_) {
       throw LSHFunctionError(
           "Number of probes must be at least "
@@ -106,18 +119,73 @@ class HashObjectQuery {
     }
 
     hash_transformation_.apply(point, &transformed_vector_);
-    multiprobe_.setup_probing(transformed_vector_, num_probes);
+    multiprobe_.setup_probing(transformed_vector_, max_num_generated_probes);
 
     int_fast32_t cur_table;
     HashType cur_probe;
 
-    for (int_fast64_t ii = 0; ii < num_probes; ++ii) {
+    int_fast64_t num_useful_probes = 0;
+    for (int_fast64_t ii = 0;
+         ii < max_num_generated_probes && num_useful_probes < num_probes;
+         ++ii) {
       if (!multiprobe_.get_next_probe(&cur_probe, &cur_table)) {
         break;
       }
       // printf("%u %d\n", cur_probe, cur_table);
-      (*probes)[cur_table].push_back(cur_probe);
+      if (is_useful_probe(cur_probe, cur_table)) {
+        (*probes)[cur_table].push_back(cur_probe);
+        num_useful_probes += 1;
+      }
+    }
+  }
+
+  // The first num_probes probes as (probe, table) pairs in the order of the
+  // probing sequence.
+  void get_probes_in_order(
+      const VectorType& point,
+      std::vector<std::pair<HashType, int_fast32_t>>* probes,
+      int_fast64_t num_probes) {
+    get_probes_in_order(point, probes, num_probes, num_probes,
+                        [](HashType, int_fast32_t) { return true; });
+  }
+
+  // As get_probes_by_table with a probe filter.
+  template <typename ProbeFilter>
+  void get_probes_in_order(
+      const VectorType& point,
+      std::vector<std::pair<HashType, int_fast32_t>>* probes,
+      int_fast64_t num_probes, int_fast64_t max_num_generated_probes,
+      ProbeFilter is_useful_probe) {
+    if (num_probes < parent_.l_) {
+      throw LSHFunctionError(
+          "Number of probes must be at least "
+          "the number of tables.");
     }
+    probes->clear();
+
+    hash_transformation_.apply(point, &transformed_vector_);
+    multiprobe_.setup_probing(transformed_vector_, max_num_generated_probes);
+
+    std::pair<HashType, int_fast32_t> cur;
+    for (int_fast64_t ii = 0;
+         ii < max_num_generated_probes &&
+         static_cast<int_fast64_t>(probes->size()) < num_probes;
+         ++ii) {
+      if (!multiprobe_.get_next_probe(&cur.first, &cur.second)) {
+        break;
+      }
+      if (is_useful_probe(cur.first, cur.second)) {
+        probes->push_back(cur);
+      }
+    }
+  }
+
+  // The hash of the point in a single table (without transforming the point
+  // for the other tables). Used when the tables are queried one at a time and
+  // the remaining ones may not be needed.
+  HashType get_single_table_hash(const VectorType& point, int_fast32_t table) {
+    return hash_transformation_.hash_single_table(point, table,
+                                                  &transformed_vector_);
   }
 
  private:
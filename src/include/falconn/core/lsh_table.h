@@ -3,16 +3,19 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <future>
 #include <limits>
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "../falconn_global.h"
 #include "data_storage.h"
+#include "hash_table_helpers.h"
 
 namespace falconn {
 namespace core {
@@ -115,6 +118,55 @@ class StaticLSHTable
                                              (this->lsh_)->get_l() - 1);
   }
 
+  // By default, the queries retrieve all probes of the first table, then all
+  // probes of the second table, etc., so a limited number of candidates
+  // mostly comes from the first tables. If interleave_tables is true, the
+  // buckets of all tables are retrieved in the order of the probing sequence
+  // (i.e., by probe score) instead. max_num_candidates_per_table limits the
+  // number of candidates retrieved from each table (-1 for no limit).
+  void set_retrieval_order(bool interleave_tables,
+                           int_fast64_t max_num_candidates_per_table) {
+    interleave_tables_ = interleave_tables;
+    max_num_candidates_per_table_ = max_num_candidates_per_table;
+  }
+
+  // Makes the queries account for the cost of large buckets. If
+  // bucket_size_penalty is positive, the probed buckets are retrieved in the
+  // order of their position in the retrieval order plus bucket_size_penalty
+  // times their size, so that a large bucket with a good score is retrieved
+  // after several smaller ones with slightly worse scores. If max_bucket_size
+  // is non-negative, at most max_bucket_size entries (spread evenly over the
+  // bucket) are retrieved from each bucket.
+  void set_bucket_size_policy(double bucket_size_penalty,
+                              int_fast64_t max_bucket_size) {
+    if (bucket_size_penalty < 0.0) {
+      throw LSHTableError("The bucket size penalty cannot be negative.");
+    }
+    bucket_size_penalty_ = bucket_size_penalty;
+    max_bucket_size_ = max_bucket_size;
+  }
+
+  // Filters the unique candidates of the queries by the number of tables in
+  // which they collide with the query (i.e., the number of probed buckets
+  // that contain them). Only the candidates with at least min_num_collisions
+  // collisions are kept, and of those only the fraction kept_candidate_fraction
+  // with the most collisions. The default values (1 and 1.0) disable the
+  // filter. The candidates with duplicates are never filtered.
+  void set_collision_filter(int_fast32_t min_num_collisions,
+                            double kept_candidate_fraction) {
+    if (min_num_collisions > this->lsh_->get_l()) {
+      throw LSHTableError(
+          "The minimum number of collisions cannot be larger than the "
+          "number of tables.");
+    }
+    if (!(kept_candidate_fraction > 0.0 && kept_candidate_fraction <= 1.0)) {
+      throw LSHTableError(
+          "The fraction of kept candidates must be in (0, 1].");
+    }
+    min_num_collisions_ = std::max<int_fast32_t>(min_num_collisions, 1);
+    kept_candidate_fraction_ = kept_candidate_fraction;
+  }
+
   // TODO: add query statistics back in
   class Query {
    public:
@@ -134,34 +186,12 @@ class StaticLSHTable
       auto start_time = std::chrono::high_resolution_clock::now();
       stats_.num_queries += 1;
 
-      lsh_query_.get_probes_by_table(p, &tmp_probes_by_table_, num_probes);
-
-      auto lsh_end_time = std::chrono::high_resolution_clock::now();
-      auto elapsed_lsh =
-          std::chrono::duration_cast<std::chrono::duration<double>>(
-              lsh_end_time - start_time);
-      stats_.average_lsh_time += elapsed_lsh.count();
-
-      hash_table_iterators_ =
-          parent_.hash_table_->retrieve_bulk(tmp_probes_by_table_);
-
-      int_fast64_t num_candidates = 0;
       result->clear();
-      if (max_num_candidates < 0) {
-        max_num_candidates = std::numeric_limits<int_fast64_t>::max();
-      }
-      while (num_candidates < max_num_candidates &&
-             hash_table_iterators_.first != hash_table_iterators_.second) {
-        num_candidates += 1;
-        result->push_back(*(hash_table_iterators_.first));
-        ++hash_table_iterators_.first;
-      }
+      int_fast64_t num_candidates = retrieve_candidates(
+          p, num_probes, max_num_candidates, start_time,
+          [result](int_fast64_t cur) { result->push_back(cur); });
 
       auto hashing_end_time = std::chrono::high_resolution_clock::now();
-      auto elapsed_hashing =
-          std::chrono::duration_cast<std::chrono::duration<double>>(
-              hashing_end_time - lsh_end_time);
-      stats_.average_hash_table_time += elapsed_hashing.count();
 
       auto sketches_end_time = std::chrono::high_resolution_clock::now();
       auto elapsed_sketches =
@@ -197,6 +227,90 @@ class StaticLSHTable
       stats_.average_total_query_time += elapsed_total.count();
     }
 
+    // LSH Forest style query for low-level hash tables that support prefix
+    // lookups (see StaticPrefixHashTable), which makes k a query parameter:
+    // retrieves the unique candidates that agree with the query in the first
+    // prefix_length bits of the hash in some table. While there are fewer
+    // than min_num_candidates unique candidates, the prefixes of all tables
+    // are shortened by one bit at a time and the newly covered entries are
+    // retrieved. At most max_num_candidates candidates (with duplicates) are
+    // retrieved if it is non-negative.
+    void get_unique_candidates_by_prefix(const PointType& p,
+                                         int_fast32_t prefix_length,
+                                         int_fast64_t min_num_candidates,
+                                         int_fast64_t max_num_candidates,
+                                         std::vector<KeyType>* result) {
+      if (result == nullptr) {
+        throw LSHTableError("Results vector pointer is nullptr.");
+      }
+      if (prefix_length < 0) {
+        throw LSHTableError("The prefix length cannot be negative.");
+      }
+      if (max_num_candidates < 0) {
+        max_num_candidates = std::numeric_limits<int_fast64_t>::max();
+      }
+
+      auto start_time = std::chrono::high_resolution_clock::now();
+      stats_.num_queries += 1;
+      query_counter_ += 1;
+      result->clear();
+
+      int_fast32_t l = parent_.lsh_->get_l();
+      lsh_query_.get_probes_by_table(p, &tmp_probes_by_table_, l);
+
+      auto lsh_end_time = std::chrono::high_resolution_clock::now();
+      auto elapsed_lsh =
+          std::chrono::duration_cast<std::chrono::duration<double>>(
+              lsh_end_time - start_time);
+      stats_.average_lsh_time += elapsed_lsh.count();
+
+      int_fast64_t num_candidates = 0;
+      auto add_range = [&](typename BucketRange::first_type first,
+                           typename BucketRange::first_type last) {
+        for (; first != last && num_candidates < max_num_candidates;
+             ++first) {
+          num_candidates += 1;
+          KeyType cur = *first;
+          if (is_candidate_[cur] != query_counter_) {
+            is_candidate_[cur] = query_counter_;
+            result->push_back(cur);
+          }
+        }
+      };
+
+      prefix_ranges_.resize(l);
+      for (int_fast32_t table = 0; table < l; ++table) {
+        prefix_ranges_[table] = parent_.hash_table_->retrieve_prefix_individual(
+            tmp_probes_by_table_[table][0], prefix_length, table);
+        add_range(prefix_ranges_[table].first, prefix_ranges_[table].second);
+      }
+      // The range of a prefix contains the range of its extensions, so the
+      // new entries are on both sides of the previous range.
+      while (static_cast<int_fast64_t>(result->size()) < min_num_candidates &&
+             prefix_length > 0 && num_candidates < max_num_candidates) {
+        prefix_length -= 1;
+        for (int_fast32_t table = 0; table < l; ++table) {
+          BucketRange range = parent_.hash_table_->retrieve_prefix_individual(
+              tmp_probes_by_table_[table][0], prefix_length, table);
+          add_range(range.first, prefix_ranges_[table].first);
+          add_range(prefix_ranges_[table].second, range.second);
+          prefix_ranges_[table] = range;
+        }
+      }
+
+      auto end_time = std::chrono::high_resolution_clock::now();
+      auto elapsed_hashing =
+          std::chrono::duration_cast<std::chrono::duration<double>>(
+              end_time - lsh_end_time);
+      stats_.average_hash_table_time += elapsed_hashing.count();
+      stats_.average_num_candidates += num_candidates;
+      stats_.average_num_unique_candidates += result->size();
+      auto elapsed_total =
+          std::chrono::duration_cast<std::chrono::duration<double>>(end_time -
+                                                                    start_time);
+      stats_.average_total_query_time += elapsed_total.count();
+    }
+
     void reset_query_statistics() { stats_.reset(); }
 
     QueryStatistics get_query_statistics() {
@@ -214,18 +328,85 @@ class StaticLSHTable
     std::vector<int32_t> is_candidate_;
     typename LSH::Query lsh_query_;
     std::vector<std::vector<HashType>> tmp_probes_by_table_;
+    std::vector<std::pair<HashType, int_fast32_t>> tmp_probes_;
+    std::vector<int_fast64_t> num_candidates_by_table_;
     std::pair<typename HashTable::Iterator, typename HashTable::Iterator>
         hash_table_iterators_;
+    typedef decltype(std::declval<const HashTable&>().retrieve_individual(
+        std::declval<HashType>(), 0)) BucketRange;
+    struct ScheduledBucket {
+      double priority;
+      int_fast32_t table;
+      BucketRange iters;
+    };
+    std::vector<ScheduledBucket> scheduled_buckets_;
+    std::vector<BucketRange> prefix_ranges_;
+    std::vector<int_fast64_t> num_candidates_by_count_;
 
     QueryStatistics stats_;
 
-    void get_unique_candidates_internal(const PointType& p,
-                                        int_fast64_t num_probes,
-                                        int_fast64_t max_num_candidates,
-                                        std::vector<KeyType>* result) {
-      auto start_time = std::chrono::high_resolution_clock::now();
+    static const int_fast64_t kMaxProbeFactor = 16;
+
+    // Calls add_candidate for the candidates of the probing sequence (at most
+    // max_num_candidates if it is non-negative) and returns their number. The
+    // time spent hashing and in the hash table is added to stats_.
+    template <typename AddCandidate>
+    int_fast64_t retrieve_candidates(
+        const PointType& p, int_fast64_t num_probes,
+        int_fast64_t max_num_candidates,
+        std::chrono::high_resolution_clock::time_point start_time,
+        AddCandidate add_candidate) {
+      if (max_num_candidates < 0) {
+        max_num_candidates = std::numeric_limits<int_fast64_t>::max();
+      }
+      int_fast64_t max_per_table = parent_.max_num_candidates_per_table_;
+      if (max_per_table < 0) {
+        max_per_table = std::numeric_limits<int_fast64_t>::max();
+      }
+      bool limited = max_num_candidates <
+                         std::numeric_limits<int_fast64_t>::max() ||
+                     max_per_table < std::numeric_limits<int_fast64_t>::max();
+
+      // Without multiprobing (one probe per table), the probe of a table is
+      // just its hash. If the number of candidates is also limited, the
+      // tables are then hashed one at a time, so the tables after the one
+      // that fills the candidate budget are never hashed. The order of the
+      // probes is the same for both retrieval orders.
+      //
+      // With occupancy filters, the probes of empty buckets are skipped and do
+      // not count toward num_probes, so the probes then come from the full
+      // probing sequence (at most kMaxProbeFactor * num_probes of its
+      // probes are generated). A bucket size penalty needs the buckets of all
+      // tables before the first one is retrieved, so it also disables the
+      // lazy hashing.
+      const HashTable& hash_table = *(parent_.hash_table_);
+      bool skip_empty = hash_table.has_occupancy_filters();
+      if (limited && !skip_empty && parent_.bucket_size_penalty_ == 0.0 &&
+          num_probes == parent_.lsh_->get_l()) {
+        return get_candidates_lazily(p, max_num_candidates, max_per_table,
+                                     start_time, add_candidate);
+      }
 
-      lsh_query_.get_probes_by_table(p, &tmp_probes_by_table_, num_probes);
+      int_fast64_t num_candidates = 0;
+      if (skip_empty) {
+        auto is_occupied = [&hash_table](HashType probe, int_fast32_t table) {
+          return hash_table.may_contain(probe, table);
+        };
+        int_fast64_t max_num_generated_probes = kMaxProbeFactor * num_probes;
+        if (parent_.interleave_tables_) {
+          lsh_query_.get_probes_in_order(p, &tmp_probes_, num_probes,
+                                         max_num_generated_probes,
+                                         is_occupied);
+        } else {
+          lsh_query_.get_probes_by_table(p, &tmp_probes_by_table_, num_probes,
+                                         max_num_generated_probes,
+                                         is_occupied);
+        }
+      } else if (parent_.interleave_tables_) {
+        lsh_query_.get_probes_in_order(p, &tmp_probes_, num_probes);
+      } else {
+        lsh_query_.get_probes_by_table(p, &tmp_probes_by_table_, num_probes);
+      }
 
       auto lsh_end_time = std::chrono::high_resolution_clock::now();
       auto elapsed_lsh =
@@ -233,32 +414,242 @@ class StaticLSHTable
               lsh_end_time - start_time);
       stats_.average_lsh_time += elapsed_lsh.count();
 
-      hash_table_iterators_ =
-          parent_.hash_table_->retrieve_bulk(tmp_probes_by_table_);
-      query_counter_ += 1;
+      if (!parent_.interleave_tables_ &&
+          max_per_table == std::numeric_limits<int_fast64_t>::max() &&
+          parent_.bucket_size_penalty_ == 0.0 &&
+          parent_.max_bucket_size_ < 0) {
+        hash_table_iterators_ =
+            parent_.hash_table_->retrieve_bulk(tmp_probes_by_table_);
+
+        while (num_candidates < max_num_candidates &&
+               hash_table_iterators_.first != hash_table_iterators_.second) {
+          num_candidates += 1;
+          add_candidate(*(hash_table_iterators_.first));
+          ++hash_table_iterators_.first;
+        }
+      } else {
+        if (!parent_.interleave_tables_) {
+          tmp_probes_.clear();
+          for (size_t table = 0; table < tmp_probes_by_table_.size();
+               ++table) {
+            for (HashType probe : tmp_probes_by_table_[table]) {
+              tmp_probes_.push_back(std::make_pair(probe, table));
+            }
+          }
+        }
+        // Each bucket is retrieved individually in the order of tmp_probes_
+        // (or in the order of the penalized bucket sizes), skipping the tables
+        // that reached their limit.
+        num_candidates_by_table_.assign(parent_.lsh_->get_l(), 0);
+        if (parent_.bucket_size_penalty_ > 0.0) {
+          scheduled_buckets_.clear();
+          for (size_t ii = 0; ii < tmp_probes_.size(); ++ii) {
+            int_fast32_t table = tmp_probes_[ii].second;
+            auto iters = parent_.hash_table_->retrieve_individual(
+                tmp_probes_[ii].first, table);
+            int_fast64_t size =
+                hash_table_helpers::bucket_size(iters.first, iters.second);
+            if (size > 0) {
+              scheduled_buckets_.push_back(
+                  {ii + parent_.bucket_size_penalty_ * size, table, iters});
+            }
+          }
+          std::stable_sort(
+              scheduled_buckets_.begin(), scheduled_buckets_.end(),
+              [](const ScheduledBucket& a, const ScheduledBucket& b) {
+                return a.priority < b.priority;
+              });
+          for (size_t ii = 0; ii < scheduled_buckets_.size() &&
+                              num_candidates < max_num_candidates;
+               ++ii) {
+            const ScheduledBucket& bucket = scheduled_buckets_[ii];
+            retrieve_bucket(bucket.iters, max_num_candidates, max_per_table,
+                            &num_candidates,
+                            &num_candidates_by_table_[bucket.table],
+                            add_candidate);
+          }
+        } else {
+          for (size_t ii = 0;
+               ii < tmp_probes_.size() && num_candidates < max_num_candidates;
+               ++ii) {
+            int_fast32_t table = tmp_probes_[ii].second;
+            auto iters = parent_.hash_table_->retrieve_individual(
+                tmp_probes_[ii].first, table);
+            retrieve_bucket(iters, max_num_candidates, max_per_table,
+                            &num_candidates, &num_candidates_by_table_[table],
+                            add_candidate);
+          }
+        }
+      }
 
+      auto elapsed_hashing =
+          std::chrono::duration_cast<std::chrono::duration<double>>(
+              std::chrono::high_resolution_clock::now() - lsh_end_time);
+      stats_.average_hash_table_time += elapsed_hashing.count();
+      return num_candidates;
+    }
+
+    // The candidates of the first tables without hashing the point for the
+    // remaining ones (see retrieve_candidates).
+    template <typename AddCandidate>
+    int_fast64_t get_candidates_lazily(
+        const PointType& p, int_fast64_t max_num_candidates,
+        int_fast64_t max_per_table,
+        std::chrono::high_resolution_clock::time_point start_time,
+        AddCandidate add_candidate) {
       int_fast64_t num_candidates = 0;
-      result->clear();
-      if (max_num_candidates < 0) {
-        max_num_candidates = std::numeric_limits<int_fast64_t>::max();
+      double lsh_time = 0.0;
+      double hash_table_time = 0.0;
+      auto cur_time = start_time;
+      int_fast32_t l = parent_.lsh_->get_l();
+      for (int_fast32_t table = 0;
+           table < l && num_candidates < max_num_candidates; ++table) {
+        HashType probe = lsh_query_.get_single_table_hash(p, table);
+        auto lsh_end_time = std::chrono::high_resolution_clock::now();
+        lsh_time += std::chrono::duration_cast<std::chrono::duration<double>>(
+                        lsh_end_time - cur_time)
+                        .count();
+
+        auto iters = parent_.hash_table_->retrieve_individual(probe, table);
+        int_fast64_t table_candidates = 0;
+        retrieve_bucket(iters, max_num_candidates, max_per_table,
+                        &num_candidates, &table_candidates, add_candidate);
+        cur_time = std::chrono::high_resolution_clock::now();
+        hash_table_time +=
+            std::chrono::duration_cast<std::chrono::duration<double>>(
+                cur_time - lsh_end_time)
+                .count();
+      }
+      stats_.average_lsh_time += lsh_time;
+      stats_.average_hash_table_time += hash_table_time;
+      return num_candidates;
+    }
+
+    // Adds the candidates of one bucket up to the limits, subsampling the
+    // bucket if it has more than max_bucket_size_ entries.
+    template <typename AddCandidate>
+    void retrieve_bucket(const BucketRange& iters,
+                         int_fast64_t max_num_candidates,
+                         int_fast64_t max_per_table,
+                         int_fast64_t* num_candidates,
+                         int_fast64_t* table_candidates,
+                         AddCandidate& add_candidate) {
+      if (*table_candidates >= max_per_table) {
+        return;
+      }
+      auto process_entry = [&](KeyType cur) {
+        if (*num_candidates >= max_num_candidates ||
+            *table_candidates >= max_per_table) {
+          return false;
+        }
+        *num_candidates += 1;
+        *table_candidates += 1;
+        add_candidate(cur);
+        return true;
+      };
+      int_fast64_t max_bucket_size = parent_.max_bucket_size_;
+      if (max_bucket_size < 0) {
+        max_bucket_size = std::numeric_limits<int_fast64_t>::max();
+      }
+      hash_table_helpers::sample_bucket(iters.first, iters.second,
+                                        max_bucket_size, process_entry);
+    }
+
+    // The unique candidates that pass the collision filter (see
+    // set_collision_filter). is_candidate_ doubles as the collision counter:
+    // the query reserves the values base, ..., base + l - 1 and a candidate
+    // with value base + c - 1 was retrieved c times (a point is in at most
+    // one probed bucket per table, so c <= l).
+    int_fast64_t get_frequent_candidates(
+        const PointType& p, int_fast64_t num_probes,
+        int_fast64_t max_num_candidates,
+        std::chrono::high_resolution_clock::time_point start_time,
+        std::vector<KeyType>* result) {
+      int32_t l = parent_.lsh_->get_l();
+      if (query_counter_ >= std::numeric_limits<int32_t>::max() - l - 1) {
+        std::fill(is_candidate_.begin(), is_candidate_.end(), 0);
+        query_counter_ = 0;
+      }
+      int32_t base = query_counter_ + 1;
+      query_counter_ += l;
+
+      int_fast64_t num_candidates = retrieve_candidates(
+          p, num_probes, max_num_candidates, start_time,
+          [this, result, base, l](int_fast64_t cur) {
+            int32_t& value = is_candidate_[cur];
+            if (value < base) {
+              value = base;
+              result->push_back(cur);
+            } else if (value < base + l - 1) {
+              value += 1;
+            }
+          });
+
+      // The number of kept candidates with the largest collision counts
+      // (ties are broken by the retrieval order).
+      num_candidates_by_count_.assign(l + 1, 0);
+      int_fast64_t num_frequent = 0;
+      for (KeyType cur : *result) {
+        int32_t count = is_candidate_[cur] - base + 1;
+        if (count >= parent_.min_num_collisions_) {
+          num_candidates_by_count_[count] += 1;
+          num_frequent += 1;
+        }
+      }
+      int_fast64_t num_kept = static_cast<int_fast64_t>(
+          std::ceil(parent_.kept_candidate_fraction_ * num_frequent));
+      int32_t min_count = l;
+      int_fast64_t num_above = 0;
+      while (min_count > 1 &&
+             num_above + num_candidates_by_count_[min_count] < num_kept) {
+        num_above += num_candidates_by_count_[min_count];
+        min_count -= 1;
       }
-      while (num_candidates < max_num_candidates &&
-             hash_table_iterators_.first != hash_table_iterators_.second) {
-        num_candidates += 1;
-        int_fast64_t cur = *(hash_table_iterators_.first);
-        if (is_candidate_[cur] != query_counter_) {
-          is_candidate_[cur] = query_counter_;
-          result->push_back(cur);
+      min_count = std::max<int32_t>(min_count, parent_.min_num_collisions_);
+      int_fast64_t num_at_min_count = num_kept - num_above;
+
+      size_t num_result = 0;
+      for (KeyType cur : *result) {
+        int32_t count = is_candidate_[cur] - base + 1;
+        if (count > min_count ||
+            (count == min_count && num_at_min_count > 0)) {
+          if (count == min_count) {
+            num_at_min_count -= 1;
+          }
+          (*result)[num_result] = cur;
+          num_result += 1;
         }
+      }
+      result->resize(num_result);
+      return num_candidates;
+    }
+
+    void get_unique_candidates_internal(const PointType& p,
+                                        int_fast64_t num_probes,
+                                        int_fast64_t max_num_candidates,
+                                        std::vector<KeyType>* result) {
+      auto start_time = std::chrono::high_resolution_clock::now();
 
-        ++hash_table_iterators_.first;
+      result->clear();
+      int_fast64_t num_candidates;
+      if (parent_.min_num_collisions_ <= 1 &&
+          parent_.kept_candidate_fraction_ >= 1.0) {
+        query_counter_ += 1;
+        num_candidates = retrieve_candidates(
+            p, num_probes, max_num_candidates, start_time,
+            [this, result](int_fast64_t cur) {
+              if (is_candidate_[cur] != query_counter_) {
+                is_candidate_[cur] = query_counter_;
+                result->push_back(cur);
+              }
+            });
+      } else {
+        num_candidates = get_frequent_candidates(p, num_probes,
+                                                 max_num_candidates,
+                                                 start_time, result);
       }
 
       auto hashing_end_time = std::chrono::high_resolution_clock::now();
-      auto elapsed_hashing =
-          std::chrono::duration_cast<std::chrono::duration<double>>(
-              hashing_end_time - lsh_end_time);
-      stats_.average_hash_table_time += elapsed_hashing.count();
 
       auto sketches_end_time = std::chrono::high_resolution_clock::now();
       auto elapsed_sketches =
@@ -274,6 +665,12 @@ class StaticLSHTable
  private:
   int_fast64_t n_;
   const DataStorageType& points_;
+  bool interleave_tables_ = false;
+  int_fast64_t max_num_candidates_per_table_ = -1;
+  double bucket_size_penalty_ = 0.0;
+  int_fast64_t max_bucket_size_ = -1;
+  int32_t min_num_collisions_ = 1;
+  double kept_candidate_fraction_ = 1.0;
 
   void setup_table_range(int_fast32_t from, int_fast32_t to,
                          const DataStorageType& points) {
@@ -21,15 +21,34 @@ class NearestNeighborQueryError : public FalconnError {
   NearestNeighborQueryError(const char* msg) : FalconnError(msg) {}
 };
 
+namespace nn_query_helpers {
+
+// Distance functions can provide load_query(q) to precompute per-query state
+// before the candidates are scored (e.g., CosineDistanceSparseScatter). For
+// the other distance functions this is a no-op.
+template <typename DistanceFunction, typename PointType>
+auto load_query(DistanceFunction* dst, const PointType& q, int)
+    -> decltype(dst->load_query(q), void()) {
+  dst->load_query(q);
+}
+
+template <typename DistanceFunction, typename PointType>
+void load_query(DistanceFunction*, const PointType&, long) {}
+
+}  // namespace nn_query_helpers
+
 template <typename LSHTableQuery, typename LSHTablePointType,
           typename LSHTableKeyType, typename ComparisonPointType,
           typename DistanceType, typename DistanceFunction,
           typename DataStorage>
 class NearestNeighborQuery {
  public:
+  // dst is copied into the query (e.g., a dense distance with kernels for a
+  // fixed dimension).
   NearestNeighborQuery(LSHTableQuery* table_query,
-                       const DataStorage& data_storage)
-      : table_query_(table_query), data_storage_(data_storage) {}
+                       const DataStorage& data_storage,
+                       const DistanceFunction& dst = DistanceFunction())
+      : table_query_(table_query), data_storage_(data_storage), dst_(dst) {}
 
   LSHTableKeyType find_nearest_neighbor(const LSHTablePointType& q,
                                         const ComparisonPointType& q_comp,
@@ -40,6 +59,7 @@ class NearestNeighborQuery {
     table_query_->get_unique_candidates(q, num_probes, max_num_candidates,
                                         &candidates_);
     auto distance_start_time = std::chrono::high_resolution_clock::now();
+    nn_query_helpers::load_query(&dst_, q_comp, 0);
 
     // TODO: use nullptr for pointer types
     LSHTableKeyType best_key = -1;
@@ -100,6 +120,7 @@ class NearestNeighborQuery {
     heap_.resize(k);
 
     auto distance_start_time = std::chrono::high_resolution_clock::now();
+    nn_query_helpers::load_query(&dst_, q_comp, 0);
 
     typename DataStorage::SubsequenceIterator iter =
         data_storage_.get_subsequence(candidates_);
@@ -160,6 +181,7 @@ class NearestNeighborQuery {
     table_query_->get_unique_candidates(q, num_probes, max_num_candidates,
                                         &candidates_);
     auto distance_start_time = std::chrono::high_resolution_clock::now();
+    nn_query_helpers::load_query(&dst_, q_comp, 0);
 
     typename DataStorage::SubsequenceIterator iter =
         data_storage_.get_subsequence(candidates_);
@@ -241,6 +263,262 @@ class NearestNeighborQuery {
   QueryStatistics stats_;
 };
 
+// Ranks the candidates with a scorer instead of a distance function on a data
+// storage. The scorer (e.g., PQDistanceScorer) provides
+//   load_query(q_comp)
+//   score_batch(keys, &scores)
+// and scores all candidates of a query in one call, which allows it to use
+// batched SIMD kernels. Smaller scores are better. This is meant as a
+// pre-ranking stage: wrap it in a RerankingNearestNeighborQuery to compute
+// exact distances for the best candidates.
+template <typename LSHTableQuery, typename LSHTablePointType,
+          typename LSHTableKeyType, typename ComparisonPointType,
+          typename Scorer>
+class ScorerNearestNeighborQuery {
+ public:
+  typedef typename Scorer::ScoreType ScoreType;
+
+  ScorerNearestNeighborQuery(LSHTableQuery* table_query, Scorer* scorer)
+      : table_query_(table_query), scorer_(scorer) {}
+
+  LSHTableKeyType find_nearest_neighbor(const LSHTablePointType& q,
+                                        const ComparisonPointType& q_comp,
+                                        int_fast64_t num_probes,
+                                        int_fast64_t max_num_candidates) {
+    find_k_nearest_neighbors(q, q_comp, 1, num_probes, max_num_candidates,
+                             &result_);
+    if (result_.empty()) {
+      return -1;
+    }
+    return result_[0];
+  }
+
+  void find_k_nearest_neighbors(const LSHTablePointType& q,
+                                const ComparisonPointType& q_comp,
+                                int_fast64_t k, int_fast64_t num_probes,
+                                int_fast64_t max_num_candidates,
+                                std::vector<LSHTableKeyType>* result) {
+    if (result == nullptr) {
+      throw NearestNeighborQueryError("Results vector pointer is nullptr.");
+    }
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    table_query_->get_unique_candidates(q, num_probes, max_num_candidates,
+                                        &candidates_);
+
+    auto distance_start_time = std::chrono::high_resolution_clock::now();
+
+    scorer_->load_query(q_comp);
+    scorer_->score_batch(candidates_, &scores_);
+
+    scored_candidates_.resize(candidates_.size());
+    for (size_t ii = 0; ii < candidates_.size(); ++ii) {
+      scored_candidates_[ii] = std::make_pair(scores_[ii], candidates_[ii]);
+    }
+    int_fast64_t num_results =
+        std::min(k, static_cast<int_fast64_t>(scored_candidates_.size()));
+    std::partial_sort(scored_candidates_.begin(),
+                      scored_candidates_.begin() + num_results,
+                      scored_candidates_.end());
+    result->resize(num_results);
+    for (int_fast64_t ii = 0; ii < num_results; ++ii) {
+      (*result)[ii] = scored_candidates_[ii].second;
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto elapsed_distance =
+        std::chrono::duration_cast<std::chrono::duration<double>>(
+            end_time - distance_start_time);
+    auto elapsed_total =
+        std::chrono::duration_cast<std::chrono::duration<double>>(end_time -
+                                                                  start_time);
+    stats_.average_distance_time += elapsed_distance.count();
+    stats_.average_total_query_time += elapsed_total.count();
+  }
+
+  void get_candidates_with_duplicates(const LSHTablePointType& q,
+                                      int_fast64_t num_probes,
+                                      int_fast64_t max_num_candidates,
+                                      std::vector<LSHTableKeyType>* result) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    table_query_->get_candidates_with_duplicates(q, num_probes,
+                                                 max_num_candidates, result);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto elapsed_total =
+        std::chrono::duration_cast<std::chrono::duration<double>>(end_time -
+                                                                  start_time);
+    stats_.average_total_query_time += elapsed_total.count();
+  }
+
+  void get_unique_candidates(const LSHTablePointType& q,
+                             int_fast64_t num_probes,
+                             int_fast64_t max_num_candidates,
+                             std::vector<LSHTableKeyType>* result) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    table_query_->get_unique_candidates(q, num_probes, max_num_candidates,
+                                        result);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto elapsed_total =
+        std::chrono::duration_cast<std::chrono::duration<double>>(end_time -
+                                                                  start_time);
+    stats_.average_total_query_time += elapsed_total.count();
+  }
+
+  void reset_query_statistics() {
+    table_query_->reset_query_statistics();
+    stats_.reset();
+  }
+
+  QueryStatistics get_query_statistics() {
+    QueryStatistics res = table_query_->get_query_statistics();
+    res.average_total_query_time = stats_.average_total_query_time;
+    res.average_distance_time = stats_.average_distance_time;
+
+    if (res.num_queries > 0) {
+      res.average_total_query_time /= res.num_queries;
+      res.average_distance_time /= res.num_queries;
+    }
+    return res;
+  }
+
+ private:
+  LSHTableQuery* table_query_;
+  Scorer* scorer_;
+  std::vector<LSHTableKeyType> candidates_;
+  std::vector<LSHTableKeyType> result_;
+  std::vector<ScoreType> scores_;
+  std::vector<std::pair<ScoreType, LSHTableKeyType>> scored_candidates_;
+
+  QueryStatistics stats_;
+};
+
+// Two-stage query: the inner query (typically a NearestNeighborQuery running on
+// a compressed data storage such as Int8QuantizedDataStorage, or a
+// ScorerNearestNeighborQuery with a PQDistanceScorer) selects the
+// num_reranked best candidates with its approximate distance function. These
+// candidates are then re-ranked with the exact distance function on the
+// full-precision data storage.
+template <typename InnerNNQuery, typename LSHTablePointType,
+          typename LSHTableKeyType, typename ComparisonPointType,
+          typename DistanceType, typename DistanceFunction,
+          typename DataStorage>
+class RerankingNearestNeighborQuery {
+ public:
+  RerankingNearestNeighborQuery(InnerNNQuery* inner_query,
+                                const DataStorage& data_storage,
+                                int_fast64_t num_reranked)
+      : inner_query_(inner_query),
+        data_storage_(data_storage),
+        num_reranked_(num_reranked) {
+    if (num_reranked_ < 1) {
+      throw NearestNeighborQueryError(
+          "Number of re-ranked candidates must be at least 1.");
+    }
+  }
+
+  LSHTableKeyType find_nearest_neighbor(const LSHTablePointType& q,
+                                        const ComparisonPointType& q_comp,
+                                        int_fast64_t num_probes,
+                                        int_fast64_t max_num_candidates) {
+    find_k_nearest_neighbors(q, q_comp, 1, num_probes, max_num_candidates,
+                             &result_);
+    if (result_.empty()) {
+      return -1;
+    }
+    return result_[0];
+  }
+
+  void find_k_nearest_neighbors(const LSHTablePointType& q,
+                                const ComparisonPointType& q_comp,
+                                int_fast64_t k, int_fast64_t num_probes,
+                                int_fast64_t max_num_candidates,
+                                std::vector<LSHTableKeyType>* result) {
+    if (result == nullptr) {
+      throw NearestNeighborQueryError("Results vector pointer is nullptr.");
+    }
+
+    inner_query_->find_k_nearest_neighbors(q, q_comp,
+                                           std::max(k, num_reranked_),
+                                           num_probes, max_num_candidates,
+                                           &candidates_);
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+    nn_query_helpers::load_query(&dst_, q_comp, 0);
+
+    scored_candidates_.clear();
+    typename DataStorage::SubsequenceIterator iter =
+        data_storage_.get_subsequence(candidates_);
+    while (iter.is_valid()) {
+      scored_candidates_.push_back(
+          std::make_pair(dst_(q_comp, iter.get_point()), iter.get_key()));
+      ++iter;
+    }
+
+    int_fast64_t num_results =
+        std::min(k, static_cast<int_fast64_t>(scored_candidates_.size()));
+    std::partial_sort(scored_candidates_.begin(),
+                      scored_candidates_.begin() + num_results,
+                      scored_candidates_.end());
+    result->resize(num_results);
+    for (int_fast64_t ii = 0; ii < num_results; ++ii) {
+      (*result)[ii] = scored_candidates_[ii].second;
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto elapsed_rerank =
+        std::chrono::duration_cast<std::chrono::duration<double>>(end_time -
+                                                                  start_time);
+    rerank_time_ += elapsed_rerank.count();
+  }
+
+  void get_candidates_with_duplicates(const LSHTablePointType& q,
+                                      int_fast64_t num_probes,
+                                      int_fast64_t max_num_candidates,
+                                      std::vector<LSHTableKeyType>* result) {
+    inner_query_->get_candidates_with_duplicates(q, num_probes,
+                                                 max_num_candidates, result);
+  }
+
+  void get_unique_candidates(const LSHTablePointType& q,
+                             int_fast64_t num_probes,
+                             int_fast64_t max_num_candidates,
+                             std::vector<LSHTableKeyType>* result) {
+    inner_query_->get_unique_candidates(q, num_probes, max_num_candidates,
+                                        result);
+  }
+
+  void reset_query_statistics() {
+    inner_query_->reset_query_statistics();
+    rerank_time_ = 0.0;
+  }
+
+  // The re-ranking time is counted as part of the distance time and the total
+  // query time.
+  QueryStatistics get_query_statistics() {
+    QueryStatistics res = inner_query_->get_query_statistics();
+    if (res.num_queries > 0) {
+      res.average_distance_time += rerank_time_ / res.num_queries;
+      res.average_total_query_time += rerank_time_ / res.num_queries;
+    }
+    return res;
+  }
+
+ private:
+  InnerNNQuery* inner_query_;
+  const DataStorage& data_storage_;
+  int_fast64_t num_reranked_;
+  std::vector<LSHTableKeyType> candidates_;
+  std::vector<LSHTableKeyType> result_;
+  std::vector<std::pair<DistanceType, LSHTableKeyType>> scored_candidates_;
+  DistanceFunction dst_;
+  double rerank_time_ = 0.0;
+};
+
 }  // namespace core
 }  // namespace falconn
 
@@ -0,0 +1,117 @@
+#ifndef __OCCUPANCY_FILTER_H__
+#define __OCCUPANCY_FILTER_H__
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "hash_table_helpers.h"
+
+namespace falconn {
+namespace core {
+
+// Answers "does the table contain this key?" for the keys of a static hash
+// table without touching the table itself. The answer "no" is always correct,
+// the answer "yes" may be wrong for keys that are not in the table.
+//
+// If the keys are small enough (at most kMaxBitmapBitsPerKey times the number
+// of keys, e.g., the buckets of a flat hash table with not too many bits), the
+// filter is an exact bitmap of the occupied keys. Otherwise, it is a blocked
+// Bloom filter: each key sets kNumBloomBits bits within one 512-bit block, so
+// a lookup reads one or two cache lines. With kBloomBitsPerKey bits per key,
+// the false positive rate is about 0.1%.
+template <typename KeyType>
+class OccupancyFilter {
+ public:
+  static const uint64_t kMaxBitmapBitsPerKey = 64;
+  static const uint64_t kBloomBitsPerKey = 16;
+  static const int_fast32_t kNumBloomBits = 6;
+
+  // The keys of the table (with repetitions).
+  void build(const std::vector<KeyType>& keys) {
+    bits_.clear();
+    max_key_ = 0;
+    for (const KeyType& key : keys) {
+      max_key_ = std::max(max_key_, key);
+    }
+    uint64_t num_keys = keys.size();
+    uint64_t max_key = static_cast<uint64_t>(max_key_);
+    exact_ = num_keys == 0 || (static_cast<KeyType>(max_key) == max_key_ &&
+                               max_key / kMaxBitmapBitsPerKey < num_keys);
+
+    if (exact_) {
+      if (num_keys > 0) {
+        bits_.resize(max_key / 64 + 1, 0);
+      }
+      for (const KeyType& key : keys) {
+        uint64_t k = static_cast<uint64_t>(key);
+        bits_[k / 64] |= uint64_t(1) << (k % 64);
+      }
+    } else {
+      num_blocks_ = (num_keys * kBloomBitsPerKey + kBitsPerBlock - 1) /
+                    kBitsPerBlock;
+      bits_.resize(num_blocks_ * kWordsPerBlock, 0);
+      for (const KeyType& key : keys) {
+        uint64_t h = mix(hash_table_helpers::fold_key(key));
+        uint64_t* block = &bits_[block_index(h) * kWordsPerBlock];
+        uint64_t g = mix(h);
+        for (int_fast32_t ii = 0; ii < kNumBloomBits; ++ii) {
+          uint64_t bit = (g >> (9 * ii)) % kBitsPerBlock;
+          block[bit / 64] |= uint64_t(1) << (bit % 64);
+        }
+      }
+    }
+  }
+
+  bool may_contain(const KeyType& key) const {
+    if (exact_) {
+      uint64_t k = static_cast<uint64_t>(key);
+      return key <= max_key_ && !bits_.empty() &&
+             ((bits_[k / 64] >> (k % 64)) & 1);
+    }
+    uint64_t h = mix(hash_table_helpers::fold_key(key));
+    const uint64_t* block = &bits_[block_index(h) * kWordsPerBlock];
+    uint64_t g = mix(h);
+    for (int_fast32_t ii = 0; ii < kNumBloomBits; ++ii) {
+      uint64_t bit = (g >> (9 * ii)) % kBitsPerBlock;
+      if (!((block[bit / 64] >> (bit % 64)) & 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool is_exact() const { return exact_; }
+
+  // Size of the filter in bytes.
+  size_t memory_usage() const { return bits_.size() * sizeof(uint64_t); }
+
+ private:
+  static const uint64_t kBitsPerBlock = 512;
+  static const uint64_t kWordsPerBlock = kBitsPerBlock / 64;
+
+  bool exact_ = true;
+  KeyType max_key_ = 0;
+  uint64_t num_blocks_ = 0;
+  std::vector<uint64_t> bits_;
+
+  // One step of SplitMix64.
+  static uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+  }
+
+  uint64_t block_index(uint64_t h) const {
+    return ((h >> 32) * num_blocks_) >> 32;
+  }
+};
+
+}  // namespace core
+}  // namespace falconn
+
+#endif
@@ -12,7 +12,12 @@
 
 #include <Eigen/Dense>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 #include "../ffht/fht_header_only.h"
+#include "cpu_dispatch.h"
 #include "data_storage.h"
 #include "heap.h"
 #include "incremental_sorter.h"
@@ -46,6 +51,12 @@ static inline int_fast32_t compute_number_of_hash_bits(
   return (k - 1) * (log_rotation_dim + 1) + last_cp_log_dim + 1;
 }
 
+// FHTFunction<ScalarType>::kernel() is the FFHT kernel for the best
+// instruction set the CPU supports (AVX-512, AVX, SSE4.1 or the generic one).
+// It is resolved once, so callers that keep the pointer (such as FHTHelper)
+// skip the dispatch in fht_float / fht_double on every transform.
+// fixed_kernel(log_dim) is the kernel for one length only (nullptr if there is
+// none), which also skips the dispatch on log_dim.
 template <typename ScalarType>
 struct FHTFunction {
   static void apply(ScalarType*, int_fast32_t) {
@@ -57,58 +68,143 @@ struct FHTFunction {
 
 template <>
 struct FHTFunction<float> {
-  static void apply(float* data, int_fast32_t dim) {
-    int_fast32_t log_dim = 0;
-    while (((int_fast32_t)1 << log_dim) < dim) {
-      ++log_dim;
-    }
-    if (fht_float(data, log_dim) != 0) {
+  typedef fht_float_function Kernel;
+  typedef fht_float_fixed_function FixedKernel;
+
+  static Kernel kernel() {
+    static const Kernel best_kernel = fht_float_kernel(fht_best_isa());
+    return best_kernel;
+  }
+
+  static FixedKernel fixed_kernel(int_fast32_t log_dim) {
+    return fht_float_fixed_kernel(fht_best_isa(), log_dim);
+  }
+
+  static void apply(Kernel kernel, float* data, int_fast32_t log_dim) {
+    if (kernel(data, log_dim) != 0) {
       throw LSHFunctionError("fht_float returned nonzero value.");
     }
   }
+
+  static void apply(float* data, int_fast32_t dim) {
+    apply(kernel(), data, log2ceil(dim));
+  }
 };
 
 template <>
 struct FHTFunction<double> {
-  static void apply(double* data, int_fast32_t dim) {
-    int_fast32_t log_dim = 0;
-    while (((int_fast32_t)1 << log_dim) < dim) {
-      ++log_dim;
-    }
-    if (fht_double(data, log_dim) != 0) {
+  typedef fht_double_function Kernel;
+  typedef fht_double_fixed_function FixedKernel;
+
+  static Kernel kernel() {
+    static const Kernel best_kernel = fht_double_kernel(fht_best_isa());
+    return best_kernel;
+  }
+
+  static FixedKernel fixed_kernel(int_fast32_t log_dim) {
+    return fht_double_fixed_kernel(fht_best_isa(), log_dim);
+  }
+
+  static void apply(Kernel kernel, double* data, int_fast32_t log_dim) {
+    if (kernel(data, log_dim) != 0) {
       throw LSHFunctionError("FHTDouble returned nonzero value.");
     }
   }
+
+  static void apply(double* data, int_fast32_t dim) {
+    apply(kernel(), data, log2ceil(dim));
+  }
 };
 
 template <typename ScalarType>
 class FHTHelper {
  public:
-  FHTHelper(int_fast32_t dim) : dim_(dim) {}
+  FHTHelper(int_fast32_t dim)
+      : dim_(dim),
+        log_dim_(log2ceil(dim)),
+        kernel_(FHTFunction<ScalarType>::kernel()),
+        fixed_kernel_(FHTFunction<ScalarType>::fixed_kernel(log_dim_)) {}
 
   int_fast32_t get_dim() { return dim_; }
 
-  void apply(ScalarType* data) { FHTFunction<ScalarType>::apply(data, dim_); }
+  void apply(ScalarType* data) {
+    if (fixed_kernel_ != nullptr) {
+      fixed_kernel_(data);
+    } else {
+      FHTFunction<ScalarType>::apply(kernel_, data, log_dim_);
+    }
+  }
 
  private:
   int_fast64_t dim_;
+  int_fast32_t log_dim_;
+  typename FHTFunction<ScalarType>::Kernel kernel_;
+  typename FHTFunction<ScalarType>::FixedKernel fixed_kernel_;
 };
 
+// Feature hashing without lookup tables: the hash of coordinate x under the
+// seeds (a, b) is a * x + b (mod 2^64) (multiply-add-shift). Its top
+// log_dim + 1 bits are the target index (shifted up by one) and the sign bit.
+// computed_feature_hashing_scalar and computed_feature_hashing compute these
+// top bits for a block of coordinates.
+static inline void computed_feature_hashing_scalar(
+    const uint32_t* coordinates, int_fast32_t num_coordinates, uint64_t a,
+    uint64_t b, int_fast32_t shift, uint32_t* result) {
+  for (int_fast32_t ii = 0; ii < num_coordinates; ++ii) {
+    result[ii] = static_cast<uint32_t>((a * coordinates[ii] + b) >> shift);
+  }
+}
+
+static inline void computed_feature_hashing(const uint32_t* coordinates,
+                                            int_fast32_t num_coordinates,
+                                            uint64_t a, uint64_t b,
+                                            int_fast32_t shift,
+                                            uint32_t* result) {
+  int_fast32_t ii = 0;
+#ifdef __AVX2__
+  // AVX2 has no 64-bit multiplication, so we compute
+  // a * x = (a_hi * x) << 32 + a_lo * x with two 32 x 32 -> 64 bit products.
+  __m256i a_lo = _mm256_set1_epi64x(a & 0xffffffffu);
+  __m256i a_hi = _mm256_set1_epi64x(a >> 32);
+  __m256i bb = _mm256_set1_epi64x(b);
+  __m128i count = _mm_cvtsi32_si128(shift);
+  // selects the low 32 bits of each 64-bit lane
+  __m256i pack = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+  for (; ii + 4 <= num_coordinates; ii += 4) {
+    __m256i x = _mm256_cvtepu32_epi64(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(coordinates + ii)));
+    __m256i h = _mm256_add_epi64(
+        _mm256_add_epi64(_mm256_mul_epu32(x, a_lo),
+                         _mm256_slli_epi64(_mm256_mul_epu32(x, a_hi), 32)),
+        bb);
+    h = _mm256_permutevar8x32_epi32(_mm256_srl_epi64(h, count), pack);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(result + ii),
+                     _mm256_castsi256_si128(h));
+  }
+#endif
+  computed_feature_hashing_scalar(coordinates + ii, num_coordinates - ii, a, b,
+                                  shift, result + ii);
+}
+
 }  // namespace cp_hash_helpers
 
 // TODO: replace CoordinateType with a type trait of VectorT?
 template <typename Derived, typename VectorT, typename CoordinateType = float,
           typename HashT = uint32_t>
 class CrossPolytopeHashBase {
- private:
+ public:
   class MultiProbeLookup;
 
- public:
   typedef VectorT VectorType;
   typedef HashT HashType;
   typedef Eigen::Matrix<CoordinateType, Eigen::Dynamic, 1, Eigen::ColMajor>
       RotatedVectorType;
-  typedef std::vector<RotatedVectorType> TransformedVectorType;
+  // The k * l rotated vectors of a point, one per column (column ii * k + jj
+  // is the jj-th cross-polytope of table ii). All of them are in one aligned
+  // allocation, which a query object sets up once.
+  typedef Eigen::Matrix<CoordinateType, Eigen::Dynamic, Eigen::Dynamic,
+                        Eigen::ColMajor>
+      TransformedVectorType;
 
   typedef HashObjectQuery<Derived> Query;
 
@@ -121,6 +217,16 @@ class CrossPolytopeHashBase {
       parent_.compute_rotated_vectors(v, result, &fht_helper_);
     }
 
+    // Only computes the rotated vectors of table l (the other columns of
+    // result are left unchanged).
+    HashType hash_single_table(const VectorT& v, int_fast32_t l,
+                               TransformedVectorType* result) {
+      parent_.compute_rotated_vectors_single_table(v, l, result, &fht_helper_);
+      return compute_cp_hash(*result, l, parent_.k_, parent_.rotation_dim_,
+                             parent_.log_rotation_dim_, parent_.last_cp_dim_,
+                             parent_.last_cp_log_dim_);
+    }
+
    private:
     const Derived& parent_;
     cp_hash_helpers::FHTHelper<CoordinateType> fht_helper_;
@@ -189,10 +295,7 @@ class CrossPolytopeHashBase {
   int_fast32_t get_l() const { return l_; }
 
   void reserve_transformed_vector_memory(TransformedVectorType* tv) const {
-    tv->resize(k_ * l_);
-    for (int_fast32_t ii = 0; ii < k_ * l_; ++ii) {
-      (*tv)[ii].resize(rotation_dim_);
-    }
+    tv->resize(rotation_dim_, k_ * l_);
   }
 
   void hash(
@@ -231,23 +334,11 @@ class CrossPolytopeHashBase {
     }
   }
 
-  static HashType decodeCP(const RotatedVectorType& data, int_fast64_t dim) {
-    HashType res = 0;
-    CoordinateType best = data[0];
-    if (-data[0] > best) {
-      best = -data[0];
-      res = dim;
-    }
-    for (int_fast64_t ii = 1; ii < dim; ++ii) {
-      if (data[ii] > best) {
-        best = data[ii];
-        res = ii;
-      } else if (-data[ii] > best) {
-        best = -data[ii];
-        res = ii + dim;
-      }
-    }
-    return res;
+  // data is a RotatedVectorType or a column of a TransformedVectorType.
+  template <typename RotatedVectorT>
+  static HashType decodeCP(const Eigen::MatrixBase<RotatedVectorT>& data,
+                           int_fast64_t dim) {
+    return cpu_dispatch_helpers::decode_cp(data.derived().data(), dim);
   }
 
   void add_table() {
@@ -344,16 +435,25 @@ class CrossPolytopeHashBase {
     }
 
     for (int_fast32_t ii = 0; ii < l; ++ii) {
-      res[ii] = 0;
-
-      for (int_fast32_t jj = 0; jj < k - 1; ++jj) {
-        res[ii] = res[ii] << (log_dim + 1);
-        res[ii] = res[ii] | decodeCP(rotated_vectors[ii * k + jj], dim);
-      }
+      res[ii] = compute_cp_hash(rotated_vectors, ii, k, dim, log_dim, last_dim,
+                                last_log_dim);
+    }
+  }
 
-      res[ii] = res[ii] << (last_log_dim + 1);
-      res[ii] = res[ii] | decodeCP(rotated_vectors[ii * k + k - 1], last_dim);
+  static HashType compute_cp_hash(const TransformedVectorType& rotated_vectors,
+                                  int_fast32_t table, int_fast32_t k,
+                                  int_fast32_t dim, int_fast32_t log_dim,
+                                  int_fast32_t last_dim,
+                                  int_fast32_t last_log_dim) {
+    HashType res = 0;
+    for (int_fast32_t jj = 0; jj < k - 1; ++jj) {
+      res = res << (log_dim + 1);
+      res = res | decodeCP(rotated_vectors.col(table * k + jj), dim);
     }
+
+    res = res << (last_log_dim + 1);
+    res = res | decodeCP(rotated_vectors.col(table * k + k - 1), last_dim);
+    return res;
   }
 
   const int_fast32_t rotation_dim_;  // dimension of the vectors to be rotated
@@ -373,28 +473,33 @@ class CrossPolytopeHashBase {
   void compute_rotated_vectors(
       const VectorT& v, TransformedVectorType* result,
       cp_hash_helpers::FHTHelper<CoordinateType>* fht) const {
-    int_fast32_t pattern = 0;
     for (int_fast32_t ii = 0; ii < l_; ++ii) {
-      for (int_fast32_t jj = 0; jj < k_; ++jj) {
-        RotatedVectorType& cur_vec = (*result)[ii * k_ + jj];
-        static_cast<const Derived*>(this)->embed(v, ii, jj, &cur_vec);
+      compute_rotated_vectors_single_table(v, ii, result, fht);
+    }
+  }
 
-        for (int_fast32_t rot = 0; rot < num_rotations_; ++rot) {
-          cur_vec = cur_vec.cwiseProduct(random_signs_[pattern]);
-          ++pattern;
-          fht->apply(cur_vec.data());
-        }
+  void compute_rotated_vectors_single_table(
+      const VectorT& v, int_fast32_t l, TransformedVectorType* result,
+      cp_hash_helpers::FHTHelper<CoordinateType>* fht) const {
+    int_fast32_t pattern = l * k_ * num_rotations_;
+    for (int_fast32_t jj = 0; jj < k_; ++jj) {
+      auto cur_vec = result->col(l * k_ + jj);
+      static_cast<const Derived*>(this)->embed(v, l, jj, &cur_vec);
+
+      for (int_fast32_t rot = 0; rot < num_rotations_; ++rot) {
+        cur_vec.array() *= random_signs_[pattern].array();
+        ++pattern;
+        fht->apply(cur_vec.data());
       }
     }
   }
 
   // friend BatchHash;
+
+ public:
   // Helper class for multiprobe LSH
   class MultiProbeLookup {
    public:
-    typedef Eigen::Matrix<CoordinateType, Eigen::Dynamic, 1, Eigen::ColMajor>
-        VectorType;
-
     MultiProbeLookup(const Derived& parent)
         : k_(parent.k_),
           l_(parent.l_),
@@ -404,16 +509,14 @@ class CrossPolytopeHashBase {
           last_cp_log_dim_(parent.last_cp_log_dim_),
           num_probes_(0),
           cur_probe_counter_(0),
-          sorted_coordinate_indices_(parent.k_ * parent.l_),
+          scores_per_table_(2 * ((parent.k_ - 1) * parent.rotation_dim_ +
+                                 parent.last_cp_dim_)),
+          sorted_coordinate_indices_(scores_per_table_ * parent.l_),
           inc_sorted_coordinate_indices_(parent.k_ * parent.l_),
-          main_table_probes_(parent.l_) {
-      for (int_fast32_t ii = 0; ii < l_; ++ii) {
-        for (int_fast32_t jj = 0; jj < k_; ++jj) {
-          int_fast32_t cur_cp_dim = (jj == k_ - 1 ? last_cp_dim_ : dim_);
-          sorted_coordinate_indices_[ii * k_ + jj].resize(2 * cur_cp_dim);
-        }
-      }
-    }
+          max_abs_coords_(parent.k_ * parent.l_),
+          first_two_coordinates_(2 * parent.k_ * parent.l_),
+          cp_prepared_(parent.k_ * parent.l_),
+          main_table_probes_(parent.l_) {}
 
     void setup_probing(const TransformedVectorType& transformed_vector,
                        int_fast64_t num_probes) {
@@ -429,7 +532,7 @@ class CrossPolytopeHashBase {
         return;
       }
 
-      int sorting_block_size = 0;
+      sorting_block_size_ = 0;
       if (num_probes_ >= 0) {
         double b = 1.0;
         double sqrt2 = std::sqrt(2.0);
@@ -438,42 +541,34 @@ class CrossPolytopeHashBase {
                static_cast<double>(num_probes_) / l_) {
           b *= sqrt2;
         }
-        sorting_block_size =
+        sorting_block_size_ =
             std::max(1, static_cast<int>(std::round(b * sqrt2)));
       } else {
-        sorting_block_size = 8;
+        sorting_block_size_ = 8;
       }
       // printf("sorting block size: %d\n", sorting_block_size_);
 
-      // For each CP, we now sort the potential hash values (2 * dim) by their
-      // distance to the largest absolute value in the respective CP
+      // The potential hash values (2 * dim) of each CP are ordered by their
+      // distance to the largest absolute value in the respective CP. This
+      // order is set up lazily: here we only find the first two hash values
+      // of each CP (one pass over the CP, which is all the heap needs until
+      // it continues with the third hash value of a CP). The remaining ones
+      // are sorted by prepare_cp in get_sorted_coordinate.
       for (int_fast32_t ii = 0; ii < l_; ++ii) {
         for (int_fast32_t jj = 0; jj < k_; ++jj) {
-          int_fast32_t cur_cp_dim = (jj == k_ - 1 ? last_cp_dim_ : dim_);
-          const VectorType& cur_vec = transformed_vector[ii * k_ + jj];
-          std::vector<std::pair<CoordinateType, int_fast32_t>>& cur_indices =
-              sorted_coordinate_indices_[ii * k_ + jj];
-
-          // TODO: use eigen for abs and max here
-          CoordinateType max_abs_coord = std::abs(cur_vec[0]);
-          for (int_fast32_t mm = 1; mm < cur_cp_dim; ++mm) {
-            max_abs_coord = std::max(max_abs_coord, std::abs(cur_vec[mm]));
-          }
-
-          for (int_fast32_t mm = 0; mm < cur_cp_dim; ++mm) {
-            cur_indices[mm] = std::make_pair(max_abs_coord - cur_vec[mm], mm);
-            cur_indices[mm + cur_cp_dim] =
-                std::make_pair(max_abs_coord + cur_vec[mm], mm + cur_cp_dim);
-          }
-
-          inc_sorted_coordinate_indices_[ii * k_ + jj].reset(
-              &(sorted_coordinate_indices_[ii * k_ + jj]), sorting_block_size);
+          find_first_two_coordinates(ii * k_ + jj);
         }
       }
 
-      // We use a heap to construct the probing sequence.
+      // We use a heap to construct the probing sequence. Each extracted
+      // candidate adds at most two new ones, so the heap is small unless
+      // many probes are requested. Reserving space for all of them up front
+      // would take a lot of memory for large num_probes, so the reserved
+      // space is capped (the heap grows on demand beyond that).
       if (num_probes_ >= 0) {
-        heap_.resize(2 * k_ * l_ * num_probes_ + l_);
+        heap_.reserve(
+            std::min(2 * k_ * num_probes_ + l_,
+                     static_cast<int_fast64_t>(kMaxReservedHeapSize)));
       }
       heap_.reset();
       for (int_fast32_t ii = 0; ii < l_; ++ii) {
@@ -533,18 +628,18 @@ class CrossPolytopeHashBase {
             cur_cp_log_dim = last_cp_log_dim_;
           }
 
-          CoordinateType cur_coord_score =
-              inc_sorted_coordinate_indices_[cur_table * k_ + cur_cp]
-                  .get(cur_sorted_coord_index)
-                  .first;
-          cur_coord_score = cur_coord_score * cur_coord_score;
+          int_fast32_t cur_cp_index = cur_table * k_ + cur_cp;
+          // Entries that were already returned stay in place, so the
+          // reference remains valid while the next one is set up.
+          const ScoredCoordinate& cur_coord =
+              get_sorted_coordinate(cur_cp_index, cur_sorted_coord_index);
+          CoordinateType cur_coord_score = cur_coord.first * cur_coord.first;
 
           // first case: same CP, but next higher index
           if (cur_sorted_coord_index < 2 * cur_cp_dim - 1) {
             CoordinateType next_score = cur_score - cur_coord_score;
             CoordinateType next_coord_score =
-                inc_sorted_coordinate_indices_[cur_table * k_ + cur_cp]
-                    .get(cur_sorted_coord_index + 1)
+                get_sorted_coordinate(cur_cp_index, cur_sorted_coord_index + 1)
                     .first;
             next_score += next_coord_score * next_coord_score;
 
@@ -554,10 +649,7 @@ class CrossPolytopeHashBase {
           }
 
           // second case: next CP
-          HashType cur_index =
-              inc_sorted_coordinate_indices_[cur_table * k_ + cur_cp]
-                  .get(cur_sorted_coord_index)
-                  .second;
+          HashType cur_index = cur_coord.second;
           HashType next_hash = cur_candidate.prev_cps_hash_
                                << (cur_cp_log_dim + 1);
           next_hash = next_hash | cur_index;
@@ -568,6 +660,86 @@ class CrossPolytopeHashBase {
     }
 
    private:
+    typedef std::pair<CoordinateType, int_fast32_t> ScoredCoordinate;
+
+    static const int_fast64_t kMaxReservedHeapSize = 1 << 16;
+
+    // The first two entries of the sorted order of CP cp_index (see
+    // setup_probing).
+    void find_first_two_coordinates(int_fast32_t cp_index) {
+      int_fast32_t cur_cp_dim = (cp_index % k_ == k_ - 1 ? last_cp_dim_ : dim_);
+      const CoordinateType* cur_vec =
+          transformed_vector_->col(cp_index).data();
+
+      // TODO: use eigen for abs and max here
+      CoordinateType max_abs_coord = std::abs(cur_vec[0]);
+      for (int_fast32_t mm = 1; mm < cur_cp_dim; ++mm) {
+        max_abs_coord = std::max(max_abs_coord, std::abs(cur_vec[mm]));
+      }
+
+      // Compares the pairs like the full sort, so ties are broken the same
+      // way.
+      ScoredCoordinate first(max_abs_coord - cur_vec[0], 0);
+      ScoredCoordinate second(max_abs_coord + cur_vec[0], cur_cp_dim);
+      if (second < first) {
+        std::swap(first, second);
+      }
+      for (int_fast32_t mm = 1; mm < cur_cp_dim; ++mm) {
+        ScoredCoordinate candidates[2] = {
+            ScoredCoordinate(max_abs_coord - cur_vec[mm], mm),
+            ScoredCoordinate(max_abs_coord + cur_vec[mm], mm + cur_cp_dim)};
+        for (const ScoredCoordinate& cur : candidates) {
+          if (cur < second) {
+            if (cur < first) {
+              second = first;
+              first = cur;
+            } else {
+              second = cur;
+            }
+          }
+        }
+      }
+      max_abs_coords_[cp_index] = max_abs_coord;
+      first_two_coordinates_[2 * cp_index] = first;
+      first_two_coordinates_[2 * cp_index + 1] = second;
+      cp_prepared_[cp_index] = false;
+    }
+
+    // Sorts the potential hash values of CP cp_index (incrementally, so only
+    // the first few are actually sorted).
+    void prepare_cp(int_fast32_t cp_index) {
+      int_fast32_t table = cp_index / k_;
+      int_fast32_t cp = cp_index % k_;
+      int_fast32_t cur_cp_dim = (cp == k_ - 1 ? last_cp_dim_ : dim_);
+      const CoordinateType* cur_vec =
+          transformed_vector_->col(cp_index).data();
+      CoordinateType max_abs_coord = max_abs_coords_[cp_index];
+      ScoredCoordinate* cur_indices =
+          &sorted_coordinate_indices_[table * scores_per_table_ +
+                                      2 * cp * dim_];
+
+      for (int_fast32_t mm = 0; mm < cur_cp_dim; ++mm) {
+        cur_indices[mm] = std::make_pair(max_abs_coord - cur_vec[mm], mm);
+        cur_indices[mm + cur_cp_dim] =
+            std::make_pair(max_abs_coord + cur_vec[mm], mm + cur_cp_dim);
+      }
+
+      inc_sorted_coordinate_indices_[cp_index].reset(
+          cur_indices, cur_indices + 2 * cur_cp_dim, sorting_block_size_);
+      cp_prepared_[cp_index] = true;
+    }
+
+    const ScoredCoordinate& get_sorted_coordinate(int_fast32_t cp_index,
+                                                  int_fast32_t index) {
+      if (index < 2 && !cp_prepared_[cp_index]) {
+        return first_two_coordinates_[2 * cp_index + index];
+      }
+      if (!cp_prepared_[cp_index]) {
+        prepare_cp(cp_index);
+      }
+      return inc_sorted_coordinate_indices_[cp_index].get(index);
+    }
+
     class ProbeCandidate {
      public:
       ProbeCandidate(int_fast32_t table = 0, HashType prev_cps_hash = 0,
@@ -592,16 +764,32 @@ class CrossPolytopeHashBase {
     const int_fast32_t last_cp_log_dim_;
     int_fast64_t num_probes_;
     int_fast64_t cur_probe_counter_;
-    std::vector<std::vector<std::pair<CoordinateType, int_fast32_t>>>
-        sorted_coordinate_indices_;
-    std::vector<IncrementalSorter<std::pair<CoordinateType, int_fast32_t>>>
+    // The 2 * dim scores of the candidate hash values of all k * l
+    // cross-polytopes in one array (the ones of table ii start at
+    // ii * scores_per_table_).
+    const int_fast64_t scores_per_table_;
+    std::vector<ScoredCoordinate> sorted_coordinate_indices_;
+    std::vector<IncrementalSorter<ScoredCoordinate>>
         inc_sorted_coordinate_indices_;
+    // Per CP: the largest absolute value, the first two entries of the sorted
+    // order, and whether the remaining entries are set up (prepare_cp).
+    std::vector<CoordinateType> max_abs_coords_;
+    std::vector<ScoredCoordinate> first_two_coordinates_;
+    std::vector<bool> cp_prepared_;
+    int_fast32_t sorting_block_size_ = 0;
     std::vector<HashType> main_table_probes_;
     AugmentedHeap<CoordinateType, ProbeCandidate> heap_;
     const TransformedVectorType* transformed_vector_;
   };
 };
 
+// The sparse cross-polytope hash first maps the vectors to rotation_dim
+// dimensions via feature hashing (a separate feature hashing function for each
+// of the k * l cross-polytopes). By default, the target index and sign of each
+// coordinate are stored in lookup tables with k * l * vector_dim entries. For
+// large vocabularies these tables become very large, so with
+// computed_feature_hashing = true they are instead computed from a seeded hash
+// of the coordinate (see cp_hash_helpers::computed_feature_hashing).
 template <typename CoordinateType = float, typename HashType = uint32_t,
           typename IndexType = int32_t>
 class CrossPolytopeHashSparse
@@ -617,12 +805,14 @@ class CrossPolytopeHashSparse
   CrossPolytopeHashSparse(int_fast32_t vector_dim, int_fast32_t k,
                           int_fast32_t l, int_fast32_t num_rotations,
                           int_fast32_t feature_hashing_dim,
-                          int_fast32_t last_cp_dim, uint_fast64_t seed)
+                          int_fast32_t last_cp_dim, uint_fast64_t seed,
+                          bool computed_feature_hashing = false)
       : CrossPolytopeHashBase<CrossPolytopeHashSparse<CoordinateType, HashType>,
                               std::vector<std::pair<IndexType, CoordinateType>>,
                               CoordinateType, HashType>(
             feature_hashing_dim, k, l, num_rotations, last_cp_dim, seed),
-        vector_dim_(vector_dim) {
+        vector_dim_(vector_dim),
+        computed_feature_hashing_(computed_feature_hashing) {
     if (vector_dim_ < 1) {
       throw LSHFunctionError("Vector dimension must be at least 1.");
     }
@@ -631,6 +821,19 @@ class CrossPolytopeHashSparse
     // xor'ing in a random number to avoid seeding with the same seed as in
     // the base class.
     std::mt19937_64 gen(this->seed_ ^ 846980723);
+
+    if (computed_feature_hashing_) {
+      int_fast32_t num_functions = this->k_ * this->l_;
+      feature_hashing_seeds_.resize(2 * num_functions);
+      for (int_fast32_t ii = 0; ii < num_functions; ++ii) {
+        // the multiplier must be odd
+        feature_hashing_seeds_[2 * ii] = gen() | 1;
+        feature_hashing_seeds_[2 * ii + 1] = gen();
+      }
+      feature_hashing_shift_ = 64 - (this->log_rotation_dim_ + 1);
+      return;
+    }
+
     std::uniform_int_distribution<int_fast32_t> bernoulli(0, 1);
     std::uniform_int_distribution<int_fast32_t> feature_hashing_distribution(
         0, this->rotation_dim_ - 1);
@@ -646,10 +849,18 @@ class CrossPolytopeHashSparse
     }
   }
 
-  void embed(const DerivedVectorT& v, int_fast32_t l, int_fast32_t k,
-             HashedVectorT* res) const {
+  // SparseVectorT is DerivedVectorT or a type with the same interface (e.g.,
+  // SparseVectorView for points in a CSRDataStorage).
+  // OutputVectorT is HashedVectorT or a column of a TransformedVectorType.
+  template <typename SparseVectorT, typename OutputVectorT>
+  void embed(const SparseVectorT& v, int_fast32_t l, int_fast32_t k,
+             OutputVectorT* res) const {
     res->setZero();
-    IndexType offset =
+    if (computed_feature_hashing_) {
+      embed_computed(v, static_cast<int_fast64_t>(l) * this->k_ + k, res);
+      return;
+    }
+    int_fast64_t offset =
         ((static_cast<int_fast64_t>(l) * this->k_) + k) * vector_dim_;
 
     for (IndexType ii = 0; ii < static_cast<IndexType>(v.size()); ++ii) {
@@ -662,9 +873,42 @@ class CrossPolytopeHashSparse
   }
 
  private:
+  // Hashes the coordinates in blocks so that computed_feature_hashing can use
+  // SIMD instructions. Only the accumulation into res is sequential.
+  template <typename SparseVectorT, typename OutputVectorT>
+  void embed_computed(const SparseVectorT& v, int_fast64_t function_index,
+                      OutputVectorT* res) const {
+    const int_fast32_t kBlockSize = 32;
+    uint32_t coordinates[kBlockSize];
+    uint32_t hashes[kBlockSize];
+    uint64_t a = feature_hashing_seeds_[2 * function_index];
+    uint64_t b = feature_hashing_seeds_[2 * function_index + 1];
+    int_fast64_t size = v.size();
+    for (int_fast64_t start = 0; start < size; start += kBlockSize) {
+      int_fast32_t num_coordinates =
+          std::min<int_fast64_t>(kBlockSize, size - start);
+      for (int_fast32_t ii = 0; ii < num_coordinates; ++ii) {
+        coordinates[ii] = static_cast<uint32_t>(v[start + ii].first);
+      }
+      cp_hash_helpers::computed_feature_hashing(coordinates, num_coordinates,
+                                                a, b, feature_hashing_shift_,
+                                                hashes);
+      for (int_fast32_t ii = 0; ii < num_coordinates; ++ii) {
+        CoordinateType cur_val = v[start + ii].second;
+        (*res)[hashes[ii] >> 1] += (hashes[ii] & 1) ? -cur_val : cur_val;
+      }
+    }
+  }
+
   const int_fast32_t vector_dim_;  // actual dimension of the vectors
+  const bool computed_feature_hashing_;
+  // used if computed_feature_hashing_ is false
   std::vector<int> feature_hashing_index_;
   std::vector<CoordinateType> feature_hashing_coeff_;
+  // used if computed_feature_hashing_ is true: pairs (a, b) of seeds for the
+  // k * l hash functions
+  std::vector<uint64_t> feature_hashing_seeds_;
+  int_fast32_t feature_hashing_shift_ = 0;
 };
 
 template <typename CoordinateType = float, typename HashType = uint32_t>
@@ -691,7 +935,9 @@ class CrossPolytopeHashDense
     }
   }
 
-  void embed(const DerivedVectorT& v, int, int, DerivedVectorT* result) const {
+  // OutputVectorT is DerivedVectorT or a column of a TransformedVectorType.
+  template <typename OutputVectorT>
+  void embed(const DerivedVectorT& v, int, int, OutputVectorT* result) const {
     // TODO: use something more low-level here?
     for (int_fast32_t ii = 0; ii < vector_dim_; ++ii) {
       (*result)[ii] = v[ii];
@@ -0,0 +1,435 @@
+#ifndef __PQ_DATA_STORAGE_H__
+#define __PQ_DATA_STORAGE_H__
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "../falconn_global.h"
+#include "data_storage.h"
+#include "euclidean_distance.h"
+
+namespace falconn {
+namespace core {
+
+// Product quantization (PQ) of dense points. The coordinates are split into
+// num_subspaces contiguous blocks, and each block is replaced by the index of
+// the closest of 16 centroids learned with k-means on that block. A point is
+// therefore stored in num_subspaces / 2 bytes (two 4-bit codes per byte), e.g.
+// 8 to 16 bytes instead of the 1-4KB of a full-precision vector.
+//
+// PQDistanceScorer scores a query against the codes with asymmetric distance
+// computation (ADC): the distances between the query and all centroids are
+// tabulated once per query, after which a candidate is scored with
+// num_subspaces table lookups. ScorerNearestNeighborQuery (see nn_query.h)
+// uses the scorer to pre-rank the LSH candidates, and
+// RerankingNearestNeighborQuery re-ranks the best of them with exact
+// distances.
+
+class PQDataStorageError : public DataStorageError {
+ public:
+  PQDataStorageError(const char* msg) : DataStorageError(msg) {}
+};
+
+namespace pq_helpers {
+
+const int_fast32_t kNumCentroids = 16;
+
+// Sums 8-bit lookup table entries for a block of kBlockSize points whose codes
+// are stored transposed: byte jj of point pp is at block[jj * kBlockSize + pp].
+// lut holds 16 entries per subspace. The results are exact integers, so the
+// SIMD and the scalar version below agree.
+const int_fast32_t kBlockSize = 32;
+
+inline void adc_scan_block_scalar(const uint8_t* block, const uint8_t* lut,
+                                  int_fast32_t code_size, uint16_t* result) {
+  for (int_fast32_t pp = 0; pp < kBlockSize; ++pp) {
+    result[pp] = 0;
+  }
+  for (int_fast32_t jj = 0; jj < code_size; ++jj) {
+    const uint8_t* lut_lo = lut + 2 * jj * kNumCentroids;
+    const uint8_t* lut_hi = lut_lo + kNumCentroids;
+    const uint8_t* cur = block + jj * kBlockSize;
+    for (int_fast32_t pp = 0; pp < kBlockSize; ++pp) {
+      result[pp] += lut_lo[cur[pp] & 0x0f] + lut_hi[cur[pp] >> 4];
+    }
+  }
+}
+
+#ifdef __AVX2__
+// Uses the byte shuffle (vpshufb) as 32 parallel lookups into a 16-entry table.
+inline void adc_scan_block_avx2(const uint8_t* block, const uint8_t* lut,
+                                int_fast32_t code_size, uint16_t* result) {
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+  const __m256i zero = _mm256_setzero_si256();
+  // acc_a holds points 0-7 and 16-23, acc_b holds points 8-15 and 24-31
+  // (unpack works within 128-bit lanes).
+  __m256i acc_a = _mm256_setzero_si256();
+  __m256i acc_b = _mm256_setzero_si256();
+  for (int_fast32_t jj = 0; jj < code_size; ++jj) {
+    __m256i codes = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(block + jj * kBlockSize));
+    __m256i lo = _mm256_and_si256(codes, low_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(codes, 4), low_mask);
+    __m256i lut_lo = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(lut + 2 * jj * kNumCentroids)));
+    __m256i lut_hi = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(lut + (2 * jj + 1) * kNumCentroids)));
+    __m256i val_lo = _mm256_shuffle_epi8(lut_lo, lo);
+    __m256i val_hi = _mm256_shuffle_epi8(lut_hi, hi);
+    acc_a = _mm256_add_epi16(acc_a, _mm256_unpacklo_epi8(val_lo, zero));
+    acc_a = _mm256_add_epi16(acc_a, _mm256_unpacklo_epi8(val_hi, zero));
+    acc_b = _mm256_add_epi16(acc_b, _mm256_unpackhi_epi8(val_lo, zero));
+    acc_b = _mm256_add_epi16(acc_b, _mm256_unpackhi_epi8(val_hi, zero));
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(result),
+                   _mm256_castsi256_si128(acc_a));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(result + 8),
+                   _mm256_castsi256_si128(acc_b));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(result + 16),
+                   _mm256_extracti128_si256(acc_a, 1));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(result + 24),
+                   _mm256_extracti128_si256(acc_b, 1));
+}
+#endif
+
+inline void adc_scan_block(const uint8_t* block, const uint8_t* lut,
+                           int_fast32_t code_size, uint16_t* result) {
+#ifdef __AVX2__
+  adc_scan_block_avx2(block, lut, code_size, result);
+#else
+  adc_scan_block_scalar(block, lut, code_size, result);
+#endif
+}
+
+}  // namespace pq_helpers
+
+template <typename CoordinateType = float, typename KeyType = int32_t>
+class PQDataStorage {
+ public:
+  typedef Eigen::Matrix<CoordinateType, Eigen::Dynamic, 1, Eigen::ColMajor>
+      VectorType;
+
+  // Trains the codebooks on all points of a dense data storage and encodes
+  // them. num_subspaces must be even and at most the dimension. The inner
+  // storage is not referenced afterwards.
+  template <typename InnerDataStorage>
+  PQDataStorage(const InnerDataStorage& storage, int_fast32_t num_subspaces,
+                int_fast32_t num_iterations = 10, uint_fast64_t seed = 93410385)
+      : num_points_(storage.size()), num_subspaces_(num_subspaces) {
+    if (num_subspaces_ < 2 || num_subspaces_ % 2 != 0) {
+      throw PQDataStorageError(
+          "Number of subspaces must be a positive even number.");
+    }
+    // The SIMD scorer sums up to 255 per subspace in 16-bit integers.
+    if (num_subspaces_ > 256) {
+      throw PQDataStorageError("More than 256 subspaces are not supported.");
+    }
+    if (num_iterations < 0) {
+      throw PQDataStorageError("Number of iterations cannot be negative.");
+    }
+    typename InnerDataStorage::FullSequenceIterator iter =
+        storage.get_full_sequence();
+    if (!iter.is_valid()) {
+      throw PQDataStorageError("Cannot quantize an empty data set.");
+    }
+    dim_ = iter.get_point().size();
+    if (num_subspaces_ > dim_) {
+      throw PQDataStorageError(
+          "Number of subspaces cannot be larger than the dimension.");
+    }
+    code_size_ = num_subspaces_ / 2;
+
+    subspace_begin_.resize(num_subspaces_ + 1);
+    for (int_fast32_t ss = 0; ss <= num_subspaces_; ++ss) {
+      subspace_begin_[ss] = ss * dim_ / num_subspaces_;
+    }
+
+    std::vector<CoordinateType> points(num_points_ * dim_);
+    int_fast64_t cur_point = 0;
+    for (; iter.is_valid(); ++iter) {
+      const auto& p = iter.get_point();
+      for (int_fast64_t jj = 0; jj < dim_; ++jj) {
+        points[cur_point * dim_ + jj] = p[jj];
+      }
+      cur_point += 1;
+    }
+
+    centroids_.resize(pq_helpers::kNumCentroids * dim_);
+    std::vector<uint8_t> assignment(num_points_ * num_subspaces_);
+    std::mt19937_64 gen(seed);
+    for (int_fast32_t ss = 0; ss < num_subspaces_; ++ss) {
+      train_subspace(points, ss, num_iterations, &gen, &assignment);
+    }
+
+    codes_.assign(num_points_ * code_size_, 0);
+    for (int_fast64_t ii = 0; ii < num_points_; ++ii) {
+      uint8_t* cur_codes = &(codes_[ii * code_size_]);
+      for (int_fast32_t ss = 0; ss < num_subspaces_; ++ss) {
+        uint8_t code = assignment[ii * num_subspaces_ + ss];
+        cur_codes[ss / 2] |= (ss % 2 == 0) ? code : (code << 4);
+      }
+    }
+  }
+
+  int_fast64_t size() const { return num_points_; }
+
+  int_fast64_t dimension() const { return dim_; }
+
+  int_fast32_t num_subspaces() const { return num_subspaces_; }
+
+  // Number of bytes per encoded point.
+  int_fast32_t code_size() const { return code_size_; }
+
+  int_fast64_t subspace_begin(int_fast32_t subspace) const {
+    return subspace_begin_[subspace];
+  }
+
+  int_fast64_t subspace_dimension(int_fast32_t subspace) const {
+    return subspace_begin_[subspace + 1] - subspace_begin_[subspace];
+  }
+
+  const CoordinateType* centroid(int_fast32_t subspace,
+                                 int_fast32_t code) const {
+    return &(centroids_[pq_helpers::kNumCentroids * subspace_begin_[subspace] +
+                        code * subspace_dimension(subspace)]);
+  }
+
+  const uint8_t* codes(KeyType key) const {
+    return &(codes_[static_cast<int_fast64_t>(key) * code_size_]);
+  }
+
+  int_fast32_t get_code(KeyType key, int_fast32_t subspace) const {
+    uint8_t byte = codes(key)[subspace / 2];
+    return (subspace % 2 == 0) ? (byte & 0x0f) : (byte >> 4);
+  }
+
+  // Writes the reconstruction (concatenation of the centroids) of a point.
+  void decode(KeyType key, VectorType* result) const {
+    result->resize(dim_);
+    for (int_fast32_t ss = 0; ss < num_subspaces_; ++ss) {
+      const CoordinateType* c = centroid(ss, get_code(key, ss));
+      for (int_fast64_t jj = 0; jj < subspace_dimension(ss); ++jj) {
+        (*result)[subspace_begin_[ss] + jj] = c[jj];
+      }
+    }
+  }
+
+ private:
+  // Lloyd's algorithm on the coordinates of one subspace. The centroids are
+  // initialized with distinct random points (or repeated points if there are
+  // fewer points than centroids). Empty clusters keep their centroid.
+  void train_subspace(const std::vector<CoordinateType>& points,
+                      int_fast32_t ss, int_fast32_t num_iterations,
+                      std::mt19937_64* gen, std::vector<uint8_t>* assignment) {
+    const int_fast32_t num_centroids = pq_helpers::kNumCentroids;
+    int_fast64_t begin = subspace_begin_[ss];
+    int_fast64_t sub_dim = subspace_dimension(ss);
+    CoordinateType* cents =
+        &(centroids_[num_centroids * subspace_begin_[ss]]);
+
+    std::vector<int_fast64_t> perm(num_points_);
+    for (int_fast64_t ii = 0; ii < num_points_; ++ii) {
+      perm[ii] = ii;
+    }
+    for (int_fast32_t cc = 0; cc < num_centroids && cc < num_points_; ++cc) {
+      std::uniform_int_distribution<int_fast64_t> dist(cc, num_points_ - 1);
+      std::swap(perm[cc], perm[dist(*gen)]);
+    }
+    for (int_fast32_t cc = 0; cc < num_centroids; ++cc) {
+      const CoordinateType* p = &(points[perm[cc % num_points_] * dim_ + begin]);
+      std::copy(p, p + sub_dim, cents + cc * sub_dim);
+    }
+
+    std::vector<CoordinateType> sums(num_centroids * sub_dim);
+    std::vector<int_fast64_t> counts(num_centroids);
+    for (int_fast32_t iteration = 0; iteration <= num_iterations;
+         ++iteration) {
+      std::fill(sums.begin(), sums.end(), 0);
+      std::fill(counts.begin(), counts.end(), 0);
+      for (int_fast64_t ii = 0; ii < num_points_; ++ii) {
+        const CoordinateType* p = &(points[ii * dim_ + begin]);
+        int_fast32_t best = 0;
+        CoordinateType best_distance = std::numeric_limits<CoordinateType>::max();
+        for (int_fast32_t cc = 0; cc < num_centroids; ++cc) {
+          CoordinateType distance = 0;
+          for (int_fast64_t jj = 0; jj < sub_dim; ++jj) {
+            CoordinateType diff = p[jj] - cents[cc * sub_dim + jj];
+            distance += diff * diff;
+          }
+          if (distance < best_distance) {
+            best_distance = distance;
+            best = cc;
+          }
+        }
+        (*assignment)[ii * num_subspaces_ + ss] = best;
+        counts[best] += 1;
+        for (int_fast64_t jj = 0; jj < sub_dim; ++jj) {
+          sums[best * sub_dim + jj] += p[jj];
+        }
+      }
+      // The last pass only computes the final assignment.
+      if (iteration == num_iterations) {
+        break;
+      }
+      for (int_fast32_t cc = 0; cc < num_centroids; ++cc) {
+        if (counts[cc] == 0) {
+          continue;
+        }
+        for (int_fast64_t jj = 0; jj < sub_dim; ++jj) {
+          cents[cc * sub_dim + jj] = sums[cc * sub_dim + jj] / counts[cc];
+        }
+      }
+    }
+  }
+
+  int_fast64_t num_points_;
+  int_fast32_t num_subspaces_;
+  int_fast64_t dim_;
+  int_fast32_t code_size_;
+  std::vector<int_fast64_t> subspace_begin_;
+  // centroids of subspace ss start at kNumCentroids * subspace_begin_[ss]
+  std::vector<CoordinateType> centroids_;
+  std::vector<uint8_t> codes_;
+};
+
+// Scores PQ-encoded points against a query with asymmetric distance
+// computation. DistanceFunction must be additive over the subspaces, which
+// holds for CosineDistanceDense (negative inner product) and
+// EuclideanDistanceDense (squared distance).
+//
+// The interface follows the DistanceScorer in experimental/pipes.h:
+// load_query() builds the lookup tables, prepare() prefetches the code of a
+// point, and get_score() scores one point with the full-precision tables.
+// score_batch() scores a whole candidate list with 8-bit tables and the SIMD
+// shuffle kernel above; its scores are within num_subspaces * scale / 2 of the
+// ones returned by get_score(), where scale is the quantization step of the
+// tables.
+template <typename DistanceFunction = EuclideanDistanceDense<float>,
+          typename CoordinateType = float, typename KeyType = int32_t>
+class PQDistanceScorer {
+ public:
+  typedef CoordinateType ScoreType;
+  typedef PQDataStorage<CoordinateType, KeyType> DataStorageType;
+
+  PQDistanceScorer(const DataStorageType& storage)
+      : storage_(storage),
+        lut_(pq_helpers::kNumCentroids * storage.num_subspaces()),
+        quantized_lut_(pq_helpers::kNumCentroids * storage.num_subspaces()),
+        block_(pq_helpers::kBlockSize * storage.code_size()) {}
+
+  template <typename Derived>
+  void load_query(const Eigen::MatrixBase<Derived>& q) {
+    if (q.size() != storage_.dimension()) {
+      throw PQDataStorageError("Query dimension does not match the data.");
+    }
+    const int_fast32_t num_centroids = pq_helpers::kNumCentroids;
+    int_fast32_t num_subspaces = storage_.num_subspaces();
+    CoordinateType max_range = 0;
+    bias_ = 0;
+    for (int_fast32_t ss = 0; ss < num_subspaces; ++ss) {
+      int_fast64_t sub_dim = storage_.subspace_dimension(ss);
+      auto q_sub = q.segment(storage_.subspace_begin(ss), sub_dim);
+      CoordinateType* cur_lut = &(lut_[ss * num_centroids]);
+      for (int_fast32_t cc = 0; cc < num_centroids; ++cc) {
+        Eigen::Map<const Eigen::Matrix<CoordinateType, Eigen::Dynamic, 1>>
+            centroid(storage_.centroid(ss, cc), sub_dim);
+        cur_lut[cc] = dst_(q_sub, centroid);
+      }
+      auto range = std::minmax_element(cur_lut, cur_lut + num_centroids);
+      bias_ += *range.first;
+      max_range = std::max(max_range, *range.second - *range.first);
+    }
+
+    // One scale for all subspaces so that the 8-bit entries can be summed.
+    scale_ = max_range / 255;
+    for (int_fast32_t ss = 0; ss < num_subspaces; ++ss) {
+      const CoordinateType* cur_lut = &(lut_[ss * num_centroids]);
+      CoordinateType min_entry = *std::min_element(cur_lut,
+                                                   cur_lut + num_centroids);
+      for (int_fast32_t cc = 0; cc < num_centroids; ++cc) {
+        CoordinateType entry = 0;
+        if (scale_ > 0) {
+          entry = std::round((cur_lut[cc] - min_entry) / scale_);
+        }
+        quantized_lut_[ss * num_centroids + cc] =
+            static_cast<uint8_t>(std::min<CoordinateType>(255, entry));
+      }
+    }
+  }
+
+  void prepare(KeyType key) const {
+    __builtin_prefetch(storage_.codes(key), 0, 1);
+  }
+
+  ScoreType get_score(KeyType key) const {
+    const uint8_t* codes = storage_.codes(key);
+    const CoordinateType* lut = lut_.data();
+    ScoreType res = 0;
+    for (int_fast32_t jj = 0; jj < storage_.code_size(); ++jj) {
+      res += lut[codes[jj] & 0x0f];
+      res += lut[pq_helpers::kNumCentroids + (codes[jj] >> 4)];
+      lut += 2 * pq_helpers::kNumCentroids;
+    }
+    return res;
+  }
+
+  void score_batch(const std::vector<KeyType>& keys,
+                   std::vector<ScoreType>* scores) {
+    const int_fast32_t block_size = pq_helpers::kBlockSize;
+    int_fast32_t code_size = storage_.code_size();
+    int_fast64_t num_keys = keys.size();
+    scores->resize(num_keys);
+    for (int_fast64_t start = 0; start < num_keys; start += block_size) {
+      int_fast64_t cur_size = std::min<int_fast64_t>(block_size,
+                                                     num_keys - start);
+      // Transpose the codes of the block (zero padding for a partial block).
+      for (int_fast64_t pp = 0; pp < cur_size; ++pp) {
+        if (start + pp + block_size < num_keys) {
+          prepare(keys[start + pp + block_size]);
+        }
+        const uint8_t* codes = storage_.codes(keys[start + pp]);
+        for (int_fast32_t jj = 0; jj < code_size; ++jj) {
+          block_[jj * block_size + pp] = codes[jj];
+        }
+      }
+      for (int_fast64_t pp = cur_size; pp < block_size; ++pp) {
+        for (int_fast32_t jj = 0; jj < code_size; ++jj) {
+          block_[jj * block_size + pp] = 0;
+        }
+      }
+      pq_helpers::adc_scan_block(block_.data(), quantized_lut_.data(),
+                                 code_size, block_result_);
+      for (int_fast64_t pp = 0; pp < cur_size; ++pp) {
+        (*scores)[start + pp] = bias_ + scale_ * block_result_[pp];
+      }
+    }
+  }
+
+  // Quantization step of the 8-bit lookup tables for the current query.
+  CoordinateType get_table_scale() const { return scale_; }
+
+ private:
+  const DataStorageType& storage_;
+  std::vector<CoordinateType> lut_;
+  std::vector<uint8_t> quantized_lut_;
+  std::vector<uint8_t> block_;
+  uint16_t block_result_[pq_helpers::kBlockSize];
+  CoordinateType bias_ = 0;
+  CoordinateType scale_ = 0;
+  DistanceFunction dst_;
+};
+
+}  // namespace core
+}  // namespace falconn
+
+#endif
@@ -57,6 +57,18 @@ class PlainArrayPrefetcher {
   void prefetch(const T* p) { __builtin_prefetch(p, 0, 1); }
 };
 
+// Prefetches the start of the index and value arrays of a point in CSR
+// format (the two arrays are separate, so a point spans two memory regions).
+template <typename CoordinateType, typename IndexType>
+class CSRPrefetcher {
+ public:
+  void prefetch(const IndexType* indices, const CoordinateType* values,
+                int64_t begin) {
+    __builtin_prefetch(indices + begin, 0, 1);
+    __builtin_prefetch(values + begin, 0, 1);
+  }
+};
+
 }  // namespace core
 }  // namespace falconn
 
@@ -0,0 +1,182 @@
+#ifndef __PREFIX_HASH_TABLE_H__
+#define __PREFIX_HASH_TABLE_H__
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "hash_table_helpers.h"
+
+#include <serialize.h>
+
+namespace falconn {
+namespace core {
+
+class PrefixHashTableError : public HashTableError {
+ public:
+  PrefixHashTableError(const char* msg) : HashTableError(msg) {}
+};
+
+// A static hash table for keys with num_bits bits that stores the values
+// sorted by their key (as in an LSH Forest). Besides the bucket of a key, it
+// can retrieve all entries whose keys share the first (most significant)
+// prefix_length bits with a given key. For the LSH families, the first bits
+// of a hash come from the first hash functions, so a prefix corresponds to a
+// hash with a smaller k.
+//
+// A prefix index with one entry per possible value of the first
+// num_index_bits bits (at most about one entry per item) narrows the binary
+// searches for a key down to a few entries. The buckets are contiguous, so
+// the iterators are pointers.
+template <typename KeyType, typename ValueType = int32_t,
+          typename IndexType = int32_t>
+class StaticPrefixHashTable {
+ public:
+  class Factory {
+   public:
+    Factory(int_fast32_t num_bits) : num_bits_(num_bits) {
+      if (num_bits_ < 1 ||
+          num_bits_ > static_cast<int_fast32_t>(8 * sizeof(KeyType))) {
+        throw PrefixHashTableError(
+            "Number of key bits must be between 1 and the width of the key "
+            "type.");
+      }
+    }
+
+    StaticPrefixHashTable<KeyType, ValueType, IndexType>* new_hash_table() {
+      return new StaticPrefixHashTable<KeyType, ValueType, IndexType>(
+          num_bits_);
+    }
+
+   private:
+    int_fast32_t num_bits_;
+  };
+
+  typedef const ValueType* Iterator;
+
+  StaticPrefixHashTable(int_fast32_t num_bits) : num_bits_(num_bits) {}
+
+  void add_entries(const std::vector<KeyType>& keys) {
+    if (entries_added_) {
+      throw PrefixHashTableError("Entries were already added.");
+    }
+    entries_added_ = true;
+
+    for (const KeyType& key : keys) {
+      if (low_bits(key, num_bits_) != key) {
+        throw PrefixHashTableError("Key value out of range.");
+      }
+    }
+    values_.resize(keys.size());
+    for (IndexType ii = 0; static_cast<size_t>(ii) < keys.size(); ++ii) {
+      values_[ii] = ii;
+    }
+    std::stable_sort(values_.begin(), values_.end(),
+                     [&keys](ValueType a, ValueType b) {
+                       return keys[a] < keys[b];
+                     });
+    sorted_keys_.resize(keys.size());
+    for (size_t ii = 0; ii < keys.size(); ++ii) {
+      sorted_keys_[ii] = keys[values_[ii]];
+    }
+
+    num_index_bits_ = 0;
+    while (num_index_bits_ < num_bits_ && num_index_bits_ < kMaxIndexBits &&
+           (uint64_t(1) << (num_index_bits_ + 1)) <= keys.size()) {
+      num_index_bits_ += 1;
+    }
+    uint64_t index_size = uint64_t(1) << num_index_bits_;
+    prefix_index_.resize(index_size + 1);
+    IndexType cur = 0;
+    for (uint64_t prefix = 0; prefix < index_size; ++prefix) {
+      prefix_index_[prefix] = cur;
+      while (static_cast<size_t>(cur) < sorted_keys_.size() &&
+             index_prefix(sorted_keys_[cur]) == prefix) {
+        ++cur;
+      }
+    }
+    prefix_index_[index_size] = cur;
+  }
+
+  std::pair<Iterator, Iterator> retrieve(const KeyType& key) const {
+    return retrieve_prefix(key, num_bits_);
+  }
+
+  // All entries whose keys agree with key in the first prefix_length bits
+  // (all entries for prefix_length 0). The range for a prefix contains the
+  // ranges of its extensions.
+  std::pair<Iterator, Iterator> retrieve_prefix(
+      const KeyType& key, int_fast32_t prefix_length) const {
+    if (prefix_length < 0 || prefix_length > num_bits_) {
+      throw PrefixHashTableError("Prefix length out of range.");
+    }
+    KeyType low_mask = low_bits(~KeyType(0), num_bits_ - prefix_length);
+    KeyType first_key = key & ~low_mask;
+    KeyType last_key = first_key | low_mask;
+
+    const ValueType* values = values_.data();
+    uint64_t first_prefix = index_prefix(first_key);
+    uint64_t last_prefix = index_prefix(last_key);
+    if (prefix_length <= num_index_bits_) {
+      return std::make_pair(values + prefix_index_[first_prefix],
+                            values + prefix_index_[last_prefix + 1]);
+    }
+    // The key range lies within a single prefix of the index.
+    auto begin = sorted_keys_.begin() + prefix_index_[first_prefix];
+    auto end = sorted_keys_.begin() + prefix_index_[first_prefix + 1];
+    auto first = std::lower_bound(begin, end, first_key);
+    auto last = std::upper_bound(first, end, last_key);
+    return std::make_pair(values + (first - sorted_keys_.begin()),
+                          values + (last - sorted_keys_.begin()));
+  }
+
+  int_fast32_t get_num_bits() const { return num_bits_; }
+
+  void serialize(FILE* output) { ir::serialize(output, get_data()); }
+
+  void serialize(const std::string& file_name) {
+    ir::serialize(file_name, get_data());
+  }
+
+ private:
+  static const int_fast32_t kMaxIndexBits = 30;
+
+  int_fast32_t num_bits_;
+  int_fast32_t num_index_bits_ = 0;
+  bool entries_added_ = false;
+  // the values (point indices) sorted by key, and the sorted keys
+  std::vector<ValueType> values_;
+  std::vector<KeyType> sorted_keys_;
+  // start of the entries with each value of the first num_index_bits_ bits
+  std::vector<IndexType> prefix_index_;
+
+  // The last num_low_bits bits of key.
+  static KeyType low_bits(KeyType key, int_fast32_t num_low_bits) {
+    if (num_low_bits >= static_cast<int_fast32_t>(8 * sizeof(KeyType))) {
+      return key;
+    }
+    return key & ((KeyType(1) << num_low_bits) - 1);
+  }
+
+  uint64_t index_prefix(KeyType key) const {
+    if (num_index_bits_ == 0) {
+      return 0;
+    }
+    return static_cast<uint64_t>(key >> (num_bits_ - num_index_bits_));
+  }
+
+  std::vector<KeyType> get_data() {
+    std::vector<KeyType> data(values_.size());
+    for (size_t ii = 0; ii < values_.size(); ++ii) {
+      data[values_[ii]] = sorted_keys_[ii];
+    }
+    return data;
+  }
+};
+
+}  // namespace core
+}  // namespace falconn
+
+#endif
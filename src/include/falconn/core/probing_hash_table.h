@@ -136,7 +136,7 @@ class StaticLinearProbingHashTable {
  private:
   // TODO: make the hash function a template argument
   IndexType hash(const KeyType& key) const {
-    return (static_cast<uint_fast64_t>(key) * kLargePrime) % table_size_;
+    return (hash_table_helpers::fold_key(key) * kLargePrime) % table_size_;
   }
 
   IndexType find_free_entry(const KeyType& key) const {
@@ -442,7 +442,7 @@ class DynamicLinearProbingHashTable {
   IndexType hash(const KeyType& key) const { return hash(key, table_.size()); }
 
   IndexType hash(const KeyType& key, uint_fast64_t table_size) const {
-    return (static_cast<uint_fast64_t>(key) * kLargePrime) % table_size;
+    return (hash_table_helpers::fold_key(key) * kLargePrime) % table_size;
   }
 
   enum EntryState {
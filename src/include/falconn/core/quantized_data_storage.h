@@ -0,0 +1,562 @@
+#ifndef __QUANTIZED_DATA_STORAGE_H__
+#define __QUANTIZED_DATA_STORAGE_H__
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#if defined(__AVX2__) || defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+#include "../falconn_global.h"
+#include "data_storage.h"
+#include "prefetchers.h"
+
+namespace falconn {
+namespace core {
+
+// Data storage classes that keep a compressed copy of dense points. Candidate
+// scoring in NearestNeighborQuery is usually bound by memory traffic, so
+// reading one byte (int8) or two bytes (half precision) per coordinate instead
+// of four makes the distance computations correspondingly cheaper. The
+// distances computed on the compressed points are approximate; use
+// RerankingNearestNeighborQuery (see nn_query.h) to re-rank the best
+// candidates with the full-precision points.
+
+// A point quantized to one signed byte per coordinate. Coordinate ii is
+// approximated by offsets[ii] + scales[ii] * codes[ii].
+template <typename CoordinateType>
+struct Int8QuantizedPoint {
+  const int8_t* codes;
+  const CoordinateType* scales;
+  const CoordinateType* offsets;
+  int_fast64_t dim;
+};
+
+// A point stored in IEEE 754 half precision (binary16).
+struct HalfPrecisionPoint {
+  const uint16_t* data;
+  int_fast64_t dim;
+};
+
+namespace quantization_helpers {
+
+inline float half_to_float(uint16_t h) {
+#ifdef __F16C__
+  return _cvtsh_ss(h);
+#else
+  uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+  uint32_t exponent = (h >> 10) & 0x1f;
+  uint32_t mantissa = h & 0x3ff;
+  uint32_t bits;
+  if (exponent == 0) {
+    if (mantissa == 0) {
+      bits = sign;
+    } else {
+      // subnormal half, normalize it
+      exponent = 127 - 15 + 1;
+      while ((mantissa & 0x400) == 0) {
+        mantissa <<= 1;
+        exponent -= 1;
+      }
+      mantissa &= 0x3ff;
+      bits = sign | (exponent << 23) | (mantissa << 13);
+    }
+  } else if (exponent == 0x1f) {
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  } else {
+    bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+  }
+  float res;
+  std::memcpy(&res, &bits, sizeof(res));
+  return res;
+#endif
+}
+
+inline uint16_t float_to_half(float f) {
+#ifdef __F16C__
+  return _cvtss_sh(f, 0);
+#else
+  uint32_t bits;
+  std::memcpy(&bits, &f, sizeof(bits));
+  uint16_t sign = (bits >> 16) & 0x8000;
+  int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xff) - 127 + 15;
+  uint32_t mantissa = bits & 0x7fffff;
+  if (((bits >> 23) & 0xff) == 0xff) {
+    // infinity or NaN
+    return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+  }
+  if (exponent >= 0x1f) {
+    return sign | 0x7c00;
+  }
+  if (exponent <= 0) {
+    if (exponent < -10) {
+      return sign;
+    }
+    // subnormal half
+    mantissa |= 0x800000;
+    int32_t shift = 14 - exponent;
+    uint32_t half_mantissa = mantissa >> shift;
+    uint32_t remainder = mantissa & ((1u << shift) - 1);
+    uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half_mantissa & 1))) {
+      half_mantissa += 1;
+    }
+    return sign | static_cast<uint16_t>(half_mantissa);
+  }
+  uint32_t res = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+  uint32_t remainder = mantissa & 0x1fff;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (res & 1))) {
+    // may carry into the exponent, which is the correct rounding
+    res += 1;
+  }
+  return sign | static_cast<uint16_t>(res);
+#endif
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+inline float horizontal_sum(__m256 v) {
+  __m128 lo = _mm256_castps256_ps128(v);
+  __m128 hi = _mm256_extractf128_ps(v, 1);
+  lo = _mm_add_ps(lo, hi);
+  lo = _mm_hadd_ps(lo, lo);
+  lo = _mm_hadd_ps(lo, lo);
+  return _mm_cvtss_f32(lo);
+}
+
+inline __m256 load_int8_as_float(const int8_t* p) {
+  __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+  return _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(bytes));
+}
+#endif
+
+// Inner product between a dense float vector and an int8 quantized point.
+template <typename CoordinateType>
+CoordinateType dot_int8(const CoordinateType* q,
+                        const Int8QuantizedPoint<CoordinateType>& p) {
+  CoordinateType res = 0.0;
+  for (int_fast64_t ii = 0; ii < p.dim; ++ii) {
+    res += q[ii] * (p.offsets[ii] + p.scales[ii] * p.codes[ii]);
+  }
+  return res;
+}
+
+// Squared Euclidean distance between a dense float vector and an int8
+// quantized point.
+template <typename CoordinateType>
+CoordinateType squared_distance_int8(
+    const CoordinateType* q, const Int8QuantizedPoint<CoordinateType>& p) {
+  CoordinateType res = 0.0;
+  for (int_fast64_t ii = 0; ii < p.dim; ++ii) {
+    CoordinateType x = q[ii] - (p.offsets[ii] + p.scales[ii] * p.codes[ii]);
+    res += x * x;
+  }
+  return res;
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+template <>
+inline float dot_int8<float>(const float* q,
+                             const Int8QuantizedPoint<float>& p) {
+  __m256 acc = _mm256_setzero_ps();
+  int_fast64_t ii = 0;
+  for (; ii + 8 <= p.dim; ii += 8) {
+    __m256 x = _mm256_fmadd_ps(load_int8_as_float(p.codes + ii),
+                               _mm256_loadu_ps(p.scales + ii),
+                               _mm256_loadu_ps(p.offsets + ii));
+    acc = _mm256_fmadd_ps(_mm256_loadu_ps(q + ii), x, acc);
+  }
+  float res = horizontal_sum(acc);
+  for (; ii < p.dim; ++ii) {
+    res += q[ii] * (p.offsets[ii] + p.scales[ii] * p.codes[ii]);
+  }
+  return res;
+}
+
+template <>
+inline float squared_distance_int8<float>(const float* q,
+                                          const Int8QuantizedPoint<float>& p) {
+  __m256 acc = _mm256_setzero_ps();
+  int_fast64_t ii = 0;
+  for (; ii + 8 <= p.dim; ii += 8) {
+    __m256 x = _mm256_fmadd_ps(load_int8_as_float(p.codes + ii),
+                               _mm256_loadu_ps(p.scales + ii),
+                               _mm256_loadu_ps(p.offsets + ii));
+    __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(q + ii), x);
+    acc = _mm256_fmadd_ps(diff, diff, acc);
+  }
+  float res = horizontal_sum(acc);
+  for (; ii < p.dim; ++ii) {
+    float x = q[ii] - (p.offsets[ii] + p.scales[ii] * p.codes[ii]);
+    res += x * x;
+  }
+  return res;
+}
+#endif
+
+// Inner product between a dense vector and a half precision point.
+template <typename CoordinateType>
+CoordinateType dot_half(const CoordinateType* q, const HalfPrecisionPoint& p) {
+  CoordinateType res = 0.0;
+  for (int_fast64_t ii = 0; ii < p.dim; ++ii) {
+    res += q[ii] * half_to_float(p.data[ii]);
+  }
+  return res;
+}
+
+// Squared Euclidean distance between a dense vector and a half precision
+// point.
+template <typename CoordinateType>
+CoordinateType squared_distance_half(const CoordinateType* q,
+                                     const HalfPrecisionPoint& p) {
+  CoordinateType res = 0.0;
+  for (int_fast64_t ii = 0; ii < p.dim; ++ii) {
+    CoordinateType x = q[ii] - half_to_float(p.data[ii]);
+    res += x * x;
+  }
+  return res;
+}
+
+#if defined(__AVX2__) && defined(__FMA__) && defined(__F16C__)
+template <>
+inline float dot_half<float>(const float* q, const HalfPrecisionPoint& p) {
+  __m256 acc = _mm256_setzero_ps();
+  int_fast64_t ii = 0;
+  for (; ii + 8 <= p.dim; ii += 8) {
+    __m256 x = _mm256_cvtph_ps(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(p.data + ii)));
+    acc = _mm256_fmadd_ps(_mm256_loadu_ps(q + ii), x, acc);
+  }
+  float res = horizontal_sum(acc);
+  for (; ii < p.dim; ++ii) {
+    res += q[ii] * half_to_float(p.data[ii]);
+  }
+  return res;
+}
+
+template <>
+inline float squared_distance_half<float>(const float* q,
+                                          const HalfPrecisionPoint& p) {
+  __m256 acc = _mm256_setzero_ps();
+  int_fast64_t ii = 0;
+  for (; ii + 8 <= p.dim; ii += 8) {
+    __m256 x = _mm256_cvtph_ps(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(p.data + ii)));
+    __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(q + ii), x);
+    acc = _mm256_fmadd_ps(diff, diff, acc);
+  }
+  float res = horizontal_sum(acc);
+  for (; ii < p.dim; ++ii) {
+    float x = q[ii] - half_to_float(p.data[ii]);
+    res += x * x;
+  }
+  return res;
+}
+#endif
+
+}  // namespace quantization_helpers
+
+class QuantizedDataStorageError : public DataStorageError {
+ public:
+  QuantizedDataStorageError(const char* msg) : DataStorageError(msg) {}
+};
+
+// Common iterator code for the quantized storage classes below. Derived has
+// to provide point_data(index) (the start of the compressed point, used for
+// prefetching) and make_point(index, &point).
+template <typename Derived, typename PointType, typename KeyType>
+class QuantizedDataStorageBase {
+ public:
+  class FullSequenceIterator {
+   public:
+    FullSequenceIterator(const Derived& parent) : parent_(&parent) {
+      if (parent_->size() == 0) {
+        parent_ = nullptr;
+        index_ = -1;
+      } else {
+        index_ = 0;
+        for (int_fast64_t ii = 0; ii < std::min<int_fast64_t>(3, parent_->size());
+             ++ii) {
+          __builtin_prefetch(parent_->point_data(ii), 0, 1);
+        }
+      }
+    }
+
+    FullSequenceIterator() {}
+
+    const PointType& get_point() {
+      parent_->make_point(index_, &tmp_point_);
+      return tmp_point_;
+    }
+
+    const KeyType& get_key() const { return index_; }
+
+    bool is_valid() const { return parent_ != nullptr; }
+
+    void operator++() {
+      if (index_ >= 0 && index_ + 1 < parent_->size()) {
+        index_ += 1;
+        if (index_ + 2 < parent_->size()) {
+          __builtin_prefetch(parent_->point_data(index_ + 2), 0, 1);
+        }
+      } else {
+        if (index_ == -1) {
+          throw DataStorageError("Advancing invalid FullSequenceIterator.");
+        } else {
+          parent_ = nullptr;
+          index_ = -1;
+        }
+      }
+    }
+
+   private:
+    KeyType index_ = -1;
+    const Derived* parent_ = nullptr;
+    PointType tmp_point_;
+  };
+
+  class SubsequenceIterator {
+   public:
+    SubsequenceIterator(const std::vector<KeyType>& keys, const Derived& parent)
+        : keys_(&keys), parent_(&parent) {
+      if (keys_->size() == 0) {
+        keys_ = nullptr;
+        parent_ = nullptr;
+        index_ = -1;
+      } else {
+        index_ = 0;
+        for (int_fast64_t ii = 0;
+             ii < std::min<int_fast64_t>(3, keys_->size()); ++ii) {
+          __builtin_prefetch(parent_->point_data((*keys_)[ii]), 0, 1);
+        }
+      }
+    }
+
+    SubsequenceIterator() {}
+
+    const PointType& get_point() {
+      parent_->make_point((*keys_)[index_], &tmp_point_);
+      return tmp_point_;
+    }
+
+    const KeyType& get_key() const { return (*keys_)[index_]; }
+
+    bool is_valid() const { return parent_ != nullptr; }
+
+    void operator++() {
+      if (index_ >= 0 &&
+          index_ + 1 < static_cast<int_fast64_t>(keys_->size())) {
+        index_ += 1;
+        if (index_ + 2 < static_cast<int_fast64_t>(keys_->size())) {
+          __builtin_prefetch(parent_->point_data((*keys_)[index_ + 2]), 0, 1);
+        }
+      } else {
+        if (index_ == -1) {
+          throw DataStorageError("Advancing invalid SubsequenceIterator.");
+        }
+        keys_ = nullptr;
+        parent_ = nullptr;
+        index_ = -1;
+      }
+    }
+
+   private:
+    int_fast64_t index_ = -1;
+    const std::vector<KeyType>* keys_ = nullptr;
+    const Derived* parent_ = nullptr;
+    PointType tmp_point_;
+  };
+
+  SubsequenceIterator get_subsequence(const std::vector<KeyType>& keys) const {
+    return SubsequenceIterator(keys, *static_cast<const Derived*>(this));
+  }
+
+  FullSequenceIterator get_full_sequence() const {
+    return FullSequenceIterator(*static_cast<const Derived*>(this));
+  }
+};
+
+// Stores every coordinate as a signed byte with a per-dimension scale and
+// offset. The scale and offset are chosen so that the range of each dimension
+// over the data set maps to [-127, 127].
+template <typename CoordinateType = float, typename KeyType = int32_t>
+class Int8QuantizedDataStorage
+    : public QuantizedDataStorageBase<
+          Int8QuantizedDataStorage<CoordinateType, KeyType>,
+          Int8QuantizedPoint<CoordinateType>, KeyType> {
+ public:
+  typedef Int8QuantizedPoint<CoordinateType> PointType;
+
+  // Quantizes all points of a dense data storage (e.g., ArrayDataStorage or
+  // PlainArrayDataStorage). The inner storage is not referenced afterwards.
+  template <typename InnerDataStorage>
+  Int8QuantizedDataStorage(const InnerDataStorage& storage)
+      : num_points_(storage.size()) {
+    typename InnerDataStorage::FullSequenceIterator iter =
+        storage.get_full_sequence();
+    if (!iter.is_valid()) {
+      throw QuantizedDataStorageError("Cannot quantize an empty data set.");
+    }
+    dim_ = iter.get_point().size();
+    std::vector<CoordinateType> min_coord(dim_), max_coord(dim_);
+    for (int_fast64_t jj = 0; jj < dim_; ++jj) {
+      min_coord[jj] = max_coord[jj] = iter.get_point()[jj];
+    }
+    for (; iter.is_valid(); ++iter) {
+      const auto& p = iter.get_point();
+      for (int_fast64_t jj = 0; jj < dim_; ++jj) {
+        min_coord[jj] = std::min(min_coord[jj], p[jj]);
+        max_coord[jj] = std::max(max_coord[jj], p[jj]);
+      }
+    }
+
+    offsets_.resize(dim_);
+    scales_.resize(dim_);
+    for (int_fast64_t jj = 0; jj < dim_; ++jj) {
+      offsets_[jj] = (max_coord[jj] + min_coord[jj]) / 2;
+      scales_[jj] = (max_coord[jj] - min_coord[jj]) / (2 * kMaxCode);
+    }
+
+    codes_.resize(num_points_ * dim_);
+    int_fast64_t cur_point = 0;
+    typename InnerDataStorage::FullSequenceIterator iter2 =
+        storage.get_full_sequence();
+    for (; iter2.is_valid(); ++iter2) {
+      const auto& p = iter2.get_point();
+      int8_t* cur_codes = &(codes_[cur_point * dim_]);
+      for (int_fast64_t jj = 0; jj < dim_; ++jj) {
+        if (scales_[jj] == 0) {
+          cur_codes[jj] = 0;
+        } else {
+          CoordinateType code =
+              std::round((p[jj] - offsets_[jj]) / scales_[jj]);
+          code = std::max<CoordinateType>(-kMaxCode,
+                                          std::min<CoordinateType>(kMaxCode,
+                                                                   code));
+          cur_codes[jj] = static_cast<int8_t>(code);
+        }
+      }
+      cur_point += 1;
+    }
+  }
+
+  int_fast64_t size() const { return num_points_; }
+
+  int_fast64_t dimension() const { return dim_; }
+
+  const int8_t* point_data(int_fast64_t index) const {
+    return &(codes_[index * dim_]);
+  }
+
+  void make_point(int_fast64_t index, PointType* p) const {
+    p->codes = point_data(index);
+    p->scales = scales_.data();
+    p->offsets = offsets_.data();
+    p->dim = dim_;
+  }
+
+ private:
+  static constexpr int kMaxCode = 127;
+
+  int_fast64_t num_points_;
+  int_fast64_t dim_;
+  std::vector<int8_t> codes_;
+  std::vector<CoordinateType> scales_;
+  std::vector<CoordinateType> offsets_;
+};
+
+// Stores every coordinate as an IEEE half precision float. Half precision has
+// an 11-bit significand, which is usually enough to rank candidates correctly
+// for normalized or centered data.
+template <typename KeyType = int32_t>
+class HalfPrecisionDataStorage
+    : public QuantizedDataStorageBase<HalfPrecisionDataStorage<KeyType>,
+                                      HalfPrecisionPoint, KeyType> {
+ public:
+  typedef HalfPrecisionPoint PointType;
+
+  template <typename InnerDataStorage>
+  HalfPrecisionDataStorage(const InnerDataStorage& storage)
+      : num_points_(storage.size()) {
+    typename InnerDataStorage::FullSequenceIterator iter =
+        storage.get_full_sequence();
+    if (!iter.is_valid()) {
+      throw QuantizedDataStorageError("Cannot convert an empty data set.");
+    }
+    dim_ = iter.get_point().size();
+    data_.resize(num_points_ * dim_);
+    int_fast64_t cur_point = 0;
+    for (; iter.is_valid(); ++iter) {
+      const auto& p = iter.get_point();
+      for (int_fast64_t jj = 0; jj < dim_; ++jj) {
+        data_[cur_point * dim_ + jj] =
+            quantization_helpers::float_to_half(static_cast<float>(p[jj]));
+      }
+      cur_point += 1;
+    }
+  }
+
+  int_fast64_t size() const { return num_points_; }
+
+  int_fast64_t dimension() const { return dim_; }
+
+  const uint16_t* point_data(int_fast64_t index) const {
+    return &(data_[index * dim_]);
+  }
+
+  void make_point(int_fast64_t index, PointType* p) const {
+    p->data = point_data(index);
+    p->dim = dim_;
+  }
+
+ private:
+  int_fast64_t num_points_;
+  int_fast64_t dim_;
+  std::vector<uint16_t> data_;
+};
+
+// Distance functions between a dense query (an Eigen vector or map with
+// contiguous storage) and a quantized point. They can be used as the
+// DistanceFunction template argument of NearestNeighborQuery together with the
+// quantized storage classes above.
+
+template <typename CoordinateType = float>
+struct CosineDistanceQuantized {
+  template <typename Derived>
+  CoordinateType operator()(const Eigen::MatrixBase<Derived>& q,
+                            const Int8QuantizedPoint<CoordinateType>& p) {
+    return -quantization_helpers::dot_int8(q.derived().data(), p);
+  }
+
+  template <typename Derived>
+  CoordinateType operator()(const Eigen::MatrixBase<Derived>& q,
+                            const HalfPrecisionPoint& p) {
+    return -quantization_helpers::dot_half(q.derived().data(), p);
+  }
+};
+
+// Computes *SQUARED* Euclidean distances.
+template <typename CoordinateType = float>
+struct EuclideanDistanceQuantized {
+  template <typename Derived>
+  CoordinateType operator()(const Eigen::MatrixBase<Derived>& q,
+                            const Int8QuantizedPoint<CoordinateType>& p) {
+    return quantization_helpers::squared_distance_int8(q.derived().data(), p);
+  }
+
+  template <typename Derived>
+  CoordinateType operator()(const Eigen::MatrixBase<Derived>& q,
+                            const HalfPrecisionPoint& p) {
+    return quantization_helpers::squared_distance_half(q.derived().data(), p);
+  }
+};
+
+}  // namespace core
+}  // namespace falconn
+
+#endif
@@ -7,6 +7,7 @@
 #include <random>
 #include <vector>
 #include "../falconn_global.h"
+#include "cpu_dispatch.h"
 #include "data_storage.h"
 #include "polytope_hash.h"
 
@@ -173,15 +174,9 @@ class RandomProjectionSketches {
       throw SketchesError(
           "worker id is not in the range 0 to num_workers_ - 1");
     }
-    int32_t hamming_distance = 0;
     size_t ind = dataset_point_id * num_chunks_;
-
-    for (int32_t i = 0; i < num_chunks_; ++i) {
-      hamming_distance +=
-          __builtin_popcountll(sketches_[ind] ^ query_sketches_[worker_id][i]);
-      ++ind;
-    }
-    return hamming_distance;
+    return cpu_kernels().hamming_distance(
+        &sketches_[ind], query_sketches_[worker_id].data(), num_chunks_);
   }
 
  private:
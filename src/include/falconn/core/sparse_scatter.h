@@ -0,0 +1,207 @@
+#ifndef __SPARSE_SCATTER_H__
+#define __SPARSE_SCATTER_H__
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace falconn {
+namespace core {
+
+template <typename CoordinateType, typename IndexType>
+class SparseVectorView;
+
+namespace sparse_scatter_helpers {
+
+// Accumulates the inner product <buf, p> and the squared norm of p, where buf
+// is a dense vector with buf_size entries (coordinates of p outside of buf
+// count as zero) and p is a sparse vector given by its nonzeros.
+template <typename CoordinateType, typename IndexType>
+void gather_split(const CoordinateType* buf, int_fast64_t buf_size,
+                  const IndexType* indices, const CoordinateType* values,
+                  int_fast64_t nnz, CoordinateType* dot,
+                  CoordinateType* sqnorm) {
+  CoordinateType d = 0.0;
+  CoordinateType n = 0.0;
+  for (int_fast64_t ii = 0; ii < nnz; ++ii) {
+    CoordinateType v = values[ii];
+    if (indices[ii] < buf_size) {
+      d += buf[indices[ii]] * v;
+    }
+    n += v * v;
+  }
+  *dot = d;
+  *sqnorm = n;
+}
+
+// The same for a sparse vector stored as interleaved (index, value) pairs.
+template <typename CoordinateType, typename IndexType>
+void gather_pairs(const CoordinateType* buf, int_fast64_t buf_size,
+                  const std::pair<IndexType, CoordinateType>* entries,
+                  int_fast64_t nnz, CoordinateType* dot,
+                  CoordinateType* sqnorm) {
+  CoordinateType d = 0.0;
+  CoordinateType n = 0.0;
+  for (int_fast64_t ii = 0; ii < nnz; ++ii) {
+    CoordinateType v = entries[ii].second;
+    if (entries[ii].first < buf_size) {
+      d += buf[entries[ii].first] * v;
+    }
+    n += v * v;
+  }
+  *dot = d;
+  *sqnorm = n;
+}
+
+#ifdef __AVX2__
+inline float horizontal_sum(__m256 v) {
+  __m128 lo = _mm256_castps256_ps128(v);
+  __m128 hi = _mm256_extractf128_ps(v, 1);
+  lo = _mm_add_ps(lo, hi);
+  lo = _mm_hadd_ps(lo, lo);
+  lo = _mm_hadd_ps(lo, lo);
+  return _mm_cvtss_f32(lo);
+}
+
+// Gathers buf[idx] for the eight lanes of idx, with zero for indices that are
+// outside of buf.
+inline __m256 masked_gather(const float* buf, __m256i limit, __m256i idx) {
+  __m256 mask = _mm256_castsi256_ps(_mm256_cmpgt_epi32(limit, idx));
+  return _mm256_mask_i32gather_ps(_mm256_setzero_ps(), buf, idx, mask, 4);
+}
+
+template <>
+inline void gather_split<float, int32_t>(const float* buf,
+                                         int_fast64_t buf_size,
+                                         const int32_t* indices,
+                                         const float* values, int_fast64_t nnz,
+                                         float* dot, float* sqnorm) {
+  __m256i limit = _mm256_set1_epi32(static_cast<int32_t>(
+      std::min<int_fast64_t>(buf_size, INT32_MAX)));
+  __m256 d = _mm256_setzero_ps();
+  __m256 n = _mm256_setzero_ps();
+  int_fast64_t ii = 0;
+  for (; ii + 8 <= nnz; ii += 8) {
+    __m256i idx =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + ii));
+    __m256 v = _mm256_loadu_ps(values + ii);
+    d = _mm256_add_ps(d, _mm256_mul_ps(masked_gather(buf, limit, idx), v));
+    n = _mm256_add_ps(n, _mm256_mul_ps(v, v));
+  }
+  float tail_dot = 0.0;
+  float tail_sqnorm = 0.0;
+  for (; ii < nnz; ++ii) {
+    if (indices[ii] < buf_size) {
+      tail_dot += buf[indices[ii]] * values[ii];
+    }
+    tail_sqnorm += values[ii] * values[ii];
+  }
+  *dot = horizontal_sum(d) + tail_dot;
+  *sqnorm = horizontal_sum(n) + tail_sqnorm;
+}
+
+template <>
+inline void gather_pairs<float, int32_t>(
+    const float* buf, int_fast64_t buf_size,
+    const std::pair<int32_t, float>* entries, int_fast64_t nnz, float* dot,
+    float* sqnorm) {
+  static_assert(sizeof(std::pair<int32_t, float>) == 8,
+                "Unexpected layout of std::pair<int32_t, float>.");
+  __m256i limit = _mm256_set1_epi32(static_cast<int32_t>(
+      std::min<int_fast64_t>(buf_size, INT32_MAX)));
+  __m256 d = _mm256_setzero_ps();
+  __m256 n = _mm256_setzero_ps();
+  const float* raw = reinterpret_cast<const float*>(entries);
+  int_fast64_t ii = 0;
+  for (; ii + 8 <= nnz; ii += 8) {
+    __m256 lo = _mm256_loadu_ps(raw + 2 * ii);
+    __m256 hi = _mm256_loadu_ps(raw + 2 * ii + 8);
+    // De-interleave the pairs. Indices and values end up in the same
+    // (permuted) lane order, which does not matter for the sums.
+    __m256i idx = _mm256_castps_si256(
+        _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+    __m256 v = _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+    d = _mm256_add_ps(d, _mm256_mul_ps(masked_gather(buf, limit, idx), v));
+    n = _mm256_add_ps(n, _mm256_mul_ps(v, v));
+  }
+  float tail_dot = 0.0;
+  float tail_sqnorm = 0.0;
+  for (; ii < nnz; ++ii) {
+    float v = entries[ii].second;
+    if (entries[ii].first < buf_size) {
+      tail_dot += buf[entries[ii].first] * v;
+    }
+    tail_sqnorm += v * v;
+  }
+  *dot = horizontal_sum(d) + tail_dot;
+  *sqnorm = horizontal_sum(n) + tail_sqnorm;
+}
+#endif
+
+}  // namespace sparse_scatter_helpers
+
+// Holds a sparse query scattered into a dense buffer. After load_query(q), the
+// inner product between q and a sparse point p only reads the nonzeros of p
+// (plus one random access into the buffer per nonzero) instead of merging the
+// two sorted index lists. As for the other sparse functions, the indices of q
+// must be sorted and unique. Loading a query only touches the buffer entries
+// of the previous and the current query, so the buffer (which grows to the
+// largest query index seen) is never cleared as a whole.
+template <typename CoordinateType = float, typename IndexType = int32_t>
+class SparseScatterQuery {
+ public:
+  template <typename SparseVectorType>
+  void load_query(const SparseVectorType& q) {
+    for (IndexType index : touched_) {
+      buffer_[index] = 0.0;
+    }
+    touched_.clear();
+    query_sqnorm_ = 0.0;
+    for (int_fast64_t ii = 0; ii < static_cast<int_fast64_t>(q.size()); ++ii) {
+      IndexType index = q[ii].first;
+      if (static_cast<int_fast64_t>(buffer_.size()) <= index) {
+        buffer_.resize(index + 1, 0.0);
+      }
+      buffer_[index] = q[ii].second;
+      query_sqnorm_ += q[ii].second * q[ii].second;
+      touched_.push_back(index);
+    }
+    loaded_query_ = &q;
+  }
+
+  // Returns true if q is the vector passed to the last load_query call.
+  bool is_loaded(const void* q) const { return loaded_query_ == q; }
+
+  CoordinateType query_sqnorm() const { return query_sqnorm_; }
+
+  // Computes the inner product with the loaded query and the squared norm of
+  // p.
+  void gather(const std::vector<std::pair<IndexType, CoordinateType>>& p,
+              CoordinateType* dot, CoordinateType* sqnorm) const {
+    sparse_scatter_helpers::gather_pairs(buffer_.data(), buffer_.size(),
+                                         p.data(), p.size(), dot, sqnorm);
+  }
+
+  void gather(const SparseVectorView<CoordinateType, IndexType>& p,
+              CoordinateType* dot, CoordinateType* sqnorm) const {
+    sparse_scatter_helpers::gather_split(buffer_.data(), buffer_.size(),
+                                         p.indices(), p.values(), p.size(),
+                                         dot, sqnorm);
+  }
+
+ private:
+  std::vector<CoordinateType> buffer_;
+  std::vector<IndexType> touched_;
+  CoordinateType query_sqnorm_ = 0.0;
+  const void* loaded_query_ = nullptr;
+};
+
+}  // namespace core
+}  // namespace falconn
+
+#endif
@@ -1,10 +1,13 @@
 #ifndef __STL_HASH_TABLE_H__
 #define __STL_HASH_TABLE_H__
 
+#include <cstdint>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "hash_table_helpers.h"
+
 namespace falconn {
 namespace core {
 
@@ -21,7 +24,8 @@ class STLHashTable {
 
   class Iterator {
    public:
-    typedef typename std::unordered_multimap<KeyType, ValueType>::iterator
+    typedef typename std::unordered_multimap<
+        KeyType, ValueType, hash_table_helpers::KeyHash>::iterator
         InnerIterator;
     Iterator() {}
 
@@ -55,7 +59,8 @@ class STLHashTable {
   }
 
  private:
-  std::unordered_multimap<KeyType, ValueType> internal_table_;
+  std::unordered_multimap<KeyType, ValueType, hash_table_helpers::KeyHash>
+      internal_table_;
 };
 
 }  // namespace core
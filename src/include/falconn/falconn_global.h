@@ -9,6 +9,16 @@
 
 namespace falconn {
 
+#ifdef __SIZEOF_INT128__
+#define FALCONN_HAVE_UINT128
+///
+/// Unsigned 128-bit integer type for hashes with more than 64 bits (only
+/// available with compilers that support __int128, e.g., GCC and clang on
+/// 64-bit platforms).
+///
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
 ///
 /// Common exception base class
 ///
@@ -172,6 +182,22 @@ struct PlainArrayPointSet {
   int_fast32_t dimension;
 };
 
+///
+/// A struct for wrapping sparse point data stored in the compressed sparse row
+/// (CSR) format, e.g., the arrays of a scipy.sparse.csr_matrix. The non-zero
+/// entries of point ii are indices[jj] / values[jj] for jj in the range
+/// indptr[ii] to indptr[ii + 1] - 1. The indices of each point must be sorted.
+/// The arrays are not copied, so they must stay valid while the table is used.
+///
+template <typename CoordinateType, typename IndexType = int32_t>
+struct CSRPointSet {
+  const int64_t* indptr;
+  const IndexType* indices;
+  const CoordinateType* values;
+  int_fast32_t num_points;
+  int_fast32_t dimension;
+};
+
 }  // namespace falconn
 
 #endif
@@ -1,6 +1,6 @@
 #include "fht.h"
-static inline void helper_float_1(float *buf);
-static inline void helper_float_1(float *buf) {
+FHT_TARGET("avx") static inline void helper_float_avx_1(float *buf);
+FHT_TARGET("avx") static inline void helper_float_avx_1(float *buf) {
   for (int j = 0; j < 2; j += 2) {
     for (int k = 0; k < 1; ++k) {
       float u = buf[j + k];
@@ -10,8 +10,8 @@ static inline void helper_float_1(float *buf) {
     }
   }
 }
-static inline void helper_float_2(float *buf);
-static inline void helper_float_2(float *buf) {
+FHT_TARGET("avx") static inline void helper_float_avx_2(float *buf);
+FHT_TARGET("avx") static inline void helper_float_avx_2(float *buf) {
   for (int j = 0; j < 4; j += 2) {
     for (int k = 0; k < 1; ++k) {
       float u = buf[j + k];
@@ -29,8 +29,8 @@ static inline void helper_float_2(float *buf) {
     }
   }
 }
-static inline void helper_float_3(float *buf);
-static inline void helper_float_3(float *buf) {
+FHT_TARGET("avx") static inline void helper_float_avx_3(float *buf);
+FHT_TARGET("avx") static inline void helper_float_avx_3(float *buf) {
   for (int j = 0; j < 8; j += 8) {
     __asm__ volatile (
       "vmovups (%0), %%ymm0\n"
@@ -55,8 +55,8 @@ static inline void helper_float_3(float *buf) {
     );
   }
 }
-static inline void helper_float_4(float *buf);
-static inline void helper_float_4(float *buf) {
+FHT_TARGET("avx") static inline void helper_float_avx_4(float *buf);
+FHT_TARGET("avx") static inline void helper_float_avx_4(float *buf) {
   for (int j = 0; j < 16; j += 16) {
     for (int k = 0; k < 8; k += 8) {
       __asm__ volatile (
@@ -103,8 +103,8 @@ static inline void helper_float_4(float *buf) {
     }
   }
 }
-static inline void helper_float_5(float *buf);
-static inline void helper_float_5(float *buf) {
+FHT_TARGET("avx") static inline void helper_float_avx_5(float *buf);
+FHT_TARGET("avx") static inline void helper_float_avx_5(float *buf) {
   for (int j = 0; j < 32; j += 32) {
     for (int k = 0; k < 8; k += 8) {
       __asm__ volatile (
@@ -193,8 +193,8 @@ static inline void helper_float_5(float *buf) {
     }
   }
 }
-static inline void helper_float_6(float *buf);
-static inline void helper_float_6(float *buf) {
+FHT_TARGET("avx") static inline void helper_float_avx_6(float *buf);
+FHT_TARGET("avx") static inline void helper_float_avx_6(float *buf) {
   for (int j = 0; j < 64; j += 64) {
     for (int k = 0; k < 8; k += 8) {
       __asm__ volatile (
@@ -371,8 +371,8 @@ static inline void helper_float_6(float *buf) {
     }
   }
 }
-void helper_float_7_recursive(float *buf, int depth);
-void helper_float_7_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_7_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_7_recursive(float *buf, int depth) {
   if (depth == 7) {
     for (int j = 0; j < 128; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -565,12 +565,12 @@ void helper_float_7_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_7(float *buf);
-void helper_float_7(float *buf) {
-  helper_float_7_recursive(buf, 7);
+FHT_TARGET("avx") void helper_float_avx_7(float *buf);
+FHT_TARGET("avx") void helper_float_avx_7(float *buf) {
+  helper_float_avx_7_recursive(buf, 7);
 }
-void helper_float_8_recursive(float *buf, int depth);
-void helper_float_8_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_8_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_8_recursive(float *buf, int depth) {
   if (depth == 6) {
     for (int j = 0; j < 64; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -750,10 +750,10 @@ void helper_float_8_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 8) {
-    helper_float_8_recursive(buf + 0, 6);
-    helper_float_8_recursive(buf + 64, 6);
-    helper_float_8_recursive(buf + 128, 6);
-    helper_float_8_recursive(buf + 192, 6);
+    helper_float_avx_8_recursive(buf + 0, 6);
+    helper_float_avx_8_recursive(buf + 64, 6);
+    helper_float_avx_8_recursive(buf + 128, 6);
+    helper_float_avx_8_recursive(buf + 192, 6);
     for (int j = 0; j < 256; j += 256) {
       for (int k = 0; k < 64; k += 8) {
         __asm__ volatile (
@@ -780,12 +780,12 @@ void helper_float_8_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_8(float *buf);
-void helper_float_8(float *buf) {
-  helper_float_8_recursive(buf, 8);
+FHT_TARGET("avx") void helper_float_avx_8(float *buf);
+FHT_TARGET("avx") void helper_float_avx_8(float *buf) {
+  helper_float_avx_8_recursive(buf, 8);
 }
-static inline void helper_float_9(float *buf);
-static inline void helper_float_9(float *buf) {
+FHT_TARGET("avx") static inline void helper_float_avx_9(float *buf);
+FHT_TARGET("avx") static inline void helper_float_avx_9(float *buf) {
   for (int j = 0; j < 512; j += 64) {
     for (int k = 0; k < 8; k += 8) {
       __asm__ volatile (
@@ -1009,8 +1009,8 @@ static inline void helper_float_9(float *buf) {
     }
   }
 }
-void helper_float_10_recursive(float *buf, int depth);
-void helper_float_10_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_10_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_10_recursive(float *buf, int depth) {
   if (depth == 10) {
     for (int j = 0; j < 1024; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -1250,12 +1250,12 @@ void helper_float_10_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_10(float *buf);
-void helper_float_10(float *buf) {
-  helper_float_10_recursive(buf, 10);
+FHT_TARGET("avx") void helper_float_avx_10(float *buf);
+FHT_TARGET("avx") void helper_float_avx_10(float *buf) {
+  helper_float_avx_10_recursive(buf, 10);
 }
-void helper_float_11_recursive(float *buf, int depth);
-void helper_float_11_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_11_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_11_recursive(float *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -1505,12 +1505,12 @@ void helper_float_11_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_11(float *buf);
-void helper_float_11(float *buf) {
-  helper_float_11_recursive(buf, 11);
+FHT_TARGET("avx") void helper_float_avx_11(float *buf);
+FHT_TARGET("avx") void helper_float_avx_11(float *buf) {
+  helper_float_avx_11_recursive(buf, 11);
 }
-static inline void helper_float_12(float *buf);
-static inline void helper_float_12(float *buf) {
+FHT_TARGET("avx") static inline void helper_float_avx_12(float *buf);
+FHT_TARGET("avx") static inline void helper_float_avx_12(float *buf) {
   for (int j = 0; j < 4096; j += 64) {
     for (int k = 0; k < 8; k += 8) {
       __asm__ volatile (
@@ -1781,8 +1781,8 @@ static inline void helper_float_12(float *buf) {
     }
   }
 }
-void helper_float_13_recursive(float *buf, int depth);
-void helper_float_13_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_13_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_13_recursive(float *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -2032,10 +2032,10 @@ void helper_float_13_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 13) {
-    helper_float_13_recursive(buf + 0, 11);
-    helper_float_13_recursive(buf + 2048, 11);
-    helper_float_13_recursive(buf + 4096, 11);
-    helper_float_13_recursive(buf + 6144, 11);
+    helper_float_avx_13_recursive(buf + 0, 11);
+    helper_float_avx_13_recursive(buf + 2048, 11);
+    helper_float_avx_13_recursive(buf + 4096, 11);
+    helper_float_avx_13_recursive(buf + 6144, 11);
     for (int j = 0; j < 8192; j += 8192) {
       for (int k = 0; k < 2048; k += 8) {
         __asm__ volatile (
@@ -2062,12 +2062,12 @@ void helper_float_13_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_13(float *buf);
-void helper_float_13(float *buf) {
-  helper_float_13_recursive(buf, 13);
+FHT_TARGET("avx") void helper_float_avx_13(float *buf);
+FHT_TARGET("avx") void helper_float_avx_13(float *buf) {
+  helper_float_avx_13_recursive(buf, 13);
 }
-void helper_float_14_recursive(float *buf, int depth);
-void helper_float_14_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_14_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_14_recursive(float *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -2341,10 +2341,10 @@ void helper_float_14_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_float_14_recursive(buf + 0, 12);
-    helper_float_14_recursive(buf + 4096, 12);
-    helper_float_14_recursive(buf + 8192, 12);
-    helper_float_14_recursive(buf + 12288, 12);
+    helper_float_avx_14_recursive(buf + 0, 12);
+    helper_float_avx_14_recursive(buf + 4096, 12);
+    helper_float_avx_14_recursive(buf + 8192, 12);
+    helper_float_avx_14_recursive(buf + 12288, 12);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 4096; k += 8) {
         __asm__ volatile (
@@ -2371,12 +2371,12 @@ void helper_float_14_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_14(float *buf);
-void helper_float_14(float *buf) {
-  helper_float_14_recursive(buf, 14);
+FHT_TARGET("avx") void helper_float_avx_14(float *buf);
+FHT_TARGET("avx") void helper_float_avx_14(float *buf) {
+  helper_float_avx_14_recursive(buf, 14);
 }
-void helper_float_15_recursive(float *buf, int depth);
-void helper_float_15_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_15_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_15_recursive(float *buf, int depth) {
   if (depth == 13) {
     for (int j = 0; j < 8192; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -2663,10 +2663,10 @@ void helper_float_15_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_float_15_recursive(buf + 0, 13);
-    helper_float_15_recursive(buf + 8192, 13);
-    helper_float_15_recursive(buf + 16384, 13);
-    helper_float_15_recursive(buf + 24576, 13);
+    helper_float_avx_15_recursive(buf + 0, 13);
+    helper_float_avx_15_recursive(buf + 8192, 13);
+    helper_float_avx_15_recursive(buf + 16384, 13);
+    helper_float_avx_15_recursive(buf + 24576, 13);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 8192; k += 8) {
         __asm__ volatile (
@@ -2693,12 +2693,12 @@ void helper_float_15_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_15(float *buf);
-void helper_float_15(float *buf) {
-  helper_float_15_recursive(buf, 15);
+FHT_TARGET("avx") void helper_float_avx_15(float *buf);
+FHT_TARGET("avx") void helper_float_avx_15(float *buf) {
+  helper_float_avx_15_recursive(buf, 15);
 }
-void helper_float_16_recursive(float *buf, int depth);
-void helper_float_16_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_16_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_16_recursive(float *buf, int depth) {
   if (depth == 13) {
     for (int j = 0; j < 8192; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -2985,14 +2985,14 @@ void helper_float_16_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 16) {
-    helper_float_16_recursive(buf + 0, 13);
-    helper_float_16_recursive(buf + 8192, 13);
-    helper_float_16_recursive(buf + 16384, 13);
-    helper_float_16_recursive(buf + 24576, 13);
-    helper_float_16_recursive(buf + 32768, 13);
-    helper_float_16_recursive(buf + 40960, 13);
-    helper_float_16_recursive(buf + 49152, 13);
-    helper_float_16_recursive(buf + 57344, 13);
+    helper_float_avx_16_recursive(buf + 0, 13);
+    helper_float_avx_16_recursive(buf + 8192, 13);
+    helper_float_avx_16_recursive(buf + 16384, 13);
+    helper_float_avx_16_recursive(buf + 24576, 13);
+    helper_float_avx_16_recursive(buf + 32768, 13);
+    helper_float_avx_16_recursive(buf + 40960, 13);
+    helper_float_avx_16_recursive(buf + 49152, 13);
+    helper_float_avx_16_recursive(buf + 57344, 13);
     for (int j = 0; j < 65536; j += 65536) {
       for (int k = 0; k < 8192; k += 8) {
         __asm__ volatile (
@@ -3043,12 +3043,12 @@ void helper_float_16_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_16(float *buf);
-void helper_float_16(float *buf) {
-  helper_float_16_recursive(buf, 16);
+FHT_TARGET("avx") void helper_float_avx_16(float *buf);
+FHT_TARGET("avx") void helper_float_avx_16(float *buf) {
+  helper_float_avx_16_recursive(buf, 16);
 }
-void helper_float_17_recursive(float *buf, int depth);
-void helper_float_17_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_17_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_17_recursive(float *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -3322,14 +3322,14 @@ void helper_float_17_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_float_17_recursive(buf + 0, 12);
-    helper_float_17_recursive(buf + 4096, 12);
-    helper_float_17_recursive(buf + 8192, 12);
-    helper_float_17_recursive(buf + 12288, 12);
-    helper_float_17_recursive(buf + 16384, 12);
-    helper_float_17_recursive(buf + 20480, 12);
-    helper_float_17_recursive(buf + 24576, 12);
-    helper_float_17_recursive(buf + 28672, 12);
+    helper_float_avx_17_recursive(buf + 0, 12);
+    helper_float_avx_17_recursive(buf + 4096, 12);
+    helper_float_avx_17_recursive(buf + 8192, 12);
+    helper_float_avx_17_recursive(buf + 12288, 12);
+    helper_float_avx_17_recursive(buf + 16384, 12);
+    helper_float_avx_17_recursive(buf + 20480, 12);
+    helper_float_avx_17_recursive(buf + 24576, 12);
+    helper_float_avx_17_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 8) {
         __asm__ volatile (
@@ -3380,10 +3380,10 @@ void helper_float_17_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_float_17_recursive(buf + 0, 15);
-    helper_float_17_recursive(buf + 32768, 15);
-    helper_float_17_recursive(buf + 65536, 15);
-    helper_float_17_recursive(buf + 98304, 15);
+    helper_float_avx_17_recursive(buf + 0, 15);
+    helper_float_avx_17_recursive(buf + 32768, 15);
+    helper_float_avx_17_recursive(buf + 65536, 15);
+    helper_float_avx_17_recursive(buf + 98304, 15);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 32768; k += 8) {
         __asm__ volatile (
@@ -3410,12 +3410,12 @@ void helper_float_17_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_17(float *buf);
-void helper_float_17(float *buf) {
-  helper_float_17_recursive(buf, 17);
+FHT_TARGET("avx") void helper_float_avx_17(float *buf);
+FHT_TARGET("avx") void helper_float_avx_17(float *buf) {
+  helper_float_avx_17_recursive(buf, 17);
 }
-void helper_float_18_recursive(float *buf, int depth);
-void helper_float_18_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_18_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_18_recursive(float *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -3689,14 +3689,14 @@ void helper_float_18_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_float_18_recursive(buf + 0, 12);
-    helper_float_18_recursive(buf + 4096, 12);
-    helper_float_18_recursive(buf + 8192, 12);
-    helper_float_18_recursive(buf + 12288, 12);
-    helper_float_18_recursive(buf + 16384, 12);
-    helper_float_18_recursive(buf + 20480, 12);
-    helper_float_18_recursive(buf + 24576, 12);
-    helper_float_18_recursive(buf + 28672, 12);
+    helper_float_avx_18_recursive(buf + 0, 12);
+    helper_float_avx_18_recursive(buf + 4096, 12);
+    helper_float_avx_18_recursive(buf + 8192, 12);
+    helper_float_avx_18_recursive(buf + 12288, 12);
+    helper_float_avx_18_recursive(buf + 16384, 12);
+    helper_float_avx_18_recursive(buf + 20480, 12);
+    helper_float_avx_18_recursive(buf + 24576, 12);
+    helper_float_avx_18_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 8) {
         __asm__ volatile (
@@ -3747,14 +3747,14 @@ void helper_float_18_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_float_18_recursive(buf + 0, 15);
-    helper_float_18_recursive(buf + 32768, 15);
-    helper_float_18_recursive(buf + 65536, 15);
-    helper_float_18_recursive(buf + 98304, 15);
-    helper_float_18_recursive(buf + 131072, 15);
-    helper_float_18_recursive(buf + 163840, 15);
-    helper_float_18_recursive(buf + 196608, 15);
-    helper_float_18_recursive(buf + 229376, 15);
+    helper_float_avx_18_recursive(buf + 0, 15);
+    helper_float_avx_18_recursive(buf + 32768, 15);
+    helper_float_avx_18_recursive(buf + 65536, 15);
+    helper_float_avx_18_recursive(buf + 98304, 15);
+    helper_float_avx_18_recursive(buf + 131072, 15);
+    helper_float_avx_18_recursive(buf + 163840, 15);
+    helper_float_avx_18_recursive(buf + 196608, 15);
+    helper_float_avx_18_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 8) {
         __asm__ volatile (
@@ -3805,12 +3805,12 @@ void helper_float_18_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_18(float *buf);
-void helper_float_18(float *buf) {
-  helper_float_18_recursive(buf, 18);
+FHT_TARGET("avx") void helper_float_avx_18(float *buf);
+FHT_TARGET("avx") void helper_float_avx_18(float *buf) {
+  helper_float_avx_18_recursive(buf, 18);
 }
-void helper_float_19_recursive(float *buf, int depth);
-void helper_float_19_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_19_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_19_recursive(float *buf, int depth) {
   if (depth == 13) {
     for (int j = 0; j < 8192; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -4097,14 +4097,14 @@ void helper_float_19_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 16) {
-    helper_float_19_recursive(buf + 0, 13);
-    helper_float_19_recursive(buf + 8192, 13);
-    helper_float_19_recursive(buf + 16384, 13);
-    helper_float_19_recursive(buf + 24576, 13);
-    helper_float_19_recursive(buf + 32768, 13);
-    helper_float_19_recursive(buf + 40960, 13);
-    helper_float_19_recursive(buf + 49152, 13);
-    helper_float_19_recursive(buf + 57344, 13);
+    helper_float_avx_19_recursive(buf + 0, 13);
+    helper_float_avx_19_recursive(buf + 8192, 13);
+    helper_float_avx_19_recursive(buf + 16384, 13);
+    helper_float_avx_19_recursive(buf + 24576, 13);
+    helper_float_avx_19_recursive(buf + 32768, 13);
+    helper_float_avx_19_recursive(buf + 40960, 13);
+    helper_float_avx_19_recursive(buf + 49152, 13);
+    helper_float_avx_19_recursive(buf + 57344, 13);
     for (int j = 0; j < 65536; j += 65536) {
       for (int k = 0; k < 8192; k += 8) {
         __asm__ volatile (
@@ -4155,14 +4155,14 @@ void helper_float_19_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 19) {
-    helper_float_19_recursive(buf + 0, 16);
-    helper_float_19_recursive(buf + 65536, 16);
-    helper_float_19_recursive(buf + 131072, 16);
-    helper_float_19_recursive(buf + 196608, 16);
-    helper_float_19_recursive(buf + 262144, 16);
-    helper_float_19_recursive(buf + 327680, 16);
-    helper_float_19_recursive(buf + 393216, 16);
-    helper_float_19_recursive(buf + 458752, 16);
+    helper_float_avx_19_recursive(buf + 0, 16);
+    helper_float_avx_19_recursive(buf + 65536, 16);
+    helper_float_avx_19_recursive(buf + 131072, 16);
+    helper_float_avx_19_recursive(buf + 196608, 16);
+    helper_float_avx_19_recursive(buf + 262144, 16);
+    helper_float_avx_19_recursive(buf + 327680, 16);
+    helper_float_avx_19_recursive(buf + 393216, 16);
+    helper_float_avx_19_recursive(buf + 458752, 16);
     for (int j = 0; j < 524288; j += 524288) {
       for (int k = 0; k < 65536; k += 8) {
         __asm__ volatile (
@@ -4213,12 +4213,12 @@ void helper_float_19_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_19(float *buf);
-void helper_float_19(float *buf) {
-  helper_float_19_recursive(buf, 19);
+FHT_TARGET("avx") void helper_float_avx_19(float *buf);
+FHT_TARGET("avx") void helper_float_avx_19(float *buf) {
+  helper_float_avx_19_recursive(buf, 19);
 }
-void helper_float_20_recursive(float *buf, int depth);
-void helper_float_20_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_20_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_20_recursive(float *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -4492,14 +4492,14 @@ void helper_float_20_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_float_20_recursive(buf + 0, 12);
-    helper_float_20_recursive(buf + 4096, 12);
-    helper_float_20_recursive(buf + 8192, 12);
-    helper_float_20_recursive(buf + 12288, 12);
-    helper_float_20_recursive(buf + 16384, 12);
-    helper_float_20_recursive(buf + 20480, 12);
-    helper_float_20_recursive(buf + 24576, 12);
-    helper_float_20_recursive(buf + 28672, 12);
+    helper_float_avx_20_recursive(buf + 0, 12);
+    helper_float_avx_20_recursive(buf + 4096, 12);
+    helper_float_avx_20_recursive(buf + 8192, 12);
+    helper_float_avx_20_recursive(buf + 12288, 12);
+    helper_float_avx_20_recursive(buf + 16384, 12);
+    helper_float_avx_20_recursive(buf + 20480, 12);
+    helper_float_avx_20_recursive(buf + 24576, 12);
+    helper_float_avx_20_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 8) {
         __asm__ volatile (
@@ -4550,14 +4550,14 @@ void helper_float_20_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_float_20_recursive(buf + 0, 15);
-    helper_float_20_recursive(buf + 32768, 15);
-    helper_float_20_recursive(buf + 65536, 15);
-    helper_float_20_recursive(buf + 98304, 15);
-    helper_float_20_recursive(buf + 131072, 15);
-    helper_float_20_recursive(buf + 163840, 15);
-    helper_float_20_recursive(buf + 196608, 15);
-    helper_float_20_recursive(buf + 229376, 15);
+    helper_float_avx_20_recursive(buf + 0, 15);
+    helper_float_avx_20_recursive(buf + 32768, 15);
+    helper_float_avx_20_recursive(buf + 65536, 15);
+    helper_float_avx_20_recursive(buf + 98304, 15);
+    helper_float_avx_20_recursive(buf + 131072, 15);
+    helper_float_avx_20_recursive(buf + 163840, 15);
+    helper_float_avx_20_recursive(buf + 196608, 15);
+    helper_float_avx_20_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 8) {
         __asm__ volatile (
@@ -4608,10 +4608,10 @@ void helper_float_20_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_float_20_recursive(buf + 0, 18);
-    helper_float_20_recursive(buf + 262144, 18);
-    helper_float_20_recursive(buf + 524288, 18);
-    helper_float_20_recursive(buf + 786432, 18);
+    helper_float_avx_20_recursive(buf + 0, 18);
+    helper_float_avx_20_recursive(buf + 262144, 18);
+    helper_float_avx_20_recursive(buf + 524288, 18);
+    helper_float_avx_20_recursive(buf + 786432, 18);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 262144; k += 8) {
         __asm__ volatile (
@@ -4638,12 +4638,12 @@ void helper_float_20_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_20(float *buf);
-void helper_float_20(float *buf) {
-  helper_float_20_recursive(buf, 20);
+FHT_TARGET("avx") void helper_float_avx_20(float *buf);
+FHT_TARGET("avx") void helper_float_avx_20(float *buf) {
+  helper_float_avx_20_recursive(buf, 20);
 }
-void helper_float_21_recursive(float *buf, int depth);
-void helper_float_21_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_21_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_21_recursive(float *buf, int depth) {
   if (depth == 9) {
     for (int j = 0; j < 512; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -4870,14 +4870,14 @@ void helper_float_21_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 12) {
-    helper_float_21_recursive(buf + 0, 9);
-    helper_float_21_recursive(buf + 512, 9);
-    helper_float_21_recursive(buf + 1024, 9);
-    helper_float_21_recursive(buf + 1536, 9);
-    helper_float_21_recursive(buf + 2048, 9);
-    helper_float_21_recursive(buf + 2560, 9);
-    helper_float_21_recursive(buf + 3072, 9);
-    helper_float_21_recursive(buf + 3584, 9);
+    helper_float_avx_21_recursive(buf + 0, 9);
+    helper_float_avx_21_recursive(buf + 512, 9);
+    helper_float_avx_21_recursive(buf + 1024, 9);
+    helper_float_avx_21_recursive(buf + 1536, 9);
+    helper_float_avx_21_recursive(buf + 2048, 9);
+    helper_float_avx_21_recursive(buf + 2560, 9);
+    helper_float_avx_21_recursive(buf + 3072, 9);
+    helper_float_avx_21_recursive(buf + 3584, 9);
     for (int j = 0; j < 4096; j += 4096) {
       for (int k = 0; k < 512; k += 8) {
         __asm__ volatile (
@@ -4928,14 +4928,14 @@ void helper_float_21_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_float_21_recursive(buf + 0, 12);
-    helper_float_21_recursive(buf + 4096, 12);
-    helper_float_21_recursive(buf + 8192, 12);
-    helper_float_21_recursive(buf + 12288, 12);
-    helper_float_21_recursive(buf + 16384, 12);
-    helper_float_21_recursive(buf + 20480, 12);
-    helper_float_21_recursive(buf + 24576, 12);
-    helper_float_21_recursive(buf + 28672, 12);
+    helper_float_avx_21_recursive(buf + 0, 12);
+    helper_float_avx_21_recursive(buf + 4096, 12);
+    helper_float_avx_21_recursive(buf + 8192, 12);
+    helper_float_avx_21_recursive(buf + 12288, 12);
+    helper_float_avx_21_recursive(buf + 16384, 12);
+    helper_float_avx_21_recursive(buf + 20480, 12);
+    helper_float_avx_21_recursive(buf + 24576, 12);
+    helper_float_avx_21_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 8) {
         __asm__ volatile (
@@ -4986,14 +4986,14 @@ void helper_float_21_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_float_21_recursive(buf + 0, 15);
-    helper_float_21_recursive(buf + 32768, 15);
-    helper_float_21_recursive(buf + 65536, 15);
-    helper_float_21_recursive(buf + 98304, 15);
-    helper_float_21_recursive(buf + 131072, 15);
-    helper_float_21_recursive(buf + 163840, 15);
-    helper_float_21_recursive(buf + 196608, 15);
-    helper_float_21_recursive(buf + 229376, 15);
+    helper_float_avx_21_recursive(buf + 0, 15);
+    helper_float_avx_21_recursive(buf + 32768, 15);
+    helper_float_avx_21_recursive(buf + 65536, 15);
+    helper_float_avx_21_recursive(buf + 98304, 15);
+    helper_float_avx_21_recursive(buf + 131072, 15);
+    helper_float_avx_21_recursive(buf + 163840, 15);
+    helper_float_avx_21_recursive(buf + 196608, 15);
+    helper_float_avx_21_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 8) {
         __asm__ volatile (
@@ -5044,14 +5044,14 @@ void helper_float_21_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_float_21_recursive(buf + 0, 18);
-    helper_float_21_recursive(buf + 262144, 18);
-    helper_float_21_recursive(buf + 524288, 18);
-    helper_float_21_recursive(buf + 786432, 18);
-    helper_float_21_recursive(buf + 1048576, 18);
-    helper_float_21_recursive(buf + 1310720, 18);
-    helper_float_21_recursive(buf + 1572864, 18);
-    helper_float_21_recursive(buf + 1835008, 18);
+    helper_float_avx_21_recursive(buf + 0, 18);
+    helper_float_avx_21_recursive(buf + 262144, 18);
+    helper_float_avx_21_recursive(buf + 524288, 18);
+    helper_float_avx_21_recursive(buf + 786432, 18);
+    helper_float_avx_21_recursive(buf + 1048576, 18);
+    helper_float_avx_21_recursive(buf + 1310720, 18);
+    helper_float_avx_21_recursive(buf + 1572864, 18);
+    helper_float_avx_21_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 8) {
         __asm__ volatile (
@@ -5102,12 +5102,12 @@ void helper_float_21_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_21(float *buf);
-void helper_float_21(float *buf) {
-  helper_float_21_recursive(buf, 21);
+FHT_TARGET("avx") void helper_float_avx_21(float *buf);
+FHT_TARGET("avx") void helper_float_avx_21(float *buf) {
+  helper_float_avx_21_recursive(buf, 21);
 }
-void helper_float_22_recursive(float *buf, int depth);
-void helper_float_22_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_22_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_22_recursive(float *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -5357,14 +5357,14 @@ void helper_float_22_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_float_22_recursive(buf + 0, 11);
-    helper_float_22_recursive(buf + 2048, 11);
-    helper_float_22_recursive(buf + 4096, 11);
-    helper_float_22_recursive(buf + 6144, 11);
-    helper_float_22_recursive(buf + 8192, 11);
-    helper_float_22_recursive(buf + 10240, 11);
-    helper_float_22_recursive(buf + 12288, 11);
-    helper_float_22_recursive(buf + 14336, 11);
+    helper_float_avx_22_recursive(buf + 0, 11);
+    helper_float_avx_22_recursive(buf + 2048, 11);
+    helper_float_avx_22_recursive(buf + 4096, 11);
+    helper_float_avx_22_recursive(buf + 6144, 11);
+    helper_float_avx_22_recursive(buf + 8192, 11);
+    helper_float_avx_22_recursive(buf + 10240, 11);
+    helper_float_avx_22_recursive(buf + 12288, 11);
+    helper_float_avx_22_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 8) {
         __asm__ volatile (
@@ -5415,14 +5415,14 @@ void helper_float_22_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_float_22_recursive(buf + 0, 14);
-    helper_float_22_recursive(buf + 16384, 14);
-    helper_float_22_recursive(buf + 32768, 14);
-    helper_float_22_recursive(buf + 49152, 14);
-    helper_float_22_recursive(buf + 65536, 14);
-    helper_float_22_recursive(buf + 81920, 14);
-    helper_float_22_recursive(buf + 98304, 14);
-    helper_float_22_recursive(buf + 114688, 14);
+    helper_float_avx_22_recursive(buf + 0, 14);
+    helper_float_avx_22_recursive(buf + 16384, 14);
+    helper_float_avx_22_recursive(buf + 32768, 14);
+    helper_float_avx_22_recursive(buf + 49152, 14);
+    helper_float_avx_22_recursive(buf + 65536, 14);
+    helper_float_avx_22_recursive(buf + 81920, 14);
+    helper_float_avx_22_recursive(buf + 98304, 14);
+    helper_float_avx_22_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 8) {
         __asm__ volatile (
@@ -5473,14 +5473,14 @@ void helper_float_22_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_float_22_recursive(buf + 0, 17);
-    helper_float_22_recursive(buf + 131072, 17);
-    helper_float_22_recursive(buf + 262144, 17);
-    helper_float_22_recursive(buf + 393216, 17);
-    helper_float_22_recursive(buf + 524288, 17);
-    helper_float_22_recursive(buf + 655360, 17);
-    helper_float_22_recursive(buf + 786432, 17);
-    helper_float_22_recursive(buf + 917504, 17);
+    helper_float_avx_22_recursive(buf + 0, 17);
+    helper_float_avx_22_recursive(buf + 131072, 17);
+    helper_float_avx_22_recursive(buf + 262144, 17);
+    helper_float_avx_22_recursive(buf + 393216, 17);
+    helper_float_avx_22_recursive(buf + 524288, 17);
+    helper_float_avx_22_recursive(buf + 655360, 17);
+    helper_float_avx_22_recursive(buf + 786432, 17);
+    helper_float_avx_22_recursive(buf + 917504, 17);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 131072; k += 8) {
         __asm__ volatile (
@@ -5531,10 +5531,10 @@ void helper_float_22_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 22) {
-    helper_float_22_recursive(buf + 0, 20);
-    helper_float_22_recursive(buf + 1048576, 20);
-    helper_float_22_recursive(buf + 2097152, 20);
-    helper_float_22_recursive(buf + 3145728, 20);
+    helper_float_avx_22_recursive(buf + 0, 20);
+    helper_float_avx_22_recursive(buf + 1048576, 20);
+    helper_float_avx_22_recursive(buf + 2097152, 20);
+    helper_float_avx_22_recursive(buf + 3145728, 20);
     for (int j = 0; j < 4194304; j += 4194304) {
       for (int k = 0; k < 1048576; k += 8) {
         __asm__ volatile (
@@ -5561,12 +5561,12 @@ void helper_float_22_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_22(float *buf);
-void helper_float_22(float *buf) {
-  helper_float_22_recursive(buf, 22);
+FHT_TARGET("avx") void helper_float_avx_22(float *buf);
+FHT_TARGET("avx") void helper_float_avx_22(float *buf) {
+  helper_float_avx_22_recursive(buf, 22);
 }
-void helper_float_23_recursive(float *buf, int depth);
-void helper_float_23_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_23_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_23_recursive(float *buf, int depth) {
   if (depth == 9) {
     for (int j = 0; j < 512; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -5793,14 +5793,14 @@ void helper_float_23_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 12) {
-    helper_float_23_recursive(buf + 0, 9);
-    helper_float_23_recursive(buf + 512, 9);
-    helper_float_23_recursive(buf + 1024, 9);
-    helper_float_23_recursive(buf + 1536, 9);
-    helper_float_23_recursive(buf + 2048, 9);
-    helper_float_23_recursive(buf + 2560, 9);
-    helper_float_23_recursive(buf + 3072, 9);
-    helper_float_23_recursive(buf + 3584, 9);
+    helper_float_avx_23_recursive(buf + 0, 9);
+    helper_float_avx_23_recursive(buf + 512, 9);
+    helper_float_avx_23_recursive(buf + 1024, 9);
+    helper_float_avx_23_recursive(buf + 1536, 9);
+    helper_float_avx_23_recursive(buf + 2048, 9);
+    helper_float_avx_23_recursive(buf + 2560, 9);
+    helper_float_avx_23_recursive(buf + 3072, 9);
+    helper_float_avx_23_recursive(buf + 3584, 9);
     for (int j = 0; j < 4096; j += 4096) {
       for (int k = 0; k < 512; k += 8) {
         __asm__ volatile (
@@ -5851,14 +5851,14 @@ void helper_float_23_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_float_23_recursive(buf + 0, 12);
-    helper_float_23_recursive(buf + 4096, 12);
-    helper_float_23_recursive(buf + 8192, 12);
-    helper_float_23_recursive(buf + 12288, 12);
-    helper_float_23_recursive(buf + 16384, 12);
-    helper_float_23_recursive(buf + 20480, 12);
-    helper_float_23_recursive(buf + 24576, 12);
-    helper_float_23_recursive(buf + 28672, 12);
+    helper_float_avx_23_recursive(buf + 0, 12);
+    helper_float_avx_23_recursive(buf + 4096, 12);
+    helper_float_avx_23_recursive(buf + 8192, 12);
+    helper_float_avx_23_recursive(buf + 12288, 12);
+    helper_float_avx_23_recursive(buf + 16384, 12);
+    helper_float_avx_23_recursive(buf + 20480, 12);
+    helper_float_avx_23_recursive(buf + 24576, 12);
+    helper_float_avx_23_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 8) {
         __asm__ volatile (
@@ -5909,14 +5909,14 @@ void helper_float_23_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_float_23_recursive(buf + 0, 15);
-    helper_float_23_recursive(buf + 32768, 15);
-    helper_float_23_recursive(buf + 65536, 15);
-    helper_float_23_recursive(buf + 98304, 15);
-    helper_float_23_recursive(buf + 131072, 15);
-    helper_float_23_recursive(buf + 163840, 15);
-    helper_float_23_recursive(buf + 196608, 15);
-    helper_float_23_recursive(buf + 229376, 15);
+    helper_float_avx_23_recursive(buf + 0, 15);
+    helper_float_avx_23_recursive(buf + 32768, 15);
+    helper_float_avx_23_recursive(buf + 65536, 15);
+    helper_float_avx_23_recursive(buf + 98304, 15);
+    helper_float_avx_23_recursive(buf + 131072, 15);
+    helper_float_avx_23_recursive(buf + 163840, 15);
+    helper_float_avx_23_recursive(buf + 196608, 15);
+    helper_float_avx_23_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 8) {
         __asm__ volatile (
@@ -5967,14 +5967,14 @@ void helper_float_23_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_float_23_recursive(buf + 0, 18);
-    helper_float_23_recursive(buf + 262144, 18);
-    helper_float_23_recursive(buf + 524288, 18);
-    helper_float_23_recursive(buf + 786432, 18);
-    helper_float_23_recursive(buf + 1048576, 18);
-    helper_float_23_recursive(buf + 1310720, 18);
-    helper_float_23_recursive(buf + 1572864, 18);
-    helper_float_23_recursive(buf + 1835008, 18);
+    helper_float_avx_23_recursive(buf + 0, 18);
+    helper_float_avx_23_recursive(buf + 262144, 18);
+    helper_float_avx_23_recursive(buf + 524288, 18);
+    helper_float_avx_23_recursive(buf + 786432, 18);
+    helper_float_avx_23_recursive(buf + 1048576, 18);
+    helper_float_avx_23_recursive(buf + 1310720, 18);
+    helper_float_avx_23_recursive(buf + 1572864, 18);
+    helper_float_avx_23_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 8) {
         __asm__ volatile (
@@ -6025,10 +6025,10 @@ void helper_float_23_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 23) {
-    helper_float_23_recursive(buf + 0, 21);
-    helper_float_23_recursive(buf + 2097152, 21);
-    helper_float_23_recursive(buf + 4194304, 21);
-    helper_float_23_recursive(buf + 6291456, 21);
+    helper_float_avx_23_recursive(buf + 0, 21);
+    helper_float_avx_23_recursive(buf + 2097152, 21);
+    helper_float_avx_23_recursive(buf + 4194304, 21);
+    helper_float_avx_23_recursive(buf + 6291456, 21);
     for (int j = 0; j < 8388608; j += 8388608) {
       for (int k = 0; k < 2097152; k += 8) {
         __asm__ volatile (
@@ -6055,12 +6055,12 @@ void helper_float_23_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_23(float *buf);
-void helper_float_23(float *buf) {
-  helper_float_23_recursive(buf, 23);
+FHT_TARGET("avx") void helper_float_avx_23(float *buf);
+FHT_TARGET("avx") void helper_float_avx_23(float *buf) {
+  helper_float_avx_23_recursive(buf, 23);
 }
-void helper_float_24_recursive(float *buf, int depth);
-void helper_float_24_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_24_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_24_recursive(float *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -6334,14 +6334,14 @@ void helper_float_24_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_float_24_recursive(buf + 0, 12);
-    helper_float_24_recursive(buf + 4096, 12);
-    helper_float_24_recursive(buf + 8192, 12);
-    helper_float_24_recursive(buf + 12288, 12);
-    helper_float_24_recursive(buf + 16384, 12);
-    helper_float_24_recursive(buf + 20480, 12);
-    helper_float_24_recursive(buf + 24576, 12);
-    helper_float_24_recursive(buf + 28672, 12);
+    helper_float_avx_24_recursive(buf + 0, 12);
+    helper_float_avx_24_recursive(buf + 4096, 12);
+    helper_float_avx_24_recursive(buf + 8192, 12);
+    helper_float_avx_24_recursive(buf + 12288, 12);
+    helper_float_avx_24_recursive(buf + 16384, 12);
+    helper_float_avx_24_recursive(buf + 20480, 12);
+    helper_float_avx_24_recursive(buf + 24576, 12);
+    helper_float_avx_24_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 8) {
         __asm__ volatile (
@@ -6392,14 +6392,14 @@ void helper_float_24_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_float_24_recursive(buf + 0, 15);
-    helper_float_24_recursive(buf + 32768, 15);
-    helper_float_24_recursive(buf + 65536, 15);
-    helper_float_24_recursive(buf + 98304, 15);
-    helper_float_24_recursive(buf + 131072, 15);
-    helper_float_24_recursive(buf + 163840, 15);
-    helper_float_24_recursive(buf + 196608, 15);
-    helper_float_24_recursive(buf + 229376, 15);
+    helper_float_avx_24_recursive(buf + 0, 15);
+    helper_float_avx_24_recursive(buf + 32768, 15);
+    helper_float_avx_24_recursive(buf + 65536, 15);
+    helper_float_avx_24_recursive(buf + 98304, 15);
+    helper_float_avx_24_recursive(buf + 131072, 15);
+    helper_float_avx_24_recursive(buf + 163840, 15);
+    helper_float_avx_24_recursive(buf + 196608, 15);
+    helper_float_avx_24_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 8) {
         __asm__ volatile (
@@ -6450,14 +6450,14 @@ void helper_float_24_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_float_24_recursive(buf + 0, 18);
-    helper_float_24_recursive(buf + 262144, 18);
-    helper_float_24_recursive(buf + 524288, 18);
-    helper_float_24_recursive(buf + 786432, 18);
-    helper_float_24_recursive(buf + 1048576, 18);
-    helper_float_24_recursive(buf + 1310720, 18);
-    helper_float_24_recursive(buf + 1572864, 18);
-    helper_float_24_recursive(buf + 1835008, 18);
+    helper_float_avx_24_recursive(buf + 0, 18);
+    helper_float_avx_24_recursive(buf + 262144, 18);
+    helper_float_avx_24_recursive(buf + 524288, 18);
+    helper_float_avx_24_recursive(buf + 786432, 18);
+    helper_float_avx_24_recursive(buf + 1048576, 18);
+    helper_float_avx_24_recursive(buf + 1310720, 18);
+    helper_float_avx_24_recursive(buf + 1572864, 18);
+    helper_float_avx_24_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 8) {
         __asm__ volatile (
@@ -6508,14 +6508,14 @@ void helper_float_24_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 24) {
-    helper_float_24_recursive(buf + 0, 21);
-    helper_float_24_recursive(buf + 2097152, 21);
-    helper_float_24_recursive(buf + 4194304, 21);
-    helper_float_24_recursive(buf + 6291456, 21);
-    helper_float_24_recursive(buf + 8388608, 21);
-    helper_float_24_recursive(buf + 10485760, 21);
-    helper_float_24_recursive(buf + 12582912, 21);
-    helper_float_24_recursive(buf + 14680064, 21);
+    helper_float_avx_24_recursive(buf + 0, 21);
+    helper_float_avx_24_recursive(buf + 2097152, 21);
+    helper_float_avx_24_recursive(buf + 4194304, 21);
+    helper_float_avx_24_recursive(buf + 6291456, 21);
+    helper_float_avx_24_recursive(buf + 8388608, 21);
+    helper_float_avx_24_recursive(buf + 10485760, 21);
+    helper_float_avx_24_recursive(buf + 12582912, 21);
+    helper_float_avx_24_recursive(buf + 14680064, 21);
     for (int j = 0; j < 16777216; j += 16777216) {
       for (int k = 0; k < 2097152; k += 8) {
         __asm__ volatile (
@@ -6566,12 +6566,12 @@ void helper_float_24_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_24(float *buf);
-void helper_float_24(float *buf) {
-  helper_float_24_recursive(buf, 24);
+FHT_TARGET("avx") void helper_float_avx_24(float *buf);
+FHT_TARGET("avx") void helper_float_avx_24(float *buf) {
+  helper_float_avx_24_recursive(buf, 24);
 }
-void helper_float_25_recursive(float *buf, int depth);
-void helper_float_25_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_25_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_25_recursive(float *buf, int depth) {
   if (depth == 7) {
     for (int j = 0; j < 128; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -6764,14 +6764,14 @@ void helper_float_25_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 10) {
-    helper_float_25_recursive(buf + 0, 7);
-    helper_float_25_recursive(buf + 128, 7);
-    helper_float_25_recursive(buf + 256, 7);
-    helper_float_25_recursive(buf + 384, 7);
-    helper_float_25_recursive(buf + 512, 7);
-    helper_float_25_recursive(buf + 640, 7);
-    helper_float_25_recursive(buf + 768, 7);
-    helper_float_25_recursive(buf + 896, 7);
+    helper_float_avx_25_recursive(buf + 0, 7);
+    helper_float_avx_25_recursive(buf + 128, 7);
+    helper_float_avx_25_recursive(buf + 256, 7);
+    helper_float_avx_25_recursive(buf + 384, 7);
+    helper_float_avx_25_recursive(buf + 512, 7);
+    helper_float_avx_25_recursive(buf + 640, 7);
+    helper_float_avx_25_recursive(buf + 768, 7);
+    helper_float_avx_25_recursive(buf + 896, 7);
     for (int j = 0; j < 1024; j += 1024) {
       for (int k = 0; k < 128; k += 8) {
         __asm__ volatile (
@@ -6822,14 +6822,14 @@ void helper_float_25_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 13) {
-    helper_float_25_recursive(buf + 0, 10);
-    helper_float_25_recursive(buf + 1024, 10);
-    helper_float_25_recursive(buf + 2048, 10);
-    helper_float_25_recursive(buf + 3072, 10);
-    helper_float_25_recursive(buf + 4096, 10);
-    helper_float_25_recursive(buf + 5120, 10);
-    helper_float_25_recursive(buf + 6144, 10);
-    helper_float_25_recursive(buf + 7168, 10);
+    helper_float_avx_25_recursive(buf + 0, 10);
+    helper_float_avx_25_recursive(buf + 1024, 10);
+    helper_float_avx_25_recursive(buf + 2048, 10);
+    helper_float_avx_25_recursive(buf + 3072, 10);
+    helper_float_avx_25_recursive(buf + 4096, 10);
+    helper_float_avx_25_recursive(buf + 5120, 10);
+    helper_float_avx_25_recursive(buf + 6144, 10);
+    helper_float_avx_25_recursive(buf + 7168, 10);
     for (int j = 0; j < 8192; j += 8192) {
       for (int k = 0; k < 1024; k += 8) {
         __asm__ volatile (
@@ -6880,14 +6880,14 @@ void helper_float_25_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 16) {
-    helper_float_25_recursive(buf + 0, 13);
-    helper_float_25_recursive(buf + 8192, 13);
-    helper_float_25_recursive(buf + 16384, 13);
-    helper_float_25_recursive(buf + 24576, 13);
-    helper_float_25_recursive(buf + 32768, 13);
-    helper_float_25_recursive(buf + 40960, 13);
-    helper_float_25_recursive(buf + 49152, 13);
-    helper_float_25_recursive(buf + 57344, 13);
+    helper_float_avx_25_recursive(buf + 0, 13);
+    helper_float_avx_25_recursive(buf + 8192, 13);
+    helper_float_avx_25_recursive(buf + 16384, 13);
+    helper_float_avx_25_recursive(buf + 24576, 13);
+    helper_float_avx_25_recursive(buf + 32768, 13);
+    helper_float_avx_25_recursive(buf + 40960, 13);
+    helper_float_avx_25_recursive(buf + 49152, 13);
+    helper_float_avx_25_recursive(buf + 57344, 13);
     for (int j = 0; j < 65536; j += 65536) {
       for (int k = 0; k < 8192; k += 8) {
         __asm__ volatile (
@@ -6938,14 +6938,14 @@ void helper_float_25_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 19) {
-    helper_float_25_recursive(buf + 0, 16);
-    helper_float_25_recursive(buf + 65536, 16);
-    helper_float_25_recursive(buf + 131072, 16);
-    helper_float_25_recursive(buf + 196608, 16);
-    helper_float_25_recursive(buf + 262144, 16);
-    helper_float_25_recursive(buf + 327680, 16);
-    helper_float_25_recursive(buf + 393216, 16);
-    helper_float_25_recursive(buf + 458752, 16);
+    helper_float_avx_25_recursive(buf + 0, 16);
+    helper_float_avx_25_recursive(buf + 65536, 16);
+    helper_float_avx_25_recursive(buf + 131072, 16);
+    helper_float_avx_25_recursive(buf + 196608, 16);
+    helper_float_avx_25_recursive(buf + 262144, 16);
+    helper_float_avx_25_recursive(buf + 327680, 16);
+    helper_float_avx_25_recursive(buf + 393216, 16);
+    helper_float_avx_25_recursive(buf + 458752, 16);
     for (int j = 0; j < 524288; j += 524288) {
       for (int k = 0; k < 65536; k += 8) {
         __asm__ volatile (
@@ -6996,14 +6996,14 @@ void helper_float_25_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 22) {
-    helper_float_25_recursive(buf + 0, 19);
-    helper_float_25_recursive(buf + 524288, 19);
-    helper_float_25_recursive(buf + 1048576, 19);
-    helper_float_25_recursive(buf + 1572864, 19);
-    helper_float_25_recursive(buf + 2097152, 19);
-    helper_float_25_recursive(buf + 2621440, 19);
-    helper_float_25_recursive(buf + 3145728, 19);
-    helper_float_25_recursive(buf + 3670016, 19);
+    helper_float_avx_25_recursive(buf + 0, 19);
+    helper_float_avx_25_recursive(buf + 524288, 19);
+    helper_float_avx_25_recursive(buf + 1048576, 19);
+    helper_float_avx_25_recursive(buf + 1572864, 19);
+    helper_float_avx_25_recursive(buf + 2097152, 19);
+    helper_float_avx_25_recursive(buf + 2621440, 19);
+    helper_float_avx_25_recursive(buf + 3145728, 19);
+    helper_float_avx_25_recursive(buf + 3670016, 19);
     for (int j = 0; j < 4194304; j += 4194304) {
       for (int k = 0; k < 524288; k += 8) {
         __asm__ volatile (
@@ -7054,14 +7054,14 @@ void helper_float_25_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 25) {
-    helper_float_25_recursive(buf + 0, 22);
-    helper_float_25_recursive(buf + 4194304, 22);
-    helper_float_25_recursive(buf + 8388608, 22);
-    helper_float_25_recursive(buf + 12582912, 22);
-    helper_float_25_recursive(buf + 16777216, 22);
-    helper_float_25_recursive(buf + 20971520, 22);
-    helper_float_25_recursive(buf + 25165824, 22);
-    helper_float_25_recursive(buf + 29360128, 22);
+    helper_float_avx_25_recursive(buf + 0, 22);
+    helper_float_avx_25_recursive(buf + 4194304, 22);
+    helper_float_avx_25_recursive(buf + 8388608, 22);
+    helper_float_avx_25_recursive(buf + 12582912, 22);
+    helper_float_avx_25_recursive(buf + 16777216, 22);
+    helper_float_avx_25_recursive(buf + 20971520, 22);
+    helper_float_avx_25_recursive(buf + 25165824, 22);
+    helper_float_avx_25_recursive(buf + 29360128, 22);
     for (int j = 0; j < 33554432; j += 33554432) {
       for (int k = 0; k < 4194304; k += 8) {
         __asm__ volatile (
@@ -7112,12 +7112,12 @@ void helper_float_25_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_25(float *buf);
-void helper_float_25(float *buf) {
-  helper_float_25_recursive(buf, 25);
+FHT_TARGET("avx") void helper_float_avx_25(float *buf);
+FHT_TARGET("avx") void helper_float_avx_25(float *buf) {
+  helper_float_avx_25_recursive(buf, 25);
 }
-void helper_float_26_recursive(float *buf, int depth);
-void helper_float_26_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_26_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_26_recursive(float *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -7391,14 +7391,14 @@ void helper_float_26_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_float_26_recursive(buf + 0, 12);
-    helper_float_26_recursive(buf + 4096, 12);
-    helper_float_26_recursive(buf + 8192, 12);
-    helper_float_26_recursive(buf + 12288, 12);
-    helper_float_26_recursive(buf + 16384, 12);
-    helper_float_26_recursive(buf + 20480, 12);
-    helper_float_26_recursive(buf + 24576, 12);
-    helper_float_26_recursive(buf + 28672, 12);
+    helper_float_avx_26_recursive(buf + 0, 12);
+    helper_float_avx_26_recursive(buf + 4096, 12);
+    helper_float_avx_26_recursive(buf + 8192, 12);
+    helper_float_avx_26_recursive(buf + 12288, 12);
+    helper_float_avx_26_recursive(buf + 16384, 12);
+    helper_float_avx_26_recursive(buf + 20480, 12);
+    helper_float_avx_26_recursive(buf + 24576, 12);
+    helper_float_avx_26_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 8) {
         __asm__ volatile (
@@ -7449,14 +7449,14 @@ void helper_float_26_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_float_26_recursive(buf + 0, 15);
-    helper_float_26_recursive(buf + 32768, 15);
-    helper_float_26_recursive(buf + 65536, 15);
-    helper_float_26_recursive(buf + 98304, 15);
-    helper_float_26_recursive(buf + 131072, 15);
-    helper_float_26_recursive(buf + 163840, 15);
-    helper_float_26_recursive(buf + 196608, 15);
-    helper_float_26_recursive(buf + 229376, 15);
+    helper_float_avx_26_recursive(buf + 0, 15);
+    helper_float_avx_26_recursive(buf + 32768, 15);
+    helper_float_avx_26_recursive(buf + 65536, 15);
+    helper_float_avx_26_recursive(buf + 98304, 15);
+    helper_float_avx_26_recursive(buf + 131072, 15);
+    helper_float_avx_26_recursive(buf + 163840, 15);
+    helper_float_avx_26_recursive(buf + 196608, 15);
+    helper_float_avx_26_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 8) {
         __asm__ volatile (
@@ -7507,14 +7507,14 @@ void helper_float_26_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_float_26_recursive(buf + 0, 18);
-    helper_float_26_recursive(buf + 262144, 18);
-    helper_float_26_recursive(buf + 524288, 18);
-    helper_float_26_recursive(buf + 786432, 18);
-    helper_float_26_recursive(buf + 1048576, 18);
-    helper_float_26_recursive(buf + 1310720, 18);
-    helper_float_26_recursive(buf + 1572864, 18);
-    helper_float_26_recursive(buf + 1835008, 18);
+    helper_float_avx_26_recursive(buf + 0, 18);
+    helper_float_avx_26_recursive(buf + 262144, 18);
+    helper_float_avx_26_recursive(buf + 524288, 18);
+    helper_float_avx_26_recursive(buf + 786432, 18);
+    helper_float_avx_26_recursive(buf + 1048576, 18);
+    helper_float_avx_26_recursive(buf + 1310720, 18);
+    helper_float_avx_26_recursive(buf + 1572864, 18);
+    helper_float_avx_26_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 8) {
         __asm__ volatile (
@@ -7565,14 +7565,14 @@ void helper_float_26_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 24) {
-    helper_float_26_recursive(buf + 0, 21);
-    helper_float_26_recursive(buf + 2097152, 21);
-    helper_float_26_recursive(buf + 4194304, 21);
-    helper_float_26_recursive(buf + 6291456, 21);
-    helper_float_26_recursive(buf + 8388608, 21);
-    helper_float_26_recursive(buf + 10485760, 21);
-    helper_float_26_recursive(buf + 12582912, 21);
-    helper_float_26_recursive(buf + 14680064, 21);
+    helper_float_avx_26_recursive(buf + 0, 21);
+    helper_float_avx_26_recursive(buf + 2097152, 21);
+    helper_float_avx_26_recursive(buf + 4194304, 21);
+    helper_float_avx_26_recursive(buf + 6291456, 21);
+    helper_float_avx_26_recursive(buf + 8388608, 21);
+    helper_float_avx_26_recursive(buf + 10485760, 21);
+    helper_float_avx_26_recursive(buf + 12582912, 21);
+    helper_float_avx_26_recursive(buf + 14680064, 21);
     for (int j = 0; j < 16777216; j += 16777216) {
       for (int k = 0; k < 2097152; k += 8) {
         __asm__ volatile (
@@ -7623,10 +7623,10 @@ void helper_float_26_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 26) {
-    helper_float_26_recursive(buf + 0, 24);
-    helper_float_26_recursive(buf + 16777216, 24);
-    helper_float_26_recursive(buf + 33554432, 24);
-    helper_float_26_recursive(buf + 50331648, 24);
+    helper_float_avx_26_recursive(buf + 0, 24);
+    helper_float_avx_26_recursive(buf + 16777216, 24);
+    helper_float_avx_26_recursive(buf + 33554432, 24);
+    helper_float_avx_26_recursive(buf + 50331648, 24);
     for (int j = 0; j < 67108864; j += 67108864) {
       for (int k = 0; k < 16777216; k += 8) {
         __asm__ volatile (
@@ -7653,12 +7653,12 @@ void helper_float_26_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_26(float *buf);
-void helper_float_26(float *buf) {
-  helper_float_26_recursive(buf, 26);
+FHT_TARGET("avx") void helper_float_avx_26(float *buf);
+FHT_TARGET("avx") void helper_float_avx_26(float *buf) {
+  helper_float_avx_26_recursive(buf, 26);
 }
-void helper_float_27_recursive(float *buf, int depth);
-void helper_float_27_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_27_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_27_recursive(float *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -7932,14 +7932,14 @@ void helper_float_27_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_float_27_recursive(buf + 0, 12);
-    helper_float_27_recursive(buf + 4096, 12);
-    helper_float_27_recursive(buf + 8192, 12);
-    helper_float_27_recursive(buf + 12288, 12);
-    helper_float_27_recursive(buf + 16384, 12);
-    helper_float_27_recursive(buf + 20480, 12);
-    helper_float_27_recursive(buf + 24576, 12);
-    helper_float_27_recursive(buf + 28672, 12);
+    helper_float_avx_27_recursive(buf + 0, 12);
+    helper_float_avx_27_recursive(buf + 4096, 12);
+    helper_float_avx_27_recursive(buf + 8192, 12);
+    helper_float_avx_27_recursive(buf + 12288, 12);
+    helper_float_avx_27_recursive(buf + 16384, 12);
+    helper_float_avx_27_recursive(buf + 20480, 12);
+    helper_float_avx_27_recursive(buf + 24576, 12);
+    helper_float_avx_27_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 8) {
         __asm__ volatile (
@@ -7990,14 +7990,14 @@ void helper_float_27_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_float_27_recursive(buf + 0, 15);
-    helper_float_27_recursive(buf + 32768, 15);
-    helper_float_27_recursive(buf + 65536, 15);
-    helper_float_27_recursive(buf + 98304, 15);
-    helper_float_27_recursive(buf + 131072, 15);
-    helper_float_27_recursive(buf + 163840, 15);
-    helper_float_27_recursive(buf + 196608, 15);
-    helper_float_27_recursive(buf + 229376, 15);
+    helper_float_avx_27_recursive(buf + 0, 15);
+    helper_float_avx_27_recursive(buf + 32768, 15);
+    helper_float_avx_27_recursive(buf + 65536, 15);
+    helper_float_avx_27_recursive(buf + 98304, 15);
+    helper_float_avx_27_recursive(buf + 131072, 15);
+    helper_float_avx_27_recursive(buf + 163840, 15);
+    helper_float_avx_27_recursive(buf + 196608, 15);
+    helper_float_avx_27_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 8) {
         __asm__ volatile (
@@ -8048,14 +8048,14 @@ void helper_float_27_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_float_27_recursive(buf + 0, 18);
-    helper_float_27_recursive(buf + 262144, 18);
-    helper_float_27_recursive(buf + 524288, 18);
-    helper_float_27_recursive(buf + 786432, 18);
-    helper_float_27_recursive(buf + 1048576, 18);
-    helper_float_27_recursive(buf + 1310720, 18);
-    helper_float_27_recursive(buf + 1572864, 18);
-    helper_float_27_recursive(buf + 1835008, 18);
+    helper_float_avx_27_recursive(buf + 0, 18);
+    helper_float_avx_27_recursive(buf + 262144, 18);
+    helper_float_avx_27_recursive(buf + 524288, 18);
+    helper_float_avx_27_recursive(buf + 786432, 18);
+    helper_float_avx_27_recursive(buf + 1048576, 18);
+    helper_float_avx_27_recursive(buf + 1310720, 18);
+    helper_float_avx_27_recursive(buf + 1572864, 18);
+    helper_float_avx_27_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 8) {
         __asm__ volatile (
@@ -8106,14 +8106,14 @@ void helper_float_27_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 24) {
-    helper_float_27_recursive(buf + 0, 21);
-    helper_float_27_recursive(buf + 2097152, 21);
-    helper_float_27_recursive(buf + 4194304, 21);
-    helper_float_27_recursive(buf + 6291456, 21);
-    helper_float_27_recursive(buf + 8388608, 21);
-    helper_float_27_recursive(buf + 10485760, 21);
-    helper_float_27_recursive(buf + 12582912, 21);
-    helper_float_27_recursive(buf + 14680064, 21);
+    helper_float_avx_27_recursive(buf + 0, 21);
+    helper_float_avx_27_recursive(buf + 2097152, 21);
+    helper_float_avx_27_recursive(buf + 4194304, 21);
+    helper_float_avx_27_recursive(buf + 6291456, 21);
+    helper_float_avx_27_recursive(buf + 8388608, 21);
+    helper_float_avx_27_recursive(buf + 10485760, 21);
+    helper_float_avx_27_recursive(buf + 12582912, 21);
+    helper_float_avx_27_recursive(buf + 14680064, 21);
     for (int j = 0; j < 16777216; j += 16777216) {
       for (int k = 0; k < 2097152; k += 8) {
         __asm__ volatile (
@@ -8164,14 +8164,14 @@ void helper_float_27_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 27) {
-    helper_float_27_recursive(buf + 0, 24);
-    helper_float_27_recursive(buf + 16777216, 24);
-    helper_float_27_recursive(buf + 33554432, 24);
-    helper_float_27_recursive(buf + 50331648, 24);
-    helper_float_27_recursive(buf + 67108864, 24);
-    helper_float_27_recursive(buf + 83886080, 24);
-    helper_float_27_recursive(buf + 100663296, 24);
-    helper_float_27_recursive(buf + 117440512, 24);
+    helper_float_avx_27_recursive(buf + 0, 24);
+    helper_float_avx_27_recursive(buf + 16777216, 24);
+    helper_float_avx_27_recursive(buf + 33554432, 24);
+    helper_float_avx_27_recursive(buf + 50331648, 24);
+    helper_float_avx_27_recursive(buf + 67108864, 24);
+    helper_float_avx_27_recursive(buf + 83886080, 24);
+    helper_float_avx_27_recursive(buf + 100663296, 24);
+    helper_float_avx_27_recursive(buf + 117440512, 24);
     for (int j = 0; j < 134217728; j += 134217728) {
       for (int k = 0; k < 16777216; k += 8) {
         __asm__ volatile (
@@ -8222,12 +8222,12 @@ void helper_float_27_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_27(float *buf);
-void helper_float_27(float *buf) {
-  helper_float_27_recursive(buf, 27);
+FHT_TARGET("avx") void helper_float_avx_27(float *buf);
+FHT_TARGET("avx") void helper_float_avx_27(float *buf) {
+  helper_float_avx_27_recursive(buf, 27);
 }
-void helper_float_28_recursive(float *buf, int depth);
-void helper_float_28_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_28_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_28_recursive(float *buf, int depth) {
   if (depth == 7) {
     for (int j = 0; j < 128; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -8420,14 +8420,14 @@ void helper_float_28_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 10) {
-    helper_float_28_recursive(buf + 0, 7);
-    helper_float_28_recursive(buf + 128, 7);
-    helper_float_28_recursive(buf + 256, 7);
-    helper_float_28_recursive(buf + 384, 7);
-    helper_float_28_recursive(buf + 512, 7);
-    helper_float_28_recursive(buf + 640, 7);
-    helper_float_28_recursive(buf + 768, 7);
-    helper_float_28_recursive(buf + 896, 7);
+    helper_float_avx_28_recursive(buf + 0, 7);
+    helper_float_avx_28_recursive(buf + 128, 7);
+    helper_float_avx_28_recursive(buf + 256, 7);
+    helper_float_avx_28_recursive(buf + 384, 7);
+    helper_float_avx_28_recursive(buf + 512, 7);
+    helper_float_avx_28_recursive(buf + 640, 7);
+    helper_float_avx_28_recursive(buf + 768, 7);
+    helper_float_avx_28_recursive(buf + 896, 7);
     for (int j = 0; j < 1024; j += 1024) {
       for (int k = 0; k < 128; k += 8) {
         __asm__ volatile (
@@ -8478,14 +8478,14 @@ void helper_float_28_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 13) {
-    helper_float_28_recursive(buf + 0, 10);
-    helper_float_28_recursive(buf + 1024, 10);
-    helper_float_28_recursive(buf + 2048, 10);
-    helper_float_28_recursive(buf + 3072, 10);
-    helper_float_28_recursive(buf + 4096, 10);
-    helper_float_28_recursive(buf + 5120, 10);
-    helper_float_28_recursive(buf + 6144, 10);
-    helper_float_28_recursive(buf + 7168, 10);
+    helper_float_avx_28_recursive(buf + 0, 10);
+    helper_float_avx_28_recursive(buf + 1024, 10);
+    helper_float_avx_28_recursive(buf + 2048, 10);
+    helper_float_avx_28_recursive(buf + 3072, 10);
+    helper_float_avx_28_recursive(buf + 4096, 10);
+    helper_float_avx_28_recursive(buf + 5120, 10);
+    helper_float_avx_28_recursive(buf + 6144, 10);
+    helper_float_avx_28_recursive(buf + 7168, 10);
     for (int j = 0; j < 8192; j += 8192) {
       for (int k = 0; k < 1024; k += 8) {
         __asm__ volatile (
@@ -8536,14 +8536,14 @@ void helper_float_28_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 16) {
-    helper_float_28_recursive(buf + 0, 13);
-    helper_float_28_recursive(buf + 8192, 13);
-    helper_float_28_recursive(buf + 16384, 13);
-    helper_float_28_recursive(buf + 24576, 13);
-    helper_float_28_recursive(buf + 32768, 13);
-    helper_float_28_recursive(buf + 40960, 13);
-    helper_float_28_recursive(buf + 49152, 13);
-    helper_float_28_recursive(buf + 57344, 13);
+    helper_float_avx_28_recursive(buf + 0, 13);
+    helper_float_avx_28_recursive(buf + 8192, 13);
+    helper_float_avx_28_recursive(buf + 16384, 13);
+    helper_float_avx_28_recursive(buf + 24576, 13);
+    helper_float_avx_28_recursive(buf + 32768, 13);
+    helper_float_avx_28_recursive(buf + 40960, 13);
+    helper_float_avx_28_recursive(buf + 49152, 13);
+    helper_float_avx_28_recursive(buf + 57344, 13);
     for (int j = 0; j < 65536; j += 65536) {
       for (int k = 0; k < 8192; k += 8) {
         __asm__ volatile (
@@ -8594,14 +8594,14 @@ void helper_float_28_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 19) {
-    helper_float_28_recursive(buf + 0, 16);
-    helper_float_28_recursive(buf + 65536, 16);
-    helper_float_28_recursive(buf + 131072, 16);
-    helper_float_28_recursive(buf + 196608, 16);
-    helper_float_28_recursive(buf + 262144, 16);
-    helper_float_28_recursive(buf + 327680, 16);
-    helper_float_28_recursive(buf + 393216, 16);
-    helper_float_28_recursive(buf + 458752, 16);
+    helper_float_avx_28_recursive(buf + 0, 16);
+    helper_float_avx_28_recursive(buf + 65536, 16);
+    helper_float_avx_28_recursive(buf + 131072, 16);
+    helper_float_avx_28_recursive(buf + 196608, 16);
+    helper_float_avx_28_recursive(buf + 262144, 16);
+    helper_float_avx_28_recursive(buf + 327680, 16);
+    helper_float_avx_28_recursive(buf + 393216, 16);
+    helper_float_avx_28_recursive(buf + 458752, 16);
     for (int j = 0; j < 524288; j += 524288) {
       for (int k = 0; k < 65536; k += 8) {
         __asm__ volatile (
@@ -8652,14 +8652,14 @@ void helper_float_28_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 22) {
-    helper_float_28_recursive(buf + 0, 19);
-    helper_float_28_recursive(buf + 524288, 19);
-    helper_float_28_recursive(buf + 1048576, 19);
-    helper_float_28_recursive(buf + 1572864, 19);
-    helper_float_28_recursive(buf + 2097152, 19);
-    helper_float_28_recursive(buf + 2621440, 19);
-    helper_float_28_recursive(buf + 3145728, 19);
-    helper_float_28_recursive(buf + 3670016, 19);
+    helper_float_avx_28_recursive(buf + 0, 19);
+    helper_float_avx_28_recursive(buf + 524288, 19);
+    helper_float_avx_28_recursive(buf + 1048576, 19);
+    helper_float_avx_28_recursive(buf + 1572864, 19);
+    helper_float_avx_28_recursive(buf + 2097152, 19);
+    helper_float_avx_28_recursive(buf + 2621440, 19);
+    helper_float_avx_28_recursive(buf + 3145728, 19);
+    helper_float_avx_28_recursive(buf + 3670016, 19);
     for (int j = 0; j < 4194304; j += 4194304) {
       for (int k = 0; k < 524288; k += 8) {
         __asm__ volatile (
@@ -8710,14 +8710,14 @@ void helper_float_28_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 25) {
-    helper_float_28_recursive(buf + 0, 22);
-    helper_float_28_recursive(buf + 4194304, 22);
-    helper_float_28_recursive(buf + 8388608, 22);
-    helper_float_28_recursive(buf + 12582912, 22);
-    helper_float_28_recursive(buf + 16777216, 22);
-    helper_float_28_recursive(buf + 20971520, 22);
-    helper_float_28_recursive(buf + 25165824, 22);
-    helper_float_28_recursive(buf + 29360128, 22);
+    helper_float_avx_28_recursive(buf + 0, 22);
+    helper_float_avx_28_recursive(buf + 4194304, 22);
+    helper_float_avx_28_recursive(buf + 8388608, 22);
+    helper_float_avx_28_recursive(buf + 12582912, 22);
+    helper_float_avx_28_recursive(buf + 16777216, 22);
+    helper_float_avx_28_recursive(buf + 20971520, 22);
+    helper_float_avx_28_recursive(buf + 25165824, 22);
+    helper_float_avx_28_recursive(buf + 29360128, 22);
     for (int j = 0; j < 33554432; j += 33554432) {
       for (int k = 0; k < 4194304; k += 8) {
         __asm__ volatile (
@@ -8768,14 +8768,14 @@ void helper_float_28_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 28) {
-    helper_float_28_recursive(buf + 0, 25);
-    helper_float_28_recursive(buf + 33554432, 25);
-    helper_float_28_recursive(buf + 67108864, 25);
-    helper_float_28_recursive(buf + 100663296, 25);
-    helper_float_28_recursive(buf + 134217728, 25);
-    helper_float_28_recursive(buf + 167772160, 25);
-    helper_float_28_recursive(buf + 201326592, 25);
-    helper_float_28_recursive(buf + 234881024, 25);
+    helper_float_avx_28_recursive(buf + 0, 25);
+    helper_float_avx_28_recursive(buf + 33554432, 25);
+    helper_float_avx_28_recursive(buf + 67108864, 25);
+    helper_float_avx_28_recursive(buf + 100663296, 25);
+    helper_float_avx_28_recursive(buf + 134217728, 25);
+    helper_float_avx_28_recursive(buf + 167772160, 25);
+    helper_float_avx_28_recursive(buf + 201326592, 25);
+    helper_float_avx_28_recursive(buf + 234881024, 25);
     for (int j = 0; j < 268435456; j += 268435456) {
       for (int k = 0; k < 33554432; k += 8) {
         __asm__ volatile (
@@ -8826,12 +8826,12 @@ void helper_float_28_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_28(float *buf);
-void helper_float_28(float *buf) {
-  helper_float_28_recursive(buf, 28);
+FHT_TARGET("avx") void helper_float_avx_28(float *buf);
+FHT_TARGET("avx") void helper_float_avx_28(float *buf) {
+  helper_float_avx_28_recursive(buf, 28);
 }
-void helper_float_29_recursive(float *buf, int depth);
-void helper_float_29_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_29_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_29_recursive(float *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -9105,14 +9105,14 @@ void helper_float_29_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_float_29_recursive(buf + 0, 12);
-    helper_float_29_recursive(buf + 4096, 12);
-    helper_float_29_recursive(buf + 8192, 12);
-    helper_float_29_recursive(buf + 12288, 12);
-    helper_float_29_recursive(buf + 16384, 12);
-    helper_float_29_recursive(buf + 20480, 12);
-    helper_float_29_recursive(buf + 24576, 12);
-    helper_float_29_recursive(buf + 28672, 12);
+    helper_float_avx_29_recursive(buf + 0, 12);
+    helper_float_avx_29_recursive(buf + 4096, 12);
+    helper_float_avx_29_recursive(buf + 8192, 12);
+    helper_float_avx_29_recursive(buf + 12288, 12);
+    helper_float_avx_29_recursive(buf + 16384, 12);
+    helper_float_avx_29_recursive(buf + 20480, 12);
+    helper_float_avx_29_recursive(buf + 24576, 12);
+    helper_float_avx_29_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 8) {
         __asm__ volatile (
@@ -9163,14 +9163,14 @@ void helper_float_29_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_float_29_recursive(buf + 0, 15);
-    helper_float_29_recursive(buf + 32768, 15);
-    helper_float_29_recursive(buf + 65536, 15);
-    helper_float_29_recursive(buf + 98304, 15);
-    helper_float_29_recursive(buf + 131072, 15);
-    helper_float_29_recursive(buf + 163840, 15);
-    helper_float_29_recursive(buf + 196608, 15);
-    helper_float_29_recursive(buf + 229376, 15);
+    helper_float_avx_29_recursive(buf + 0, 15);
+    helper_float_avx_29_recursive(buf + 32768, 15);
+    helper_float_avx_29_recursive(buf + 65536, 15);
+    helper_float_avx_29_recursive(buf + 98304, 15);
+    helper_float_avx_29_recursive(buf + 131072, 15);
+    helper_float_avx_29_recursive(buf + 163840, 15);
+    helper_float_avx_29_recursive(buf + 196608, 15);
+    helper_float_avx_29_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 8) {
         __asm__ volatile (
@@ -9221,14 +9221,14 @@ void helper_float_29_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_float_29_recursive(buf + 0, 18);
-    helper_float_29_recursive(buf + 262144, 18);
-    helper_float_29_recursive(buf + 524288, 18);
-    helper_float_29_recursive(buf + 786432, 18);
-    helper_float_29_recursive(buf + 1048576, 18);
-    helper_float_29_recursive(buf + 1310720, 18);
-    helper_float_29_recursive(buf + 1572864, 18);
-    helper_float_29_recursive(buf + 1835008, 18);
+    helper_float_avx_29_recursive(buf + 0, 18);
+    helper_float_avx_29_recursive(buf + 262144, 18);
+    helper_float_avx_29_recursive(buf + 524288, 18);
+    helper_float_avx_29_recursive(buf + 786432, 18);
+    helper_float_avx_29_recursive(buf + 1048576, 18);
+    helper_float_avx_29_recursive(buf + 1310720, 18);
+    helper_float_avx_29_recursive(buf + 1572864, 18);
+    helper_float_avx_29_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 8) {
         __asm__ volatile (
@@ -9279,14 +9279,14 @@ void helper_float_29_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 24) {
-    helper_float_29_recursive(buf + 0, 21);
-    helper_float_29_recursive(buf + 2097152, 21);
-    helper_float_29_recursive(buf + 4194304, 21);
-    helper_float_29_recursive(buf + 6291456, 21);
-    helper_float_29_recursive(buf + 8388608, 21);
-    helper_float_29_recursive(buf + 10485760, 21);
-    helper_float_29_recursive(buf + 12582912, 21);
-    helper_float_29_recursive(buf + 14680064, 21);
+    helper_float_avx_29_recursive(buf + 0, 21);
+    helper_float_avx_29_recursive(buf + 2097152, 21);
+    helper_float_avx_29_recursive(buf + 4194304, 21);
+    helper_float_avx_29_recursive(buf + 6291456, 21);
+    helper_float_avx_29_recursive(buf + 8388608, 21);
+    helper_float_avx_29_recursive(buf + 10485760, 21);
+    helper_float_avx_29_recursive(buf + 12582912, 21);
+    helper_float_avx_29_recursive(buf + 14680064, 21);
     for (int j = 0; j < 16777216; j += 16777216) {
       for (int k = 0; k < 2097152; k += 8) {
         __asm__ volatile (
@@ -9337,14 +9337,14 @@ void helper_float_29_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 27) {
-    helper_float_29_recursive(buf + 0, 24);
-    helper_float_29_recursive(buf + 16777216, 24);
-    helper_float_29_recursive(buf + 33554432, 24);
-    helper_float_29_recursive(buf + 50331648, 24);
-    helper_float_29_recursive(buf + 67108864, 24);
-    helper_float_29_recursive(buf + 83886080, 24);
-    helper_float_29_recursive(buf + 100663296, 24);
-    helper_float_29_recursive(buf + 117440512, 24);
+    helper_float_avx_29_recursive(buf + 0, 24);
+    helper_float_avx_29_recursive(buf + 16777216, 24);
+    helper_float_avx_29_recursive(buf + 33554432, 24);
+    helper_float_avx_29_recursive(buf + 50331648, 24);
+    helper_float_avx_29_recursive(buf + 67108864, 24);
+    helper_float_avx_29_recursive(buf + 83886080, 24);
+    helper_float_avx_29_recursive(buf + 100663296, 24);
+    helper_float_avx_29_recursive(buf + 117440512, 24);
     for (int j = 0; j < 134217728; j += 134217728) {
       for (int k = 0; k < 16777216; k += 8) {
         __asm__ volatile (
@@ -9395,10 +9395,10 @@ void helper_float_29_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 29) {
-    helper_float_29_recursive(buf + 0, 27);
-    helper_float_29_recursive(buf + 134217728, 27);
-    helper_float_29_recursive(buf + 268435456, 27);
-    helper_float_29_recursive(buf + 402653184, 27);
+    helper_float_avx_29_recursive(buf + 0, 27);
+    helper_float_avx_29_recursive(buf + 134217728, 27);
+    helper_float_avx_29_recursive(buf + 268435456, 27);
+    helper_float_avx_29_recursive(buf + 402653184, 27);
     for (int j = 0; j < 536870912; j += 536870912) {
       for (int k = 0; k < 134217728; k += 8) {
         __asm__ volatile (
@@ -9425,12 +9425,12 @@ void helper_float_29_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_29(float *buf);
-void helper_float_29(float *buf) {
-  helper_float_29_recursive(buf, 29);
+FHT_TARGET("avx") void helper_float_avx_29(float *buf);
+FHT_TARGET("avx") void helper_float_avx_29(float *buf) {
+  helper_float_avx_29_recursive(buf, 29);
 }
-void helper_float_30_recursive(float *buf, int depth);
-void helper_float_30_recursive(float *buf, int depth) {
+FHT_TARGET("avx") void helper_float_avx_30_recursive(float *buf, int depth);
+FHT_TARGET("avx") void helper_float_avx_30_recursive(float *buf, int depth) {
   if (depth == 6) {
     for (int j = 0; j < 64; j += 64) {
       for (int k = 0; k < 8; k += 8) {
@@ -9610,14 +9610,14 @@ void helper_float_30_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 9) {
-    helper_float_30_recursive(buf + 0, 6);
-    helper_float_30_recursive(buf + 64, 6);
-    helper_float_30_recursive(buf + 128, 6);
-    helper_float_30_recursive(buf + 192, 6);
-    helper_float_30_recursive(buf + 256, 6);
-    helper_float_30_recursive(buf + 320, 6);
-    helper_float_30_recursive(buf + 384, 6);
-    helper_float_30_recursive(buf + 448, 6);
+    helper_float_avx_30_recursive(buf + 0, 6);
+    helper_float_avx_30_recursive(buf + 64, 6);
+    helper_float_avx_30_recursive(buf + 128, 6);
+    helper_float_avx_30_recursive(buf + 192, 6);
+    helper_float_avx_30_recursive(buf + 256, 6);
+    helper_float_avx_30_recursive(buf + 320, 6);
+    helper_float_avx_30_recursive(buf + 384, 6);
+    helper_float_avx_30_recursive(buf + 448, 6);
     for (int j = 0; j < 512; j += 512) {
       for (int k = 0; k < 64; k += 8) {
         __asm__ volatile (
@@ -9668,14 +9668,14 @@ void helper_float_30_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 12) {
-    helper_float_30_recursive(buf + 0, 9);
-    helper_float_30_recursive(buf + 512, 9);
-    helper_float_30_recursive(buf + 1024, 9);
-    helper_float_30_recursive(buf + 1536, 9);
-    helper_float_30_recursive(buf + 2048, 9);
-    helper_float_30_recursive(buf + 2560, 9);
-    helper_float_30_recursive(buf + 3072, 9);
-    helper_float_30_recursive(buf + 3584, 9);
+    helper_float_avx_30_recursive(buf + 0, 9);
+    helper_float_avx_30_recursive(buf + 512, 9);
+    helper_float_avx_30_recursive(buf + 1024, 9);
+    helper_float_avx_30_recursive(buf + 1536, 9);
+    helper_float_avx_30_recursive(buf + 2048, 9);
+    helper_float_avx_30_recursive(buf + 2560, 9);
+    helper_float_avx_30_recursive(buf + 3072, 9);
+    helper_float_avx_30_recursive(buf + 3584, 9);
     for (int j = 0; j < 4096; j += 4096) {
       for (int k = 0; k < 512; k += 8) {
         __asm__ volatile (
@@ -9726,14 +9726,14 @@ void helper_float_30_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_float_30_recursive(buf + 0, 12);
-    helper_float_30_recursive(buf + 4096, 12);
-    helper_float_30_recursive(buf + 8192, 12);
-    helper_float_30_recursive(buf + 12288, 12);
-    helper_float_30_recursive(buf + 16384, 12);
-    helper_float_30_recursive(buf + 20480, 12);
-    helper_float_30_recursive(buf + 24576, 12);
-    helper_float_30_recursive(buf + 28672, 12);
+    helper_float_avx_30_recursive(buf + 0, 12);
+    helper_float_avx_30_recursive(buf + 4096, 12);
+    helper_float_avx_30_recursive(buf + 8192, 12);
+    helper_float_avx_30_recursive(buf + 12288, 12);
+    helper_float_avx_30_recursive(buf + 16384, 12);
+    helper_float_avx_30_recursive(buf + 20480, 12);
+    helper_float_avx_30_recursive(buf + 24576, 12);
+    helper_float_avx_30_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 8) {
         __asm__ volatile (
@@ -9784,14 +9784,14 @@ void helper_float_30_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_float_30_recursive(buf + 0, 15);
-    helper_float_30_recursive(buf + 32768, 15);
-    helper_float_30_recursive(buf + 65536, 15);
-    helper_float_30_recursive(buf + 98304, 15);
-    helper_float_30_recursive(buf + 131072, 15);
-    helper_float_30_recursive(buf + 163840, 15);
-    helper_float_30_recursive(buf + 196608, 15);
-    helper_float_30_recursive(buf + 229376, 15);
+    helper_float_avx_30_recursive(buf + 0, 15);
+    helper_float_avx_30_recursive(buf + 32768, 15);
+    helper_float_avx_30_recursive(buf + 65536, 15);
+    helper_float_avx_30_recursive(buf + 98304, 15);
+    helper_float_avx_30_recursive(buf + 131072, 15);
+    helper_float_avx_30_recursive(buf + 163840, 15);
+    helper_float_avx_30_recursive(buf + 196608, 15);
+    helper_float_avx_30_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 8) {
         __asm__ volatile (
@@ -9842,14 +9842,14 @@ void helper_float_30_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_float_30_recursive(buf + 0, 18);
-    helper_float_30_recursive(buf + 262144, 18);
-    helper_float_30_recursive(buf + 524288, 18);
-    helper_float_30_recursive(buf + 786432, 18);
-    helper_float_30_recursive(buf + 1048576, 18);
-    helper_float_30_recursive(buf + 1310720, 18);
-    helper_float_30_recursive(buf + 1572864, 18);
-    helper_float_30_recursive(buf + 1835008, 18);
+    helper_float_avx_30_recursive(buf + 0, 18);
+    helper_float_avx_30_recursive(buf + 262144, 18);
+    helper_float_avx_30_recursive(buf + 524288, 18);
+    helper_float_avx_30_recursive(buf + 786432, 18);
+    helper_float_avx_30_recursive(buf + 1048576, 18);
+    helper_float_avx_30_recursive(buf + 1310720, 18);
+    helper_float_avx_30_recursive(buf + 1572864, 18);
+    helper_float_avx_30_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 8) {
         __asm__ volatile (
@@ -9900,14 +9900,14 @@ void helper_float_30_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 24) {
-    helper_float_30_recursive(buf + 0, 21);
-    helper_float_30_recursive(buf + 2097152, 21);
-    helper_float_30_recursive(buf + 4194304, 21);
-    helper_float_30_recursive(buf + 6291456, 21);
-    helper_float_30_recursive(buf + 8388608, 21);
-    helper_float_30_recursive(buf + 10485760, 21);
-    helper_float_30_recursive(buf + 12582912, 21);
-    helper_float_30_recursive(buf + 14680064, 21);
+    helper_float_avx_30_recursive(buf + 0, 21);
+    helper_float_avx_30_recursive(buf + 2097152, 21);
+    helper_float_avx_30_recursive(buf + 4194304, 21);
+    helper_float_avx_30_recursive(buf + 6291456, 21);
+    helper_float_avx_30_recursive(buf + 8388608, 21);
+    helper_float_avx_30_recursive(buf + 10485760, 21);
+    helper_float_avx_30_recursive(buf + 12582912, 21);
+    helper_float_avx_30_recursive(buf + 14680064, 21);
     for (int j = 0; j < 16777216; j += 16777216) {
       for (int k = 0; k < 2097152; k += 8) {
         __asm__ volatile (
@@ -9958,14 +9958,14 @@ void helper_float_30_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 27) {
-    helper_float_30_recursive(buf + 0, 24);
-    helper_float_30_recursive(buf + 16777216, 24);
-    helper_float_30_recursive(buf + 33554432, 24);
-    helper_float_30_recursive(buf + 50331648, 24);
-    helper_float_30_recursive(buf + 67108864, 24);
-    helper_float_30_recursive(buf + 83886080, 24);
-    helper_float_30_recursive(buf + 100663296, 24);
-    helper_float_30_recursive(buf + 117440512, 24);
+    helper_float_avx_30_recursive(buf + 0, 24);
+    helper_float_avx_30_recursive(buf + 16777216, 24);
+    helper_float_avx_30_recursive(buf + 33554432, 24);
+    helper_float_avx_30_recursive(buf + 50331648, 24);
+    helper_float_avx_30_recursive(buf + 67108864, 24);
+    helper_float_avx_30_recursive(buf + 83886080, 24);
+    helper_float_avx_30_recursive(buf + 100663296, 24);
+    helper_float_avx_30_recursive(buf + 117440512, 24);
     for (int j = 0; j < 134217728; j += 134217728) {
       for (int k = 0; k < 16777216; k += 8) {
         __asm__ volatile (
@@ -10016,14 +10016,14 @@ void helper_float_30_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 30) {
-    helper_float_30_recursive(buf + 0, 27);
-    helper_float_30_recursive(buf + 134217728, 27);
-    helper_float_30_recursive(buf + 268435456, 27);
-    helper_float_30_recursive(buf + 402653184, 27);
-    helper_float_30_recursive(buf + 536870912, 27);
-    helper_float_30_recursive(buf + 671088640, 27);
-    helper_float_30_recursive(buf + 805306368, 27);
-    helper_float_30_recursive(buf + 939524096, 27);
+    helper_float_avx_30_recursive(buf + 0, 27);
+    helper_float_avx_30_recursive(buf + 134217728, 27);
+    helper_float_avx_30_recursive(buf + 268435456, 27);
+    helper_float_avx_30_recursive(buf + 402653184, 27);
+    helper_float_avx_30_recursive(buf + 536870912, 27);
+    helper_float_avx_30_recursive(buf + 671088640, 27);
+    helper_float_avx_30_recursive(buf + 805306368, 27);
+    helper_float_avx_30_recursive(buf + 939524096, 27);
     for (int j = 0; j < 1073741824; j += 1073741824) {
       for (int k = 0; k < 134217728; k += 8) {
         __asm__ volatile (
@@ -10074,138 +10074,172 @@ void helper_float_30_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_30(float *buf);
-void helper_float_30(float *buf) {
-  helper_float_30_recursive(buf, 30);
+FHT_TARGET("avx") void helper_float_avx_30(float *buf);
+FHT_TARGET("avx") void helper_float_avx_30(float *buf) {
+  helper_float_avx_30_recursive(buf, 30);
 }
-int fht_float(float *buf, int log_n) {
+FHT_TARGET("avx") int fht_float_avx(float *buf, int log_n);
+FHT_TARGET("avx") int fht_float_avx(float *buf, int log_n) {
   if (log_n == 0) {
     return 0;
   }
   if (log_n == 1) {
-    helper_float_1(buf);
+    helper_float_avx_1(buf);
     return 0;
   }
   if (log_n == 2) {
-    helper_float_2(buf);
+    helper_float_avx_2(buf);
     return 0;
   }
   if (log_n == 3) {
-    helper_float_3(buf);
+    helper_float_avx_3(buf);
     return 0;
   }
   if (log_n == 4) {
-    helper_float_4(buf);
+    helper_float_avx_4(buf);
     return 0;
   }
   if (log_n == 5) {
-    helper_float_5(buf);
+    helper_float_avx_5(buf);
     return 0;
   }
   if (log_n == 6) {
-    helper_float_6(buf);
+    helper_float_avx_6(buf);
     return 0;
   }
   if (log_n == 7) {
-    helper_float_7(buf);
+    helper_float_avx_7(buf);
     return 0;
   }
   if (log_n == 8) {
-    helper_float_8(buf);
+    helper_float_avx_8(buf);
     return 0;
   }
   if (log_n == 9) {
-    helper_float_9(buf);
+    helper_float_avx_9(buf);
     return 0;
   }
   if (log_n == 10) {
-    helper_float_10(buf);
+    helper_float_avx_10(buf);
     return 0;
   }
   if (log_n == 11) {
-    helper_float_11(buf);
+    helper_float_avx_11(buf);
     return 0;
   }
   if (log_n == 12) {
-    helper_float_12(buf);
+    helper_float_avx_12(buf);
     return 0;
   }
   if (log_n == 13) {
-    helper_float_13(buf);
+    helper_float_avx_13(buf);
     return 0;
   }
   if (log_n == 14) {
-    helper_float_14(buf);
+    helper_float_avx_14(buf);
     return 0;
   }
   if (log_n == 15) {
-    helper_float_15(buf);
+    helper_float_avx_15(buf);
     return 0;
   }
   if (log_n == 16) {
-    helper_float_16(buf);
+    helper_float_avx_16(buf);
     return 0;
   }
   if (log_n == 17) {
-    helper_float_17(buf);
+    helper_float_avx_17(buf);
     return 0;
   }
   if (log_n == 18) {
-    helper_float_18(buf);
+    helper_float_avx_18(buf);
     return 0;
   }
   if (log_n == 19) {
-    helper_float_19(buf);
+    helper_float_avx_19(buf);
     return 0;
   }
   if (log_n == 20) {
-    helper_float_20(buf);
+    helper_float_avx_20(buf);
     return 0;
   }
   if (log_n == 21) {
-    helper_float_21(buf);
+    helper_float_avx_21(buf);
     return 0;
   }
   if (log_n == 22) {
-    helper_float_22(buf);
+    helper_float_avx_22(buf);
     return 0;
   }
   if (log_n == 23) {
-    helper_float_23(buf);
+    helper_float_avx_23(buf);
     return 0;
   }
   if (log_n == 24) {
-    helper_float_24(buf);
+    helper_float_avx_24(buf);
     return 0;
   }
   if (log_n == 25) {
-    helper_float_25(buf);
+    helper_float_avx_25(buf);
     return 0;
   }
   if (log_n == 26) {
-    helper_float_26(buf);
+    helper_float_avx_26(buf);
     return 0;
   }
   if (log_n == 27) {
-    helper_float_27(buf);
+    helper_float_avx_27(buf);
     return 0;
   }
   if (log_n == 28) {
-    helper_float_28(buf);
+    helper_float_avx_28(buf);
     return 0;
   }
   if (log_n == 29) {
-    helper_float_29(buf);
+    helper_float_avx_29(buf);
     return 0;
   }
   if (log_n == 30) {
-    helper_float_30(buf);
+    helper_float_avx_30(buf);
     return 0;
   }
   return 1;
 }
-static inline void helper_double_1(double *buf);
-static inline void helper_double_1(double *buf) {
+static void (*const fht_float_avx_helpers[31])(float *) = {
+  0,
+  helper_float_avx_1,
+  helper_float_avx_2,
+  helper_float_avx_3,
+  helper_float_avx_4,
+  helper_float_avx_5,
+  helper_float_avx_6,
+  helper_float_avx_7,
+  helper_float_avx_8,
+  helper_float_avx_9,
+  helper_float_avx_10,
+  helper_float_avx_11,
+  helper_float_avx_12,
+  helper_float_avx_13,
+  helper_float_avx_14,
+  helper_float_avx_15,
+  helper_float_avx_16,
+  helper_float_avx_17,
+  helper_float_avx_18,
+  helper_float_avx_19,
+  helper_float_avx_20,
+  helper_float_avx_21,
+  helper_float_avx_22,
+  helper_float_avx_23,
+  helper_float_avx_24,
+  helper_float_avx_25,
+  helper_float_avx_26,
+  helper_float_avx_27,
+  helper_float_avx_28,
+  helper_float_avx_29,
+  helper_float_avx_30,
+};
+FHT_TARGET("avx") static inline void helper_double_avx_1(double *buf);
+FHT_TARGET("avx") static inline void helper_double_avx_1(double *buf) {
   for (int j = 0; j < 2; j += 2) {
     for (int k = 0; k < 1; ++k) {
       double u = buf[j + k];
@@ -10215,8 +10249,8 @@ static inline void helper_double_1(double *buf) {
     }
   }
 }
-static inline void helper_double_2(double *buf);
-static inline void helper_double_2(double *buf) {
+FHT_TARGET("avx") static inline void helper_double_avx_2(double *buf);
+FHT_TARGET("avx") static inline void helper_double_avx_2(double *buf) {
   for (int j = 0; j < 4; j += 4) {
     __asm__ volatile (
       "vmovupd (%0), %%ymm0\n"
@@ -10235,8 +10269,8 @@ static inline void helper_double_2(double *buf) {
     );
   }
 }
-static inline void helper_double_3(double *buf);
-static inline void helper_double_3(double *buf) {
+FHT_TARGET("avx") static inline void helper_double_avx_3(double *buf);
+FHT_TARGET("avx") static inline void helper_double_avx_3(double *buf) {
   for (int j = 0; j < 8; j += 8) {
     for (int k = 0; k < 4; k += 4) {
       __asm__ volatile (
@@ -10271,8 +10305,8 @@ static inline void helper_double_3(double *buf) {
     }
   }
 }
-void helper_double_4_recursive(double *buf, int depth);
-void helper_double_4_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_4_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_4_recursive(double *buf, int depth) {
   if (depth == 4) {
     for (int j = 0; j < 16; j += 16) {
       for (int k = 0; k < 4; k += 4) {
@@ -10340,12 +10374,12 @@ void helper_double_4_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_4(double *buf);
-void helper_double_4(double *buf) {
-  helper_double_4_recursive(buf, 4);
+FHT_TARGET("avx") void helper_double_avx_4(double *buf);
+FHT_TARGET("avx") void helper_double_avx_4(double *buf) {
+  helper_double_avx_4_recursive(buf, 4);
 }
-static inline void helper_double_5(double *buf);
-static inline void helper_double_5(double *buf) {
+FHT_TARGET("avx") static inline void helper_double_avx_5(double *buf);
+FHT_TARGET("avx") static inline void helper_double_avx_5(double *buf) {
   for (int j = 0; j < 32; j += 32) {
     for (int k = 0; k < 4; k += 4) {
       __asm__ volatile (
@@ -10474,8 +10508,8 @@ static inline void helper_double_5(double *buf) {
     }
   }
 }
-static inline void helper_double_6(double *buf);
-static inline void helper_double_6(double *buf) {
+FHT_TARGET("avx") static inline void helper_double_avx_6(double *buf);
+FHT_TARGET("avx") static inline void helper_double_avx_6(double *buf) {
   for (int j = 0; j < 64; j += 32) {
     for (int k = 0; k < 4; k += 4) {
       __asm__ volatile (
@@ -10617,8 +10651,8 @@ static inline void helper_double_6(double *buf) {
     }
   }
 }
-static inline void helper_double_7(double *buf);
-static inline void helper_double_7(double *buf) {
+FHT_TARGET("avx") static inline void helper_double_avx_7(double *buf);
+FHT_TARGET("avx") static inline void helper_double_avx_7(double *buf) {
   for (int j = 0; j < 128; j += 32) {
     for (int k = 0; k < 4; k += 4) {
       __asm__ volatile (
@@ -10770,8 +10804,8 @@ static inline void helper_double_7(double *buf) {
     }
   }
 }
-static inline void helper_double_8(double *buf);
-static inline void helper_double_8(double *buf) {
+FHT_TARGET("avx") static inline void helper_double_avx_8(double *buf);
+FHT_TARGET("avx") static inline void helper_double_avx_8(double *buf) {
   for (int j = 0; j < 256; j += 32) {
     for (int k = 0; k < 4; k += 4) {
       __asm__ volatile (
@@ -10947,8 +10981,8 @@ static inline void helper_double_8(double *buf) {
     }
   }
 }
-static inline void helper_double_9(double *buf);
-static inline void helper_double_9(double *buf) {
+FHT_TARGET("avx") static inline void helper_double_avx_9(double *buf);
+FHT_TARGET("avx") static inline void helper_double_avx_9(double *buf) {
   for (int j = 0; j < 512; j += 32) {
     for (int k = 0; k < 4; k += 4) {
       __asm__ volatile (
@@ -11137,8 +11171,8 @@ static inline void helper_double_9(double *buf) {
     }
   }
 }
-static inline void helper_double_10(double *buf);
-static inline void helper_double_10(double *buf) {
+FHT_TARGET("avx") static inline void helper_double_avx_10(double *buf);
+FHT_TARGET("avx") static inline void helper_double_avx_10(double *buf) {
   for (int j = 0; j < 1024; j += 32) {
     for (int k = 0; k < 4; k += 4) {
       __asm__ volatile (
@@ -11337,8 +11371,8 @@ static inline void helper_double_10(double *buf) {
     }
   }
 }
-static inline void helper_double_11(double *buf);
-static inline void helper_double_11(double *buf) {
+FHT_TARGET("avx") static inline void helper_double_avx_11(double *buf);
+FHT_TARGET("avx") static inline void helper_double_avx_11(double *buf) {
   for (int j = 0; j < 2048; j += 32) {
     for (int k = 0; k < 4; k += 4) {
       __asm__ volatile (
@@ -11561,8 +11595,8 @@ static inline void helper_double_11(double *buf) {
     }
   }
 }
-void helper_double_12_recursive(double *buf, int depth);
-void helper_double_12_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_12_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_12_recursive(double *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -11788,8 +11822,8 @@ void helper_double_12_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 12) {
-    helper_double_12_recursive(buf + 0, 11);
-    helper_double_12_recursive(buf + 2048, 11);
+    helper_double_avx_12_recursive(buf + 0, 11);
+    helper_double_avx_12_recursive(buf + 2048, 11);
     for (int j = 0; j < 4096; j += 4096) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -11806,12 +11840,12 @@ void helper_double_12_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_12(double *buf);
-void helper_double_12(double *buf) {
-  helper_double_12_recursive(buf, 12);
+FHT_TARGET("avx") void helper_double_avx_12(double *buf);
+FHT_TARGET("avx") void helper_double_avx_12(double *buf) {
+  helper_double_avx_12_recursive(buf, 12);
 }
-void helper_double_13_recursive(double *buf, int depth);
-void helper_double_13_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_13_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_13_recursive(double *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -12037,10 +12071,10 @@ void helper_double_13_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 13) {
-    helper_double_13_recursive(buf + 0, 11);
-    helper_double_13_recursive(buf + 2048, 11);
-    helper_double_13_recursive(buf + 4096, 11);
-    helper_double_13_recursive(buf + 6144, 11);
+    helper_double_avx_13_recursive(buf + 0, 11);
+    helper_double_avx_13_recursive(buf + 2048, 11);
+    helper_double_avx_13_recursive(buf + 4096, 11);
+    helper_double_avx_13_recursive(buf + 6144, 11);
     for (int j = 0; j < 8192; j += 8192) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -12067,12 +12101,12 @@ void helper_double_13_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_13(double *buf);
-void helper_double_13(double *buf) {
-  helper_double_13_recursive(buf, 13);
+FHT_TARGET("avx") void helper_double_avx_13(double *buf);
+FHT_TARGET("avx") void helper_double_avx_13(double *buf) {
+  helper_double_avx_13_recursive(buf, 13);
 }
-void helper_double_14_recursive(double *buf, int depth);
-void helper_double_14_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_14_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_14_recursive(double *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -12311,10 +12345,10 @@ void helper_double_14_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_double_14_recursive(buf + 0, 12);
-    helper_double_14_recursive(buf + 4096, 12);
-    helper_double_14_recursive(buf + 8192, 12);
-    helper_double_14_recursive(buf + 12288, 12);
+    helper_double_avx_14_recursive(buf + 0, 12);
+    helper_double_avx_14_recursive(buf + 4096, 12);
+    helper_double_avx_14_recursive(buf + 8192, 12);
+    helper_double_avx_14_recursive(buf + 12288, 12);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 4096; k += 4) {
         __asm__ volatile (
@@ -12341,12 +12375,12 @@ void helper_double_14_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_14(double *buf);
-void helper_double_14(double *buf) {
-  helper_double_14_recursive(buf, 14);
+FHT_TARGET("avx") void helper_double_avx_14(double *buf);
+FHT_TARGET("avx") void helper_double_avx_14(double *buf) {
+  helper_double_avx_14_recursive(buf, 14);
 }
-void helper_double_15_recursive(double *buf, int depth);
-void helper_double_15_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_15_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_15_recursive(double *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -12585,14 +12619,14 @@ void helper_double_15_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_double_15_recursive(buf + 0, 12);
-    helper_double_15_recursive(buf + 4096, 12);
-    helper_double_15_recursive(buf + 8192, 12);
-    helper_double_15_recursive(buf + 12288, 12);
-    helper_double_15_recursive(buf + 16384, 12);
-    helper_double_15_recursive(buf + 20480, 12);
-    helper_double_15_recursive(buf + 24576, 12);
-    helper_double_15_recursive(buf + 28672, 12);
+    helper_double_avx_15_recursive(buf + 0, 12);
+    helper_double_avx_15_recursive(buf + 4096, 12);
+    helper_double_avx_15_recursive(buf + 8192, 12);
+    helper_double_avx_15_recursive(buf + 12288, 12);
+    helper_double_avx_15_recursive(buf + 16384, 12);
+    helper_double_avx_15_recursive(buf + 20480, 12);
+    helper_double_avx_15_recursive(buf + 24576, 12);
+    helper_double_avx_15_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 4) {
         __asm__ volatile (
@@ -12643,12 +12677,12 @@ void helper_double_15_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_15(double *buf);
-void helper_double_15(double *buf) {
-  helper_double_15_recursive(buf, 15);
+FHT_TARGET("avx") void helper_double_avx_15(double *buf);
+FHT_TARGET("avx") void helper_double_avx_15(double *buf) {
+  helper_double_avx_15_recursive(buf, 15);
 }
-void helper_double_16_recursive(double *buf, int depth);
-void helper_double_16_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_16_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_16_recursive(double *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -12874,14 +12908,14 @@ void helper_double_16_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_double_16_recursive(buf + 0, 11);
-    helper_double_16_recursive(buf + 2048, 11);
-    helper_double_16_recursive(buf + 4096, 11);
-    helper_double_16_recursive(buf + 6144, 11);
-    helper_double_16_recursive(buf + 8192, 11);
-    helper_double_16_recursive(buf + 10240, 11);
-    helper_double_16_recursive(buf + 12288, 11);
-    helper_double_16_recursive(buf + 14336, 11);
+    helper_double_avx_16_recursive(buf + 0, 11);
+    helper_double_avx_16_recursive(buf + 2048, 11);
+    helper_double_avx_16_recursive(buf + 4096, 11);
+    helper_double_avx_16_recursive(buf + 6144, 11);
+    helper_double_avx_16_recursive(buf + 8192, 11);
+    helper_double_avx_16_recursive(buf + 10240, 11);
+    helper_double_avx_16_recursive(buf + 12288, 11);
+    helper_double_avx_16_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -12932,10 +12966,10 @@ void helper_double_16_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 16) {
-    helper_double_16_recursive(buf + 0, 14);
-    helper_double_16_recursive(buf + 16384, 14);
-    helper_double_16_recursive(buf + 32768, 14);
-    helper_double_16_recursive(buf + 49152, 14);
+    helper_double_avx_16_recursive(buf + 0, 14);
+    helper_double_avx_16_recursive(buf + 16384, 14);
+    helper_double_avx_16_recursive(buf + 32768, 14);
+    helper_double_avx_16_recursive(buf + 49152, 14);
     for (int j = 0; j < 65536; j += 65536) {
       for (int k = 0; k < 16384; k += 4) {
         __asm__ volatile (
@@ -12962,12 +12996,12 @@ void helper_double_16_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_16(double *buf);
-void helper_double_16(double *buf) {
-  helper_double_16_recursive(buf, 16);
+FHT_TARGET("avx") void helper_double_avx_16(double *buf);
+FHT_TARGET("avx") void helper_double_avx_16(double *buf) {
+  helper_double_avx_16_recursive(buf, 16);
 }
-void helper_double_17_recursive(double *buf, int depth);
-void helper_double_17_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_17_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_17_recursive(double *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -13193,14 +13227,14 @@ void helper_double_17_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_double_17_recursive(buf + 0, 11);
-    helper_double_17_recursive(buf + 2048, 11);
-    helper_double_17_recursive(buf + 4096, 11);
-    helper_double_17_recursive(buf + 6144, 11);
-    helper_double_17_recursive(buf + 8192, 11);
-    helper_double_17_recursive(buf + 10240, 11);
-    helper_double_17_recursive(buf + 12288, 11);
-    helper_double_17_recursive(buf + 14336, 11);
+    helper_double_avx_17_recursive(buf + 0, 11);
+    helper_double_avx_17_recursive(buf + 2048, 11);
+    helper_double_avx_17_recursive(buf + 4096, 11);
+    helper_double_avx_17_recursive(buf + 6144, 11);
+    helper_double_avx_17_recursive(buf + 8192, 11);
+    helper_double_avx_17_recursive(buf + 10240, 11);
+    helper_double_avx_17_recursive(buf + 12288, 11);
+    helper_double_avx_17_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -13251,14 +13285,14 @@ void helper_double_17_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_double_17_recursive(buf + 0, 14);
-    helper_double_17_recursive(buf + 16384, 14);
-    helper_double_17_recursive(buf + 32768, 14);
-    helper_double_17_recursive(buf + 49152, 14);
-    helper_double_17_recursive(buf + 65536, 14);
-    helper_double_17_recursive(buf + 81920, 14);
-    helper_double_17_recursive(buf + 98304, 14);
-    helper_double_17_recursive(buf + 114688, 14);
+    helper_double_avx_17_recursive(buf + 0, 14);
+    helper_double_avx_17_recursive(buf + 16384, 14);
+    helper_double_avx_17_recursive(buf + 32768, 14);
+    helper_double_avx_17_recursive(buf + 49152, 14);
+    helper_double_avx_17_recursive(buf + 65536, 14);
+    helper_double_avx_17_recursive(buf + 81920, 14);
+    helper_double_avx_17_recursive(buf + 98304, 14);
+    helper_double_avx_17_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 4) {
         __asm__ volatile (
@@ -13309,12 +13343,12 @@ void helper_double_17_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_17(double *buf);
-void helper_double_17(double *buf) {
-  helper_double_17_recursive(buf, 17);
+FHT_TARGET("avx") void helper_double_avx_17(double *buf);
+FHT_TARGET("avx") void helper_double_avx_17(double *buf) {
+  helper_double_avx_17_recursive(buf, 17);
 }
-void helper_double_18_recursive(double *buf, int depth);
-void helper_double_18_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_18_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_18_recursive(double *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -13553,14 +13587,14 @@ void helper_double_18_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_double_18_recursive(buf + 0, 12);
-    helper_double_18_recursive(buf + 4096, 12);
-    helper_double_18_recursive(buf + 8192, 12);
-    helper_double_18_recursive(buf + 12288, 12);
-    helper_double_18_recursive(buf + 16384, 12);
-    helper_double_18_recursive(buf + 20480, 12);
-    helper_double_18_recursive(buf + 24576, 12);
-    helper_double_18_recursive(buf + 28672, 12);
+    helper_double_avx_18_recursive(buf + 0, 12);
+    helper_double_avx_18_recursive(buf + 4096, 12);
+    helper_double_avx_18_recursive(buf + 8192, 12);
+    helper_double_avx_18_recursive(buf + 12288, 12);
+    helper_double_avx_18_recursive(buf + 16384, 12);
+    helper_double_avx_18_recursive(buf + 20480, 12);
+    helper_double_avx_18_recursive(buf + 24576, 12);
+    helper_double_avx_18_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 4) {
         __asm__ volatile (
@@ -13611,14 +13645,14 @@ void helper_double_18_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_double_18_recursive(buf + 0, 15);
-    helper_double_18_recursive(buf + 32768, 15);
-    helper_double_18_recursive(buf + 65536, 15);
-    helper_double_18_recursive(buf + 98304, 15);
-    helper_double_18_recursive(buf + 131072, 15);
-    helper_double_18_recursive(buf + 163840, 15);
-    helper_double_18_recursive(buf + 196608, 15);
-    helper_double_18_recursive(buf + 229376, 15);
+    helper_double_avx_18_recursive(buf + 0, 15);
+    helper_double_avx_18_recursive(buf + 32768, 15);
+    helper_double_avx_18_recursive(buf + 65536, 15);
+    helper_double_avx_18_recursive(buf + 98304, 15);
+    helper_double_avx_18_recursive(buf + 131072, 15);
+    helper_double_avx_18_recursive(buf + 163840, 15);
+    helper_double_avx_18_recursive(buf + 196608, 15);
+    helper_double_avx_18_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 4) {
         __asm__ volatile (
@@ -13669,12 +13703,12 @@ void helper_double_18_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_18(double *buf);
-void helper_double_18(double *buf) {
-  helper_double_18_recursive(buf, 18);
+FHT_TARGET("avx") void helper_double_avx_18(double *buf);
+FHT_TARGET("avx") void helper_double_avx_18(double *buf) {
+  helper_double_avx_18_recursive(buf, 18);
 }
-void helper_double_19_recursive(double *buf, int depth);
-void helper_double_19_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_19_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_19_recursive(double *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -13900,14 +13934,14 @@ void helper_double_19_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_double_19_recursive(buf + 0, 11);
-    helper_double_19_recursive(buf + 2048, 11);
-    helper_double_19_recursive(buf + 4096, 11);
-    helper_double_19_recursive(buf + 6144, 11);
-    helper_double_19_recursive(buf + 8192, 11);
-    helper_double_19_recursive(buf + 10240, 11);
-    helper_double_19_recursive(buf + 12288, 11);
-    helper_double_19_recursive(buf + 14336, 11);
+    helper_double_avx_19_recursive(buf + 0, 11);
+    helper_double_avx_19_recursive(buf + 2048, 11);
+    helper_double_avx_19_recursive(buf + 4096, 11);
+    helper_double_avx_19_recursive(buf + 6144, 11);
+    helper_double_avx_19_recursive(buf + 8192, 11);
+    helper_double_avx_19_recursive(buf + 10240, 11);
+    helper_double_avx_19_recursive(buf + 12288, 11);
+    helper_double_avx_19_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -13958,14 +13992,14 @@ void helper_double_19_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_double_19_recursive(buf + 0, 14);
-    helper_double_19_recursive(buf + 16384, 14);
-    helper_double_19_recursive(buf + 32768, 14);
-    helper_double_19_recursive(buf + 49152, 14);
-    helper_double_19_recursive(buf + 65536, 14);
-    helper_double_19_recursive(buf + 81920, 14);
-    helper_double_19_recursive(buf + 98304, 14);
-    helper_double_19_recursive(buf + 114688, 14);
+    helper_double_avx_19_recursive(buf + 0, 14);
+    helper_double_avx_19_recursive(buf + 16384, 14);
+    helper_double_avx_19_recursive(buf + 32768, 14);
+    helper_double_avx_19_recursive(buf + 49152, 14);
+    helper_double_avx_19_recursive(buf + 65536, 14);
+    helper_double_avx_19_recursive(buf + 81920, 14);
+    helper_double_avx_19_recursive(buf + 98304, 14);
+    helper_double_avx_19_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 4) {
         __asm__ volatile (
@@ -14016,10 +14050,10 @@ void helper_double_19_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 19) {
-    helper_double_19_recursive(buf + 0, 17);
-    helper_double_19_recursive(buf + 131072, 17);
-    helper_double_19_recursive(buf + 262144, 17);
-    helper_double_19_recursive(buf + 393216, 17);
+    helper_double_avx_19_recursive(buf + 0, 17);
+    helper_double_avx_19_recursive(buf + 131072, 17);
+    helper_double_avx_19_recursive(buf + 262144, 17);
+    helper_double_avx_19_recursive(buf + 393216, 17);
     for (int j = 0; j < 524288; j += 524288) {
       for (int k = 0; k < 131072; k += 4) {
         __asm__ volatile (
@@ -14046,12 +14080,12 @@ void helper_double_19_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_19(double *buf);
-void helper_double_19(double *buf) {
-  helper_double_19_recursive(buf, 19);
+FHT_TARGET("avx") void helper_double_avx_19(double *buf);
+FHT_TARGET("avx") void helper_double_avx_19(double *buf) {
+  helper_double_avx_19_recursive(buf, 19);
 }
-void helper_double_20_recursive(double *buf, int depth);
-void helper_double_20_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_20_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_20_recursive(double *buf, int depth) {
   if (depth == 9) {
     for (int j = 0; j < 512; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -14243,14 +14277,14 @@ void helper_double_20_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 12) {
-    helper_double_20_recursive(buf + 0, 9);
-    helper_double_20_recursive(buf + 512, 9);
-    helper_double_20_recursive(buf + 1024, 9);
-    helper_double_20_recursive(buf + 1536, 9);
-    helper_double_20_recursive(buf + 2048, 9);
-    helper_double_20_recursive(buf + 2560, 9);
-    helper_double_20_recursive(buf + 3072, 9);
-    helper_double_20_recursive(buf + 3584, 9);
+    helper_double_avx_20_recursive(buf + 0, 9);
+    helper_double_avx_20_recursive(buf + 512, 9);
+    helper_double_avx_20_recursive(buf + 1024, 9);
+    helper_double_avx_20_recursive(buf + 1536, 9);
+    helper_double_avx_20_recursive(buf + 2048, 9);
+    helper_double_avx_20_recursive(buf + 2560, 9);
+    helper_double_avx_20_recursive(buf + 3072, 9);
+    helper_double_avx_20_recursive(buf + 3584, 9);
     for (int j = 0; j < 4096; j += 4096) {
       for (int k = 0; k < 512; k += 4) {
         __asm__ volatile (
@@ -14301,14 +14335,14 @@ void helper_double_20_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_double_20_recursive(buf + 0, 12);
-    helper_double_20_recursive(buf + 4096, 12);
-    helper_double_20_recursive(buf + 8192, 12);
-    helper_double_20_recursive(buf + 12288, 12);
-    helper_double_20_recursive(buf + 16384, 12);
-    helper_double_20_recursive(buf + 20480, 12);
-    helper_double_20_recursive(buf + 24576, 12);
-    helper_double_20_recursive(buf + 28672, 12);
+    helper_double_avx_20_recursive(buf + 0, 12);
+    helper_double_avx_20_recursive(buf + 4096, 12);
+    helper_double_avx_20_recursive(buf + 8192, 12);
+    helper_double_avx_20_recursive(buf + 12288, 12);
+    helper_double_avx_20_recursive(buf + 16384, 12);
+    helper_double_avx_20_recursive(buf + 20480, 12);
+    helper_double_avx_20_recursive(buf + 24576, 12);
+    helper_double_avx_20_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 4) {
         __asm__ volatile (
@@ -14359,14 +14393,14 @@ void helper_double_20_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_double_20_recursive(buf + 0, 15);
-    helper_double_20_recursive(buf + 32768, 15);
-    helper_double_20_recursive(buf + 65536, 15);
-    helper_double_20_recursive(buf + 98304, 15);
-    helper_double_20_recursive(buf + 131072, 15);
-    helper_double_20_recursive(buf + 163840, 15);
-    helper_double_20_recursive(buf + 196608, 15);
-    helper_double_20_recursive(buf + 229376, 15);
+    helper_double_avx_20_recursive(buf + 0, 15);
+    helper_double_avx_20_recursive(buf + 32768, 15);
+    helper_double_avx_20_recursive(buf + 65536, 15);
+    helper_double_avx_20_recursive(buf + 98304, 15);
+    helper_double_avx_20_recursive(buf + 131072, 15);
+    helper_double_avx_20_recursive(buf + 163840, 15);
+    helper_double_avx_20_recursive(buf + 196608, 15);
+    helper_double_avx_20_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 4) {
         __asm__ volatile (
@@ -14417,10 +14451,10 @@ void helper_double_20_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_double_20_recursive(buf + 0, 18);
-    helper_double_20_recursive(buf + 262144, 18);
-    helper_double_20_recursive(buf + 524288, 18);
-    helper_double_20_recursive(buf + 786432, 18);
+    helper_double_avx_20_recursive(buf + 0, 18);
+    helper_double_avx_20_recursive(buf + 262144, 18);
+    helper_double_avx_20_recursive(buf + 524288, 18);
+    helper_double_avx_20_recursive(buf + 786432, 18);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 262144; k += 4) {
         __asm__ volatile (
@@ -14447,12 +14481,12 @@ void helper_double_20_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_20(double *buf);
-void helper_double_20(double *buf) {
-  helper_double_20_recursive(buf, 20);
+FHT_TARGET("avx") void helper_double_avx_20(double *buf);
+FHT_TARGET("avx") void helper_double_avx_20(double *buf) {
+  helper_double_avx_20_recursive(buf, 20);
 }
-void helper_double_21_recursive(double *buf, int depth);
-void helper_double_21_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_21_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_21_recursive(double *buf, int depth) {
   if (depth == 7) {
     for (int j = 0; j < 128; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -14607,14 +14641,14 @@ void helper_double_21_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 10) {
-    helper_double_21_recursive(buf + 0, 7);
-    helper_double_21_recursive(buf + 128, 7);
-    helper_double_21_recursive(buf + 256, 7);
-    helper_double_21_recursive(buf + 384, 7);
-    helper_double_21_recursive(buf + 512, 7);
-    helper_double_21_recursive(buf + 640, 7);
-    helper_double_21_recursive(buf + 768, 7);
-    helper_double_21_recursive(buf + 896, 7);
+    helper_double_avx_21_recursive(buf + 0, 7);
+    helper_double_avx_21_recursive(buf + 128, 7);
+    helper_double_avx_21_recursive(buf + 256, 7);
+    helper_double_avx_21_recursive(buf + 384, 7);
+    helper_double_avx_21_recursive(buf + 512, 7);
+    helper_double_avx_21_recursive(buf + 640, 7);
+    helper_double_avx_21_recursive(buf + 768, 7);
+    helper_double_avx_21_recursive(buf + 896, 7);
     for (int j = 0; j < 1024; j += 1024) {
       for (int k = 0; k < 128; k += 4) {
         __asm__ volatile (
@@ -14665,14 +14699,14 @@ void helper_double_21_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 13) {
-    helper_double_21_recursive(buf + 0, 10);
-    helper_double_21_recursive(buf + 1024, 10);
-    helper_double_21_recursive(buf + 2048, 10);
-    helper_double_21_recursive(buf + 3072, 10);
-    helper_double_21_recursive(buf + 4096, 10);
-    helper_double_21_recursive(buf + 5120, 10);
-    helper_double_21_recursive(buf + 6144, 10);
-    helper_double_21_recursive(buf + 7168, 10);
+    helper_double_avx_21_recursive(buf + 0, 10);
+    helper_double_avx_21_recursive(buf + 1024, 10);
+    helper_double_avx_21_recursive(buf + 2048, 10);
+    helper_double_avx_21_recursive(buf + 3072, 10);
+    helper_double_avx_21_recursive(buf + 4096, 10);
+    helper_double_avx_21_recursive(buf + 5120, 10);
+    helper_double_avx_21_recursive(buf + 6144, 10);
+    helper_double_avx_21_recursive(buf + 7168, 10);
     for (int j = 0; j < 8192; j += 8192) {
       for (int k = 0; k < 1024; k += 4) {
         __asm__ volatile (
@@ -14723,14 +14757,14 @@ void helper_double_21_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 16) {
-    helper_double_21_recursive(buf + 0, 13);
-    helper_double_21_recursive(buf + 8192, 13);
-    helper_double_21_recursive(buf + 16384, 13);
-    helper_double_21_recursive(buf + 24576, 13);
-    helper_double_21_recursive(buf + 32768, 13);
-    helper_double_21_recursive(buf + 40960, 13);
-    helper_double_21_recursive(buf + 49152, 13);
-    helper_double_21_recursive(buf + 57344, 13);
+    helper_double_avx_21_recursive(buf + 0, 13);
+    helper_double_avx_21_recursive(buf + 8192, 13);
+    helper_double_avx_21_recursive(buf + 16384, 13);
+    helper_double_avx_21_recursive(buf + 24576, 13);
+    helper_double_avx_21_recursive(buf + 32768, 13);
+    helper_double_avx_21_recursive(buf + 40960, 13);
+    helper_double_avx_21_recursive(buf + 49152, 13);
+    helper_double_avx_21_recursive(buf + 57344, 13);
     for (int j = 0; j < 65536; j += 65536) {
       for (int k = 0; k < 8192; k += 4) {
         __asm__ volatile (
@@ -14781,14 +14815,14 @@ void helper_double_21_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 19) {
-    helper_double_21_recursive(buf + 0, 16);
-    helper_double_21_recursive(buf + 65536, 16);
-    helper_double_21_recursive(buf + 131072, 16);
-    helper_double_21_recursive(buf + 196608, 16);
-    helper_double_21_recursive(buf + 262144, 16);
-    helper_double_21_recursive(buf + 327680, 16);
-    helper_double_21_recursive(buf + 393216, 16);
-    helper_double_21_recursive(buf + 458752, 16);
+    helper_double_avx_21_recursive(buf + 0, 16);
+    helper_double_avx_21_recursive(buf + 65536, 16);
+    helper_double_avx_21_recursive(buf + 131072, 16);
+    helper_double_avx_21_recursive(buf + 196608, 16);
+    helper_double_avx_21_recursive(buf + 262144, 16);
+    helper_double_avx_21_recursive(buf + 327680, 16);
+    helper_double_avx_21_recursive(buf + 393216, 16);
+    helper_double_avx_21_recursive(buf + 458752, 16);
     for (int j = 0; j < 524288; j += 524288) {
       for (int k = 0; k < 65536; k += 4) {
         __asm__ volatile (
@@ -14839,10 +14873,10 @@ void helper_double_21_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_double_21_recursive(buf + 0, 19);
-    helper_double_21_recursive(buf + 524288, 19);
-    helper_double_21_recursive(buf + 1048576, 19);
-    helper_double_21_recursive(buf + 1572864, 19);
+    helper_double_avx_21_recursive(buf + 0, 19);
+    helper_double_avx_21_recursive(buf + 524288, 19);
+    helper_double_avx_21_recursive(buf + 1048576, 19);
+    helper_double_avx_21_recursive(buf + 1572864, 19);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 524288; k += 4) {
         __asm__ volatile (
@@ -14869,12 +14903,12 @@ void helper_double_21_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_21(double *buf);
-void helper_double_21(double *buf) {
-  helper_double_21_recursive(buf, 21);
+FHT_TARGET("avx") void helper_double_avx_21(double *buf);
+FHT_TARGET("avx") void helper_double_avx_21(double *buf) {
+  helper_double_avx_21_recursive(buf, 21);
 }
-void helper_double_22_recursive(double *buf, int depth);
-void helper_double_22_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_22_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_22_recursive(double *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -15100,14 +15134,14 @@ void helper_double_22_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_double_22_recursive(buf + 0, 11);
-    helper_double_22_recursive(buf + 2048, 11);
-    helper_double_22_recursive(buf + 4096, 11);
-    helper_double_22_recursive(buf + 6144, 11);
-    helper_double_22_recursive(buf + 8192, 11);
-    helper_double_22_recursive(buf + 10240, 11);
-    helper_double_22_recursive(buf + 12288, 11);
-    helper_double_22_recursive(buf + 14336, 11);
+    helper_double_avx_22_recursive(buf + 0, 11);
+    helper_double_avx_22_recursive(buf + 2048, 11);
+    helper_double_avx_22_recursive(buf + 4096, 11);
+    helper_double_avx_22_recursive(buf + 6144, 11);
+    helper_double_avx_22_recursive(buf + 8192, 11);
+    helper_double_avx_22_recursive(buf + 10240, 11);
+    helper_double_avx_22_recursive(buf + 12288, 11);
+    helper_double_avx_22_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -15158,14 +15192,14 @@ void helper_double_22_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_double_22_recursive(buf + 0, 14);
-    helper_double_22_recursive(buf + 16384, 14);
-    helper_double_22_recursive(buf + 32768, 14);
-    helper_double_22_recursive(buf + 49152, 14);
-    helper_double_22_recursive(buf + 65536, 14);
-    helper_double_22_recursive(buf + 81920, 14);
-    helper_double_22_recursive(buf + 98304, 14);
-    helper_double_22_recursive(buf + 114688, 14);
+    helper_double_avx_22_recursive(buf + 0, 14);
+    helper_double_avx_22_recursive(buf + 16384, 14);
+    helper_double_avx_22_recursive(buf + 32768, 14);
+    helper_double_avx_22_recursive(buf + 49152, 14);
+    helper_double_avx_22_recursive(buf + 65536, 14);
+    helper_double_avx_22_recursive(buf + 81920, 14);
+    helper_double_avx_22_recursive(buf + 98304, 14);
+    helper_double_avx_22_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 4) {
         __asm__ volatile (
@@ -15216,14 +15250,14 @@ void helper_double_22_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_double_22_recursive(buf + 0, 17);
-    helper_double_22_recursive(buf + 131072, 17);
-    helper_double_22_recursive(buf + 262144, 17);
-    helper_double_22_recursive(buf + 393216, 17);
-    helper_double_22_recursive(buf + 524288, 17);
-    helper_double_22_recursive(buf + 655360, 17);
-    helper_double_22_recursive(buf + 786432, 17);
-    helper_double_22_recursive(buf + 917504, 17);
+    helper_double_avx_22_recursive(buf + 0, 17);
+    helper_double_avx_22_recursive(buf + 131072, 17);
+    helper_double_avx_22_recursive(buf + 262144, 17);
+    helper_double_avx_22_recursive(buf + 393216, 17);
+    helper_double_avx_22_recursive(buf + 524288, 17);
+    helper_double_avx_22_recursive(buf + 655360, 17);
+    helper_double_avx_22_recursive(buf + 786432, 17);
+    helper_double_avx_22_recursive(buf + 917504, 17);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 131072; k += 4) {
         __asm__ volatile (
@@ -15274,10 +15308,10 @@ void helper_double_22_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 22) {
-    helper_double_22_recursive(buf + 0, 20);
-    helper_double_22_recursive(buf + 1048576, 20);
-    helper_double_22_recursive(buf + 2097152, 20);
-    helper_double_22_recursive(buf + 3145728, 20);
+    helper_double_avx_22_recursive(buf + 0, 20);
+    helper_double_avx_22_recursive(buf + 1048576, 20);
+    helper_double_avx_22_recursive(buf + 2097152, 20);
+    helper_double_avx_22_recursive(buf + 3145728, 20);
     for (int j = 0; j < 4194304; j += 4194304) {
       for (int k = 0; k < 1048576; k += 4) {
         __asm__ volatile (
@@ -15304,12 +15338,12 @@ void helper_double_22_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_22(double *buf);
-void helper_double_22(double *buf) {
-  helper_double_22_recursive(buf, 22);
+FHT_TARGET("avx") void helper_double_avx_22(double *buf);
+FHT_TARGET("avx") void helper_double_avx_22(double *buf) {
+  helper_double_avx_22_recursive(buf, 22);
 }
-void helper_double_23_recursive(double *buf, int depth);
-void helper_double_23_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_23_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_23_recursive(double *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -15535,14 +15569,14 @@ void helper_double_23_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_double_23_recursive(buf + 0, 11);
-    helper_double_23_recursive(buf + 2048, 11);
-    helper_double_23_recursive(buf + 4096, 11);
-    helper_double_23_recursive(buf + 6144, 11);
-    helper_double_23_recursive(buf + 8192, 11);
-    helper_double_23_recursive(buf + 10240, 11);
-    helper_double_23_recursive(buf + 12288, 11);
-    helper_double_23_recursive(buf + 14336, 11);
+    helper_double_avx_23_recursive(buf + 0, 11);
+    helper_double_avx_23_recursive(buf + 2048, 11);
+    helper_double_avx_23_recursive(buf + 4096, 11);
+    helper_double_avx_23_recursive(buf + 6144, 11);
+    helper_double_avx_23_recursive(buf + 8192, 11);
+    helper_double_avx_23_recursive(buf + 10240, 11);
+    helper_double_avx_23_recursive(buf + 12288, 11);
+    helper_double_avx_23_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -15593,14 +15627,14 @@ void helper_double_23_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_double_23_recursive(buf + 0, 14);
-    helper_double_23_recursive(buf + 16384, 14);
-    helper_double_23_recursive(buf + 32768, 14);
-    helper_double_23_recursive(buf + 49152, 14);
-    helper_double_23_recursive(buf + 65536, 14);
-    helper_double_23_recursive(buf + 81920, 14);
-    helper_double_23_recursive(buf + 98304, 14);
-    helper_double_23_recursive(buf + 114688, 14);
+    helper_double_avx_23_recursive(buf + 0, 14);
+    helper_double_avx_23_recursive(buf + 16384, 14);
+    helper_double_avx_23_recursive(buf + 32768, 14);
+    helper_double_avx_23_recursive(buf + 49152, 14);
+    helper_double_avx_23_recursive(buf + 65536, 14);
+    helper_double_avx_23_recursive(buf + 81920, 14);
+    helper_double_avx_23_recursive(buf + 98304, 14);
+    helper_double_avx_23_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 4) {
         __asm__ volatile (
@@ -15651,14 +15685,14 @@ void helper_double_23_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_double_23_recursive(buf + 0, 17);
-    helper_double_23_recursive(buf + 131072, 17);
-    helper_double_23_recursive(buf + 262144, 17);
-    helper_double_23_recursive(buf + 393216, 17);
-    helper_double_23_recursive(buf + 524288, 17);
-    helper_double_23_recursive(buf + 655360, 17);
-    helper_double_23_recursive(buf + 786432, 17);
-    helper_double_23_recursive(buf + 917504, 17);
+    helper_double_avx_23_recursive(buf + 0, 17);
+    helper_double_avx_23_recursive(buf + 131072, 17);
+    helper_double_avx_23_recursive(buf + 262144, 17);
+    helper_double_avx_23_recursive(buf + 393216, 17);
+    helper_double_avx_23_recursive(buf + 524288, 17);
+    helper_double_avx_23_recursive(buf + 655360, 17);
+    helper_double_avx_23_recursive(buf + 786432, 17);
+    helper_double_avx_23_recursive(buf + 917504, 17);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 131072; k += 4) {
         __asm__ volatile (
@@ -15709,14 +15743,14 @@ void helper_double_23_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 23) {
-    helper_double_23_recursive(buf + 0, 20);
-    helper_double_23_recursive(buf + 1048576, 20);
-    helper_double_23_recursive(buf + 2097152, 20);
-    helper_double_23_recursive(buf + 3145728, 20);
-    helper_double_23_recursive(buf + 4194304, 20);
-    helper_double_23_recursive(buf + 5242880, 20);
-    helper_double_23_recursive(buf + 6291456, 20);
-    helper_double_23_recursive(buf + 7340032, 20);
+    helper_double_avx_23_recursive(buf + 0, 20);
+    helper_double_avx_23_recursive(buf + 1048576, 20);
+    helper_double_avx_23_recursive(buf + 2097152, 20);
+    helper_double_avx_23_recursive(buf + 3145728, 20);
+    helper_double_avx_23_recursive(buf + 4194304, 20);
+    helper_double_avx_23_recursive(buf + 5242880, 20);
+    helper_double_avx_23_recursive(buf + 6291456, 20);
+    helper_double_avx_23_recursive(buf + 7340032, 20);
     for (int j = 0; j < 8388608; j += 8388608) {
       for (int k = 0; k < 1048576; k += 4) {
         __asm__ volatile (
@@ -15767,12 +15801,12 @@ void helper_double_23_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_23(double *buf);
-void helper_double_23(double *buf) {
-  helper_double_23_recursive(buf, 23);
+FHT_TARGET("avx") void helper_double_avx_23(double *buf);
+FHT_TARGET("avx") void helper_double_avx_23(double *buf) {
+  helper_double_avx_23_recursive(buf, 23);
 }
-void helper_double_24_recursive(double *buf, int depth);
-void helper_double_24_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_24_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_24_recursive(double *buf, int depth) {
   if (depth == 10) {
     for (int j = 0; j < 1024; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -15974,14 +16008,14 @@ void helper_double_24_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 13) {
-    helper_double_24_recursive(buf + 0, 10);
-    helper_double_24_recursive(buf + 1024, 10);
-    helper_double_24_recursive(buf + 2048, 10);
-    helper_double_24_recursive(buf + 3072, 10);
-    helper_double_24_recursive(buf + 4096, 10);
-    helper_double_24_recursive(buf + 5120, 10);
-    helper_double_24_recursive(buf + 6144, 10);
-    helper_double_24_recursive(buf + 7168, 10);
+    helper_double_avx_24_recursive(buf + 0, 10);
+    helper_double_avx_24_recursive(buf + 1024, 10);
+    helper_double_avx_24_recursive(buf + 2048, 10);
+    helper_double_avx_24_recursive(buf + 3072, 10);
+    helper_double_avx_24_recursive(buf + 4096, 10);
+    helper_double_avx_24_recursive(buf + 5120, 10);
+    helper_double_avx_24_recursive(buf + 6144, 10);
+    helper_double_avx_24_recursive(buf + 7168, 10);
     for (int j = 0; j < 8192; j += 8192) {
       for (int k = 0; k < 1024; k += 4) {
         __asm__ volatile (
@@ -16032,14 +16066,14 @@ void helper_double_24_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 16) {
-    helper_double_24_recursive(buf + 0, 13);
-    helper_double_24_recursive(buf + 8192, 13);
-    helper_double_24_recursive(buf + 16384, 13);
-    helper_double_24_recursive(buf + 24576, 13);
-    helper_double_24_recursive(buf + 32768, 13);
-    helper_double_24_recursive(buf + 40960, 13);
-    helper_double_24_recursive(buf + 49152, 13);
-    helper_double_24_recursive(buf + 57344, 13);
+    helper_double_avx_24_recursive(buf + 0, 13);
+    helper_double_avx_24_recursive(buf + 8192, 13);
+    helper_double_avx_24_recursive(buf + 16384, 13);
+    helper_double_avx_24_recursive(buf + 24576, 13);
+    helper_double_avx_24_recursive(buf + 32768, 13);
+    helper_double_avx_24_recursive(buf + 40960, 13);
+    helper_double_avx_24_recursive(buf + 49152, 13);
+    helper_double_avx_24_recursive(buf + 57344, 13);
     for (int j = 0; j < 65536; j += 65536) {
       for (int k = 0; k < 8192; k += 4) {
         __asm__ volatile (
@@ -16090,14 +16124,14 @@ void helper_double_24_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 19) {
-    helper_double_24_recursive(buf + 0, 16);
-    helper_double_24_recursive(buf + 65536, 16);
-    helper_double_24_recursive(buf + 131072, 16);
-    helper_double_24_recursive(buf + 196608, 16);
-    helper_double_24_recursive(buf + 262144, 16);
-    helper_double_24_recursive(buf + 327680, 16);
-    helper_double_24_recursive(buf + 393216, 16);
-    helper_double_24_recursive(buf + 458752, 16);
+    helper_double_avx_24_recursive(buf + 0, 16);
+    helper_double_avx_24_recursive(buf + 65536, 16);
+    helper_double_avx_24_recursive(buf + 131072, 16);
+    helper_double_avx_24_recursive(buf + 196608, 16);
+    helper_double_avx_24_recursive(buf + 262144, 16);
+    helper_double_avx_24_recursive(buf + 327680, 16);
+    helper_double_avx_24_recursive(buf + 393216, 16);
+    helper_double_avx_24_recursive(buf + 458752, 16);
     for (int j = 0; j < 524288; j += 524288) {
       for (int k = 0; k < 65536; k += 4) {
         __asm__ volatile (
@@ -16148,14 +16182,14 @@ void helper_double_24_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 22) {
-    helper_double_24_recursive(buf + 0, 19);
-    helper_double_24_recursive(buf + 524288, 19);
-    helper_double_24_recursive(buf + 1048576, 19);
-    helper_double_24_recursive(buf + 1572864, 19);
-    helper_double_24_recursive(buf + 2097152, 19);
-    helper_double_24_recursive(buf + 2621440, 19);
-    helper_double_24_recursive(buf + 3145728, 19);
-    helper_double_24_recursive(buf + 3670016, 19);
+    helper_double_avx_24_recursive(buf + 0, 19);
+    helper_double_avx_24_recursive(buf + 524288, 19);
+    helper_double_avx_24_recursive(buf + 1048576, 19);
+    helper_double_avx_24_recursive(buf + 1572864, 19);
+    helper_double_avx_24_recursive(buf + 2097152, 19);
+    helper_double_avx_24_recursive(buf + 2621440, 19);
+    helper_double_avx_24_recursive(buf + 3145728, 19);
+    helper_double_avx_24_recursive(buf + 3670016, 19);
     for (int j = 0; j < 4194304; j += 4194304) {
       for (int k = 0; k < 524288; k += 4) {
         __asm__ volatile (
@@ -16206,10 +16240,10 @@ void helper_double_24_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 24) {
-    helper_double_24_recursive(buf + 0, 22);
-    helper_double_24_recursive(buf + 4194304, 22);
-    helper_double_24_recursive(buf + 8388608, 22);
-    helper_double_24_recursive(buf + 12582912, 22);
+    helper_double_avx_24_recursive(buf + 0, 22);
+    helper_double_avx_24_recursive(buf + 4194304, 22);
+    helper_double_avx_24_recursive(buf + 8388608, 22);
+    helper_double_avx_24_recursive(buf + 12582912, 22);
     for (int j = 0; j < 16777216; j += 16777216) {
       for (int k = 0; k < 4194304; k += 4) {
         __asm__ volatile (
@@ -16236,12 +16270,12 @@ void helper_double_24_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_24(double *buf);
-void helper_double_24(double *buf) {
-  helper_double_24_recursive(buf, 24);
+FHT_TARGET("avx") void helper_double_avx_24(double *buf);
+FHT_TARGET("avx") void helper_double_avx_24(double *buf) {
+  helper_double_avx_24_recursive(buf, 24);
 }
-void helper_double_25_recursive(double *buf, int depth);
-void helper_double_25_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_25_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_25_recursive(double *buf, int depth) {
   if (depth == 8) {
     for (int j = 0; j < 256; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -16420,14 +16454,14 @@ void helper_double_25_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 11) {
-    helper_double_25_recursive(buf + 0, 8);
-    helper_double_25_recursive(buf + 256, 8);
-    helper_double_25_recursive(buf + 512, 8);
-    helper_double_25_recursive(buf + 768, 8);
-    helper_double_25_recursive(buf + 1024, 8);
-    helper_double_25_recursive(buf + 1280, 8);
-    helper_double_25_recursive(buf + 1536, 8);
-    helper_double_25_recursive(buf + 1792, 8);
+    helper_double_avx_25_recursive(buf + 0, 8);
+    helper_double_avx_25_recursive(buf + 256, 8);
+    helper_double_avx_25_recursive(buf + 512, 8);
+    helper_double_avx_25_recursive(buf + 768, 8);
+    helper_double_avx_25_recursive(buf + 1024, 8);
+    helper_double_avx_25_recursive(buf + 1280, 8);
+    helper_double_avx_25_recursive(buf + 1536, 8);
+    helper_double_avx_25_recursive(buf + 1792, 8);
     for (int j = 0; j < 2048; j += 2048) {
       for (int k = 0; k < 256; k += 4) {
         __asm__ volatile (
@@ -16478,14 +16512,14 @@ void helper_double_25_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_double_25_recursive(buf + 0, 11);
-    helper_double_25_recursive(buf + 2048, 11);
-    helper_double_25_recursive(buf + 4096, 11);
-    helper_double_25_recursive(buf + 6144, 11);
-    helper_double_25_recursive(buf + 8192, 11);
-    helper_double_25_recursive(buf + 10240, 11);
-    helper_double_25_recursive(buf + 12288, 11);
-    helper_double_25_recursive(buf + 14336, 11);
+    helper_double_avx_25_recursive(buf + 0, 11);
+    helper_double_avx_25_recursive(buf + 2048, 11);
+    helper_double_avx_25_recursive(buf + 4096, 11);
+    helper_double_avx_25_recursive(buf + 6144, 11);
+    helper_double_avx_25_recursive(buf + 8192, 11);
+    helper_double_avx_25_recursive(buf + 10240, 11);
+    helper_double_avx_25_recursive(buf + 12288, 11);
+    helper_double_avx_25_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -16536,14 +16570,14 @@ void helper_double_25_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_double_25_recursive(buf + 0, 14);
-    helper_double_25_recursive(buf + 16384, 14);
-    helper_double_25_recursive(buf + 32768, 14);
-    helper_double_25_recursive(buf + 49152, 14);
-    helper_double_25_recursive(buf + 65536, 14);
-    helper_double_25_recursive(buf + 81920, 14);
-    helper_double_25_recursive(buf + 98304, 14);
-    helper_double_25_recursive(buf + 114688, 14);
+    helper_double_avx_25_recursive(buf + 0, 14);
+    helper_double_avx_25_recursive(buf + 16384, 14);
+    helper_double_avx_25_recursive(buf + 32768, 14);
+    helper_double_avx_25_recursive(buf + 49152, 14);
+    helper_double_avx_25_recursive(buf + 65536, 14);
+    helper_double_avx_25_recursive(buf + 81920, 14);
+    helper_double_avx_25_recursive(buf + 98304, 14);
+    helper_double_avx_25_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 4) {
         __asm__ volatile (
@@ -16594,14 +16628,14 @@ void helper_double_25_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_double_25_recursive(buf + 0, 17);
-    helper_double_25_recursive(buf + 131072, 17);
-    helper_double_25_recursive(buf + 262144, 17);
-    helper_double_25_recursive(buf + 393216, 17);
-    helper_double_25_recursive(buf + 524288, 17);
-    helper_double_25_recursive(buf + 655360, 17);
-    helper_double_25_recursive(buf + 786432, 17);
-    helper_double_25_recursive(buf + 917504, 17);
+    helper_double_avx_25_recursive(buf + 0, 17);
+    helper_double_avx_25_recursive(buf + 131072, 17);
+    helper_double_avx_25_recursive(buf + 262144, 17);
+    helper_double_avx_25_recursive(buf + 393216, 17);
+    helper_double_avx_25_recursive(buf + 524288, 17);
+    helper_double_avx_25_recursive(buf + 655360, 17);
+    helper_double_avx_25_recursive(buf + 786432, 17);
+    helper_double_avx_25_recursive(buf + 917504, 17);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 131072; k += 4) {
         __asm__ volatile (
@@ -16652,14 +16686,14 @@ void helper_double_25_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 23) {
-    helper_double_25_recursive(buf + 0, 20);
-    helper_double_25_recursive(buf + 1048576, 20);
-    helper_double_25_recursive(buf + 2097152, 20);
-    helper_double_25_recursive(buf + 3145728, 20);
-    helper_double_25_recursive(buf + 4194304, 20);
-    helper_double_25_recursive(buf + 5242880, 20);
-    helper_double_25_recursive(buf + 6291456, 20);
-    helper_double_25_recursive(buf + 7340032, 20);
+    helper_double_avx_25_recursive(buf + 0, 20);
+    helper_double_avx_25_recursive(buf + 1048576, 20);
+    helper_double_avx_25_recursive(buf + 2097152, 20);
+    helper_double_avx_25_recursive(buf + 3145728, 20);
+    helper_double_avx_25_recursive(buf + 4194304, 20);
+    helper_double_avx_25_recursive(buf + 5242880, 20);
+    helper_double_avx_25_recursive(buf + 6291456, 20);
+    helper_double_avx_25_recursive(buf + 7340032, 20);
     for (int j = 0; j < 8388608; j += 8388608) {
       for (int k = 0; k < 1048576; k += 4) {
         __asm__ volatile (
@@ -16710,10 +16744,10 @@ void helper_double_25_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 25) {
-    helper_double_25_recursive(buf + 0, 23);
-    helper_double_25_recursive(buf + 8388608, 23);
-    helper_double_25_recursive(buf + 16777216, 23);
-    helper_double_25_recursive(buf + 25165824, 23);
+    helper_double_avx_25_recursive(buf + 0, 23);
+    helper_double_avx_25_recursive(buf + 8388608, 23);
+    helper_double_avx_25_recursive(buf + 16777216, 23);
+    helper_double_avx_25_recursive(buf + 25165824, 23);
     for (int j = 0; j < 33554432; j += 33554432) {
       for (int k = 0; k < 8388608; k += 4) {
         __asm__ volatile (
@@ -16740,12 +16774,12 @@ void helper_double_25_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_25(double *buf);
-void helper_double_25(double *buf) {
-  helper_double_25_recursive(buf, 25);
+FHT_TARGET("avx") void helper_double_avx_25(double *buf);
+FHT_TARGET("avx") void helper_double_avx_25(double *buf) {
+  helper_double_avx_25_recursive(buf, 25);
 }
-void helper_double_26_recursive(double *buf, int depth);
-void helper_double_26_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_26_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_26_recursive(double *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -16971,14 +17005,14 @@ void helper_double_26_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_double_26_recursive(buf + 0, 11);
-    helper_double_26_recursive(buf + 2048, 11);
-    helper_double_26_recursive(buf + 4096, 11);
-    helper_double_26_recursive(buf + 6144, 11);
-    helper_double_26_recursive(buf + 8192, 11);
-    helper_double_26_recursive(buf + 10240, 11);
-    helper_double_26_recursive(buf + 12288, 11);
-    helper_double_26_recursive(buf + 14336, 11);
+    helper_double_avx_26_recursive(buf + 0, 11);
+    helper_double_avx_26_recursive(buf + 2048, 11);
+    helper_double_avx_26_recursive(buf + 4096, 11);
+    helper_double_avx_26_recursive(buf + 6144, 11);
+    helper_double_avx_26_recursive(buf + 8192, 11);
+    helper_double_avx_26_recursive(buf + 10240, 11);
+    helper_double_avx_26_recursive(buf + 12288, 11);
+    helper_double_avx_26_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -17029,14 +17063,14 @@ void helper_double_26_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_double_26_recursive(buf + 0, 14);
-    helper_double_26_recursive(buf + 16384, 14);
-    helper_double_26_recursive(buf + 32768, 14);
-    helper_double_26_recursive(buf + 49152, 14);
-    helper_double_26_recursive(buf + 65536, 14);
-    helper_double_26_recursive(buf + 81920, 14);
-    helper_double_26_recursive(buf + 98304, 14);
-    helper_double_26_recursive(buf + 114688, 14);
+    helper_double_avx_26_recursive(buf + 0, 14);
+    helper_double_avx_26_recursive(buf + 16384, 14);
+    helper_double_avx_26_recursive(buf + 32768, 14);
+    helper_double_avx_26_recursive(buf + 49152, 14);
+    helper_double_avx_26_recursive(buf + 65536, 14);
+    helper_double_avx_26_recursive(buf + 81920, 14);
+    helper_double_avx_26_recursive(buf + 98304, 14);
+    helper_double_avx_26_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 4) {
         __asm__ volatile (
@@ -17087,14 +17121,14 @@ void helper_double_26_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_double_26_recursive(buf + 0, 17);
-    helper_double_26_recursive(buf + 131072, 17);
-    helper_double_26_recursive(buf + 262144, 17);
-    helper_double_26_recursive(buf + 393216, 17);
-    helper_double_26_recursive(buf + 524288, 17);
-    helper_double_26_recursive(buf + 655360, 17);
-    helper_double_26_recursive(buf + 786432, 17);
-    helper_double_26_recursive(buf + 917504, 17);
+    helper_double_avx_26_recursive(buf + 0, 17);
+    helper_double_avx_26_recursive(buf + 131072, 17);
+    helper_double_avx_26_recursive(buf + 262144, 17);
+    helper_double_avx_26_recursive(buf + 393216, 17);
+    helper_double_avx_26_recursive(buf + 524288, 17);
+    helper_double_avx_26_recursive(buf + 655360, 17);
+    helper_double_avx_26_recursive(buf + 786432, 17);
+    helper_double_avx_26_recursive(buf + 917504, 17);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 131072; k += 4) {
         __asm__ volatile (
@@ -17145,14 +17179,14 @@ void helper_double_26_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 23) {
-    helper_double_26_recursive(buf + 0, 20);
-    helper_double_26_recursive(buf + 1048576, 20);
-    helper_double_26_recursive(buf + 2097152, 20);
-    helper_double_26_recursive(buf + 3145728, 20);
-    helper_double_26_recursive(buf + 4194304, 20);
-    helper_double_26_recursive(buf + 5242880, 20);
-    helper_double_26_recursive(buf + 6291456, 20);
-    helper_double_26_recursive(buf + 7340032, 20);
+    helper_double_avx_26_recursive(buf + 0, 20);
+    helper_double_avx_26_recursive(buf + 1048576, 20);
+    helper_double_avx_26_recursive(buf + 2097152, 20);
+    helper_double_avx_26_recursive(buf + 3145728, 20);
+    helper_double_avx_26_recursive(buf + 4194304, 20);
+    helper_double_avx_26_recursive(buf + 5242880, 20);
+    helper_double_avx_26_recursive(buf + 6291456, 20);
+    helper_double_avx_26_recursive(buf + 7340032, 20);
     for (int j = 0; j < 8388608; j += 8388608) {
       for (int k = 0; k < 1048576; k += 4) {
         __asm__ volatile (
@@ -17203,14 +17237,14 @@ void helper_double_26_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 26) {
-    helper_double_26_recursive(buf + 0, 23);
-    helper_double_26_recursive(buf + 8388608, 23);
-    helper_double_26_recursive(buf + 16777216, 23);
-    helper_double_26_recursive(buf + 25165824, 23);
-    helper_double_26_recursive(buf + 33554432, 23);
-    helper_double_26_recursive(buf + 41943040, 23);
-    helper_double_26_recursive(buf + 50331648, 23);
-    helper_double_26_recursive(buf + 58720256, 23);
+    helper_double_avx_26_recursive(buf + 0, 23);
+    helper_double_avx_26_recursive(buf + 8388608, 23);
+    helper_double_avx_26_recursive(buf + 16777216, 23);
+    helper_double_avx_26_recursive(buf + 25165824, 23);
+    helper_double_avx_26_recursive(buf + 33554432, 23);
+    helper_double_avx_26_recursive(buf + 41943040, 23);
+    helper_double_avx_26_recursive(buf + 50331648, 23);
+    helper_double_avx_26_recursive(buf + 58720256, 23);
     for (int j = 0; j < 67108864; j += 67108864) {
       for (int k = 0; k < 8388608; k += 4) {
         __asm__ volatile (
@@ -17261,12 +17295,12 @@ void helper_double_26_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_26(double *buf);
-void helper_double_26(double *buf) {
-  helper_double_26_recursive(buf, 26);
+FHT_TARGET("avx") void helper_double_avx_26(double *buf);
+FHT_TARGET("avx") void helper_double_avx_26(double *buf) {
+  helper_double_avx_26_recursive(buf, 26);
 }
-void helper_double_27_recursive(double *buf, int depth);
-void helper_double_27_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_27_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_27_recursive(double *buf, int depth) {
   if (depth == 9) {
     for (int j = 0; j < 512; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -17458,14 +17492,14 @@ void helper_double_27_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 12) {
-    helper_double_27_recursive(buf + 0, 9);
-    helper_double_27_recursive(buf + 512, 9);
-    helper_double_27_recursive(buf + 1024, 9);
-    helper_double_27_recursive(buf + 1536, 9);
-    helper_double_27_recursive(buf + 2048, 9);
-    helper_double_27_recursive(buf + 2560, 9);
-    helper_double_27_recursive(buf + 3072, 9);
-    helper_double_27_recursive(buf + 3584, 9);
+    helper_double_avx_27_recursive(buf + 0, 9);
+    helper_double_avx_27_recursive(buf + 512, 9);
+    helper_double_avx_27_recursive(buf + 1024, 9);
+    helper_double_avx_27_recursive(buf + 1536, 9);
+    helper_double_avx_27_recursive(buf + 2048, 9);
+    helper_double_avx_27_recursive(buf + 2560, 9);
+    helper_double_avx_27_recursive(buf + 3072, 9);
+    helper_double_avx_27_recursive(buf + 3584, 9);
     for (int j = 0; j < 4096; j += 4096) {
       for (int k = 0; k < 512; k += 4) {
         __asm__ volatile (
@@ -17516,14 +17550,14 @@ void helper_double_27_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_double_27_recursive(buf + 0, 12);
-    helper_double_27_recursive(buf + 4096, 12);
-    helper_double_27_recursive(buf + 8192, 12);
-    helper_double_27_recursive(buf + 12288, 12);
-    helper_double_27_recursive(buf + 16384, 12);
-    helper_double_27_recursive(buf + 20480, 12);
-    helper_double_27_recursive(buf + 24576, 12);
-    helper_double_27_recursive(buf + 28672, 12);
+    helper_double_avx_27_recursive(buf + 0, 12);
+    helper_double_avx_27_recursive(buf + 4096, 12);
+    helper_double_avx_27_recursive(buf + 8192, 12);
+    helper_double_avx_27_recursive(buf + 12288, 12);
+    helper_double_avx_27_recursive(buf + 16384, 12);
+    helper_double_avx_27_recursive(buf + 20480, 12);
+    helper_double_avx_27_recursive(buf + 24576, 12);
+    helper_double_avx_27_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 4) {
         __asm__ volatile (
@@ -17574,14 +17608,14 @@ void helper_double_27_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_double_27_recursive(buf + 0, 15);
-    helper_double_27_recursive(buf + 32768, 15);
-    helper_double_27_recursive(buf + 65536, 15);
-    helper_double_27_recursive(buf + 98304, 15);
-    helper_double_27_recursive(buf + 131072, 15);
-    helper_double_27_recursive(buf + 163840, 15);
-    helper_double_27_recursive(buf + 196608, 15);
-    helper_double_27_recursive(buf + 229376, 15);
+    helper_double_avx_27_recursive(buf + 0, 15);
+    helper_double_avx_27_recursive(buf + 32768, 15);
+    helper_double_avx_27_recursive(buf + 65536, 15);
+    helper_double_avx_27_recursive(buf + 98304, 15);
+    helper_double_avx_27_recursive(buf + 131072, 15);
+    helper_double_avx_27_recursive(buf + 163840, 15);
+    helper_double_avx_27_recursive(buf + 196608, 15);
+    helper_double_avx_27_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 4) {
         __asm__ volatile (
@@ -17632,14 +17666,14 @@ void helper_double_27_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_double_27_recursive(buf + 0, 18);
-    helper_double_27_recursive(buf + 262144, 18);
-    helper_double_27_recursive(buf + 524288, 18);
-    helper_double_27_recursive(buf + 786432, 18);
-    helper_double_27_recursive(buf + 1048576, 18);
-    helper_double_27_recursive(buf + 1310720, 18);
-    helper_double_27_recursive(buf + 1572864, 18);
-    helper_double_27_recursive(buf + 1835008, 18);
+    helper_double_avx_27_recursive(buf + 0, 18);
+    helper_double_avx_27_recursive(buf + 262144, 18);
+    helper_double_avx_27_recursive(buf + 524288, 18);
+    helper_double_avx_27_recursive(buf + 786432, 18);
+    helper_double_avx_27_recursive(buf + 1048576, 18);
+    helper_double_avx_27_recursive(buf + 1310720, 18);
+    helper_double_avx_27_recursive(buf + 1572864, 18);
+    helper_double_avx_27_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 4) {
         __asm__ volatile (
@@ -17690,14 +17724,14 @@ void helper_double_27_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 24) {
-    helper_double_27_recursive(buf + 0, 21);
-    helper_double_27_recursive(buf + 2097152, 21);
-    helper_double_27_recursive(buf + 4194304, 21);
-    helper_double_27_recursive(buf + 6291456, 21);
-    helper_double_27_recursive(buf + 8388608, 21);
-    helper_double_27_recursive(buf + 10485760, 21);
-    helper_double_27_recursive(buf + 12582912, 21);
-    helper_double_27_recursive(buf + 14680064, 21);
+    helper_double_avx_27_recursive(buf + 0, 21);
+    helper_double_avx_27_recursive(buf + 2097152, 21);
+    helper_double_avx_27_recursive(buf + 4194304, 21);
+    helper_double_avx_27_recursive(buf + 6291456, 21);
+    helper_double_avx_27_recursive(buf + 8388608, 21);
+    helper_double_avx_27_recursive(buf + 10485760, 21);
+    helper_double_avx_27_recursive(buf + 12582912, 21);
+    helper_double_avx_27_recursive(buf + 14680064, 21);
     for (int j = 0; j < 16777216; j += 16777216) {
       for (int k = 0; k < 2097152; k += 4) {
         __asm__ volatile (
@@ -17748,14 +17782,14 @@ void helper_double_27_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 27) {
-    helper_double_27_recursive(buf + 0, 24);
-    helper_double_27_recursive(buf + 16777216, 24);
-    helper_double_27_recursive(buf + 33554432, 24);
-    helper_double_27_recursive(buf + 50331648, 24);
-    helper_double_27_recursive(buf + 67108864, 24);
-    helper_double_27_recursive(buf + 83886080, 24);
-    helper_double_27_recursive(buf + 100663296, 24);
-    helper_double_27_recursive(buf + 117440512, 24);
+    helper_double_avx_27_recursive(buf + 0, 24);
+    helper_double_avx_27_recursive(buf + 16777216, 24);
+    helper_double_avx_27_recursive(buf + 33554432, 24);
+    helper_double_avx_27_recursive(buf + 50331648, 24);
+    helper_double_avx_27_recursive(buf + 67108864, 24);
+    helper_double_avx_27_recursive(buf + 83886080, 24);
+    helper_double_avx_27_recursive(buf + 100663296, 24);
+    helper_double_avx_27_recursive(buf + 117440512, 24);
     for (int j = 0; j < 134217728; j += 134217728) {
       for (int k = 0; k < 16777216; k += 4) {
         __asm__ volatile (
@@ -17806,12 +17840,12 @@ void helper_double_27_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_27(double *buf);
-void helper_double_27(double *buf) {
-  helper_double_27_recursive(buf, 27);
+FHT_TARGET("avx") void helper_double_avx_27(double *buf);
+FHT_TARGET("avx") void helper_double_avx_27(double *buf) {
+  helper_double_avx_27_recursive(buf, 27);
 }
-void helper_double_28_recursive(double *buf, int depth);
-void helper_double_28_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_28_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_28_recursive(double *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -18037,14 +18071,14 @@ void helper_double_28_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_double_28_recursive(buf + 0, 11);
-    helper_double_28_recursive(buf + 2048, 11);
-    helper_double_28_recursive(buf + 4096, 11);
-    helper_double_28_recursive(buf + 6144, 11);
-    helper_double_28_recursive(buf + 8192, 11);
-    helper_double_28_recursive(buf + 10240, 11);
-    helper_double_28_recursive(buf + 12288, 11);
-    helper_double_28_recursive(buf + 14336, 11);
+    helper_double_avx_28_recursive(buf + 0, 11);
+    helper_double_avx_28_recursive(buf + 2048, 11);
+    helper_double_avx_28_recursive(buf + 4096, 11);
+    helper_double_avx_28_recursive(buf + 6144, 11);
+    helper_double_avx_28_recursive(buf + 8192, 11);
+    helper_double_avx_28_recursive(buf + 10240, 11);
+    helper_double_avx_28_recursive(buf + 12288, 11);
+    helper_double_avx_28_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -18095,14 +18129,14 @@ void helper_double_28_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_double_28_recursive(buf + 0, 14);
-    helper_double_28_recursive(buf + 16384, 14);
-    helper_double_28_recursive(buf + 32768, 14);
-    helper_double_28_recursive(buf + 49152, 14);
-    helper_double_28_recursive(buf + 65536, 14);
-    helper_double_28_recursive(buf + 81920, 14);
-    helper_double_28_recursive(buf + 98304, 14);
-    helper_double_28_recursive(buf + 114688, 14);
+    helper_double_avx_28_recursive(buf + 0, 14);
+    helper_double_avx_28_recursive(buf + 16384, 14);
+    helper_double_avx_28_recursive(buf + 32768, 14);
+    helper_double_avx_28_recursive(buf + 49152, 14);
+    helper_double_avx_28_recursive(buf + 65536, 14);
+    helper_double_avx_28_recursive(buf + 81920, 14);
+    helper_double_avx_28_recursive(buf + 98304, 14);
+    helper_double_avx_28_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 4) {
         __asm__ volatile (
@@ -18153,14 +18187,14 @@ void helper_double_28_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_double_28_recursive(buf + 0, 17);
-    helper_double_28_recursive(buf + 131072, 17);
-    helper_double_28_recursive(buf + 262144, 17);
-    helper_double_28_recursive(buf + 393216, 17);
-    helper_double_28_recursive(buf + 524288, 17);
-    helper_double_28_recursive(buf + 655360, 17);
-    helper_double_28_recursive(buf + 786432, 17);
-    helper_double_28_recursive(buf + 917504, 17);
+    helper_double_avx_28_recursive(buf + 0, 17);
+    helper_double_avx_28_recursive(buf + 131072, 17);
+    helper_double_avx_28_recursive(buf + 262144, 17);
+    helper_double_avx_28_recursive(buf + 393216, 17);
+    helper_double_avx_28_recursive(buf + 524288, 17);
+    helper_double_avx_28_recursive(buf + 655360, 17);
+    helper_double_avx_28_recursive(buf + 786432, 17);
+    helper_double_avx_28_recursive(buf + 917504, 17);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 131072; k += 4) {
         __asm__ volatile (
@@ -18211,14 +18245,14 @@ void helper_double_28_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 23) {
-    helper_double_28_recursive(buf + 0, 20);
-    helper_double_28_recursive(buf + 1048576, 20);
-    helper_double_28_recursive(buf + 2097152, 20);
-    helper_double_28_recursive(buf + 3145728, 20);
-    helper_double_28_recursive(buf + 4194304, 20);
-    helper_double_28_recursive(buf + 5242880, 20);
-    helper_double_28_recursive(buf + 6291456, 20);
-    helper_double_28_recursive(buf + 7340032, 20);
+    helper_double_avx_28_recursive(buf + 0, 20);
+    helper_double_avx_28_recursive(buf + 1048576, 20);
+    helper_double_avx_28_recursive(buf + 2097152, 20);
+    helper_double_avx_28_recursive(buf + 3145728, 20);
+    helper_double_avx_28_recursive(buf + 4194304, 20);
+    helper_double_avx_28_recursive(buf + 5242880, 20);
+    helper_double_avx_28_recursive(buf + 6291456, 20);
+    helper_double_avx_28_recursive(buf + 7340032, 20);
     for (int j = 0; j < 8388608; j += 8388608) {
       for (int k = 0; k < 1048576; k += 4) {
         __asm__ volatile (
@@ -18269,14 +18303,14 @@ void helper_double_28_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 26) {
-    helper_double_28_recursive(buf + 0, 23);
-    helper_double_28_recursive(buf + 8388608, 23);
-    helper_double_28_recursive(buf + 16777216, 23);
-    helper_double_28_recursive(buf + 25165824, 23);
-    helper_double_28_recursive(buf + 33554432, 23);
-    helper_double_28_recursive(buf + 41943040, 23);
-    helper_double_28_recursive(buf + 50331648, 23);
-    helper_double_28_recursive(buf + 58720256, 23);
+    helper_double_avx_28_recursive(buf + 0, 23);
+    helper_double_avx_28_recursive(buf + 8388608, 23);
+    helper_double_avx_28_recursive(buf + 16777216, 23);
+    helper_double_avx_28_recursive(buf + 25165824, 23);
+    helper_double_avx_28_recursive(buf + 33554432, 23);
+    helper_double_avx_28_recursive(buf + 41943040, 23);
+    helper_double_avx_28_recursive(buf + 50331648, 23);
+    helper_double_avx_28_recursive(buf + 58720256, 23);
     for (int j = 0; j < 67108864; j += 67108864) {
       for (int k = 0; k < 8388608; k += 4) {
         __asm__ volatile (
@@ -18327,10 +18361,10 @@ void helper_double_28_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 28) {
-    helper_double_28_recursive(buf + 0, 26);
-    helper_double_28_recursive(buf + 67108864, 26);
-    helper_double_28_recursive(buf + 134217728, 26);
-    helper_double_28_recursive(buf + 201326592, 26);
+    helper_double_avx_28_recursive(buf + 0, 26);
+    helper_double_avx_28_recursive(buf + 67108864, 26);
+    helper_double_avx_28_recursive(buf + 134217728, 26);
+    helper_double_avx_28_recursive(buf + 201326592, 26);
     for (int j = 0; j < 268435456; j += 268435456) {
       for (int k = 0; k < 67108864; k += 4) {
         __asm__ volatile (
@@ -18357,12 +18391,12 @@ void helper_double_28_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_28(double *buf);
-void helper_double_28(double *buf) {
-  helper_double_28_recursive(buf, 28);
+FHT_TARGET("avx") void helper_double_avx_28(double *buf);
+FHT_TARGET("avx") void helper_double_avx_28(double *buf) {
+  helper_double_avx_28_recursive(buf, 28);
 }
-void helper_double_29_recursive(double *buf, int depth);
-void helper_double_29_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_29_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_29_recursive(double *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -18588,14 +18622,14 @@ void helper_double_29_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_double_29_recursive(buf + 0, 11);
-    helper_double_29_recursive(buf + 2048, 11);
-    helper_double_29_recursive(buf + 4096, 11);
-    helper_double_29_recursive(buf + 6144, 11);
-    helper_double_29_recursive(buf + 8192, 11);
-    helper_double_29_recursive(buf + 10240, 11);
-    helper_double_29_recursive(buf + 12288, 11);
-    helper_double_29_recursive(buf + 14336, 11);
+    helper_double_avx_29_recursive(buf + 0, 11);
+    helper_double_avx_29_recursive(buf + 2048, 11);
+    helper_double_avx_29_recursive(buf + 4096, 11);
+    helper_double_avx_29_recursive(buf + 6144, 11);
+    helper_double_avx_29_recursive(buf + 8192, 11);
+    helper_double_avx_29_recursive(buf + 10240, 11);
+    helper_double_avx_29_recursive(buf + 12288, 11);
+    helper_double_avx_29_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -18646,14 +18680,14 @@ void helper_double_29_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_double_29_recursive(buf + 0, 14);
-    helper_double_29_recursive(buf + 16384, 14);
-    helper_double_29_recursive(buf + 32768, 14);
-    helper_double_29_recursive(buf + 49152, 14);
-    helper_double_29_recursive(buf + 65536, 14);
-    helper_double_29_recursive(buf + 81920, 14);
-    helper_double_29_recursive(buf + 98304, 14);
-    helper_double_29_recursive(buf + 114688, 14);
+    helper_double_avx_29_recursive(buf + 0, 14);
+    helper_double_avx_29_recursive(buf + 16384, 14);
+    helper_double_avx_29_recursive(buf + 32768, 14);
+    helper_double_avx_29_recursive(buf + 49152, 14);
+    helper_double_avx_29_recursive(buf + 65536, 14);
+    helper_double_avx_29_recursive(buf + 81920, 14);
+    helper_double_avx_29_recursive(buf + 98304, 14);
+    helper_double_avx_29_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 4) {
         __asm__ volatile (
@@ -18704,14 +18738,14 @@ void helper_double_29_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_double_29_recursive(buf + 0, 17);
-    helper_double_29_recursive(buf + 131072, 17);
-    helper_double_29_recursive(buf + 262144, 17);
-    helper_double_29_recursive(buf + 393216, 17);
-    helper_double_29_recursive(buf + 524288, 17);
-    helper_double_29_recursive(buf + 655360, 17);
-    helper_double_29_recursive(buf + 786432, 17);
-    helper_double_29_recursive(buf + 917504, 17);
+    helper_double_avx_29_recursive(buf + 0, 17);
+    helper_double_avx_29_recursive(buf + 131072, 17);
+    helper_double_avx_29_recursive(buf + 262144, 17);
+    helper_double_avx_29_recursive(buf + 393216, 17);
+    helper_double_avx_29_recursive(buf + 524288, 17);
+    helper_double_avx_29_recursive(buf + 655360, 17);
+    helper_double_avx_29_recursive(buf + 786432, 17);
+    helper_double_avx_29_recursive(buf + 917504, 17);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 131072; k += 4) {
         __asm__ volatile (
@@ -18762,14 +18796,14 @@ void helper_double_29_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 23) {
-    helper_double_29_recursive(buf + 0, 20);
-    helper_double_29_recursive(buf + 1048576, 20);
-    helper_double_29_recursive(buf + 2097152, 20);
-    helper_double_29_recursive(buf + 3145728, 20);
-    helper_double_29_recursive(buf + 4194304, 20);
-    helper_double_29_recursive(buf + 5242880, 20);
-    helper_double_29_recursive(buf + 6291456, 20);
-    helper_double_29_recursive(buf + 7340032, 20);
+    helper_double_avx_29_recursive(buf + 0, 20);
+    helper_double_avx_29_recursive(buf + 1048576, 20);
+    helper_double_avx_29_recursive(buf + 2097152, 20);
+    helper_double_avx_29_recursive(buf + 3145728, 20);
+    helper_double_avx_29_recursive(buf + 4194304, 20);
+    helper_double_avx_29_recursive(buf + 5242880, 20);
+    helper_double_avx_29_recursive(buf + 6291456, 20);
+    helper_double_avx_29_recursive(buf + 7340032, 20);
     for (int j = 0; j < 8388608; j += 8388608) {
       for (int k = 0; k < 1048576; k += 4) {
         __asm__ volatile (
@@ -18820,14 +18854,14 @@ void helper_double_29_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 26) {
-    helper_double_29_recursive(buf + 0, 23);
-    helper_double_29_recursive(buf + 8388608, 23);
-    helper_double_29_recursive(buf + 16777216, 23);
-    helper_double_29_recursive(buf + 25165824, 23);
-    helper_double_29_recursive(buf + 33554432, 23);
-    helper_double_29_recursive(buf + 41943040, 23);
-    helper_double_29_recursive(buf + 50331648, 23);
-    helper_double_29_recursive(buf + 58720256, 23);
+    helper_double_avx_29_recursive(buf + 0, 23);
+    helper_double_avx_29_recursive(buf + 8388608, 23);
+    helper_double_avx_29_recursive(buf + 16777216, 23);
+    helper_double_avx_29_recursive(buf + 25165824, 23);
+    helper_double_avx_29_recursive(buf + 33554432, 23);
+    helper_double_avx_29_recursive(buf + 41943040, 23);
+    helper_double_avx_29_recursive(buf + 50331648, 23);
+    helper_double_avx_29_recursive(buf + 58720256, 23);
     for (int j = 0; j < 67108864; j += 67108864) {
       for (int k = 0; k < 8388608; k += 4) {
         __asm__ volatile (
@@ -18878,14 +18912,14 @@ void helper_double_29_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 29) {
-    helper_double_29_recursive(buf + 0, 26);
-    helper_double_29_recursive(buf + 67108864, 26);
-    helper_double_29_recursive(buf + 134217728, 26);
-    helper_double_29_recursive(buf + 201326592, 26);
-    helper_double_29_recursive(buf + 268435456, 26);
-    helper_double_29_recursive(buf + 335544320, 26);
-    helper_double_29_recursive(buf + 402653184, 26);
-    helper_double_29_recursive(buf + 469762048, 26);
+    helper_double_avx_29_recursive(buf + 0, 26);
+    helper_double_avx_29_recursive(buf + 67108864, 26);
+    helper_double_avx_29_recursive(buf + 134217728, 26);
+    helper_double_avx_29_recursive(buf + 201326592, 26);
+    helper_double_avx_29_recursive(buf + 268435456, 26);
+    helper_double_avx_29_recursive(buf + 335544320, 26);
+    helper_double_avx_29_recursive(buf + 402653184, 26);
+    helper_double_avx_29_recursive(buf + 469762048, 26);
     for (int j = 0; j < 536870912; j += 536870912) {
       for (int k = 0; k < 67108864; k += 4) {
         __asm__ volatile (
@@ -18936,12 +18970,12 @@ void helper_double_29_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_29(double *buf);
-void helper_double_29(double *buf) {
-  helper_double_29_recursive(buf, 29);
+FHT_TARGET("avx") void helper_double_avx_29(double *buf);
+FHT_TARGET("avx") void helper_double_avx_29(double *buf) {
+  helper_double_avx_29_recursive(buf, 29);
 }
-void helper_double_30_recursive(double *buf, int depth);
-void helper_double_30_recursive(double *buf, int depth) {
+FHT_TARGET("avx") void helper_double_avx_30_recursive(double *buf, int depth);
+FHT_TARGET("avx") void helper_double_avx_30_recursive(double *buf, int depth) {
   if (depth == 9) {
     for (int j = 0; j < 512; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -19133,14 +19167,14 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 12) {
-    helper_double_30_recursive(buf + 0, 9);
-    helper_double_30_recursive(buf + 512, 9);
-    helper_double_30_recursive(buf + 1024, 9);
-    helper_double_30_recursive(buf + 1536, 9);
-    helper_double_30_recursive(buf + 2048, 9);
-    helper_double_30_recursive(buf + 2560, 9);
-    helper_double_30_recursive(buf + 3072, 9);
-    helper_double_30_recursive(buf + 3584, 9);
+    helper_double_avx_30_recursive(buf + 0, 9);
+    helper_double_avx_30_recursive(buf + 512, 9);
+    helper_double_avx_30_recursive(buf + 1024, 9);
+    helper_double_avx_30_recursive(buf + 1536, 9);
+    helper_double_avx_30_recursive(buf + 2048, 9);
+    helper_double_avx_30_recursive(buf + 2560, 9);
+    helper_double_avx_30_recursive(buf + 3072, 9);
+    helper_double_avx_30_recursive(buf + 3584, 9);
     for (int j = 0; j < 4096; j += 4096) {
       for (int k = 0; k < 512; k += 4) {
         __asm__ volatile (
@@ -19191,14 +19225,14 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_double_30_recursive(buf + 0, 12);
-    helper_double_30_recursive(buf + 4096, 12);
-    helper_double_30_recursive(buf + 8192, 12);
-    helper_double_30_recursive(buf + 12288, 12);
-    helper_double_30_recursive(buf + 16384, 12);
-    helper_double_30_recursive(buf + 20480, 12);
-    helper_double_30_recursive(buf + 24576, 12);
-    helper_double_30_recursive(buf + 28672, 12);
+    helper_double_avx_30_recursive(buf + 0, 12);
+    helper_double_avx_30_recursive(buf + 4096, 12);
+    helper_double_avx_30_recursive(buf + 8192, 12);
+    helper_double_avx_30_recursive(buf + 12288, 12);
+    helper_double_avx_30_recursive(buf + 16384, 12);
+    helper_double_avx_30_recursive(buf + 20480, 12);
+    helper_double_avx_30_recursive(buf + 24576, 12);
+    helper_double_avx_30_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 4) {
         __asm__ volatile (
@@ -19249,14 +19283,14 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_double_30_recursive(buf + 0, 15);
-    helper_double_30_recursive(buf + 32768, 15);
-    helper_double_30_recursive(buf + 65536, 15);
-    helper_double_30_recursive(buf + 98304, 15);
-    helper_double_30_recursive(buf + 131072, 15);
-    helper_double_30_recursive(buf + 163840, 15);
-    helper_double_30_recursive(buf + 196608, 15);
-    helper_double_30_recursive(buf + 229376, 15);
+    helper_double_avx_30_recursive(buf + 0, 15);
+    helper_double_avx_30_recursive(buf + 32768, 15);
+    helper_double_avx_30_recursive(buf + 65536, 15);
+    helper_double_avx_30_recursive(buf + 98304, 15);
+    helper_double_avx_30_recursive(buf + 131072, 15);
+    helper_double_avx_30_recursive(buf + 163840, 15);
+    helper_double_avx_30_recursive(buf + 196608, 15);
+    helper_double_avx_30_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 4) {
         __asm__ volatile (
@@ -19307,14 +19341,14 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_double_30_recursive(buf + 0, 18);
-    helper_double_30_recursive(buf + 262144, 18);
-    helper_double_30_recursive(buf + 524288, 18);
-    helper_double_30_recursive(buf + 786432, 18);
-    helper_double_30_recursive(buf + 1048576, 18);
-    helper_double_30_recursive(buf + 1310720, 18);
-    helper_double_30_recursive(buf + 1572864, 18);
-    helper_double_30_recursive(buf + 1835008, 18);
+    helper_double_avx_30_recursive(buf + 0, 18);
+    helper_double_avx_30_recursive(buf + 262144, 18);
+    helper_double_avx_30_recursive(buf + 524288, 18);
+    helper_double_avx_30_recursive(buf + 786432, 18);
+    helper_double_avx_30_recursive(buf + 1048576, 18);
+    helper_double_avx_30_recursive(buf + 1310720, 18);
+    helper_double_avx_30_recursive(buf + 1572864, 18);
+    helper_double_avx_30_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 4) {
         __asm__ volatile (
@@ -19365,14 +19399,14 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 24) {
-    helper_double_30_recursive(buf + 0, 21);
-    helper_double_30_recursive(buf + 2097152, 21);
-    helper_double_30_recursive(buf + 4194304, 21);
-    helper_double_30_recursive(buf + 6291456, 21);
-    helper_double_30_recursive(buf + 8388608, 21);
-    helper_double_30_recursive(buf + 10485760, 21);
-    helper_double_30_recursive(buf + 12582912, 21);
-    helper_double_30_recursive(buf + 14680064, 21);
+    helper_double_avx_30_recursive(buf + 0, 21);
+    helper_double_avx_30_recursive(buf + 2097152, 21);
+    helper_double_avx_30_recursive(buf + 4194304, 21);
+    helper_double_avx_30_recursive(buf + 6291456, 21);
+    helper_double_avx_30_recursive(buf + 8388608, 21);
+    helper_double_avx_30_recursive(buf + 10485760, 21);
+    helper_double_avx_30_recursive(buf + 12582912, 21);
+    helper_double_avx_30_recursive(buf + 14680064, 21);
     for (int j = 0; j < 16777216; j += 16777216) {
       for (int k = 0; k < 2097152; k += 4) {
         __asm__ volatile (
@@ -19423,14 +19457,14 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 27) {
-    helper_double_30_recursive(buf + 0, 24);
-    helper_double_30_recursive(buf + 16777216, 24);
-    helper_double_30_recursive(buf + 33554432, 24);
-    helper_double_30_recursive(buf + 50331648, 24);
-    helper_double_30_recursive(buf + 67108864, 24);
-    helper_double_30_recursive(buf + 83886080, 24);
-    helper_double_30_recursive(buf + 100663296, 24);
-    helper_double_30_recursive(buf + 117440512, 24);
+    helper_double_avx_30_recursive(buf + 0, 24);
+    helper_double_avx_30_recursive(buf + 16777216, 24);
+    helper_double_avx_30_recursive(buf + 33554432, 24);
+    helper_double_avx_30_recursive(buf + 50331648, 24);
+    helper_double_avx_30_recursive(buf + 67108864, 24);
+    helper_double_avx_30_recursive(buf + 83886080, 24);
+    helper_double_avx_30_recursive(buf + 100663296, 24);
+    helper_double_avx_30_recursive(buf + 117440512, 24);
     for (int j = 0; j < 134217728; j += 134217728) {
       for (int k = 0; k < 16777216; k += 4) {
         __asm__ volatile (
@@ -19481,14 +19515,14 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 30) {
-    helper_double_30_recursive(buf + 0, 27);
-    helper_double_30_recursive(buf + 134217728, 27);
-    helper_double_30_recursive(buf + 268435456, 27);
-    helper_double_30_recursive(buf + 402653184, 27);
-    helper_double_30_recursive(buf + 536870912, 27);
-    helper_double_30_recursive(buf + 671088640, 27);
-    helper_double_30_recursive(buf + 805306368, 27);
-    helper_double_30_recursive(buf + 939524096, 27);
+    helper_double_avx_30_recursive(buf + 0, 27);
+    helper_double_avx_30_recursive(buf + 134217728, 27);
+    helper_double_avx_30_recursive(buf + 268435456, 27);
+    helper_double_avx_30_recursive(buf + 402653184, 27);
+    helper_double_avx_30_recursive(buf + 536870912, 27);
+    helper_double_avx_30_recursive(buf + 671088640, 27);
+    helper_double_avx_30_recursive(buf + 805306368, 27);
+    helper_double_avx_30_recursive(buf + 939524096, 27);
     for (int j = 0; j < 1073741824; j += 1073741824) {
       for (int k = 0; k < 134217728; k += 4) {
         __asm__ volatile (
@@ -19539,133 +19573,167 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_30(double *buf);
-void helper_double_30(double *buf) {
-  helper_double_30_recursive(buf, 30);
+FHT_TARGET("avx") void helper_double_avx_30(double *buf);
+FHT_TARGET("avx") void helper_double_avx_30(double *buf) {
+  helper_double_avx_30_recursive(buf, 30);
 }
-int fht_double(double *buf, int log_n) {
+FHT_TARGET("avx") int fht_double_avx(double *buf, int log_n);
+FHT_TARGET("avx") int fht_double_avx(double *buf, int log_n) {
   if (log_n == 0) {
     return 0;
   }
   if (log_n == 1) {
-    helper_double_1(buf);
+    helper_double_avx_1(buf);
     return 0;
   }
   if (log_n == 2) {
-    helper_double_2(buf);
+    helper_double_avx_2(buf);
     return 0;
   }
   if (log_n == 3) {
-    helper_double_3(buf);
+    helper_double_avx_3(buf);
     return 0;
   }
   if (log_n == 4) {
-    helper_double_4(buf);
+    helper_double_avx_4(buf);
     return 0;
   }
   if (log_n == 5) {
-    helper_double_5(buf);
+    helper_double_avx_5(buf);
     return 0;
   }
   if (log_n == 6) {
-    helper_double_6(buf);
+    helper_double_avx_6(buf);
     return 0;
   }
   if (log_n == 7) {
-    helper_double_7(buf);
+    helper_double_avx_7(buf);
     return 0;
   }
   if (log_n == 8) {
-    helper_double_8(buf);
+    helper_double_avx_8(buf);
     return 0;
   }
   if (log_n == 9) {
-    helper_double_9(buf);
+    helper_double_avx_9(buf);
     return 0;
   }
   if (log_n == 10) {
-    helper_double_10(buf);
+    helper_double_avx_10(buf);
     return 0;
   }
   if (log_n == 11) {
-    helper_double_11(buf);
+    helper_double_avx_11(buf);
     return 0;
   }
   if (log_n == 12) {
-    helper_double_12(buf);
+    helper_double_avx_12(buf);
     return 0;
   }
   if (log_n == 13) {
-    helper_double_13(buf);
+    helper_double_avx_13(buf);
     return 0;
   }
   if (log_n == 14) {
-    helper_double_14(buf);
+    helper_double_avx_14(buf);
     return 0;
   }
   if (log_n == 15) {
-    helper_double_15(buf);
+    helper_double_avx_15(buf);
     return 0;
   }
   if (log_n == 16) {
-    helper_double_16(buf);
+    helper_double_avx_16(buf);
     return 0;
   }
   if (log_n == 17) {
-    helper_double_17(buf);
+    helper_double_avx_17(buf);
     return 0;
   }
   if (log_n == 18) {
-    helper_double_18(buf);
+    helper_double_avx_18(buf);
     return 0;
   }
   if (log_n == 19) {
-    helper_double_19(buf);
+    helper_double_avx_19(buf);
     return 0;
   }
   if (log_n == 20) {
-    helper_double_20(buf);
+    helper_double_avx_20(buf);
     return 0;
   }
   if (log_n == 21) {
-    helper_double_21(buf);
+    helper_double_avx_21(buf);
     return 0;
   }
   if (log_n == 22) {
-    helper_double_22(buf);
+    helper_double_avx_22(buf);
     return 0;
   }
   if (log_n == 23) {
-    helper_double_23(buf);
+    helper_double_avx_23(buf);
     return 0;
   }
   if (log_n == 24) {
-    helper_double_24(buf);
+    helper_double_avx_24(buf);
     return 0;
   }
   if (log_n == 25) {
-    helper_double_25(buf);
+    helper_double_avx_25(buf);
     return 0;
   }
   if (log_n == 26) {
-    helper_double_26(buf);
+    helper_double_avx_26(buf);
     return 0;
   }
   if (log_n == 27) {
-    helper_double_27(buf);
+    helper_double_avx_27(buf);
     return 0;
   }
   if (log_n == 28) {
-    helper_double_28(buf);
+    helper_double_avx_28(buf);
     return 0;
   }
   if (log_n == 29) {
-    helper_double_29(buf);
+    helper_double_avx_29(buf);
     return 0;
   }
   if (log_n == 30) {
-    helper_double_30(buf);
+    helper_double_avx_30(buf);
     return 0;
   }
   return 1;
 }
+static void (*const fht_double_avx_helpers[31])(double *) = {
+  0,
+  helper_double_avx_1,
+  helper_double_avx_2,
+  helper_double_avx_3,
+  helper_double_avx_4,
+  helper_double_avx_5,
+  helper_double_avx_6,
+  helper_double_avx_7,
+  helper_double_avx_8,
+  helper_double_avx_9,
+  helper_double_avx_10,
+  helper_double_avx_11,
+  helper_double_avx_12,
+  helper_double_avx_13,
+  helper_double_avx_14,
+  helper_double_avx_15,
+  helper_double_avx_16,
+  helper_double_avx_17,
+  helper_double_avx_18,
+  helper_double_avx_19,
+  helper_double_avx_20,
+  helper_double_avx_21,
+  helper_double_avx_22,
+  helper_double_avx_23,
+  helper_double_avx_24,
+  helper_double_avx_25,
+  helper_double_avx_26,
+  helper_double_avx_27,
+  helper_double_avx_28,
+  helper_double_avx_29,
+  helper_double_avx_30,
+};
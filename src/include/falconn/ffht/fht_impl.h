@@ -3,17 +3,254 @@
 
 #include "fast_copy.h"
 
+// With GCC or clang on x86, the kernels for all instruction sets are compiled
+// into the binary (each one with its own target attribute) and fht_float /
+// fht_double pick the best one the CPU supports on the first call. Otherwise
+// (or if FHT_NO_RUNTIME_DISPATCH is defined), the kernel is chosen at compile
+// time from the instruction sets enabled by the compiler flags.
+#if !defined(FHT_NO_RUNTIME_DISPATCH) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define FHT_RUNTIME_DISPATCH
+#define FHT_TARGET(isa) __attribute__((target(isa)))
+#else
+#define FHT_TARGET(isa)
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#ifdef __AVX__
+#ifdef FHT_RUNTIME_DISPATCH
+#include "fht_sse.c"
 #include "fht_avx.c"
-#define VECTOR_WIDTH (32u)
-#else
+#include "fht_avx512.c"
+#define FHT_HAVE_SSE
+#define FHT_HAVE_AVX
+#define FHT_HAVE_AVX512
+#elif defined(__AVX512F__)
+#include "fht_avx512.c"
+#define FHT_HAVE_AVX512
+#elif defined(__AVX__)
+#include "fht_avx.c"
+#define FHT_HAVE_AVX
+#elif defined(__SSE4_1__)
 #include "fht_sse.c"
-#define VECTOR_WIDTH (16u)
+#define FHT_HAVE_SSE
+#endif
+
+// Plain implementations for CPUs without SSE4.1 (and other architectures).
+static inline int fht_float_generic(float *buf, int log_n) {
+    if (log_n < 0 || log_n > 30) {
+        return 1;
+    }
+    int n = 1 << log_n;
+    for (int h = 1; h < n; h *= 2) {
+        for (int j = 0; j < n; j += 2 * h) {
+            for (int k = j; k < j + h; ++k) {
+                float u = buf[k];
+                float v = buf[k + h];
+                buf[k] = u + v;
+                buf[k + h] = u - v;
+            }
+        }
+    }
+    return 0;
+}
+
+static inline int fht_double_generic(double *buf, int log_n) {
+    if (log_n < 0 || log_n > 30) {
+        return 1;
+    }
+    int n = 1 << log_n;
+    for (int h = 1; h < n; h *= 2) {
+        for (int j = 0; j < n; j += 2 * h) {
+            for (int k = j; k < j + h; ++k) {
+                double u = buf[k];
+                double v = buf[k + h];
+                buf[k] = u + v;
+                buf[k + h] = u - v;
+            }
+        }
+    }
+    return 0;
+}
+
+typedef int (*fht_float_function)(float *, int);
+typedef int (*fht_double_function)(double *, int);
+
+// Instruction sets of the kernels, from the most to the least preferred.
+enum {
+    FHT_ISA_AVX512 = 0,
+    FHT_ISA_AVX = 1,
+    FHT_ISA_SSE = 2,
+    FHT_ISA_GENERIC = 3,
+    FHT_NUM_ISAS = 4
+};
+
+// Returns 1 if the kernels for the given instruction set are compiled in and
+// the CPU supports them.
+static inline int fht_isa_supported(int isa) {
+    switch (isa) {
+#ifdef FHT_HAVE_AVX512
+    case FHT_ISA_AVX512:
+#ifdef FHT_RUNTIME_DISPATCH
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx512f") ? 1 : 0;
+#else
+        return 1;
+#endif
+#endif
+#ifdef FHT_HAVE_AVX
+    case FHT_ISA_AVX:
+#ifdef FHT_RUNTIME_DISPATCH
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx") ? 1 : 0;
+#else
+        return 1;
+#endif
+#endif
+#ifdef FHT_HAVE_SSE
+    case FHT_ISA_SSE:
+#ifdef FHT_RUNTIME_DISPATCH
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse4.1") ? 1 : 0;
+#else
+        return 1;
+#endif
+#endif
+    case FHT_ISA_GENERIC:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+// The kernels for a given instruction set (NULL if they are not compiled in).
+static inline fht_float_function fht_float_kernel(int isa) {
+    switch (isa) {
+#ifdef FHT_HAVE_AVX512
+    case FHT_ISA_AVX512:
+        return fht_float_avx512;
+#endif
+#ifdef FHT_HAVE_AVX
+    case FHT_ISA_AVX:
+        return fht_float_avx;
+#endif
+#ifdef FHT_HAVE_SSE
+    case FHT_ISA_SSE:
+        return fht_float_sse;
 #endif
+    case FHT_ISA_GENERIC:
+        return fht_float_generic;
+    default:
+        return NULL;
+    }
+}
+
+static inline fht_double_function fht_double_kernel(int isa) {
+    switch (isa) {
+#ifdef FHT_HAVE_AVX512
+    case FHT_ISA_AVX512:
+        return fht_double_avx512;
+#endif
+#ifdef FHT_HAVE_AVX
+    case FHT_ISA_AVX:
+        return fht_double_avx;
+#endif
+#ifdef FHT_HAVE_SSE
+    case FHT_ISA_SSE:
+        return fht_double_sse;
+#endif
+    case FHT_ISA_GENERIC:
+        return fht_double_generic;
+    default:
+        return NULL;
+    }
+}
+
+typedef void (*fht_float_fixed_function)(float *);
+typedef void (*fht_double_fixed_function)(double *);
+
+// The kernels for vectors of length 2^log_n only (NULL for the generic
+// instruction set, for log_n = 0 and if the kernels are not compiled in).
+// They skip the dispatch on log_n, which pays off when many vectors of the
+// same length are transformed.
+static inline fht_float_fixed_function fht_float_fixed_kernel(int isa,
+                                                              int log_n) {
+    if (log_n < 1 || log_n > 30) {
+        return NULL;
+    }
+    switch (isa) {
+#ifdef FHT_HAVE_AVX512
+    case FHT_ISA_AVX512:
+        return fht_float_avx512_helpers[log_n];
+#endif
+#ifdef FHT_HAVE_AVX
+    case FHT_ISA_AVX:
+        return fht_float_avx_helpers[log_n];
+#endif
+#ifdef FHT_HAVE_SSE
+    case FHT_ISA_SSE:
+        return fht_float_sse_helpers[log_n];
+#endif
+    default:
+        return NULL;
+    }
+}
+
+static inline fht_double_fixed_function fht_double_fixed_kernel(int isa,
+                                                                int log_n) {
+    if (log_n < 1 || log_n > 30) {
+        return NULL;
+    }
+    switch (isa) {
+#ifdef FHT_HAVE_AVX512
+    case FHT_ISA_AVX512:
+        return fht_double_avx512_helpers[log_n];
+#endif
+#ifdef FHT_HAVE_AVX
+    case FHT_ISA_AVX:
+        return fht_double_avx_helpers[log_n];
+#endif
+#ifdef FHT_HAVE_SSE
+    case FHT_ISA_SSE:
+        return fht_double_sse_helpers[log_n];
+#endif
+    default:
+        return NULL;
+    }
+}
+
+// The most preferred instruction set that fht_isa_supported accepts. The
+// result is cached (concurrent first calls all compute the same value).
+static inline int fht_best_isa(void) {
+    static int best_isa = -1;
+#ifdef FHT_RUNTIME_DISPATCH
+    int isa = __atomic_load_n(&best_isa, __ATOMIC_RELAXED);
+#else
+    int isa = best_isa;
+#endif
+    if (isa < 0) {
+        isa = 0;
+        while (!fht_isa_supported(isa)) {
+            ++isa;
+        }
+#ifdef FHT_RUNTIME_DISPATCH
+        __atomic_store_n(&best_isa, isa, __ATOMIC_RELAXED);
+#else
+        best_isa = isa;
+#endif
+    }
+    return isa;
+}
+
+int fht_float(float *buf, int log_n) {
+    return fht_float_kernel(fht_best_isa())(buf, log_n);
+}
+
+int fht_double(double *buf, int log_n) {
+    return fht_double_kernel(fht_best_isa())(buf, log_n);
+}
 
 int fht_float_oop(float *in, float *out, int log_n) {
     fast_copy(out, in, sizeof(float) << log_n);
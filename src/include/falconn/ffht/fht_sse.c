@@ -1,6 +1,6 @@
 #include "fht.h"
-static inline void helper_float_1(float *buf);
-static inline void helper_float_1(float *buf) {
+FHT_TARGET("sse4.1") static inline void helper_float_sse_1(float *buf);
+FHT_TARGET("sse4.1") static inline void helper_float_sse_1(float *buf) {
   for (int j = 0; j < 2; j += 2) {
     for (int k = 0; k < 1; ++k) {
       float u = buf[j + k];
@@ -10,8 +10,8 @@ static inline void helper_float_1(float *buf) {
     }
   }
 }
-static inline void helper_float_2(float *buf);
-static inline void helper_float_2(float *buf) {
+FHT_TARGET("sse4.1") static inline void helper_float_sse_2(float *buf);
+FHT_TARGET("sse4.1") static inline void helper_float_sse_2(float *buf) {
   for (int j = 0; j < 4; j += 4) {
     __asm__ volatile (
       "movups (%0), %%xmm0\n"
@@ -37,8 +37,8 @@ static inline void helper_float_2(float *buf) {
     );
   }
 }
-static inline void helper_float_3(float *buf);
-static inline void helper_float_3(float *buf) {
+FHT_TARGET("sse4.1") static inline void helper_float_sse_3(float *buf);
+FHT_TARGET("sse4.1") static inline void helper_float_sse_3(float *buf) {
   for (int j = 0; j < 8; j += 8) {
     for (int k = 0; k < 4; k += 4) {
       __asm__ volatile (
@@ -89,8 +89,8 @@ static inline void helper_float_3(float *buf) {
     }
   }
 }
-static inline void helper_float_4(float *buf);
-static inline void helper_float_4(float *buf) {
+FHT_TARGET("sse4.1") static inline void helper_float_sse_4(float *buf);
+FHT_TARGET("sse4.1") static inline void helper_float_sse_4(float *buf) {
   for (int j = 0; j < 16; j += 16) {
     for (int k = 0; k < 4; k += 4) {
       __asm__ volatile (
@@ -191,8 +191,8 @@ static inline void helper_float_4(float *buf) {
     }
   }
 }
-static inline void helper_float_5(float *buf);
-static inline void helper_float_5(float *buf) {
+FHT_TARGET("sse4.1") static inline void helper_float_sse_5(float *buf);
+FHT_TARGET("sse4.1") static inline void helper_float_sse_5(float *buf) {
   for (int j = 0; j < 32; j += 32) {
     for (int k = 0; k < 4; k += 4) {
       __asm__ volatile (
@@ -401,8 +401,8 @@ static inline void helper_float_5(float *buf) {
     }
   }
 }
-static inline void helper_float_6(float *buf);
-static inline void helper_float_6(float *buf) {
+FHT_TARGET("sse4.1") static inline void helper_float_sse_6(float *buf);
+FHT_TARGET("sse4.1") static inline void helper_float_sse_6(float *buf) {
   for (int j = 0; j < 64; j += 32) {
     for (int k = 0; k < 4; k += 4) {
       __asm__ volatile (
@@ -626,8 +626,8 @@ static inline void helper_float_6(float *buf) {
     }
   }
 }
-void helper_float_7_recursive(float *buf, int depth);
-void helper_float_7_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_7_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_7_recursive(float *buf, int depth) {
   if (depth == 7) {
     for (int j = 0; j < 128; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -870,12 +870,12 @@ void helper_float_7_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_7(float *buf);
-void helper_float_7(float *buf) {
-  helper_float_7_recursive(buf, 7);
+FHT_TARGET("sse4.1") void helper_float_sse_7(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_7(float *buf) {
+  helper_float_sse_7_recursive(buf, 7);
 }
-static inline void helper_float_8(float *buf);
-static inline void helper_float_8(float *buf) {
+FHT_TARGET("sse4.1") static inline void helper_float_sse_8(float *buf);
+FHT_TARGET("sse4.1") static inline void helper_float_sse_8(float *buf) {
   for (int j = 0; j < 256; j += 32) {
     for (int k = 0; k < 4; k += 4) {
       __asm__ volatile (
@@ -1155,8 +1155,8 @@ static inline void helper_float_8(float *buf) {
     }
   }
 }
-static inline void helper_float_9(float *buf);
-static inline void helper_float_9(float *buf) {
+FHT_TARGET("sse4.1") static inline void helper_float_sse_9(float *buf);
+FHT_TARGET("sse4.1") static inline void helper_float_sse_9(float *buf) {
   for (int j = 0; j < 512; j += 32) {
     for (int k = 0; k < 4; k += 4) {
       __asm__ volatile (
@@ -1451,8 +1451,8 @@ static inline void helper_float_9(float *buf) {
     }
   }
 }
-static inline void helper_float_10(float *buf);
-static inline void helper_float_10(float *buf) {
+FHT_TARGET("sse4.1") static inline void helper_float_sse_10(float *buf);
+FHT_TARGET("sse4.1") static inline void helper_float_sse_10(float *buf) {
   for (int j = 0; j < 1024; j += 32) {
     for (int k = 0; k < 4; k += 4) {
       __asm__ volatile (
@@ -1763,8 +1763,8 @@ static inline void helper_float_10(float *buf) {
     }
   }
 }
-static inline void helper_float_11(float *buf);
-static inline void helper_float_11(float *buf) {
+FHT_TARGET("sse4.1") static inline void helper_float_sse_11(float *buf);
+FHT_TARGET("sse4.1") static inline void helper_float_sse_11(float *buf) {
   for (int j = 0; j < 2048; j += 32) {
     for (int k = 0; k < 4; k += 4) {
       __asm__ volatile (
@@ -2115,8 +2115,8 @@ static inline void helper_float_11(float *buf) {
     }
   }
 }
-void helper_float_12_recursive(float *buf, int depth);
-void helper_float_12_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_12_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_12_recursive(float *buf, int depth) {
   if (depth == 7) {
     for (int j = 0; j < 128; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -2359,14 +2359,14 @@ void helper_float_12_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 10) {
-    helper_float_12_recursive(buf + 0, 7);
-    helper_float_12_recursive(buf + 128, 7);
-    helper_float_12_recursive(buf + 256, 7);
-    helper_float_12_recursive(buf + 384, 7);
-    helper_float_12_recursive(buf + 512, 7);
-    helper_float_12_recursive(buf + 640, 7);
-    helper_float_12_recursive(buf + 768, 7);
-    helper_float_12_recursive(buf + 896, 7);
+    helper_float_sse_12_recursive(buf + 0, 7);
+    helper_float_sse_12_recursive(buf + 128, 7);
+    helper_float_sse_12_recursive(buf + 256, 7);
+    helper_float_sse_12_recursive(buf + 384, 7);
+    helper_float_sse_12_recursive(buf + 512, 7);
+    helper_float_sse_12_recursive(buf + 640, 7);
+    helper_float_sse_12_recursive(buf + 768, 7);
+    helper_float_sse_12_recursive(buf + 896, 7);
     for (int j = 0; j < 1024; j += 1024) {
       for (int k = 0; k < 128; k += 4) {
         __asm__ volatile (
@@ -2441,10 +2441,10 @@ void helper_float_12_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 12) {
-    helper_float_12_recursive(buf + 0, 10);
-    helper_float_12_recursive(buf + 1024, 10);
-    helper_float_12_recursive(buf + 2048, 10);
-    helper_float_12_recursive(buf + 3072, 10);
+    helper_float_sse_12_recursive(buf + 0, 10);
+    helper_float_sse_12_recursive(buf + 1024, 10);
+    helper_float_sse_12_recursive(buf + 2048, 10);
+    helper_float_sse_12_recursive(buf + 3072, 10);
     for (int j = 0; j < 4096; j += 4096) {
       for (int k = 0; k < 1024; k += 4) {
         __asm__ volatile (
@@ -2479,12 +2479,12 @@ void helper_float_12_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_12(float *buf);
-void helper_float_12(float *buf) {
-  helper_float_12_recursive(buf, 12);
+FHT_TARGET("sse4.1") void helper_float_sse_12(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_12(float *buf) {
+  helper_float_sse_12_recursive(buf, 12);
 }
-void helper_float_13_recursive(float *buf, int depth);
-void helper_float_13_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_13_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_13_recursive(float *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -2838,10 +2838,10 @@ void helper_float_13_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 13) {
-    helper_float_13_recursive(buf + 0, 11);
-    helper_float_13_recursive(buf + 2048, 11);
-    helper_float_13_recursive(buf + 4096, 11);
-    helper_float_13_recursive(buf + 6144, 11);
+    helper_float_sse_13_recursive(buf + 0, 11);
+    helper_float_sse_13_recursive(buf + 2048, 11);
+    helper_float_sse_13_recursive(buf + 4096, 11);
+    helper_float_sse_13_recursive(buf + 6144, 11);
     for (int j = 0; j < 8192; j += 8192) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -2876,12 +2876,12 @@ void helper_float_13_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_13(float *buf);
-void helper_float_13(float *buf) {
-  helper_float_13_recursive(buf, 13);
+FHT_TARGET("sse4.1") void helper_float_sse_13(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_13(float *buf) {
+  helper_float_sse_13_recursive(buf, 13);
 }
-void helper_float_14_recursive(float *buf, int depth);
-void helper_float_14_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_14_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_14_recursive(float *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -3235,14 +3235,14 @@ void helper_float_14_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_float_14_recursive(buf + 0, 11);
-    helper_float_14_recursive(buf + 2048, 11);
-    helper_float_14_recursive(buf + 4096, 11);
-    helper_float_14_recursive(buf + 6144, 11);
-    helper_float_14_recursive(buf + 8192, 11);
-    helper_float_14_recursive(buf + 10240, 11);
-    helper_float_14_recursive(buf + 12288, 11);
-    helper_float_14_recursive(buf + 14336, 11);
+    helper_float_sse_14_recursive(buf + 0, 11);
+    helper_float_sse_14_recursive(buf + 2048, 11);
+    helper_float_sse_14_recursive(buf + 4096, 11);
+    helper_float_sse_14_recursive(buf + 6144, 11);
+    helper_float_sse_14_recursive(buf + 8192, 11);
+    helper_float_sse_14_recursive(buf + 10240, 11);
+    helper_float_sse_14_recursive(buf + 12288, 11);
+    helper_float_sse_14_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -3317,12 +3317,12 @@ void helper_float_14_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_14(float *buf);
-void helper_float_14(float *buf) {
-  helper_float_14_recursive(buf, 14);
+FHT_TARGET("sse4.1") void helper_float_sse_14(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_14(float *buf) {
+  helper_float_sse_14_recursive(buf, 14);
 }
-void helper_float_15_recursive(float *buf, int depth);
-void helper_float_15_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_15_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_15_recursive(float *buf, int depth) {
   if (depth == 13) {
     for (int j = 0; j < 8192; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -3707,10 +3707,10 @@ void helper_float_15_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_float_15_recursive(buf + 0, 13);
-    helper_float_15_recursive(buf + 8192, 13);
-    helper_float_15_recursive(buf + 16384, 13);
-    helper_float_15_recursive(buf + 24576, 13);
+    helper_float_sse_15_recursive(buf + 0, 13);
+    helper_float_sse_15_recursive(buf + 8192, 13);
+    helper_float_sse_15_recursive(buf + 16384, 13);
+    helper_float_sse_15_recursive(buf + 24576, 13);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 8192; k += 4) {
         __asm__ volatile (
@@ -3745,12 +3745,12 @@ void helper_float_15_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_15(float *buf);
-void helper_float_15(float *buf) {
-  helper_float_15_recursive(buf, 15);
+FHT_TARGET("sse4.1") void helper_float_sse_15(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_15(float *buf) {
+  helper_float_sse_15_recursive(buf, 15);
 }
-void helper_float_16_recursive(float *buf, int depth);
-void helper_float_16_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_16_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_16_recursive(float *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -4104,14 +4104,14 @@ void helper_float_16_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_float_16_recursive(buf + 0, 11);
-    helper_float_16_recursive(buf + 2048, 11);
-    helper_float_16_recursive(buf + 4096, 11);
-    helper_float_16_recursive(buf + 6144, 11);
-    helper_float_16_recursive(buf + 8192, 11);
-    helper_float_16_recursive(buf + 10240, 11);
-    helper_float_16_recursive(buf + 12288, 11);
-    helper_float_16_recursive(buf + 14336, 11);
+    helper_float_sse_16_recursive(buf + 0, 11);
+    helper_float_sse_16_recursive(buf + 2048, 11);
+    helper_float_sse_16_recursive(buf + 4096, 11);
+    helper_float_sse_16_recursive(buf + 6144, 11);
+    helper_float_sse_16_recursive(buf + 8192, 11);
+    helper_float_sse_16_recursive(buf + 10240, 11);
+    helper_float_sse_16_recursive(buf + 12288, 11);
+    helper_float_sse_16_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -4186,10 +4186,10 @@ void helper_float_16_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 16) {
-    helper_float_16_recursive(buf + 0, 14);
-    helper_float_16_recursive(buf + 16384, 14);
-    helper_float_16_recursive(buf + 32768, 14);
-    helper_float_16_recursive(buf + 49152, 14);
+    helper_float_sse_16_recursive(buf + 0, 14);
+    helper_float_sse_16_recursive(buf + 16384, 14);
+    helper_float_sse_16_recursive(buf + 32768, 14);
+    helper_float_sse_16_recursive(buf + 49152, 14);
     for (int j = 0; j < 65536; j += 65536) {
       for (int k = 0; k < 16384; k += 4) {
         __asm__ volatile (
@@ -4224,12 +4224,12 @@ void helper_float_16_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_16(float *buf);
-void helper_float_16(float *buf) {
-  helper_float_16_recursive(buf, 16);
+FHT_TARGET("sse4.1") void helper_float_sse_16(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_16(float *buf) {
+  helper_float_sse_16_recursive(buf, 16);
 }
-void helper_float_17_recursive(float *buf, int depth);
-void helper_float_17_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_17_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_17_recursive(float *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -4583,14 +4583,14 @@ void helper_float_17_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_float_17_recursive(buf + 0, 11);
-    helper_float_17_recursive(buf + 2048, 11);
-    helper_float_17_recursive(buf + 4096, 11);
-    helper_float_17_recursive(buf + 6144, 11);
-    helper_float_17_recursive(buf + 8192, 11);
-    helper_float_17_recursive(buf + 10240, 11);
-    helper_float_17_recursive(buf + 12288, 11);
-    helper_float_17_recursive(buf + 14336, 11);
+    helper_float_sse_17_recursive(buf + 0, 11);
+    helper_float_sse_17_recursive(buf + 2048, 11);
+    helper_float_sse_17_recursive(buf + 4096, 11);
+    helper_float_sse_17_recursive(buf + 6144, 11);
+    helper_float_sse_17_recursive(buf + 8192, 11);
+    helper_float_sse_17_recursive(buf + 10240, 11);
+    helper_float_sse_17_recursive(buf + 12288, 11);
+    helper_float_sse_17_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -4665,14 +4665,14 @@ void helper_float_17_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_float_17_recursive(buf + 0, 14);
-    helper_float_17_recursive(buf + 16384, 14);
-    helper_float_17_recursive(buf + 32768, 14);
-    helper_float_17_recursive(buf + 49152, 14);
-    helper_float_17_recursive(buf + 65536, 14);
-    helper_float_17_recursive(buf + 81920, 14);
-    helper_float_17_recursive(buf + 98304, 14);
-    helper_float_17_recursive(buf + 114688, 14);
+    helper_float_sse_17_recursive(buf + 0, 14);
+    helper_float_sse_17_recursive(buf + 16384, 14);
+    helper_float_sse_17_recursive(buf + 32768, 14);
+    helper_float_sse_17_recursive(buf + 49152, 14);
+    helper_float_sse_17_recursive(buf + 65536, 14);
+    helper_float_sse_17_recursive(buf + 81920, 14);
+    helper_float_sse_17_recursive(buf + 98304, 14);
+    helper_float_sse_17_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 4) {
         __asm__ volatile (
@@ -4747,12 +4747,12 @@ void helper_float_17_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_17(float *buf);
-void helper_float_17(float *buf) {
-  helper_float_17_recursive(buf, 17);
+FHT_TARGET("sse4.1") void helper_float_sse_17(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_17(float *buf) {
+  helper_float_sse_17_recursive(buf, 17);
 }
-void helper_float_18_recursive(float *buf, int depth);
-void helper_float_18_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_18_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_18_recursive(float *buf, int depth) {
   if (depth == 13) {
     for (int j = 0; j < 8192; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -5137,14 +5137,14 @@ void helper_float_18_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 16) {
-    helper_float_18_recursive(buf + 0, 13);
-    helper_float_18_recursive(buf + 8192, 13);
-    helper_float_18_recursive(buf + 16384, 13);
-    helper_float_18_recursive(buf + 24576, 13);
-    helper_float_18_recursive(buf + 32768, 13);
-    helper_float_18_recursive(buf + 40960, 13);
-    helper_float_18_recursive(buf + 49152, 13);
-    helper_float_18_recursive(buf + 57344, 13);
+    helper_float_sse_18_recursive(buf + 0, 13);
+    helper_float_sse_18_recursive(buf + 8192, 13);
+    helper_float_sse_18_recursive(buf + 16384, 13);
+    helper_float_sse_18_recursive(buf + 24576, 13);
+    helper_float_sse_18_recursive(buf + 32768, 13);
+    helper_float_sse_18_recursive(buf + 40960, 13);
+    helper_float_sse_18_recursive(buf + 49152, 13);
+    helper_float_sse_18_recursive(buf + 57344, 13);
     for (int j = 0; j < 65536; j += 65536) {
       for (int k = 0; k < 8192; k += 4) {
         __asm__ volatile (
@@ -5219,10 +5219,10 @@ void helper_float_18_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_float_18_recursive(buf + 0, 16);
-    helper_float_18_recursive(buf + 65536, 16);
-    helper_float_18_recursive(buf + 131072, 16);
-    helper_float_18_recursive(buf + 196608, 16);
+    helper_float_sse_18_recursive(buf + 0, 16);
+    helper_float_sse_18_recursive(buf + 65536, 16);
+    helper_float_sse_18_recursive(buf + 131072, 16);
+    helper_float_sse_18_recursive(buf + 196608, 16);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 65536; k += 4) {
         __asm__ volatile (
@@ -5257,12 +5257,12 @@ void helper_float_18_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_18(float *buf);
-void helper_float_18(float *buf) {
-  helper_float_18_recursive(buf, 18);
+FHT_TARGET("sse4.1") void helper_float_sse_18(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_18(float *buf) {
+  helper_float_sse_18_recursive(buf, 18);
 }
-void helper_float_19_recursive(float *buf, int depth);
-void helper_float_19_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_19_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_19_recursive(float *buf, int depth) {
   if (depth == 13) {
     for (int j = 0; j < 8192; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -5647,14 +5647,14 @@ void helper_float_19_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 16) {
-    helper_float_19_recursive(buf + 0, 13);
-    helper_float_19_recursive(buf + 8192, 13);
-    helper_float_19_recursive(buf + 16384, 13);
-    helper_float_19_recursive(buf + 24576, 13);
-    helper_float_19_recursive(buf + 32768, 13);
-    helper_float_19_recursive(buf + 40960, 13);
-    helper_float_19_recursive(buf + 49152, 13);
-    helper_float_19_recursive(buf + 57344, 13);
+    helper_float_sse_19_recursive(buf + 0, 13);
+    helper_float_sse_19_recursive(buf + 8192, 13);
+    helper_float_sse_19_recursive(buf + 16384, 13);
+    helper_float_sse_19_recursive(buf + 24576, 13);
+    helper_float_sse_19_recursive(buf + 32768, 13);
+    helper_float_sse_19_recursive(buf + 40960, 13);
+    helper_float_sse_19_recursive(buf + 49152, 13);
+    helper_float_sse_19_recursive(buf + 57344, 13);
     for (int j = 0; j < 65536; j += 65536) {
       for (int k = 0; k < 8192; k += 4) {
         __asm__ volatile (
@@ -5729,14 +5729,14 @@ void helper_float_19_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 19) {
-    helper_float_19_recursive(buf + 0, 16);
-    helper_float_19_recursive(buf + 65536, 16);
-    helper_float_19_recursive(buf + 131072, 16);
-    helper_float_19_recursive(buf + 196608, 16);
-    helper_float_19_recursive(buf + 262144, 16);
-    helper_float_19_recursive(buf + 327680, 16);
-    helper_float_19_recursive(buf + 393216, 16);
-    helper_float_19_recursive(buf + 458752, 16);
+    helper_float_sse_19_recursive(buf + 0, 16);
+    helper_float_sse_19_recursive(buf + 65536, 16);
+    helper_float_sse_19_recursive(buf + 131072, 16);
+    helper_float_sse_19_recursive(buf + 196608, 16);
+    helper_float_sse_19_recursive(buf + 262144, 16);
+    helper_float_sse_19_recursive(buf + 327680, 16);
+    helper_float_sse_19_recursive(buf + 393216, 16);
+    helper_float_sse_19_recursive(buf + 458752, 16);
     for (int j = 0; j < 524288; j += 524288) {
       for (int k = 0; k < 65536; k += 4) {
         __asm__ volatile (
@@ -5811,12 +5811,12 @@ void helper_float_19_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_19(float *buf);
-void helper_float_19(float *buf) {
-  helper_float_19_recursive(buf, 19);
+FHT_TARGET("sse4.1") void helper_float_sse_19(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_19(float *buf) {
+  helper_float_sse_19_recursive(buf, 19);
 }
-void helper_float_20_recursive(float *buf, int depth);
-void helper_float_20_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_20_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_20_recursive(float *buf, int depth) {
   if (depth == 8) {
     for (int j = 0; j < 256; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -6099,14 +6099,14 @@ void helper_float_20_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 11) {
-    helper_float_20_recursive(buf + 0, 8);
-    helper_float_20_recursive(buf + 256, 8);
-    helper_float_20_recursive(buf + 512, 8);
-    helper_float_20_recursive(buf + 768, 8);
-    helper_float_20_recursive(buf + 1024, 8);
-    helper_float_20_recursive(buf + 1280, 8);
-    helper_float_20_recursive(buf + 1536, 8);
-    helper_float_20_recursive(buf + 1792, 8);
+    helper_float_sse_20_recursive(buf + 0, 8);
+    helper_float_sse_20_recursive(buf + 256, 8);
+    helper_float_sse_20_recursive(buf + 512, 8);
+    helper_float_sse_20_recursive(buf + 768, 8);
+    helper_float_sse_20_recursive(buf + 1024, 8);
+    helper_float_sse_20_recursive(buf + 1280, 8);
+    helper_float_sse_20_recursive(buf + 1536, 8);
+    helper_float_sse_20_recursive(buf + 1792, 8);
     for (int j = 0; j < 2048; j += 2048) {
       for (int k = 0; k < 256; k += 4) {
         __asm__ volatile (
@@ -6181,14 +6181,14 @@ void helper_float_20_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_float_20_recursive(buf + 0, 11);
-    helper_float_20_recursive(buf + 2048, 11);
-    helper_float_20_recursive(buf + 4096, 11);
-    helper_float_20_recursive(buf + 6144, 11);
-    helper_float_20_recursive(buf + 8192, 11);
-    helper_float_20_recursive(buf + 10240, 11);
-    helper_float_20_recursive(buf + 12288, 11);
-    helper_float_20_recursive(buf + 14336, 11);
+    helper_float_sse_20_recursive(buf + 0, 11);
+    helper_float_sse_20_recursive(buf + 2048, 11);
+    helper_float_sse_20_recursive(buf + 4096, 11);
+    helper_float_sse_20_recursive(buf + 6144, 11);
+    helper_float_sse_20_recursive(buf + 8192, 11);
+    helper_float_sse_20_recursive(buf + 10240, 11);
+    helper_float_sse_20_recursive(buf + 12288, 11);
+    helper_float_sse_20_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -6263,14 +6263,14 @@ void helper_float_20_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_float_20_recursive(buf + 0, 14);
-    helper_float_20_recursive(buf + 16384, 14);
-    helper_float_20_recursive(buf + 32768, 14);
-    helper_float_20_recursive(buf + 49152, 14);
-    helper_float_20_recursive(buf + 65536, 14);
-    helper_float_20_recursive(buf + 81920, 14);
-    helper_float_20_recursive(buf + 98304, 14);
-    helper_float_20_recursive(buf + 114688, 14);
+    helper_float_sse_20_recursive(buf + 0, 14);
+    helper_float_sse_20_recursive(buf + 16384, 14);
+    helper_float_sse_20_recursive(buf + 32768, 14);
+    helper_float_sse_20_recursive(buf + 49152, 14);
+    helper_float_sse_20_recursive(buf + 65536, 14);
+    helper_float_sse_20_recursive(buf + 81920, 14);
+    helper_float_sse_20_recursive(buf + 98304, 14);
+    helper_float_sse_20_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 4) {
         __asm__ volatile (
@@ -6345,14 +6345,14 @@ void helper_float_20_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_float_20_recursive(buf + 0, 17);
-    helper_float_20_recursive(buf + 131072, 17);
-    helper_float_20_recursive(buf + 262144, 17);
-    helper_float_20_recursive(buf + 393216, 17);
-    helper_float_20_recursive(buf + 524288, 17);
-    helper_float_20_recursive(buf + 655360, 17);
-    helper_float_20_recursive(buf + 786432, 17);
-    helper_float_20_recursive(buf + 917504, 17);
+    helper_float_sse_20_recursive(buf + 0, 17);
+    helper_float_sse_20_recursive(buf + 131072, 17);
+    helper_float_sse_20_recursive(buf + 262144, 17);
+    helper_float_sse_20_recursive(buf + 393216, 17);
+    helper_float_sse_20_recursive(buf + 524288, 17);
+    helper_float_sse_20_recursive(buf + 655360, 17);
+    helper_float_sse_20_recursive(buf + 786432, 17);
+    helper_float_sse_20_recursive(buf + 917504, 17);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 131072; k += 4) {
         __asm__ volatile (
@@ -6427,12 +6427,12 @@ void helper_float_20_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_20(float *buf);
-void helper_float_20(float *buf) {
-  helper_float_20_recursive(buf, 20);
+FHT_TARGET("sse4.1") void helper_float_sse_20(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_20(float *buf) {
+  helper_float_sse_20_recursive(buf, 20);
 }
-void helper_float_21_recursive(float *buf, int depth);
-void helper_float_21_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_21_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_21_recursive(float *buf, int depth) {
   if (depth == 13) {
     for (int j = 0; j < 8192; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -6817,14 +6817,14 @@ void helper_float_21_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 16) {
-    helper_float_21_recursive(buf + 0, 13);
-    helper_float_21_recursive(buf + 8192, 13);
-    helper_float_21_recursive(buf + 16384, 13);
-    helper_float_21_recursive(buf + 24576, 13);
-    helper_float_21_recursive(buf + 32768, 13);
-    helper_float_21_recursive(buf + 40960, 13);
-    helper_float_21_recursive(buf + 49152, 13);
-    helper_float_21_recursive(buf + 57344, 13);
+    helper_float_sse_21_recursive(buf + 0, 13);
+    helper_float_sse_21_recursive(buf + 8192, 13);
+    helper_float_sse_21_recursive(buf + 16384, 13);
+    helper_float_sse_21_recursive(buf + 24576, 13);
+    helper_float_sse_21_recursive(buf + 32768, 13);
+    helper_float_sse_21_recursive(buf + 40960, 13);
+    helper_float_sse_21_recursive(buf + 49152, 13);
+    helper_float_sse_21_recursive(buf + 57344, 13);
     for (int j = 0; j < 65536; j += 65536) {
       for (int k = 0; k < 8192; k += 4) {
         __asm__ volatile (
@@ -6899,14 +6899,14 @@ void helper_float_21_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 19) {
-    helper_float_21_recursive(buf + 0, 16);
-    helper_float_21_recursive(buf + 65536, 16);
-    helper_float_21_recursive(buf + 131072, 16);
-    helper_float_21_recursive(buf + 196608, 16);
-    helper_float_21_recursive(buf + 262144, 16);
-    helper_float_21_recursive(buf + 327680, 16);
-    helper_float_21_recursive(buf + 393216, 16);
-    helper_float_21_recursive(buf + 458752, 16);
+    helper_float_sse_21_recursive(buf + 0, 16);
+    helper_float_sse_21_recursive(buf + 65536, 16);
+    helper_float_sse_21_recursive(buf + 131072, 16);
+    helper_float_sse_21_recursive(buf + 196608, 16);
+    helper_float_sse_21_recursive(buf + 262144, 16);
+    helper_float_sse_21_recursive(buf + 327680, 16);
+    helper_float_sse_21_recursive(buf + 393216, 16);
+    helper_float_sse_21_recursive(buf + 458752, 16);
     for (int j = 0; j < 524288; j += 524288) {
       for (int k = 0; k < 65536; k += 4) {
         __asm__ volatile (
@@ -6981,10 +6981,10 @@ void helper_float_21_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_float_21_recursive(buf + 0, 19);
-    helper_float_21_recursive(buf + 524288, 19);
-    helper_float_21_recursive(buf + 1048576, 19);
-    helper_float_21_recursive(buf + 1572864, 19);
+    helper_float_sse_21_recursive(buf + 0, 19);
+    helper_float_sse_21_recursive(buf + 524288, 19);
+    helper_float_sse_21_recursive(buf + 1048576, 19);
+    helper_float_sse_21_recursive(buf + 1572864, 19);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 524288; k += 4) {
         __asm__ volatile (
@@ -7019,12 +7019,12 @@ void helper_float_21_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_21(float *buf);
-void helper_float_21(float *buf) {
-  helper_float_21_recursive(buf, 21);
+FHT_TARGET("sse4.1") void helper_float_sse_21(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_21(float *buf) {
+  helper_float_sse_21_recursive(buf, 21);
 }
-void helper_float_22_recursive(float *buf, int depth);
-void helper_float_22_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_22_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_22_recursive(float *buf, int depth) {
   if (depth == 11) {
     for (int j = 0; j < 2048; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -7378,14 +7378,14 @@ void helper_float_22_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_float_22_recursive(buf + 0, 11);
-    helper_float_22_recursive(buf + 2048, 11);
-    helper_float_22_recursive(buf + 4096, 11);
-    helper_float_22_recursive(buf + 6144, 11);
-    helper_float_22_recursive(buf + 8192, 11);
-    helper_float_22_recursive(buf + 10240, 11);
-    helper_float_22_recursive(buf + 12288, 11);
-    helper_float_22_recursive(buf + 14336, 11);
+    helper_float_sse_22_recursive(buf + 0, 11);
+    helper_float_sse_22_recursive(buf + 2048, 11);
+    helper_float_sse_22_recursive(buf + 4096, 11);
+    helper_float_sse_22_recursive(buf + 6144, 11);
+    helper_float_sse_22_recursive(buf + 8192, 11);
+    helper_float_sse_22_recursive(buf + 10240, 11);
+    helper_float_sse_22_recursive(buf + 12288, 11);
+    helper_float_sse_22_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -7460,14 +7460,14 @@ void helper_float_22_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_float_22_recursive(buf + 0, 14);
-    helper_float_22_recursive(buf + 16384, 14);
-    helper_float_22_recursive(buf + 32768, 14);
-    helper_float_22_recursive(buf + 49152, 14);
-    helper_float_22_recursive(buf + 65536, 14);
-    helper_float_22_recursive(buf + 81920, 14);
-    helper_float_22_recursive(buf + 98304, 14);
-    helper_float_22_recursive(buf + 114688, 14);
+    helper_float_sse_22_recursive(buf + 0, 14);
+    helper_float_sse_22_recursive(buf + 16384, 14);
+    helper_float_sse_22_recursive(buf + 32768, 14);
+    helper_float_sse_22_recursive(buf + 49152, 14);
+    helper_float_sse_22_recursive(buf + 65536, 14);
+    helper_float_sse_22_recursive(buf + 81920, 14);
+    helper_float_sse_22_recursive(buf + 98304, 14);
+    helper_float_sse_22_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 4) {
         __asm__ volatile (
@@ -7542,14 +7542,14 @@ void helper_float_22_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_float_22_recursive(buf + 0, 17);
-    helper_float_22_recursive(buf + 131072, 17);
-    helper_float_22_recursive(buf + 262144, 17);
-    helper_float_22_recursive(buf + 393216, 17);
-    helper_float_22_recursive(buf + 524288, 17);
-    helper_float_22_recursive(buf + 655360, 17);
-    helper_float_22_recursive(buf + 786432, 17);
-    helper_float_22_recursive(buf + 917504, 17);
+    helper_float_sse_22_recursive(buf + 0, 17);
+    helper_float_sse_22_recursive(buf + 131072, 17);
+    helper_float_sse_22_recursive(buf + 262144, 17);
+    helper_float_sse_22_recursive(buf + 393216, 17);
+    helper_float_sse_22_recursive(buf + 524288, 17);
+    helper_float_sse_22_recursive(buf + 655360, 17);
+    helper_float_sse_22_recursive(buf + 786432, 17);
+    helper_float_sse_22_recursive(buf + 917504, 17);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 131072; k += 4) {
         __asm__ volatile (
@@ -7624,10 +7624,10 @@ void helper_float_22_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 22) {
-    helper_float_22_recursive(buf + 0, 20);
-    helper_float_22_recursive(buf + 1048576, 20);
-    helper_float_22_recursive(buf + 2097152, 20);
-    helper_float_22_recursive(buf + 3145728, 20);
+    helper_float_sse_22_recursive(buf + 0, 20);
+    helper_float_sse_22_recursive(buf + 1048576, 20);
+    helper_float_sse_22_recursive(buf + 2097152, 20);
+    helper_float_sse_22_recursive(buf + 3145728, 20);
     for (int j = 0; j < 4194304; j += 4194304) {
       for (int k = 0; k < 1048576; k += 4) {
         __asm__ volatile (
@@ -7662,12 +7662,12 @@ void helper_float_22_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_22(float *buf);
-void helper_float_22(float *buf) {
-  helper_float_22_recursive(buf, 22);
+FHT_TARGET("sse4.1") void helper_float_sse_22(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_22(float *buf) {
+  helper_float_sse_22_recursive(buf, 22);
 }
-void helper_float_23_recursive(float *buf, int depth);
-void helper_float_23_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_23_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_23_recursive(float *buf, int depth) {
   if (depth == 6) {
     for (int j = 0; j < 64; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -7894,14 +7894,14 @@ void helper_float_23_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 9) {
-    helper_float_23_recursive(buf + 0, 6);
-    helper_float_23_recursive(buf + 64, 6);
-    helper_float_23_recursive(buf + 128, 6);
-    helper_float_23_recursive(buf + 192, 6);
-    helper_float_23_recursive(buf + 256, 6);
-    helper_float_23_recursive(buf + 320, 6);
-    helper_float_23_recursive(buf + 384, 6);
-    helper_float_23_recursive(buf + 448, 6);
+    helper_float_sse_23_recursive(buf + 0, 6);
+    helper_float_sse_23_recursive(buf + 64, 6);
+    helper_float_sse_23_recursive(buf + 128, 6);
+    helper_float_sse_23_recursive(buf + 192, 6);
+    helper_float_sse_23_recursive(buf + 256, 6);
+    helper_float_sse_23_recursive(buf + 320, 6);
+    helper_float_sse_23_recursive(buf + 384, 6);
+    helper_float_sse_23_recursive(buf + 448, 6);
     for (int j = 0; j < 512; j += 512) {
       for (int k = 0; k < 64; k += 4) {
         __asm__ volatile (
@@ -7976,14 +7976,14 @@ void helper_float_23_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 12) {
-    helper_float_23_recursive(buf + 0, 9);
-    helper_float_23_recursive(buf + 512, 9);
-    helper_float_23_recursive(buf + 1024, 9);
-    helper_float_23_recursive(buf + 1536, 9);
-    helper_float_23_recursive(buf + 2048, 9);
-    helper_float_23_recursive(buf + 2560, 9);
-    helper_float_23_recursive(buf + 3072, 9);
-    helper_float_23_recursive(buf + 3584, 9);
+    helper_float_sse_23_recursive(buf + 0, 9);
+    helper_float_sse_23_recursive(buf + 512, 9);
+    helper_float_sse_23_recursive(buf + 1024, 9);
+    helper_float_sse_23_recursive(buf + 1536, 9);
+    helper_float_sse_23_recursive(buf + 2048, 9);
+    helper_float_sse_23_recursive(buf + 2560, 9);
+    helper_float_sse_23_recursive(buf + 3072, 9);
+    helper_float_sse_23_recursive(buf + 3584, 9);
     for (int j = 0; j < 4096; j += 4096) {
       for (int k = 0; k < 512; k += 4) {
         __asm__ volatile (
@@ -8058,14 +8058,14 @@ void helper_float_23_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_float_23_recursive(buf + 0, 12);
-    helper_float_23_recursive(buf + 4096, 12);
-    helper_float_23_recursive(buf + 8192, 12);
-    helper_float_23_recursive(buf + 12288, 12);
-    helper_float_23_recursive(buf + 16384, 12);
-    helper_float_23_recursive(buf + 20480, 12);
-    helper_float_23_recursive(buf + 24576, 12);
-    helper_float_23_recursive(buf + 28672, 12);
+    helper_float_sse_23_recursive(buf + 0, 12);
+    helper_float_sse_23_recursive(buf + 4096, 12);
+    helper_float_sse_23_recursive(buf + 8192, 12);
+    helper_float_sse_23_recursive(buf + 12288, 12);
+    helper_float_sse_23_recursive(buf + 16384, 12);
+    helper_float_sse_23_recursive(buf + 20480, 12);
+    helper_float_sse_23_recursive(buf + 24576, 12);
+    helper_float_sse_23_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 4) {
         __asm__ volatile (
@@ -8140,14 +8140,14 @@ void helper_float_23_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_float_23_recursive(buf + 0, 15);
-    helper_float_23_recursive(buf + 32768, 15);
-    helper_float_23_recursive(buf + 65536, 15);
-    helper_float_23_recursive(buf + 98304, 15);
-    helper_float_23_recursive(buf + 131072, 15);
-    helper_float_23_recursive(buf + 163840, 15);
-    helper_float_23_recursive(buf + 196608, 15);
-    helper_float_23_recursive(buf + 229376, 15);
+    helper_float_sse_23_recursive(buf + 0, 15);
+    helper_float_sse_23_recursive(buf + 32768, 15);
+    helper_float_sse_23_recursive(buf + 65536, 15);
+    helper_float_sse_23_recursive(buf + 98304, 15);
+    helper_float_sse_23_recursive(buf + 131072, 15);
+    helper_float_sse_23_recursive(buf + 163840, 15);
+    helper_float_sse_23_recursive(buf + 196608, 15);
+    helper_float_sse_23_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 4) {
         __asm__ volatile (
@@ -8222,14 +8222,14 @@ void helper_float_23_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_float_23_recursive(buf + 0, 18);
-    helper_float_23_recursive(buf + 262144, 18);
-    helper_float_23_recursive(buf + 524288, 18);
-    helper_float_23_recursive(buf + 786432, 18);
-    helper_float_23_recursive(buf + 1048576, 18);
-    helper_float_23_recursive(buf + 1310720, 18);
-    helper_float_23_recursive(buf + 1572864, 18);
-    helper_float_23_recursive(buf + 1835008, 18);
+    helper_float_sse_23_recursive(buf + 0, 18);
+    helper_float_sse_23_recursive(buf + 262144, 18);
+    helper_float_sse_23_recursive(buf + 524288, 18);
+    helper_float_sse_23_recursive(buf + 786432, 18);
+    helper_float_sse_23_recursive(buf + 1048576, 18);
+    helper_float_sse_23_recursive(buf + 1310720, 18);
+    helper_float_sse_23_recursive(buf + 1572864, 18);
+    helper_float_sse_23_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 4) {
         __asm__ volatile (
@@ -8304,10 +8304,10 @@ void helper_float_23_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 23) {
-    helper_float_23_recursive(buf + 0, 21);
-    helper_float_23_recursive(buf + 2097152, 21);
-    helper_float_23_recursive(buf + 4194304, 21);
-    helper_float_23_recursive(buf + 6291456, 21);
+    helper_float_sse_23_recursive(buf + 0, 21);
+    helper_float_sse_23_recursive(buf + 2097152, 21);
+    helper_float_sse_23_recursive(buf + 4194304, 21);
+    helper_float_sse_23_recursive(buf + 6291456, 21);
     for (int j = 0; j < 8388608; j += 8388608) {
       for (int k = 0; k < 2097152; k += 4) {
         __asm__ volatile (
@@ -8342,12 +8342,12 @@ void helper_float_23_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_23(float *buf);
-void helper_float_23(float *buf) {
-  helper_float_23_recursive(buf, 23);
+FHT_TARGET("sse4.1") void helper_float_sse_23(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_23(float *buf) {
+  helper_float_sse_23_recursive(buf, 23);
 }
-void helper_float_24_recursive(float *buf, int depth);
-void helper_float_24_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_24_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_24_recursive(float *buf, int depth) {
   if (depth == 15) {
     for (int j = 0; j < 32768; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -8787,14 +8787,14 @@ void helper_float_24_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_float_24_recursive(buf + 0, 15);
-    helper_float_24_recursive(buf + 32768, 15);
-    helper_float_24_recursive(buf + 65536, 15);
-    helper_float_24_recursive(buf + 98304, 15);
-    helper_float_24_recursive(buf + 131072, 15);
-    helper_float_24_recursive(buf + 163840, 15);
-    helper_float_24_recursive(buf + 196608, 15);
-    helper_float_24_recursive(buf + 229376, 15);
+    helper_float_sse_24_recursive(buf + 0, 15);
+    helper_float_sse_24_recursive(buf + 32768, 15);
+    helper_float_sse_24_recursive(buf + 65536, 15);
+    helper_float_sse_24_recursive(buf + 98304, 15);
+    helper_float_sse_24_recursive(buf + 131072, 15);
+    helper_float_sse_24_recursive(buf + 163840, 15);
+    helper_float_sse_24_recursive(buf + 196608, 15);
+    helper_float_sse_24_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 4) {
         __asm__ volatile (
@@ -8869,14 +8869,14 @@ void helper_float_24_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_float_24_recursive(buf + 0, 18);
-    helper_float_24_recursive(buf + 262144, 18);
-    helper_float_24_recursive(buf + 524288, 18);
-    helper_float_24_recursive(buf + 786432, 18);
-    helper_float_24_recursive(buf + 1048576, 18);
-    helper_float_24_recursive(buf + 1310720, 18);
-    helper_float_24_recursive(buf + 1572864, 18);
-    helper_float_24_recursive(buf + 1835008, 18);
+    helper_float_sse_24_recursive(buf + 0, 18);
+    helper_float_sse_24_recursive(buf + 262144, 18);
+    helper_float_sse_24_recursive(buf + 524288, 18);
+    helper_float_sse_24_recursive(buf + 786432, 18);
+    helper_float_sse_24_recursive(buf + 1048576, 18);
+    helper_float_sse_24_recursive(buf + 1310720, 18);
+    helper_float_sse_24_recursive(buf + 1572864, 18);
+    helper_float_sse_24_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 4) {
         __asm__ volatile (
@@ -8951,14 +8951,14 @@ void helper_float_24_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 24) {
-    helper_float_24_recursive(buf + 0, 21);
-    helper_float_24_recursive(buf + 2097152, 21);
-    helper_float_24_recursive(buf + 4194304, 21);
-    helper_float_24_recursive(buf + 6291456, 21);
-    helper_float_24_recursive(buf + 8388608, 21);
-    helper_float_24_recursive(buf + 10485760, 21);
-    helper_float_24_recursive(buf + 12582912, 21);
-    helper_float_24_recursive(buf + 14680064, 21);
+    helper_float_sse_24_recursive(buf + 0, 21);
+    helper_float_sse_24_recursive(buf + 2097152, 21);
+    helper_float_sse_24_recursive(buf + 4194304, 21);
+    helper_float_sse_24_recursive(buf + 6291456, 21);
+    helper_float_sse_24_recursive(buf + 8388608, 21);
+    helper_float_sse_24_recursive(buf + 10485760, 21);
+    helper_float_sse_24_recursive(buf + 12582912, 21);
+    helper_float_sse_24_recursive(buf + 14680064, 21);
     for (int j = 0; j < 16777216; j += 16777216) {
       for (int k = 0; k < 2097152; k += 4) {
         __asm__ volatile (
@@ -9033,12 +9033,12 @@ void helper_float_24_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_24(float *buf);
-void helper_float_24(float *buf) {
-  helper_float_24_recursive(buf, 24);
+FHT_TARGET("sse4.1") void helper_float_sse_24(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_24(float *buf) {
+  helper_float_sse_24_recursive(buf, 24);
 }
-void helper_float_25_recursive(float *buf, int depth);
-void helper_float_25_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_25_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_25_recursive(float *buf, int depth) {
   if (depth == 8) {
     for (int j = 0; j < 256; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -9321,14 +9321,14 @@ void helper_float_25_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 11) {
-    helper_float_25_recursive(buf + 0, 8);
-    helper_float_25_recursive(buf + 256, 8);
-    helper_float_25_recursive(buf + 512, 8);
-    helper_float_25_recursive(buf + 768, 8);
-    helper_float_25_recursive(buf + 1024, 8);
-    helper_float_25_recursive(buf + 1280, 8);
-    helper_float_25_recursive(buf + 1536, 8);
-    helper_float_25_recursive(buf + 1792, 8);
+    helper_float_sse_25_recursive(buf + 0, 8);
+    helper_float_sse_25_recursive(buf + 256, 8);
+    helper_float_sse_25_recursive(buf + 512, 8);
+    helper_float_sse_25_recursive(buf + 768, 8);
+    helper_float_sse_25_recursive(buf + 1024, 8);
+    helper_float_sse_25_recursive(buf + 1280, 8);
+    helper_float_sse_25_recursive(buf + 1536, 8);
+    helper_float_sse_25_recursive(buf + 1792, 8);
     for (int j = 0; j < 2048; j += 2048) {
       for (int k = 0; k < 256; k += 4) {
         __asm__ volatile (
@@ -9403,14 +9403,14 @@ void helper_float_25_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_float_25_recursive(buf + 0, 11);
-    helper_float_25_recursive(buf + 2048, 11);
-    helper_float_25_recursive(buf + 4096, 11);
-    helper_float_25_recursive(buf + 6144, 11);
-    helper_float_25_recursive(buf + 8192, 11);
-    helper_float_25_recursive(buf + 10240, 11);
-    helper_float_25_recursive(buf + 12288, 11);
-    helper_float_25_recursive(buf + 14336, 11);
+    helper_float_sse_25_recursive(buf + 0, 11);
+    helper_float_sse_25_recursive(buf + 2048, 11);
+    helper_float_sse_25_recursive(buf + 4096, 11);
+    helper_float_sse_25_recursive(buf + 6144, 11);
+    helper_float_sse_25_recursive(buf + 8192, 11);
+    helper_float_sse_25_recursive(buf + 10240, 11);
+    helper_float_sse_25_recursive(buf + 12288, 11);
+    helper_float_sse_25_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -9485,14 +9485,14 @@ void helper_float_25_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_float_25_recursive(buf + 0, 14);
-    helper_float_25_recursive(buf + 16384, 14);
-    helper_float_25_recursive(buf + 32768, 14);
-    helper_float_25_recursive(buf + 49152, 14);
-    helper_float_25_recursive(buf + 65536, 14);
-    helper_float_25_recursive(buf + 81920, 14);
-    helper_float_25_recursive(buf + 98304, 14);
-    helper_float_25_recursive(buf + 114688, 14);
+    helper_float_sse_25_recursive(buf + 0, 14);
+    helper_float_sse_25_recursive(buf + 16384, 14);
+    helper_float_sse_25_recursive(buf + 32768, 14);
+    helper_float_sse_25_recursive(buf + 49152, 14);
+    helper_float_sse_25_recursive(buf + 65536, 14);
+    helper_float_sse_25_recursive(buf + 81920, 14);
+    helper_float_sse_25_recursive(buf + 98304, 14);
+    helper_float_sse_25_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 4) {
         __asm__ volatile (
@@ -9567,14 +9567,14 @@ void helper_float_25_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_float_25_recursive(buf + 0, 17);
-    helper_float_25_recursive(buf + 131072, 17);
-    helper_float_25_recursive(buf + 262144, 17);
-    helper_float_25_recursive(buf + 393216, 17);
-    helper_float_25_recursive(buf + 524288, 17);
-    helper_float_25_recursive(buf + 655360, 17);
-    helper_float_25_recursive(buf + 786432, 17);
-    helper_float_25_recursive(buf + 917504, 17);
+    helper_float_sse_25_recursive(buf + 0, 17);
+    helper_float_sse_25_recursive(buf + 131072, 17);
+    helper_float_sse_25_recursive(buf + 262144, 17);
+    helper_float_sse_25_recursive(buf + 393216, 17);
+    helper_float_sse_25_recursive(buf + 524288, 17);
+    helper_float_sse_25_recursive(buf + 655360, 17);
+    helper_float_sse_25_recursive(buf + 786432, 17);
+    helper_float_sse_25_recursive(buf + 917504, 17);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 131072; k += 4) {
         __asm__ volatile (
@@ -9649,14 +9649,14 @@ void helper_float_25_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 23) {
-    helper_float_25_recursive(buf + 0, 20);
-    helper_float_25_recursive(buf + 1048576, 20);
-    helper_float_25_recursive(buf + 2097152, 20);
-    helper_float_25_recursive(buf + 3145728, 20);
-    helper_float_25_recursive(buf + 4194304, 20);
-    helper_float_25_recursive(buf + 5242880, 20);
-    helper_float_25_recursive(buf + 6291456, 20);
-    helper_float_25_recursive(buf + 7340032, 20);
+    helper_float_sse_25_recursive(buf + 0, 20);
+    helper_float_sse_25_recursive(buf + 1048576, 20);
+    helper_float_sse_25_recursive(buf + 2097152, 20);
+    helper_float_sse_25_recursive(buf + 3145728, 20);
+    helper_float_sse_25_recursive(buf + 4194304, 20);
+    helper_float_sse_25_recursive(buf + 5242880, 20);
+    helper_float_sse_25_recursive(buf + 6291456, 20);
+    helper_float_sse_25_recursive(buf + 7340032, 20);
     for (int j = 0; j < 8388608; j += 8388608) {
       for (int k = 0; k < 1048576; k += 4) {
         __asm__ volatile (
@@ -9731,10 +9731,10 @@ void helper_float_25_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 25) {
-    helper_float_25_recursive(buf + 0, 23);
-    helper_float_25_recursive(buf + 8388608, 23);
-    helper_float_25_recursive(buf + 16777216, 23);
-    helper_float_25_recursive(buf + 25165824, 23);
+    helper_float_sse_25_recursive(buf + 0, 23);
+    helper_float_sse_25_recursive(buf + 8388608, 23);
+    helper_float_sse_25_recursive(buf + 16777216, 23);
+    helper_float_sse_25_recursive(buf + 25165824, 23);
     for (int j = 0; j < 33554432; j += 33554432) {
       for (int k = 0; k < 8388608; k += 4) {
         __asm__ volatile (
@@ -9769,12 +9769,12 @@ void helper_float_25_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_25(float *buf);
-void helper_float_25(float *buf) {
-  helper_float_25_recursive(buf, 25);
+FHT_TARGET("sse4.1") void helper_float_sse_25(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_25(float *buf) {
+  helper_float_sse_25_recursive(buf, 25);
 }
-void helper_float_26_recursive(float *buf, int depth);
-void helper_float_26_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_26_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_26_recursive(float *buf, int depth) {
   if (depth == 5) {
     for (int j = 0; j < 32; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -9986,14 +9986,14 @@ void helper_float_26_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 8) {
-    helper_float_26_recursive(buf + 0, 5);
-    helper_float_26_recursive(buf + 32, 5);
-    helper_float_26_recursive(buf + 64, 5);
-    helper_float_26_recursive(buf + 96, 5);
-    helper_float_26_recursive(buf + 128, 5);
-    helper_float_26_recursive(buf + 160, 5);
-    helper_float_26_recursive(buf + 192, 5);
-    helper_float_26_recursive(buf + 224, 5);
+    helper_float_sse_26_recursive(buf + 0, 5);
+    helper_float_sse_26_recursive(buf + 32, 5);
+    helper_float_sse_26_recursive(buf + 64, 5);
+    helper_float_sse_26_recursive(buf + 96, 5);
+    helper_float_sse_26_recursive(buf + 128, 5);
+    helper_float_sse_26_recursive(buf + 160, 5);
+    helper_float_sse_26_recursive(buf + 192, 5);
+    helper_float_sse_26_recursive(buf + 224, 5);
     for (int j = 0; j < 256; j += 256) {
       for (int k = 0; k < 32; k += 4) {
         __asm__ volatile (
@@ -10068,14 +10068,14 @@ void helper_float_26_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 11) {
-    helper_float_26_recursive(buf + 0, 8);
-    helper_float_26_recursive(buf + 256, 8);
-    helper_float_26_recursive(buf + 512, 8);
-    helper_float_26_recursive(buf + 768, 8);
-    helper_float_26_recursive(buf + 1024, 8);
-    helper_float_26_recursive(buf + 1280, 8);
-    helper_float_26_recursive(buf + 1536, 8);
-    helper_float_26_recursive(buf + 1792, 8);
+    helper_float_sse_26_recursive(buf + 0, 8);
+    helper_float_sse_26_recursive(buf + 256, 8);
+    helper_float_sse_26_recursive(buf + 512, 8);
+    helper_float_sse_26_recursive(buf + 768, 8);
+    helper_float_sse_26_recursive(buf + 1024, 8);
+    helper_float_sse_26_recursive(buf + 1280, 8);
+    helper_float_sse_26_recursive(buf + 1536, 8);
+    helper_float_sse_26_recursive(buf + 1792, 8);
     for (int j = 0; j < 2048; j += 2048) {
       for (int k = 0; k < 256; k += 4) {
         __asm__ volatile (
@@ -10150,14 +10150,14 @@ void helper_float_26_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_float_26_recursive(buf + 0, 11);
-    helper_float_26_recursive(buf + 2048, 11);
-    helper_float_26_recursive(buf + 4096, 11);
-    helper_float_26_recursive(buf + 6144, 11);
-    helper_float_26_recursive(buf + 8192, 11);
-    helper_float_26_recursive(buf + 10240, 11);
-    helper_float_26_recursive(buf + 12288, 11);
-    helper_float_26_recursive(buf + 14336, 11);
+    helper_float_sse_26_recursive(buf + 0, 11);
+    helper_float_sse_26_recursive(buf + 2048, 11);
+    helper_float_sse_26_recursive(buf + 4096, 11);
+    helper_float_sse_26_recursive(buf + 6144, 11);
+    helper_float_sse_26_recursive(buf + 8192, 11);
+    helper_float_sse_26_recursive(buf + 10240, 11);
+    helper_float_sse_26_recursive(buf + 12288, 11);
+    helper_float_sse_26_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 4) {
         __asm__ volatile (
@@ -10232,14 +10232,14 @@ void helper_float_26_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_float_26_recursive(buf + 0, 14);
-    helper_float_26_recursive(buf + 16384, 14);
-    helper_float_26_recursive(buf + 32768, 14);
-    helper_float_26_recursive(buf + 49152, 14);
-    helper_float_26_recursive(buf + 65536, 14);
-    helper_float_26_recursive(buf + 81920, 14);
-    helper_float_26_recursive(buf + 98304, 14);
-    helper_float_26_recursive(buf + 114688, 14);
+    helper_float_sse_26_recursive(buf + 0, 14);
+    helper_float_sse_26_recursive(buf + 16384, 14);
+    helper_float_sse_26_recursive(buf + 32768, 14);
+    helper_float_sse_26_recursive(buf + 49152, 14);
+    helper_float_sse_26_recursive(buf + 65536, 14);
+    helper_float_sse_26_recursive(buf + 81920, 14);
+    helper_float_sse_26_recursive(buf + 98304, 14);
+    helper_float_sse_26_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 4) {
         __asm__ volatile (
@@ -10314,14 +10314,14 @@ void helper_float_26_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_float_26_recursive(buf + 0, 17);
-    helper_float_26_recursive(buf + 131072, 17);
-    helper_float_26_recursive(buf + 262144, 17);
-    helper_float_26_recursive(buf + 393216, 17);
-    helper_float_26_recursive(buf + 524288, 17);
-    helper_float_26_recursive(buf + 655360, 17);
-    helper_float_26_recursive(buf + 786432, 17);
-    helper_float_26_recursive(buf + 917504, 17);
+    helper_float_sse_26_recursive(buf + 0, 17);
+    helper_float_sse_26_recursive(buf + 131072, 17);
+    helper_float_sse_26_recursive(buf + 262144, 17);
+    helper_float_sse_26_recursive(buf + 393216, 17);
+    helper_float_sse_26_recursive(buf + 524288, 17);
+    helper_float_sse_26_recursive(buf + 655360, 17);
+    helper_float_sse_26_recursive(buf + 786432, 17);
+    helper_float_sse_26_recursive(buf + 917504, 17);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 131072; k += 4) {
         __asm__ volatile (
@@ -10396,14 +10396,14 @@ void helper_float_26_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 23) {
-    helper_float_26_recursive(buf + 0, 20);
-    helper_float_26_recursive(buf + 1048576, 20);
-    helper_float_26_recursive(buf + 2097152, 20);
-    helper_float_26_recursive(buf + 3145728, 20);
-    helper_float_26_recursive(buf + 4194304, 20);
-    helper_float_26_recursive(buf + 5242880, 20);
-    helper_float_26_recursive(buf + 6291456, 20);
-    helper_float_26_recursive(buf + 7340032, 20);
+    helper_float_sse_26_recursive(buf + 0, 20);
+    helper_float_sse_26_recursive(buf + 1048576, 20);
+    helper_float_sse_26_recursive(buf + 2097152, 20);
+    helper_float_sse_26_recursive(buf + 3145728, 20);
+    helper_float_sse_26_recursive(buf + 4194304, 20);
+    helper_float_sse_26_recursive(buf + 5242880, 20);
+    helper_float_sse_26_recursive(buf + 6291456, 20);
+    helper_float_sse_26_recursive(buf + 7340032, 20);
     for (int j = 0; j < 8388608; j += 8388608) {
       for (int k = 0; k < 1048576; k += 4) {
         __asm__ volatile (
@@ -10478,14 +10478,14 @@ void helper_float_26_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 26) {
-    helper_float_26_recursive(buf + 0, 23);
-    helper_float_26_recursive(buf + 8388608, 23);
-    helper_float_26_recursive(buf + 16777216, 23);
-    helper_float_26_recursive(buf + 25165824, 23);
-    helper_float_26_recursive(buf + 33554432, 23);
-    helper_float_26_recursive(buf + 41943040, 23);
-    helper_float_26_recursive(buf + 50331648, 23);
-    helper_float_26_recursive(buf + 58720256, 23);
+    helper_float_sse_26_recursive(buf + 0, 23);
+    helper_float_sse_26_recursive(buf + 8388608, 23);
+    helper_float_sse_26_recursive(buf + 16777216, 23);
+    helper_float_sse_26_recursive(buf + 25165824, 23);
+    helper_float_sse_26_recursive(buf + 33554432, 23);
+    helper_float_sse_26_recursive(buf + 41943040, 23);
+    helper_float_sse_26_recursive(buf + 50331648, 23);
+    helper_float_sse_26_recursive(buf + 58720256, 23);
     for (int j = 0; j < 67108864; j += 67108864) {
       for (int k = 0; k < 8388608; k += 4) {
         __asm__ volatile (
@@ -10560,12 +10560,12 @@ void helper_float_26_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_26(float *buf);
-void helper_float_26(float *buf) {
-  helper_float_26_recursive(buf, 26);
+FHT_TARGET("sse4.1") void helper_float_sse_26(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_26(float *buf) {
+  helper_float_sse_26_recursive(buf, 26);
 }
-void helper_float_27_recursive(float *buf, int depth);
-void helper_float_27_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_27_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_27_recursive(float *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -10934,14 +10934,14 @@ void helper_float_27_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_float_27_recursive(buf + 0, 12);
-    helper_float_27_recursive(buf + 4096, 12);
-    helper_float_27_recursive(buf + 8192, 12);
-    helper_float_27_recursive(buf + 12288, 12);
-    helper_float_27_recursive(buf + 16384, 12);
-    helper_float_27_recursive(buf + 20480, 12);
-    helper_float_27_recursive(buf + 24576, 12);
-    helper_float_27_recursive(buf + 28672, 12);
+    helper_float_sse_27_recursive(buf + 0, 12);
+    helper_float_sse_27_recursive(buf + 4096, 12);
+    helper_float_sse_27_recursive(buf + 8192, 12);
+    helper_float_sse_27_recursive(buf + 12288, 12);
+    helper_float_sse_27_recursive(buf + 16384, 12);
+    helper_float_sse_27_recursive(buf + 20480, 12);
+    helper_float_sse_27_recursive(buf + 24576, 12);
+    helper_float_sse_27_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 4) {
         __asm__ volatile (
@@ -11016,14 +11016,14 @@ void helper_float_27_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_float_27_recursive(buf + 0, 15);
-    helper_float_27_recursive(buf + 32768, 15);
-    helper_float_27_recursive(buf + 65536, 15);
-    helper_float_27_recursive(buf + 98304, 15);
-    helper_float_27_recursive(buf + 131072, 15);
-    helper_float_27_recursive(buf + 163840, 15);
-    helper_float_27_recursive(buf + 196608, 15);
-    helper_float_27_recursive(buf + 229376, 15);
+    helper_float_sse_27_recursive(buf + 0, 15);
+    helper_float_sse_27_recursive(buf + 32768, 15);
+    helper_float_sse_27_recursive(buf + 65536, 15);
+    helper_float_sse_27_recursive(buf + 98304, 15);
+    helper_float_sse_27_recursive(buf + 131072, 15);
+    helper_float_sse_27_recursive(buf + 163840, 15);
+    helper_float_sse_27_recursive(buf + 196608, 15);
+    helper_float_sse_27_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 4) {
         __asm__ volatile (
@@ -11098,14 +11098,14 @@ void helper_float_27_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_float_27_recursive(buf + 0, 18);
-    helper_float_27_recursive(buf + 262144, 18);
-    helper_float_27_recursive(buf + 524288, 18);
-    helper_float_27_recursive(buf + 786432, 18);
-    helper_float_27_recursive(buf + 1048576, 18);
-    helper_float_27_recursive(buf + 1310720, 18);
-    helper_float_27_recursive(buf + 1572864, 18);
-    helper_float_27_recursive(buf + 1835008, 18);
+    helper_float_sse_27_recursive(buf + 0, 18);
+    helper_float_sse_27_recursive(buf + 262144, 18);
+    helper_float_sse_27_recursive(buf + 524288, 18);
+    helper_float_sse_27_recursive(buf + 786432, 18);
+    helper_float_sse_27_recursive(buf + 1048576, 18);
+    helper_float_sse_27_recursive(buf + 1310720, 18);
+    helper_float_sse_27_recursive(buf + 1572864, 18);
+    helper_float_sse_27_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 4) {
         __asm__ volatile (
@@ -11180,14 +11180,14 @@ void helper_float_27_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 24) {
-    helper_float_27_recursive(buf + 0, 21);
-    helper_float_27_recursive(buf + 2097152, 21);
-    helper_float_27_recursive(buf + 4194304, 21);
-    helper_float_27_recursive(buf + 6291456, 21);
-    helper_float_27_recursive(buf + 8388608, 21);
-    helper_float_27_recursive(buf + 10485760, 21);
-    helper_float_27_recursive(buf + 12582912, 21);
-    helper_float_27_recursive(buf + 14680064, 21);
+    helper_float_sse_27_recursive(buf + 0, 21);
+    helper_float_sse_27_recursive(buf + 2097152, 21);
+    helper_float_sse_27_recursive(buf + 4194304, 21);
+    helper_float_sse_27_recursive(buf + 6291456, 21);
+    helper_float_sse_27_recursive(buf + 8388608, 21);
+    helper_float_sse_27_recursive(buf + 10485760, 21);
+    helper_float_sse_27_recursive(buf + 12582912, 21);
+    helper_float_sse_27_recursive(buf + 14680064, 21);
     for (int j = 0; j < 16777216; j += 16777216) {
       for (int k = 0; k < 2097152; k += 4) {
         __asm__ volatile (
@@ -11262,14 +11262,14 @@ void helper_float_27_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 27) {
-    helper_float_27_recursive(buf + 0, 24);
-    helper_float_27_recursive(buf + 16777216, 24);
-    helper_float_27_recursive(buf + 33554432, 24);
-    helper_float_27_recursive(buf + 50331648, 24);
-    helper_float_27_recursive(buf + 67108864, 24);
-    helper_float_27_recursive(buf + 83886080, 24);
-    helper_float_27_recursive(buf + 100663296, 24);
-    helper_float_27_recursive(buf + 117440512, 24);
+    helper_float_sse_27_recursive(buf + 0, 24);
+    helper_float_sse_27_recursive(buf + 16777216, 24);
+    helper_float_sse_27_recursive(buf + 33554432, 24);
+    helper_float_sse_27_recursive(buf + 50331648, 24);
+    helper_float_sse_27_recursive(buf + 67108864, 24);
+    helper_float_sse_27_recursive(buf + 83886080, 24);
+    helper_float_sse_27_recursive(buf + 100663296, 24);
+    helper_float_sse_27_recursive(buf + 117440512, 24);
     for (int j = 0; j < 134217728; j += 134217728) {
       for (int k = 0; k < 16777216; k += 4) {
         __asm__ volatile (
@@ -11344,12 +11344,12 @@ void helper_float_27_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_27(float *buf);
-void helper_float_27(float *buf) {
-  helper_float_27_recursive(buf, 27);
+FHT_TARGET("sse4.1") void helper_float_sse_27(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_27(float *buf) {
+  helper_float_sse_27_recursive(buf, 27);
 }
-void helper_float_28_recursive(float *buf, int depth);
-void helper_float_28_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_28_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_28_recursive(float *buf, int depth) {
   if (depth == 16) {
     for (int j = 0; j < 65536; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -11805,14 +11805,14 @@ void helper_float_28_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 19) {
-    helper_float_28_recursive(buf + 0, 16);
-    helper_float_28_recursive(buf + 65536, 16);
-    helper_float_28_recursive(buf + 131072, 16);
-    helper_float_28_recursive(buf + 196608, 16);
-    helper_float_28_recursive(buf + 262144, 16);
-    helper_float_28_recursive(buf + 327680, 16);
-    helper_float_28_recursive(buf + 393216, 16);
-    helper_float_28_recursive(buf + 458752, 16);
+    helper_float_sse_28_recursive(buf + 0, 16);
+    helper_float_sse_28_recursive(buf + 65536, 16);
+    helper_float_sse_28_recursive(buf + 131072, 16);
+    helper_float_sse_28_recursive(buf + 196608, 16);
+    helper_float_sse_28_recursive(buf + 262144, 16);
+    helper_float_sse_28_recursive(buf + 327680, 16);
+    helper_float_sse_28_recursive(buf + 393216, 16);
+    helper_float_sse_28_recursive(buf + 458752, 16);
     for (int j = 0; j < 524288; j += 524288) {
       for (int k = 0; k < 65536; k += 4) {
         __asm__ volatile (
@@ -11887,14 +11887,14 @@ void helper_float_28_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 22) {
-    helper_float_28_recursive(buf + 0, 19);
-    helper_float_28_recursive(buf + 524288, 19);
-    helper_float_28_recursive(buf + 1048576, 19);
-    helper_float_28_recursive(buf + 1572864, 19);
-    helper_float_28_recursive(buf + 2097152, 19);
-    helper_float_28_recursive(buf + 2621440, 19);
-    helper_float_28_recursive(buf + 3145728, 19);
-    helper_float_28_recursive(buf + 3670016, 19);
+    helper_float_sse_28_recursive(buf + 0, 19);
+    helper_float_sse_28_recursive(buf + 524288, 19);
+    helper_float_sse_28_recursive(buf + 1048576, 19);
+    helper_float_sse_28_recursive(buf + 1572864, 19);
+    helper_float_sse_28_recursive(buf + 2097152, 19);
+    helper_float_sse_28_recursive(buf + 2621440, 19);
+    helper_float_sse_28_recursive(buf + 3145728, 19);
+    helper_float_sse_28_recursive(buf + 3670016, 19);
     for (int j = 0; j < 4194304; j += 4194304) {
       for (int k = 0; k < 524288; k += 4) {
         __asm__ volatile (
@@ -11969,14 +11969,14 @@ void helper_float_28_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 25) {
-    helper_float_28_recursive(buf + 0, 22);
-    helper_float_28_recursive(buf + 4194304, 22);
-    helper_float_28_recursive(buf + 8388608, 22);
-    helper_float_28_recursive(buf + 12582912, 22);
-    helper_float_28_recursive(buf + 16777216, 22);
-    helper_float_28_recursive(buf + 20971520, 22);
-    helper_float_28_recursive(buf + 25165824, 22);
-    helper_float_28_recursive(buf + 29360128, 22);
+    helper_float_sse_28_recursive(buf + 0, 22);
+    helper_float_sse_28_recursive(buf + 4194304, 22);
+    helper_float_sse_28_recursive(buf + 8388608, 22);
+    helper_float_sse_28_recursive(buf + 12582912, 22);
+    helper_float_sse_28_recursive(buf + 16777216, 22);
+    helper_float_sse_28_recursive(buf + 20971520, 22);
+    helper_float_sse_28_recursive(buf + 25165824, 22);
+    helper_float_sse_28_recursive(buf + 29360128, 22);
     for (int j = 0; j < 33554432; j += 33554432) {
       for (int k = 0; k < 4194304; k += 4) {
         __asm__ volatile (
@@ -12051,14 +12051,14 @@ void helper_float_28_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 28) {
-    helper_float_28_recursive(buf + 0, 25);
-    helper_float_28_recursive(buf + 33554432, 25);
-    helper_float_28_recursive(buf + 67108864, 25);
-    helper_float_28_recursive(buf + 100663296, 25);
-    helper_float_28_recursive(buf + 134217728, 25);
-    helper_float_28_recursive(buf + 167772160, 25);
-    helper_float_28_recursive(buf + 201326592, 25);
-    helper_float_28_recursive(buf + 234881024, 25);
+    helper_float_sse_28_recursive(buf + 0, 25);
+    helper_float_sse_28_recursive(buf + 33554432, 25);
+    helper_float_sse_28_recursive(buf + 67108864, 25);
+    helper_float_sse_28_recursive(buf + 100663296, 25);
+    helper_float_sse_28_recursive(buf + 134217728, 25);
+    helper_float_sse_28_recursive(buf + 167772160, 25);
+    helper_float_sse_28_recursive(buf + 201326592, 25);
+    helper_float_sse_28_recursive(buf + 234881024, 25);
     for (int j = 0; j < 268435456; j += 268435456) {
       for (int k = 0; k < 33554432; k += 4) {
         __asm__ volatile (
@@ -12133,12 +12133,12 @@ void helper_float_28_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_28(float *buf);
-void helper_float_28(float *buf) {
-  helper_float_28_recursive(buf, 28);
+FHT_TARGET("sse4.1") void helper_float_sse_28(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_28(float *buf) {
+  helper_float_sse_28_recursive(buf, 28);
 }
-void helper_float_29_recursive(float *buf, int depth);
-void helper_float_29_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_29_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_29_recursive(float *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -12507,14 +12507,14 @@ void helper_float_29_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_float_29_recursive(buf + 0, 12);
-    helper_float_29_recursive(buf + 4096, 12);
-    helper_float_29_recursive(buf + 8192, 12);
-    helper_float_29_recursive(buf + 12288, 12);
-    helper_float_29_recursive(buf + 16384, 12);
-    helper_float_29_recursive(buf + 20480, 12);
-    helper_float_29_recursive(buf + 24576, 12);
-    helper_float_29_recursive(buf + 28672, 12);
+    helper_float_sse_29_recursive(buf + 0, 12);
+    helper_float_sse_29_recursive(buf + 4096, 12);
+    helper_float_sse_29_recursive(buf + 8192, 12);
+    helper_float_sse_29_recursive(buf + 12288, 12);
+    helper_float_sse_29_recursive(buf + 16384, 12);
+    helper_float_sse_29_recursive(buf + 20480, 12);
+    helper_float_sse_29_recursive(buf + 24576, 12);
+    helper_float_sse_29_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 4) {
         __asm__ volatile (
@@ -12589,14 +12589,14 @@ void helper_float_29_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_float_29_recursive(buf + 0, 15);
-    helper_float_29_recursive(buf + 32768, 15);
-    helper_float_29_recursive(buf + 65536, 15);
-    helper_float_29_recursive(buf + 98304, 15);
-    helper_float_29_recursive(buf + 131072, 15);
-    helper_float_29_recursive(buf + 163840, 15);
-    helper_float_29_recursive(buf + 196608, 15);
-    helper_float_29_recursive(buf + 229376, 15);
+    helper_float_sse_29_recursive(buf + 0, 15);
+    helper_float_sse_29_recursive(buf + 32768, 15);
+    helper_float_sse_29_recursive(buf + 65536, 15);
+    helper_float_sse_29_recursive(buf + 98304, 15);
+    helper_float_sse_29_recursive(buf + 131072, 15);
+    helper_float_sse_29_recursive(buf + 163840, 15);
+    helper_float_sse_29_recursive(buf + 196608, 15);
+    helper_float_sse_29_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 4) {
         __asm__ volatile (
@@ -12671,14 +12671,14 @@ void helper_float_29_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_float_29_recursive(buf + 0, 18);
-    helper_float_29_recursive(buf + 262144, 18);
-    helper_float_29_recursive(buf + 524288, 18);
-    helper_float_29_recursive(buf + 786432, 18);
-    helper_float_29_recursive(buf + 1048576, 18);
-    helper_float_29_recursive(buf + 1310720, 18);
-    helper_float_29_recursive(buf + 1572864, 18);
-    helper_float_29_recursive(buf + 1835008, 18);
+    helper_float_sse_29_recursive(buf + 0, 18);
+    helper_float_sse_29_recursive(buf + 262144, 18);
+    helper_float_sse_29_recursive(buf + 524288, 18);
+    helper_float_sse_29_recursive(buf + 786432, 18);
+    helper_float_sse_29_recursive(buf + 1048576, 18);
+    helper_float_sse_29_recursive(buf + 1310720, 18);
+    helper_float_sse_29_recursive(buf + 1572864, 18);
+    helper_float_sse_29_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 4) {
         __asm__ volatile (
@@ -12753,14 +12753,14 @@ void helper_float_29_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 24) {
-    helper_float_29_recursive(buf + 0, 21);
-    helper_float_29_recursive(buf + 2097152, 21);
-    helper_float_29_recursive(buf + 4194304, 21);
-    helper_float_29_recursive(buf + 6291456, 21);
-    helper_float_29_recursive(buf + 8388608, 21);
-    helper_float_29_recursive(buf + 10485760, 21);
-    helper_float_29_recursive(buf + 12582912, 21);
-    helper_float_29_recursive(buf + 14680064, 21);
+    helper_float_sse_29_recursive(buf + 0, 21);
+    helper_float_sse_29_recursive(buf + 2097152, 21);
+    helper_float_sse_29_recursive(buf + 4194304, 21);
+    helper_float_sse_29_recursive(buf + 6291456, 21);
+    helper_float_sse_29_recursive(buf + 8388608, 21);
+    helper_float_sse_29_recursive(buf + 10485760, 21);
+    helper_float_sse_29_recursive(buf + 12582912, 21);
+    helper_float_sse_29_recursive(buf + 14680064, 21);
     for (int j = 0; j < 16777216; j += 16777216) {
       for (int k = 0; k < 2097152; k += 4) {
         __asm__ volatile (
@@ -12835,14 +12835,14 @@ void helper_float_29_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 27) {
-    helper_float_29_recursive(buf + 0, 24);
-    helper_float_29_recursive(buf + 16777216, 24);
-    helper_float_29_recursive(buf + 33554432, 24);
-    helper_float_29_recursive(buf + 50331648, 24);
-    helper_float_29_recursive(buf + 67108864, 24);
-    helper_float_29_recursive(buf + 83886080, 24);
-    helper_float_29_recursive(buf + 100663296, 24);
-    helper_float_29_recursive(buf + 117440512, 24);
+    helper_float_sse_29_recursive(buf + 0, 24);
+    helper_float_sse_29_recursive(buf + 16777216, 24);
+    helper_float_sse_29_recursive(buf + 33554432, 24);
+    helper_float_sse_29_recursive(buf + 50331648, 24);
+    helper_float_sse_29_recursive(buf + 67108864, 24);
+    helper_float_sse_29_recursive(buf + 83886080, 24);
+    helper_float_sse_29_recursive(buf + 100663296, 24);
+    helper_float_sse_29_recursive(buf + 117440512, 24);
     for (int j = 0; j < 134217728; j += 134217728) {
       for (int k = 0; k < 16777216; k += 4) {
         __asm__ volatile (
@@ -12917,10 +12917,10 @@ void helper_float_29_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 29) {
-    helper_float_29_recursive(buf + 0, 27);
-    helper_float_29_recursive(buf + 134217728, 27);
-    helper_float_29_recursive(buf + 268435456, 27);
-    helper_float_29_recursive(buf + 402653184, 27);
+    helper_float_sse_29_recursive(buf + 0, 27);
+    helper_float_sse_29_recursive(buf + 134217728, 27);
+    helper_float_sse_29_recursive(buf + 268435456, 27);
+    helper_float_sse_29_recursive(buf + 402653184, 27);
     for (int j = 0; j < 536870912; j += 536870912) {
       for (int k = 0; k < 134217728; k += 4) {
         __asm__ volatile (
@@ -12955,12 +12955,12 @@ void helper_float_29_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_29(float *buf);
-void helper_float_29(float *buf) {
-  helper_float_29_recursive(buf, 29);
+FHT_TARGET("sse4.1") void helper_float_sse_29(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_29(float *buf) {
+  helper_float_sse_29_recursive(buf, 29);
 }
-void helper_float_30_recursive(float *buf, int depth);
-void helper_float_30_recursive(float *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_float_sse_30_recursive(float *buf, int depth);
+FHT_TARGET("sse4.1") void helper_float_sse_30_recursive(float *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 32) {
       for (int k = 0; k < 4; k += 4) {
@@ -13329,14 +13329,14 @@ void helper_float_30_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_float_30_recursive(buf + 0, 12);
-    helper_float_30_recursive(buf + 4096, 12);
-    helper_float_30_recursive(buf + 8192, 12);
-    helper_float_30_recursive(buf + 12288, 12);
-    helper_float_30_recursive(buf + 16384, 12);
-    helper_float_30_recursive(buf + 20480, 12);
-    helper_float_30_recursive(buf + 24576, 12);
-    helper_float_30_recursive(buf + 28672, 12);
+    helper_float_sse_30_recursive(buf + 0, 12);
+    helper_float_sse_30_recursive(buf + 4096, 12);
+    helper_float_sse_30_recursive(buf + 8192, 12);
+    helper_float_sse_30_recursive(buf + 12288, 12);
+    helper_float_sse_30_recursive(buf + 16384, 12);
+    helper_float_sse_30_recursive(buf + 20480, 12);
+    helper_float_sse_30_recursive(buf + 24576, 12);
+    helper_float_sse_30_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 4) {
         __asm__ volatile (
@@ -13411,14 +13411,14 @@ void helper_float_30_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_float_30_recursive(buf + 0, 15);
-    helper_float_30_recursive(buf + 32768, 15);
-    helper_float_30_recursive(buf + 65536, 15);
-    helper_float_30_recursive(buf + 98304, 15);
-    helper_float_30_recursive(buf + 131072, 15);
-    helper_float_30_recursive(buf + 163840, 15);
-    helper_float_30_recursive(buf + 196608, 15);
-    helper_float_30_recursive(buf + 229376, 15);
+    helper_float_sse_30_recursive(buf + 0, 15);
+    helper_float_sse_30_recursive(buf + 32768, 15);
+    helper_float_sse_30_recursive(buf + 65536, 15);
+    helper_float_sse_30_recursive(buf + 98304, 15);
+    helper_float_sse_30_recursive(buf + 131072, 15);
+    helper_float_sse_30_recursive(buf + 163840, 15);
+    helper_float_sse_30_recursive(buf + 196608, 15);
+    helper_float_sse_30_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 4) {
         __asm__ volatile (
@@ -13493,14 +13493,14 @@ void helper_float_30_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_float_30_recursive(buf + 0, 18);
-    helper_float_30_recursive(buf + 262144, 18);
-    helper_float_30_recursive(buf + 524288, 18);
-    helper_float_30_recursive(buf + 786432, 18);
-    helper_float_30_recursive(buf + 1048576, 18);
-    helper_float_30_recursive(buf + 1310720, 18);
-    helper_float_30_recursive(buf + 1572864, 18);
-    helper_float_30_recursive(buf + 1835008, 18);
+    helper_float_sse_30_recursive(buf + 0, 18);
+    helper_float_sse_30_recursive(buf + 262144, 18);
+    helper_float_sse_30_recursive(buf + 524288, 18);
+    helper_float_sse_30_recursive(buf + 786432, 18);
+    helper_float_sse_30_recursive(buf + 1048576, 18);
+    helper_float_sse_30_recursive(buf + 1310720, 18);
+    helper_float_sse_30_recursive(buf + 1572864, 18);
+    helper_float_sse_30_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 4) {
         __asm__ volatile (
@@ -13575,14 +13575,14 @@ void helper_float_30_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 24) {
-    helper_float_30_recursive(buf + 0, 21);
-    helper_float_30_recursive(buf + 2097152, 21);
-    helper_float_30_recursive(buf + 4194304, 21);
-    helper_float_30_recursive(buf + 6291456, 21);
-    helper_float_30_recursive(buf + 8388608, 21);
-    helper_float_30_recursive(buf + 10485760, 21);
-    helper_float_30_recursive(buf + 12582912, 21);
-    helper_float_30_recursive(buf + 14680064, 21);
+    helper_float_sse_30_recursive(buf + 0, 21);
+    helper_float_sse_30_recursive(buf + 2097152, 21);
+    helper_float_sse_30_recursive(buf + 4194304, 21);
+    helper_float_sse_30_recursive(buf + 6291456, 21);
+    helper_float_sse_30_recursive(buf + 8388608, 21);
+    helper_float_sse_30_recursive(buf + 10485760, 21);
+    helper_float_sse_30_recursive(buf + 12582912, 21);
+    helper_float_sse_30_recursive(buf + 14680064, 21);
     for (int j = 0; j < 16777216; j += 16777216) {
       for (int k = 0; k < 2097152; k += 4) {
         __asm__ volatile (
@@ -13657,14 +13657,14 @@ void helper_float_30_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 27) {
-    helper_float_30_recursive(buf + 0, 24);
-    helper_float_30_recursive(buf + 16777216, 24);
-    helper_float_30_recursive(buf + 33554432, 24);
-    helper_float_30_recursive(buf + 50331648, 24);
-    helper_float_30_recursive(buf + 67108864, 24);
-    helper_float_30_recursive(buf + 83886080, 24);
-    helper_float_30_recursive(buf + 100663296, 24);
-    helper_float_30_recursive(buf + 117440512, 24);
+    helper_float_sse_30_recursive(buf + 0, 24);
+    helper_float_sse_30_recursive(buf + 16777216, 24);
+    helper_float_sse_30_recursive(buf + 33554432, 24);
+    helper_float_sse_30_recursive(buf + 50331648, 24);
+    helper_float_sse_30_recursive(buf + 67108864, 24);
+    helper_float_sse_30_recursive(buf + 83886080, 24);
+    helper_float_sse_30_recursive(buf + 100663296, 24);
+    helper_float_sse_30_recursive(buf + 117440512, 24);
     for (int j = 0; j < 134217728; j += 134217728) {
       for (int k = 0; k < 16777216; k += 4) {
         __asm__ volatile (
@@ -13739,14 +13739,14 @@ void helper_float_30_recursive(float *buf, int depth) {
     return;
   }
   if (depth == 30) {
-    helper_float_30_recursive(buf + 0, 27);
-    helper_float_30_recursive(buf + 134217728, 27);
-    helper_float_30_recursive(buf + 268435456, 27);
-    helper_float_30_recursive(buf + 402653184, 27);
-    helper_float_30_recursive(buf + 536870912, 27);
-    helper_float_30_recursive(buf + 671088640, 27);
-    helper_float_30_recursive(buf + 805306368, 27);
-    helper_float_30_recursive(buf + 939524096, 27);
+    helper_float_sse_30_recursive(buf + 0, 27);
+    helper_float_sse_30_recursive(buf + 134217728, 27);
+    helper_float_sse_30_recursive(buf + 268435456, 27);
+    helper_float_sse_30_recursive(buf + 402653184, 27);
+    helper_float_sse_30_recursive(buf + 536870912, 27);
+    helper_float_sse_30_recursive(buf + 671088640, 27);
+    helper_float_sse_30_recursive(buf + 805306368, 27);
+    helper_float_sse_30_recursive(buf + 939524096, 27);
     for (int j = 0; j < 1073741824; j += 1073741824) {
       for (int k = 0; k < 134217728; k += 4) {
         __asm__ volatile (
@@ -13821,138 +13821,172 @@ void helper_float_30_recursive(float *buf, int depth) {
     return;
   }
 }
-void helper_float_30(float *buf);
-void helper_float_30(float *buf) {
-  helper_float_30_recursive(buf, 30);
+FHT_TARGET("sse4.1") void helper_float_sse_30(float *buf);
+FHT_TARGET("sse4.1") void helper_float_sse_30(float *buf) {
+  helper_float_sse_30_recursive(buf, 30);
 }
-int fht_float(float *buf, int log_n) {
+FHT_TARGET("sse4.1") int fht_float_sse(float *buf, int log_n);
+FHT_TARGET("sse4.1") int fht_float_sse(float *buf, int log_n) {
   if (log_n == 0) {
     return 0;
   }
   if (log_n == 1) {
-    helper_float_1(buf);
+    helper_float_sse_1(buf);
     return 0;
   }
   if (log_n == 2) {
-    helper_float_2(buf);
+    helper_float_sse_2(buf);
     return 0;
   }
   if (log_n == 3) {
-    helper_float_3(buf);
+    helper_float_sse_3(buf);
     return 0;
   }
   if (log_n == 4) {
-    helper_float_4(buf);
+    helper_float_sse_4(buf);
     return 0;
   }
   if (log_n == 5) {
-    helper_float_5(buf);
+    helper_float_sse_5(buf);
     return 0;
   }
   if (log_n == 6) {
-    helper_float_6(buf);
+    helper_float_sse_6(buf);
     return 0;
   }
   if (log_n == 7) {
-    helper_float_7(buf);
+    helper_float_sse_7(buf);
     return 0;
   }
   if (log_n == 8) {
-    helper_float_8(buf);
+    helper_float_sse_8(buf);
     return 0;
   }
   if (log_n == 9) {
-    helper_float_9(buf);
+    helper_float_sse_9(buf);
     return 0;
   }
   if (log_n == 10) {
-    helper_float_10(buf);
+    helper_float_sse_10(buf);
     return 0;
   }
   if (log_n == 11) {
-    helper_float_11(buf);
+    helper_float_sse_11(buf);
     return 0;
   }
   if (log_n == 12) {
-    helper_float_12(buf);
+    helper_float_sse_12(buf);
     return 0;
   }
   if (log_n == 13) {
-    helper_float_13(buf);
+    helper_float_sse_13(buf);
     return 0;
   }
   if (log_n == 14) {
-    helper_float_14(buf);
+    helper_float_sse_14(buf);
     return 0;
   }
   if (log_n == 15) {
-    helper_float_15(buf);
+    helper_float_sse_15(buf);
     return 0;
   }
   if (log_n == 16) {
-    helper_float_16(buf);
+    helper_float_sse_16(buf);
     return 0;
   }
   if (log_n == 17) {
-    helper_float_17(buf);
+    helper_float_sse_17(buf);
     return 0;
   }
   if (log_n == 18) {
-    helper_float_18(buf);
+    helper_float_sse_18(buf);
     return 0;
   }
   if (log_n == 19) {
-    helper_float_19(buf);
+    helper_float_sse_19(buf);
     return 0;
   }
   if (log_n == 20) {
-    helper_float_20(buf);
+    helper_float_sse_20(buf);
     return 0;
   }
   if (log_n == 21) {
-    helper_float_21(buf);
+    helper_float_sse_21(buf);
     return 0;
   }
   if (log_n == 22) {
-    helper_float_22(buf);
+    helper_float_sse_22(buf);
     return 0;
   }
   if (log_n == 23) {
-    helper_float_23(buf);
+    helper_float_sse_23(buf);
     return 0;
   }
   if (log_n == 24) {
-    helper_float_24(buf);
+    helper_float_sse_24(buf);
     return 0;
   }
   if (log_n == 25) {
-    helper_float_25(buf);
+    helper_float_sse_25(buf);
     return 0;
   }
   if (log_n == 26) {
-    helper_float_26(buf);
+    helper_float_sse_26(buf);
     return 0;
   }
   if (log_n == 27) {
-    helper_float_27(buf);
+    helper_float_sse_27(buf);
     return 0;
   }
   if (log_n == 28) {
-    helper_float_28(buf);
+    helper_float_sse_28(buf);
     return 0;
   }
   if (log_n == 29) {
-    helper_float_29(buf);
+    helper_float_sse_29(buf);
     return 0;
   }
   if (log_n == 30) {
-    helper_float_30(buf);
+    helper_float_sse_30(buf);
     return 0;
   }
   return 1;
 }
-static inline void helper_double_1(double *buf);
-static inline void helper_double_1(double *buf) {
+static void (*const fht_float_sse_helpers[31])(float *) = {
+  0,
+  helper_float_sse_1,
+  helper_float_sse_2,
+  helper_float_sse_3,
+  helper_float_sse_4,
+  helper_float_sse_5,
+  helper_float_sse_6,
+  helper_float_sse_7,
+  helper_float_sse_8,
+  helper_float_sse_9,
+  helper_float_sse_10,
+  helper_float_sse_11,
+  helper_float_sse_12,
+  helper_float_sse_13,
+  helper_float_sse_14,
+  helper_float_sse_15,
+  helper_float_sse_16,
+  helper_float_sse_17,
+  helper_float_sse_18,
+  helper_float_sse_19,
+  helper_float_sse_20,
+  helper_float_sse_21,
+  helper_float_sse_22,
+  helper_float_sse_23,
+  helper_float_sse_24,
+  helper_float_sse_25,
+  helper_float_sse_26,
+  helper_float_sse_27,
+  helper_float_sse_28,
+  helper_float_sse_29,
+  helper_float_sse_30,
+};
+FHT_TARGET("sse4.1") static inline void helper_double_sse_1(double *buf);
+FHT_TARGET("sse4.1") static inline void helper_double_sse_1(double *buf) {
   for (int j = 0; j < 2; j += 2) {
     __asm__ volatile (
       "movupd (%0), %%xmm0\n"
@@ -13967,8 +14001,8 @@ static inline void helper_double_1(double *buf) {
     );
   }
 }
-void helper_double_2_recursive(double *buf, int depth);
-void helper_double_2_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_2_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_2_recursive(double *buf, int depth) {
   if (depth == 2) {
     for (int j = 0; j < 4; j += 4) {
       for (int k = 0; k < 2; k += 2) {
@@ -14000,12 +14034,12 @@ void helper_double_2_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_2(double *buf);
-void helper_double_2(double *buf) {
-  helper_double_2_recursive(buf, 2);
+FHT_TARGET("sse4.1") void helper_double_sse_2(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_2(double *buf) {
+  helper_double_sse_2_recursive(buf, 2);
 }
-void helper_double_3_recursive(double *buf, int depth);
-void helper_double_3_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_3_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_3_recursive(double *buf, int depth) {
   if (depth == 3) {
     for (int j = 0; j < 8; j += 8) {
       for (int k = 0; k < 2; k += 2) {
@@ -14065,12 +14099,12 @@ void helper_double_3_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_3(double *buf);
-void helper_double_3(double *buf) {
-  helper_double_3_recursive(buf, 3);
+FHT_TARGET("sse4.1") void helper_double_sse_3(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_3(double *buf) {
+  helper_double_sse_3_recursive(buf, 3);
 }
-static inline void helper_double_4(double *buf);
-static inline void helper_double_4(double *buf) {
+FHT_TARGET("sse4.1") static inline void helper_double_sse_4(double *buf);
+FHT_TARGET("sse4.1") static inline void helper_double_sse_4(double *buf) {
   for (int j = 0; j < 16; j += 16) {
     for (int k = 0; k < 2; k += 2) {
       __asm__ volatile (
@@ -14191,8 +14225,8 @@ static inline void helper_double_4(double *buf) {
     }
   }
 }
-void helper_double_5_recursive(double *buf, int depth);
-void helper_double_5_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_5_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_5_recursive(double *buf, int depth) {
   if (depth == 2) {
     for (int j = 0; j < 4; j += 4) {
       for (int k = 0; k < 2; k += 2) {
@@ -14224,14 +14258,14 @@ void helper_double_5_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 5) {
-    helper_double_5_recursive(buf + 0, 2);
-    helper_double_5_recursive(buf + 4, 2);
-    helper_double_5_recursive(buf + 8, 2);
-    helper_double_5_recursive(buf + 12, 2);
-    helper_double_5_recursive(buf + 16, 2);
-    helper_double_5_recursive(buf + 20, 2);
-    helper_double_5_recursive(buf + 24, 2);
-    helper_double_5_recursive(buf + 28, 2);
+    helper_double_sse_5_recursive(buf + 0, 2);
+    helper_double_sse_5_recursive(buf + 4, 2);
+    helper_double_sse_5_recursive(buf + 8, 2);
+    helper_double_sse_5_recursive(buf + 12, 2);
+    helper_double_sse_5_recursive(buf + 16, 2);
+    helper_double_sse_5_recursive(buf + 20, 2);
+    helper_double_sse_5_recursive(buf + 24, 2);
+    helper_double_sse_5_recursive(buf + 28, 2);
     for (int j = 0; j < 32; j += 32) {
       for (int k = 0; k < 4; k += 2) {
         __asm__ volatile (
@@ -14306,12 +14340,12 @@ void helper_double_5_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_5(double *buf);
-void helper_double_5(double *buf) {
-  helper_double_5_recursive(buf, 5);
+FHT_TARGET("sse4.1") void helper_double_sse_5(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_5(double *buf) {
+  helper_double_sse_5_recursive(buf, 5);
 }
-static inline void helper_double_6(double *buf);
-static inline void helper_double_6(double *buf) {
+FHT_TARGET("sse4.1") static inline void helper_double_sse_6(double *buf);
+FHT_TARGET("sse4.1") static inline void helper_double_sse_6(double *buf) {
   for (int j = 0; j < 64; j += 16) {
     for (int k = 0; k < 2; k += 2) {
       __asm__ volatile (
@@ -14463,8 +14497,8 @@ static inline void helper_double_6(double *buf) {
     }
   }
 }
-static inline void helper_double_7(double *buf);
-static inline void helper_double_7(double *buf) {
+FHT_TARGET("sse4.1") static inline void helper_double_sse_7(double *buf);
+FHT_TARGET("sse4.1") static inline void helper_double_sse_7(double *buf) {
   for (int j = 0; j < 128; j += 16) {
     for (int k = 0; k < 2; k += 2) {
       __asm__ volatile (
@@ -14656,8 +14690,8 @@ static inline void helper_double_7(double *buf) {
     }
   }
 }
-void helper_double_8_recursive(double *buf, int depth);
-void helper_double_8_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_8_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_8_recursive(double *buf, int depth) {
   if (depth == 2) {
     for (int j = 0; j < 4; j += 4) {
       for (int k = 0; k < 2; k += 2) {
@@ -14689,14 +14723,14 @@ void helper_double_8_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 5) {
-    helper_double_8_recursive(buf + 0, 2);
-    helper_double_8_recursive(buf + 4, 2);
-    helper_double_8_recursive(buf + 8, 2);
-    helper_double_8_recursive(buf + 12, 2);
-    helper_double_8_recursive(buf + 16, 2);
-    helper_double_8_recursive(buf + 20, 2);
-    helper_double_8_recursive(buf + 24, 2);
-    helper_double_8_recursive(buf + 28, 2);
+    helper_double_sse_8_recursive(buf + 0, 2);
+    helper_double_sse_8_recursive(buf + 4, 2);
+    helper_double_sse_8_recursive(buf + 8, 2);
+    helper_double_sse_8_recursive(buf + 12, 2);
+    helper_double_sse_8_recursive(buf + 16, 2);
+    helper_double_sse_8_recursive(buf + 20, 2);
+    helper_double_sse_8_recursive(buf + 24, 2);
+    helper_double_sse_8_recursive(buf + 28, 2);
     for (int j = 0; j < 32; j += 32) {
       for (int k = 0; k < 4; k += 2) {
         __asm__ volatile (
@@ -14771,14 +14805,14 @@ void helper_double_8_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 8) {
-    helper_double_8_recursive(buf + 0, 5);
-    helper_double_8_recursive(buf + 32, 5);
-    helper_double_8_recursive(buf + 64, 5);
-    helper_double_8_recursive(buf + 96, 5);
-    helper_double_8_recursive(buf + 128, 5);
-    helper_double_8_recursive(buf + 160, 5);
-    helper_double_8_recursive(buf + 192, 5);
-    helper_double_8_recursive(buf + 224, 5);
+    helper_double_sse_8_recursive(buf + 0, 5);
+    helper_double_sse_8_recursive(buf + 32, 5);
+    helper_double_sse_8_recursive(buf + 64, 5);
+    helper_double_sse_8_recursive(buf + 96, 5);
+    helper_double_sse_8_recursive(buf + 128, 5);
+    helper_double_sse_8_recursive(buf + 160, 5);
+    helper_double_sse_8_recursive(buf + 192, 5);
+    helper_double_sse_8_recursive(buf + 224, 5);
     for (int j = 0; j < 256; j += 256) {
       for (int k = 0; k < 32; k += 2) {
         __asm__ volatile (
@@ -14853,12 +14887,12 @@ void helper_double_8_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_8(double *buf);
-void helper_double_8(double *buf) {
-  helper_double_8_recursive(buf, 8);
+FHT_TARGET("sse4.1") void helper_double_sse_8(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_8(double *buf) {
+  helper_double_sse_8_recursive(buf, 8);
 }
-void helper_double_9_recursive(double *buf, int depth);
-void helper_double_9_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_9_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_9_recursive(double *buf, int depth) {
   if (depth == 6) {
     for (int j = 0; j < 64; j += 16) {
       for (int k = 0; k < 2; k += 2) {
@@ -15013,14 +15047,14 @@ void helper_double_9_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 9) {
-    helper_double_9_recursive(buf + 0, 6);
-    helper_double_9_recursive(buf + 64, 6);
-    helper_double_9_recursive(buf + 128, 6);
-    helper_double_9_recursive(buf + 192, 6);
-    helper_double_9_recursive(buf + 256, 6);
-    helper_double_9_recursive(buf + 320, 6);
-    helper_double_9_recursive(buf + 384, 6);
-    helper_double_9_recursive(buf + 448, 6);
+    helper_double_sse_9_recursive(buf + 0, 6);
+    helper_double_sse_9_recursive(buf + 64, 6);
+    helper_double_sse_9_recursive(buf + 128, 6);
+    helper_double_sse_9_recursive(buf + 192, 6);
+    helper_double_sse_9_recursive(buf + 256, 6);
+    helper_double_sse_9_recursive(buf + 320, 6);
+    helper_double_sse_9_recursive(buf + 384, 6);
+    helper_double_sse_9_recursive(buf + 448, 6);
     for (int j = 0; j < 512; j += 512) {
       for (int k = 0; k < 64; k += 2) {
         __asm__ volatile (
@@ -15095,12 +15129,12 @@ void helper_double_9_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_9(double *buf);
-void helper_double_9(double *buf) {
-  helper_double_9_recursive(buf, 9);
+FHT_TARGET("sse4.1") void helper_double_sse_9(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_9(double *buf) {
+  helper_double_sse_9_recursive(buf, 9);
 }
-void helper_double_10_recursive(double *buf, int depth);
-void helper_double_10_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_10_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_10_recursive(double *buf, int depth) {
   if (depth == 10) {
     for (int j = 0; j < 1024; j += 16) {
       for (int k = 0; k < 2; k += 2) {
@@ -15366,12 +15400,12 @@ void helper_double_10_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_10(double *buf);
-void helper_double_10(double *buf) {
-  helper_double_10_recursive(buf, 10);
+FHT_TARGET("sse4.1") void helper_double_sse_10(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_10(double *buf) {
+  helper_double_sse_10_recursive(buf, 10);
 }
-void helper_double_11_recursive(double *buf, int depth);
-void helper_double_11_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_11_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_11_recursive(double *buf, int depth) {
   if (depth == 2) {
     for (int j = 0; j < 4; j += 4) {
       for (int k = 0; k < 2; k += 2) {
@@ -15403,14 +15437,14 @@ void helper_double_11_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 5) {
-    helper_double_11_recursive(buf + 0, 2);
-    helper_double_11_recursive(buf + 4, 2);
-    helper_double_11_recursive(buf + 8, 2);
-    helper_double_11_recursive(buf + 12, 2);
-    helper_double_11_recursive(buf + 16, 2);
-    helper_double_11_recursive(buf + 20, 2);
-    helper_double_11_recursive(buf + 24, 2);
-    helper_double_11_recursive(buf + 28, 2);
+    helper_double_sse_11_recursive(buf + 0, 2);
+    helper_double_sse_11_recursive(buf + 4, 2);
+    helper_double_sse_11_recursive(buf + 8, 2);
+    helper_double_sse_11_recursive(buf + 12, 2);
+    helper_double_sse_11_recursive(buf + 16, 2);
+    helper_double_sse_11_recursive(buf + 20, 2);
+    helper_double_sse_11_recursive(buf + 24, 2);
+    helper_double_sse_11_recursive(buf + 28, 2);
     for (int j = 0; j < 32; j += 32) {
       for (int k = 0; k < 4; k += 2) {
         __asm__ volatile (
@@ -15485,14 +15519,14 @@ void helper_double_11_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 8) {
-    helper_double_11_recursive(buf + 0, 5);
-    helper_double_11_recursive(buf + 32, 5);
-    helper_double_11_recursive(buf + 64, 5);
-    helper_double_11_recursive(buf + 96, 5);
-    helper_double_11_recursive(buf + 128, 5);
-    helper_double_11_recursive(buf + 160, 5);
-    helper_double_11_recursive(buf + 192, 5);
-    helper_double_11_recursive(buf + 224, 5);
+    helper_double_sse_11_recursive(buf + 0, 5);
+    helper_double_sse_11_recursive(buf + 32, 5);
+    helper_double_sse_11_recursive(buf + 64, 5);
+    helper_double_sse_11_recursive(buf + 96, 5);
+    helper_double_sse_11_recursive(buf + 128, 5);
+    helper_double_sse_11_recursive(buf + 160, 5);
+    helper_double_sse_11_recursive(buf + 192, 5);
+    helper_double_sse_11_recursive(buf + 224, 5);
     for (int j = 0; j < 256; j += 256) {
       for (int k = 0; k < 32; k += 2) {
         __asm__ volatile (
@@ -15567,14 +15601,14 @@ void helper_double_11_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 11) {
-    helper_double_11_recursive(buf + 0, 8);
-    helper_double_11_recursive(buf + 256, 8);
-    helper_double_11_recursive(buf + 512, 8);
-    helper_double_11_recursive(buf + 768, 8);
-    helper_double_11_recursive(buf + 1024, 8);
-    helper_double_11_recursive(buf + 1280, 8);
-    helper_double_11_recursive(buf + 1536, 8);
-    helper_double_11_recursive(buf + 1792, 8);
+    helper_double_sse_11_recursive(buf + 0, 8);
+    helper_double_sse_11_recursive(buf + 256, 8);
+    helper_double_sse_11_recursive(buf + 512, 8);
+    helper_double_sse_11_recursive(buf + 768, 8);
+    helper_double_sse_11_recursive(buf + 1024, 8);
+    helper_double_sse_11_recursive(buf + 1280, 8);
+    helper_double_sse_11_recursive(buf + 1536, 8);
+    helper_double_sse_11_recursive(buf + 1792, 8);
     for (int j = 0; j < 2048; j += 2048) {
       for (int k = 0; k < 256; k += 2) {
         __asm__ volatile (
@@ -15649,12 +15683,12 @@ void helper_double_11_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_11(double *buf);
-void helper_double_11(double *buf) {
-  helper_double_11_recursive(buf, 11);
+FHT_TARGET("sse4.1") void helper_double_sse_11(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_11(double *buf) {
+  helper_double_sse_11_recursive(buf, 11);
 }
-void helper_double_12_recursive(double *buf, int depth);
-void helper_double_12_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_12_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_12_recursive(double *buf, int depth) {
   if (depth == 10) {
     for (int j = 0; j < 1024; j += 16) {
       for (int k = 0; k < 2; k += 2) {
@@ -15920,10 +15954,10 @@ void helper_double_12_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 12) {
-    helper_double_12_recursive(buf + 0, 10);
-    helper_double_12_recursive(buf + 1024, 10);
-    helper_double_12_recursive(buf + 2048, 10);
-    helper_double_12_recursive(buf + 3072, 10);
+    helper_double_sse_12_recursive(buf + 0, 10);
+    helper_double_sse_12_recursive(buf + 1024, 10);
+    helper_double_sse_12_recursive(buf + 2048, 10);
+    helper_double_sse_12_recursive(buf + 3072, 10);
     for (int j = 0; j < 4096; j += 4096) {
       for (int k = 0; k < 1024; k += 2) {
         __asm__ volatile (
@@ -15958,12 +15992,12 @@ void helper_double_12_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_12(double *buf);
-void helper_double_12(double *buf) {
-  helper_double_12_recursive(buf, 12);
+FHT_TARGET("sse4.1") void helper_double_sse_12(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_12(double *buf) {
+  helper_double_sse_12_recursive(buf, 12);
 }
-static inline void helper_double_13(double *buf);
-static inline void helper_double_13(double *buf) {
+FHT_TARGET("sse4.1") static inline void helper_double_sse_13(double *buf);
+FHT_TARGET("sse4.1") static inline void helper_double_sse_13(double *buf) {
   for (int j = 0; j < 8192; j += 16) {
     for (int k = 0; k < 2; k += 2) {
       __asm__ volatile (
@@ -16297,8 +16331,8 @@ static inline void helper_double_13(double *buf) {
     }
   }
 }
-void helper_double_14_recursive(double *buf, int depth);
-void helper_double_14_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_14_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_14_recursive(double *buf, int depth) {
   if (depth == 9) {
     for (int j = 0; j < 512; j += 16) {
       for (int k = 0; k < 2; k += 2) {
@@ -16524,14 +16558,14 @@ void helper_double_14_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 12) {
-    helper_double_14_recursive(buf + 0, 9);
-    helper_double_14_recursive(buf + 512, 9);
-    helper_double_14_recursive(buf + 1024, 9);
-    helper_double_14_recursive(buf + 1536, 9);
-    helper_double_14_recursive(buf + 2048, 9);
-    helper_double_14_recursive(buf + 2560, 9);
-    helper_double_14_recursive(buf + 3072, 9);
-    helper_double_14_recursive(buf + 3584, 9);
+    helper_double_sse_14_recursive(buf + 0, 9);
+    helper_double_sse_14_recursive(buf + 512, 9);
+    helper_double_sse_14_recursive(buf + 1024, 9);
+    helper_double_sse_14_recursive(buf + 1536, 9);
+    helper_double_sse_14_recursive(buf + 2048, 9);
+    helper_double_sse_14_recursive(buf + 2560, 9);
+    helper_double_sse_14_recursive(buf + 3072, 9);
+    helper_double_sse_14_recursive(buf + 3584, 9);
     for (int j = 0; j < 4096; j += 4096) {
       for (int k = 0; k < 512; k += 2) {
         __asm__ volatile (
@@ -16606,10 +16640,10 @@ void helper_double_14_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_double_14_recursive(buf + 0, 12);
-    helper_double_14_recursive(buf + 4096, 12);
-    helper_double_14_recursive(buf + 8192, 12);
-    helper_double_14_recursive(buf + 12288, 12);
+    helper_double_sse_14_recursive(buf + 0, 12);
+    helper_double_sse_14_recursive(buf + 4096, 12);
+    helper_double_sse_14_recursive(buf + 8192, 12);
+    helper_double_sse_14_recursive(buf + 12288, 12);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 4096; k += 2) {
         __asm__ volatile (
@@ -16644,12 +16678,12 @@ void helper_double_14_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_14(double *buf);
-void helper_double_14(double *buf) {
-  helper_double_14_recursive(buf, 14);
+FHT_TARGET("sse4.1") void helper_double_sse_14(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_14(double *buf) {
+  helper_double_sse_14_recursive(buf, 14);
 }
-void helper_double_15_recursive(double *buf, int depth);
-void helper_double_15_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_15_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_15_recursive(double *buf, int depth) {
   if (depth == 10) {
     for (int j = 0; j < 1024; j += 16) {
       for (int k = 0; k < 2; k += 2) {
@@ -16915,14 +16949,14 @@ void helper_double_15_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 13) {
-    helper_double_15_recursive(buf + 0, 10);
-    helper_double_15_recursive(buf + 1024, 10);
-    helper_double_15_recursive(buf + 2048, 10);
-    helper_double_15_recursive(buf + 3072, 10);
-    helper_double_15_recursive(buf + 4096, 10);
-    helper_double_15_recursive(buf + 5120, 10);
-    helper_double_15_recursive(buf + 6144, 10);
-    helper_double_15_recursive(buf + 7168, 10);
+    helper_double_sse_15_recursive(buf + 0, 10);
+    helper_double_sse_15_recursive(buf + 1024, 10);
+    helper_double_sse_15_recursive(buf + 2048, 10);
+    helper_double_sse_15_recursive(buf + 3072, 10);
+    helper_double_sse_15_recursive(buf + 4096, 10);
+    helper_double_sse_15_recursive(buf + 5120, 10);
+    helper_double_sse_15_recursive(buf + 6144, 10);
+    helper_double_sse_15_recursive(buf + 7168, 10);
     for (int j = 0; j < 8192; j += 8192) {
       for (int k = 0; k < 1024; k += 2) {
         __asm__ volatile (
@@ -16997,10 +17031,10 @@ void helper_double_15_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_double_15_recursive(buf + 0, 13);
-    helper_double_15_recursive(buf + 8192, 13);
-    helper_double_15_recursive(buf + 16384, 13);
-    helper_double_15_recursive(buf + 24576, 13);
+    helper_double_sse_15_recursive(buf + 0, 13);
+    helper_double_sse_15_recursive(buf + 8192, 13);
+    helper_double_sse_15_recursive(buf + 16384, 13);
+    helper_double_sse_15_recursive(buf + 24576, 13);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 8192; k += 2) {
         __asm__ volatile (
@@ -17035,12 +17069,12 @@ void helper_double_15_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_15(double *buf);
-void helper_double_15(double *buf) {
-  helper_double_15_recursive(buf, 15);
+FHT_TARGET("sse4.1") void helper_double_sse_15(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_15(double *buf) {
+  helper_double_sse_15_recursive(buf, 15);
 }
-void helper_double_16_recursive(double *buf, int depth);
-void helper_double_16_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_16_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_16_recursive(double *buf, int depth) {
   if (depth == 2) {
     for (int j = 0; j < 4; j += 4) {
       for (int k = 0; k < 2; k += 2) {
@@ -17072,14 +17106,14 @@ void helper_double_16_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 5) {
-    helper_double_16_recursive(buf + 0, 2);
-    helper_double_16_recursive(buf + 4, 2);
-    helper_double_16_recursive(buf + 8, 2);
-    helper_double_16_recursive(buf + 12, 2);
-    helper_double_16_recursive(buf + 16, 2);
-    helper_double_16_recursive(buf + 20, 2);
-    helper_double_16_recursive(buf + 24, 2);
-    helper_double_16_recursive(buf + 28, 2);
+    helper_double_sse_16_recursive(buf + 0, 2);
+    helper_double_sse_16_recursive(buf + 4, 2);
+    helper_double_sse_16_recursive(buf + 8, 2);
+    helper_double_sse_16_recursive(buf + 12, 2);
+    helper_double_sse_16_recursive(buf + 16, 2);
+    helper_double_sse_16_recursive(buf + 20, 2);
+    helper_double_sse_16_recursive(buf + 24, 2);
+    helper_double_sse_16_recursive(buf + 28, 2);
     for (int j = 0; j < 32; j += 32) {
       for (int k = 0; k < 4; k += 2) {
         __asm__ volatile (
@@ -17154,14 +17188,14 @@ void helper_double_16_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 8) {
-    helper_double_16_recursive(buf + 0, 5);
-    helper_double_16_recursive(buf + 32, 5);
-    helper_double_16_recursive(buf + 64, 5);
-    helper_double_16_recursive(buf + 96, 5);
-    helper_double_16_recursive(buf + 128, 5);
-    helper_double_16_recursive(buf + 160, 5);
-    helper_double_16_recursive(buf + 192, 5);
-    helper_double_16_recursive(buf + 224, 5);
+    helper_double_sse_16_recursive(buf + 0, 5);
+    helper_double_sse_16_recursive(buf + 32, 5);
+    helper_double_sse_16_recursive(buf + 64, 5);
+    helper_double_sse_16_recursive(buf + 96, 5);
+    helper_double_sse_16_recursive(buf + 128, 5);
+    helper_double_sse_16_recursive(buf + 160, 5);
+    helper_double_sse_16_recursive(buf + 192, 5);
+    helper_double_sse_16_recursive(buf + 224, 5);
     for (int j = 0; j < 256; j += 256) {
       for (int k = 0; k < 32; k += 2) {
         __asm__ volatile (
@@ -17236,14 +17270,14 @@ void helper_double_16_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 11) {
-    helper_double_16_recursive(buf + 0, 8);
-    helper_double_16_recursive(buf + 256, 8);
-    helper_double_16_recursive(buf + 512, 8);
-    helper_double_16_recursive(buf + 768, 8);
-    helper_double_16_recursive(buf + 1024, 8);
-    helper_double_16_recursive(buf + 1280, 8);
-    helper_double_16_recursive(buf + 1536, 8);
-    helper_double_16_recursive(buf + 1792, 8);
+    helper_double_sse_16_recursive(buf + 0, 8);
+    helper_double_sse_16_recursive(buf + 256, 8);
+    helper_double_sse_16_recursive(buf + 512, 8);
+    helper_double_sse_16_recursive(buf + 768, 8);
+    helper_double_sse_16_recursive(buf + 1024, 8);
+    helper_double_sse_16_recursive(buf + 1280, 8);
+    helper_double_sse_16_recursive(buf + 1536, 8);
+    helper_double_sse_16_recursive(buf + 1792, 8);
     for (int j = 0; j < 2048; j += 2048) {
       for (int k = 0; k < 256; k += 2) {
         __asm__ volatile (
@@ -17318,14 +17352,14 @@ void helper_double_16_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_double_16_recursive(buf + 0, 11);
-    helper_double_16_recursive(buf + 2048, 11);
-    helper_double_16_recursive(buf + 4096, 11);
-    helper_double_16_recursive(buf + 6144, 11);
-    helper_double_16_recursive(buf + 8192, 11);
-    helper_double_16_recursive(buf + 10240, 11);
-    helper_double_16_recursive(buf + 12288, 11);
-    helper_double_16_recursive(buf + 14336, 11);
+    helper_double_sse_16_recursive(buf + 0, 11);
+    helper_double_sse_16_recursive(buf + 2048, 11);
+    helper_double_sse_16_recursive(buf + 4096, 11);
+    helper_double_sse_16_recursive(buf + 6144, 11);
+    helper_double_sse_16_recursive(buf + 8192, 11);
+    helper_double_sse_16_recursive(buf + 10240, 11);
+    helper_double_sse_16_recursive(buf + 12288, 11);
+    helper_double_sse_16_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 2) {
         __asm__ volatile (
@@ -17400,10 +17434,10 @@ void helper_double_16_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 16) {
-    helper_double_16_recursive(buf + 0, 14);
-    helper_double_16_recursive(buf + 16384, 14);
-    helper_double_16_recursive(buf + 32768, 14);
-    helper_double_16_recursive(buf + 49152, 14);
+    helper_double_sse_16_recursive(buf + 0, 14);
+    helper_double_sse_16_recursive(buf + 16384, 14);
+    helper_double_sse_16_recursive(buf + 32768, 14);
+    helper_double_sse_16_recursive(buf + 49152, 14);
     for (int j = 0; j < 65536; j += 65536) {
       for (int k = 0; k < 16384; k += 2) {
         __asm__ volatile (
@@ -17438,12 +17472,12 @@ void helper_double_16_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_16(double *buf);
-void helper_double_16(double *buf) {
-  helper_double_16_recursive(buf, 16);
+FHT_TARGET("sse4.1") void helper_double_sse_16(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_16(double *buf) {
+  helper_double_sse_16_recursive(buf, 16);
 }
-void helper_double_17_recursive(double *buf, int depth);
-void helper_double_17_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_17_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_17_recursive(double *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 16) {
       for (int k = 0; k < 2; k += 2) {
@@ -17740,14 +17774,14 @@ void helper_double_17_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_double_17_recursive(buf + 0, 12);
-    helper_double_17_recursive(buf + 4096, 12);
-    helper_double_17_recursive(buf + 8192, 12);
-    helper_double_17_recursive(buf + 12288, 12);
-    helper_double_17_recursive(buf + 16384, 12);
-    helper_double_17_recursive(buf + 20480, 12);
-    helper_double_17_recursive(buf + 24576, 12);
-    helper_double_17_recursive(buf + 28672, 12);
+    helper_double_sse_17_recursive(buf + 0, 12);
+    helper_double_sse_17_recursive(buf + 4096, 12);
+    helper_double_sse_17_recursive(buf + 8192, 12);
+    helper_double_sse_17_recursive(buf + 12288, 12);
+    helper_double_sse_17_recursive(buf + 16384, 12);
+    helper_double_sse_17_recursive(buf + 20480, 12);
+    helper_double_sse_17_recursive(buf + 24576, 12);
+    helper_double_sse_17_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 2) {
         __asm__ volatile (
@@ -17822,10 +17856,10 @@ void helper_double_17_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_double_17_recursive(buf + 0, 15);
-    helper_double_17_recursive(buf + 32768, 15);
-    helper_double_17_recursive(buf + 65536, 15);
-    helper_double_17_recursive(buf + 98304, 15);
+    helper_double_sse_17_recursive(buf + 0, 15);
+    helper_double_sse_17_recursive(buf + 32768, 15);
+    helper_double_sse_17_recursive(buf + 65536, 15);
+    helper_double_sse_17_recursive(buf + 98304, 15);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 32768; k += 2) {
         __asm__ volatile (
@@ -17860,12 +17894,12 @@ void helper_double_17_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_17(double *buf);
-void helper_double_17(double *buf) {
-  helper_double_17_recursive(buf, 17);
+FHT_TARGET("sse4.1") void helper_double_sse_17(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_17(double *buf) {
+  helper_double_sse_17_recursive(buf, 17);
 }
-void helper_double_18_recursive(double *buf, int depth);
-void helper_double_18_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_18_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_18_recursive(double *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 16) {
       for (int k = 0; k < 2; k += 2) {
@@ -18162,14 +18196,14 @@ void helper_double_18_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_double_18_recursive(buf + 0, 12);
-    helper_double_18_recursive(buf + 4096, 12);
-    helper_double_18_recursive(buf + 8192, 12);
-    helper_double_18_recursive(buf + 12288, 12);
-    helper_double_18_recursive(buf + 16384, 12);
-    helper_double_18_recursive(buf + 20480, 12);
-    helper_double_18_recursive(buf + 24576, 12);
-    helper_double_18_recursive(buf + 28672, 12);
+    helper_double_sse_18_recursive(buf + 0, 12);
+    helper_double_sse_18_recursive(buf + 4096, 12);
+    helper_double_sse_18_recursive(buf + 8192, 12);
+    helper_double_sse_18_recursive(buf + 12288, 12);
+    helper_double_sse_18_recursive(buf + 16384, 12);
+    helper_double_sse_18_recursive(buf + 20480, 12);
+    helper_double_sse_18_recursive(buf + 24576, 12);
+    helper_double_sse_18_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 2) {
         __asm__ volatile (
@@ -18244,14 +18278,14 @@ void helper_double_18_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_double_18_recursive(buf + 0, 15);
-    helper_double_18_recursive(buf + 32768, 15);
-    helper_double_18_recursive(buf + 65536, 15);
-    helper_double_18_recursive(buf + 98304, 15);
-    helper_double_18_recursive(buf + 131072, 15);
-    helper_double_18_recursive(buf + 163840, 15);
-    helper_double_18_recursive(buf + 196608, 15);
-    helper_double_18_recursive(buf + 229376, 15);
+    helper_double_sse_18_recursive(buf + 0, 15);
+    helper_double_sse_18_recursive(buf + 32768, 15);
+    helper_double_sse_18_recursive(buf + 65536, 15);
+    helper_double_sse_18_recursive(buf + 98304, 15);
+    helper_double_sse_18_recursive(buf + 131072, 15);
+    helper_double_sse_18_recursive(buf + 163840, 15);
+    helper_double_sse_18_recursive(buf + 196608, 15);
+    helper_double_sse_18_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 2) {
         __asm__ volatile (
@@ -18326,12 +18360,12 @@ void helper_double_18_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_18(double *buf);
-void helper_double_18(double *buf) {
-  helper_double_18_recursive(buf, 18);
+FHT_TARGET("sse4.1") void helper_double_sse_18(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_18(double *buf) {
+  helper_double_sse_18_recursive(buf, 18);
 }
-void helper_double_19_recursive(double *buf, int depth);
-void helper_double_19_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_19_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_19_recursive(double *buf, int depth) {
   if (depth == 2) {
     for (int j = 0; j < 4; j += 4) {
       for (int k = 0; k < 2; k += 2) {
@@ -18363,14 +18397,14 @@ void helper_double_19_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 5) {
-    helper_double_19_recursive(buf + 0, 2);
-    helper_double_19_recursive(buf + 4, 2);
-    helper_double_19_recursive(buf + 8, 2);
-    helper_double_19_recursive(buf + 12, 2);
-    helper_double_19_recursive(buf + 16, 2);
-    helper_double_19_recursive(buf + 20, 2);
-    helper_double_19_recursive(buf + 24, 2);
-    helper_double_19_recursive(buf + 28, 2);
+    helper_double_sse_19_recursive(buf + 0, 2);
+    helper_double_sse_19_recursive(buf + 4, 2);
+    helper_double_sse_19_recursive(buf + 8, 2);
+    helper_double_sse_19_recursive(buf + 12, 2);
+    helper_double_sse_19_recursive(buf + 16, 2);
+    helper_double_sse_19_recursive(buf + 20, 2);
+    helper_double_sse_19_recursive(buf + 24, 2);
+    helper_double_sse_19_recursive(buf + 28, 2);
     for (int j = 0; j < 32; j += 32) {
       for (int k = 0; k < 4; k += 2) {
         __asm__ volatile (
@@ -18445,14 +18479,14 @@ void helper_double_19_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 8) {
-    helper_double_19_recursive(buf + 0, 5);
-    helper_double_19_recursive(buf + 32, 5);
-    helper_double_19_recursive(buf + 64, 5);
-    helper_double_19_recursive(buf + 96, 5);
-    helper_double_19_recursive(buf + 128, 5);
-    helper_double_19_recursive(buf + 160, 5);
-    helper_double_19_recursive(buf + 192, 5);
-    helper_double_19_recursive(buf + 224, 5);
+    helper_double_sse_19_recursive(buf + 0, 5);
+    helper_double_sse_19_recursive(buf + 32, 5);
+    helper_double_sse_19_recursive(buf + 64, 5);
+    helper_double_sse_19_recursive(buf + 96, 5);
+    helper_double_sse_19_recursive(buf + 128, 5);
+    helper_double_sse_19_recursive(buf + 160, 5);
+    helper_double_sse_19_recursive(buf + 192, 5);
+    helper_double_sse_19_recursive(buf + 224, 5);
     for (int j = 0; j < 256; j += 256) {
       for (int k = 0; k < 32; k += 2) {
         __asm__ volatile (
@@ -18527,14 +18561,14 @@ void helper_double_19_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 11) {
-    helper_double_19_recursive(buf + 0, 8);
-    helper_double_19_recursive(buf + 256, 8);
-    helper_double_19_recursive(buf + 512, 8);
-    helper_double_19_recursive(buf + 768, 8);
-    helper_double_19_recursive(buf + 1024, 8);
-    helper_double_19_recursive(buf + 1280, 8);
-    helper_double_19_recursive(buf + 1536, 8);
-    helper_double_19_recursive(buf + 1792, 8);
+    helper_double_sse_19_recursive(buf + 0, 8);
+    helper_double_sse_19_recursive(buf + 256, 8);
+    helper_double_sse_19_recursive(buf + 512, 8);
+    helper_double_sse_19_recursive(buf + 768, 8);
+    helper_double_sse_19_recursive(buf + 1024, 8);
+    helper_double_sse_19_recursive(buf + 1280, 8);
+    helper_double_sse_19_recursive(buf + 1536, 8);
+    helper_double_sse_19_recursive(buf + 1792, 8);
     for (int j = 0; j < 2048; j += 2048) {
       for (int k = 0; k < 256; k += 2) {
         __asm__ volatile (
@@ -18609,14 +18643,14 @@ void helper_double_19_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_double_19_recursive(buf + 0, 11);
-    helper_double_19_recursive(buf + 2048, 11);
-    helper_double_19_recursive(buf + 4096, 11);
-    helper_double_19_recursive(buf + 6144, 11);
-    helper_double_19_recursive(buf + 8192, 11);
-    helper_double_19_recursive(buf + 10240, 11);
-    helper_double_19_recursive(buf + 12288, 11);
-    helper_double_19_recursive(buf + 14336, 11);
+    helper_double_sse_19_recursive(buf + 0, 11);
+    helper_double_sse_19_recursive(buf + 2048, 11);
+    helper_double_sse_19_recursive(buf + 4096, 11);
+    helper_double_sse_19_recursive(buf + 6144, 11);
+    helper_double_sse_19_recursive(buf + 8192, 11);
+    helper_double_sse_19_recursive(buf + 10240, 11);
+    helper_double_sse_19_recursive(buf + 12288, 11);
+    helper_double_sse_19_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 2) {
         __asm__ volatile (
@@ -18691,14 +18725,14 @@ void helper_double_19_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_double_19_recursive(buf + 0, 14);
-    helper_double_19_recursive(buf + 16384, 14);
-    helper_double_19_recursive(buf + 32768, 14);
-    helper_double_19_recursive(buf + 49152, 14);
-    helper_double_19_recursive(buf + 65536, 14);
-    helper_double_19_recursive(buf + 81920, 14);
-    helper_double_19_recursive(buf + 98304, 14);
-    helper_double_19_recursive(buf + 114688, 14);
+    helper_double_sse_19_recursive(buf + 0, 14);
+    helper_double_sse_19_recursive(buf + 16384, 14);
+    helper_double_sse_19_recursive(buf + 32768, 14);
+    helper_double_sse_19_recursive(buf + 49152, 14);
+    helper_double_sse_19_recursive(buf + 65536, 14);
+    helper_double_sse_19_recursive(buf + 81920, 14);
+    helper_double_sse_19_recursive(buf + 98304, 14);
+    helper_double_sse_19_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 2) {
         __asm__ volatile (
@@ -18773,10 +18807,10 @@ void helper_double_19_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 19) {
-    helper_double_19_recursive(buf + 0, 17);
-    helper_double_19_recursive(buf + 131072, 17);
-    helper_double_19_recursive(buf + 262144, 17);
-    helper_double_19_recursive(buf + 393216, 17);
+    helper_double_sse_19_recursive(buf + 0, 17);
+    helper_double_sse_19_recursive(buf + 131072, 17);
+    helper_double_sse_19_recursive(buf + 262144, 17);
+    helper_double_sse_19_recursive(buf + 393216, 17);
     for (int j = 0; j < 524288; j += 524288) {
       for (int k = 0; k < 131072; k += 2) {
         __asm__ volatile (
@@ -18811,12 +18845,12 @@ void helper_double_19_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_19(double *buf);
-void helper_double_19(double *buf) {
-  helper_double_19_recursive(buf, 19);
+FHT_TARGET("sse4.1") void helper_double_sse_19(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_19(double *buf) {
+  helper_double_sse_19_recursive(buf, 19);
 }
-void helper_double_20_recursive(double *buf, int depth);
-void helper_double_20_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_20_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_20_recursive(double *buf, int depth) {
   if (depth == 12) {
     for (int j = 0; j < 4096; j += 16) {
       for (int k = 0; k < 2; k += 2) {
@@ -19113,14 +19147,14 @@ void helper_double_20_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_double_20_recursive(buf + 0, 12);
-    helper_double_20_recursive(buf + 4096, 12);
-    helper_double_20_recursive(buf + 8192, 12);
-    helper_double_20_recursive(buf + 12288, 12);
-    helper_double_20_recursive(buf + 16384, 12);
-    helper_double_20_recursive(buf + 20480, 12);
-    helper_double_20_recursive(buf + 24576, 12);
-    helper_double_20_recursive(buf + 28672, 12);
+    helper_double_sse_20_recursive(buf + 0, 12);
+    helper_double_sse_20_recursive(buf + 4096, 12);
+    helper_double_sse_20_recursive(buf + 8192, 12);
+    helper_double_sse_20_recursive(buf + 12288, 12);
+    helper_double_sse_20_recursive(buf + 16384, 12);
+    helper_double_sse_20_recursive(buf + 20480, 12);
+    helper_double_sse_20_recursive(buf + 24576, 12);
+    helper_double_sse_20_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 2) {
         __asm__ volatile (
@@ -19195,14 +19229,14 @@ void helper_double_20_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_double_20_recursive(buf + 0, 15);
-    helper_double_20_recursive(buf + 32768, 15);
-    helper_double_20_recursive(buf + 65536, 15);
-    helper_double_20_recursive(buf + 98304, 15);
-    helper_double_20_recursive(buf + 131072, 15);
-    helper_double_20_recursive(buf + 163840, 15);
-    helper_double_20_recursive(buf + 196608, 15);
-    helper_double_20_recursive(buf + 229376, 15);
+    helper_double_sse_20_recursive(buf + 0, 15);
+    helper_double_sse_20_recursive(buf + 32768, 15);
+    helper_double_sse_20_recursive(buf + 65536, 15);
+    helper_double_sse_20_recursive(buf + 98304, 15);
+    helper_double_sse_20_recursive(buf + 131072, 15);
+    helper_double_sse_20_recursive(buf + 163840, 15);
+    helper_double_sse_20_recursive(buf + 196608, 15);
+    helper_double_sse_20_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 2) {
         __asm__ volatile (
@@ -19277,10 +19311,10 @@ void helper_double_20_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_double_20_recursive(buf + 0, 18);
-    helper_double_20_recursive(buf + 262144, 18);
-    helper_double_20_recursive(buf + 524288, 18);
-    helper_double_20_recursive(buf + 786432, 18);
+    helper_double_sse_20_recursive(buf + 0, 18);
+    helper_double_sse_20_recursive(buf + 262144, 18);
+    helper_double_sse_20_recursive(buf + 524288, 18);
+    helper_double_sse_20_recursive(buf + 786432, 18);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 262144; k += 2) {
         __asm__ volatile (
@@ -19315,12 +19349,12 @@ void helper_double_20_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_20(double *buf);
-void helper_double_20(double *buf) {
-  helper_double_20_recursive(buf, 20);
+FHT_TARGET("sse4.1") void helper_double_sse_20(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_20(double *buf) {
+  helper_double_sse_20_recursive(buf, 20);
 }
-void helper_double_21_recursive(double *buf, int depth);
-void helper_double_21_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_21_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_21_recursive(double *buf, int depth) {
   if (depth == 13) {
     for (int j = 0; j < 8192; j += 16) {
       for (int k = 0; k < 2; k += 2) {
@@ -19657,14 +19691,14 @@ void helper_double_21_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 16) {
-    helper_double_21_recursive(buf + 0, 13);
-    helper_double_21_recursive(buf + 8192, 13);
-    helper_double_21_recursive(buf + 16384, 13);
-    helper_double_21_recursive(buf + 24576, 13);
-    helper_double_21_recursive(buf + 32768, 13);
-    helper_double_21_recursive(buf + 40960, 13);
-    helper_double_21_recursive(buf + 49152, 13);
-    helper_double_21_recursive(buf + 57344, 13);
+    helper_double_sse_21_recursive(buf + 0, 13);
+    helper_double_sse_21_recursive(buf + 8192, 13);
+    helper_double_sse_21_recursive(buf + 16384, 13);
+    helper_double_sse_21_recursive(buf + 24576, 13);
+    helper_double_sse_21_recursive(buf + 32768, 13);
+    helper_double_sse_21_recursive(buf + 40960, 13);
+    helper_double_sse_21_recursive(buf + 49152, 13);
+    helper_double_sse_21_recursive(buf + 57344, 13);
     for (int j = 0; j < 65536; j += 65536) {
       for (int k = 0; k < 8192; k += 2) {
         __asm__ volatile (
@@ -19739,14 +19773,14 @@ void helper_double_21_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 19) {
-    helper_double_21_recursive(buf + 0, 16);
-    helper_double_21_recursive(buf + 65536, 16);
-    helper_double_21_recursive(buf + 131072, 16);
-    helper_double_21_recursive(buf + 196608, 16);
-    helper_double_21_recursive(buf + 262144, 16);
-    helper_double_21_recursive(buf + 327680, 16);
-    helper_double_21_recursive(buf + 393216, 16);
-    helper_double_21_recursive(buf + 458752, 16);
+    helper_double_sse_21_recursive(buf + 0, 16);
+    helper_double_sse_21_recursive(buf + 65536, 16);
+    helper_double_sse_21_recursive(buf + 131072, 16);
+    helper_double_sse_21_recursive(buf + 196608, 16);
+    helper_double_sse_21_recursive(buf + 262144, 16);
+    helper_double_sse_21_recursive(buf + 327680, 16);
+    helper_double_sse_21_recursive(buf + 393216, 16);
+    helper_double_sse_21_recursive(buf + 458752, 16);
     for (int j = 0; j < 524288; j += 524288) {
       for (int k = 0; k < 65536; k += 2) {
         __asm__ volatile (
@@ -19821,10 +19855,10 @@ void helper_double_21_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_double_21_recursive(buf + 0, 19);
-    helper_double_21_recursive(buf + 524288, 19);
-    helper_double_21_recursive(buf + 1048576, 19);
-    helper_double_21_recursive(buf + 1572864, 19);
+    helper_double_sse_21_recursive(buf + 0, 19);
+    helper_double_sse_21_recursive(buf + 524288, 19);
+    helper_double_sse_21_recursive(buf + 1048576, 19);
+    helper_double_sse_21_recursive(buf + 1572864, 19);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 524288; k += 2) {
         __asm__ volatile (
@@ -19859,12 +19893,12 @@ void helper_double_21_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_21(double *buf);
-void helper_double_21(double *buf) {
-  helper_double_21_recursive(buf, 21);
+FHT_TARGET("sse4.1") void helper_double_sse_21(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_21(double *buf) {
+  helper_double_sse_21_recursive(buf, 21);
 }
-void helper_double_22_recursive(double *buf, int depth);
-void helper_double_22_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_22_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_22_recursive(double *buf, int depth) {
   if (depth == 2) {
     for (int j = 0; j < 4; j += 4) {
       for (int k = 0; k < 2; k += 2) {
@@ -19896,14 +19930,14 @@ void helper_double_22_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 5) {
-    helper_double_22_recursive(buf + 0, 2);
-    helper_double_22_recursive(buf + 4, 2);
-    helper_double_22_recursive(buf + 8, 2);
-    helper_double_22_recursive(buf + 12, 2);
-    helper_double_22_recursive(buf + 16, 2);
-    helper_double_22_recursive(buf + 20, 2);
-    helper_double_22_recursive(buf + 24, 2);
-    helper_double_22_recursive(buf + 28, 2);
+    helper_double_sse_22_recursive(buf + 0, 2);
+    helper_double_sse_22_recursive(buf + 4, 2);
+    helper_double_sse_22_recursive(buf + 8, 2);
+    helper_double_sse_22_recursive(buf + 12, 2);
+    helper_double_sse_22_recursive(buf + 16, 2);
+    helper_double_sse_22_recursive(buf + 20, 2);
+    helper_double_sse_22_recursive(buf + 24, 2);
+    helper_double_sse_22_recursive(buf + 28, 2);
     for (int j = 0; j < 32; j += 32) {
       for (int k = 0; k < 4; k += 2) {
         __asm__ volatile (
@@ -19978,14 +20012,14 @@ void helper_double_22_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 8) {
-    helper_double_22_recursive(buf + 0, 5);
-    helper_double_22_recursive(buf + 32, 5);
-    helper_double_22_recursive(buf + 64, 5);
-    helper_double_22_recursive(buf + 96, 5);
-    helper_double_22_recursive(buf + 128, 5);
-    helper_double_22_recursive(buf + 160, 5);
-    helper_double_22_recursive(buf + 192, 5);
-    helper_double_22_recursive(buf + 224, 5);
+    helper_double_sse_22_recursive(buf + 0, 5);
+    helper_double_sse_22_recursive(buf + 32, 5);
+    helper_double_sse_22_recursive(buf + 64, 5);
+    helper_double_sse_22_recursive(buf + 96, 5);
+    helper_double_sse_22_recursive(buf + 128, 5);
+    helper_double_sse_22_recursive(buf + 160, 5);
+    helper_double_sse_22_recursive(buf + 192, 5);
+    helper_double_sse_22_recursive(buf + 224, 5);
     for (int j = 0; j < 256; j += 256) {
       for (int k = 0; k < 32; k += 2) {
         __asm__ volatile (
@@ -20060,14 +20094,14 @@ void helper_double_22_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 11) {
-    helper_double_22_recursive(buf + 0, 8);
-    helper_double_22_recursive(buf + 256, 8);
-    helper_double_22_recursive(buf + 512, 8);
-    helper_double_22_recursive(buf + 768, 8);
-    helper_double_22_recursive(buf + 1024, 8);
-    helper_double_22_recursive(buf + 1280, 8);
-    helper_double_22_recursive(buf + 1536, 8);
-    helper_double_22_recursive(buf + 1792, 8);
+    helper_double_sse_22_recursive(buf + 0, 8);
+    helper_double_sse_22_recursive(buf + 256, 8);
+    helper_double_sse_22_recursive(buf + 512, 8);
+    helper_double_sse_22_recursive(buf + 768, 8);
+    helper_double_sse_22_recursive(buf + 1024, 8);
+    helper_double_sse_22_recursive(buf + 1280, 8);
+    helper_double_sse_22_recursive(buf + 1536, 8);
+    helper_double_sse_22_recursive(buf + 1792, 8);
     for (int j = 0; j < 2048; j += 2048) {
       for (int k = 0; k < 256; k += 2) {
         __asm__ volatile (
@@ -20142,14 +20176,14 @@ void helper_double_22_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_double_22_recursive(buf + 0, 11);
-    helper_double_22_recursive(buf + 2048, 11);
-    helper_double_22_recursive(buf + 4096, 11);
-    helper_double_22_recursive(buf + 6144, 11);
-    helper_double_22_recursive(buf + 8192, 11);
-    helper_double_22_recursive(buf + 10240, 11);
-    helper_double_22_recursive(buf + 12288, 11);
-    helper_double_22_recursive(buf + 14336, 11);
+    helper_double_sse_22_recursive(buf + 0, 11);
+    helper_double_sse_22_recursive(buf + 2048, 11);
+    helper_double_sse_22_recursive(buf + 4096, 11);
+    helper_double_sse_22_recursive(buf + 6144, 11);
+    helper_double_sse_22_recursive(buf + 8192, 11);
+    helper_double_sse_22_recursive(buf + 10240, 11);
+    helper_double_sse_22_recursive(buf + 12288, 11);
+    helper_double_sse_22_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 2) {
         __asm__ volatile (
@@ -20224,14 +20258,14 @@ void helper_double_22_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_double_22_recursive(buf + 0, 14);
-    helper_double_22_recursive(buf + 16384, 14);
-    helper_double_22_recursive(buf + 32768, 14);
-    helper_double_22_recursive(buf + 49152, 14);
-    helper_double_22_recursive(buf + 65536, 14);
-    helper_double_22_recursive(buf + 81920, 14);
-    helper_double_22_recursive(buf + 98304, 14);
-    helper_double_22_recursive(buf + 114688, 14);
+    helper_double_sse_22_recursive(buf + 0, 14);
+    helper_double_sse_22_recursive(buf + 16384, 14);
+    helper_double_sse_22_recursive(buf + 32768, 14);
+    helper_double_sse_22_recursive(buf + 49152, 14);
+    helper_double_sse_22_recursive(buf + 65536, 14);
+    helper_double_sse_22_recursive(buf + 81920, 14);
+    helper_double_sse_22_recursive(buf + 98304, 14);
+    helper_double_sse_22_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 2) {
         __asm__ volatile (
@@ -20306,14 +20340,14 @@ void helper_double_22_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_double_22_recursive(buf + 0, 17);
-    helper_double_22_recursive(buf + 131072, 17);
-    helper_double_22_recursive(buf + 262144, 17);
-    helper_double_22_recursive(buf + 393216, 17);
-    helper_double_22_recursive(buf + 524288, 17);
-    helper_double_22_recursive(buf + 655360, 17);
-    helper_double_22_recursive(buf + 786432, 17);
-    helper_double_22_recursive(buf + 917504, 17);
+    helper_double_sse_22_recursive(buf + 0, 17);
+    helper_double_sse_22_recursive(buf + 131072, 17);
+    helper_double_sse_22_recursive(buf + 262144, 17);
+    helper_double_sse_22_recursive(buf + 393216, 17);
+    helper_double_sse_22_recursive(buf + 524288, 17);
+    helper_double_sse_22_recursive(buf + 655360, 17);
+    helper_double_sse_22_recursive(buf + 786432, 17);
+    helper_double_sse_22_recursive(buf + 917504, 17);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 131072; k += 2) {
         __asm__ volatile (
@@ -20388,10 +20422,10 @@ void helper_double_22_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 22) {
-    helper_double_22_recursive(buf + 0, 20);
-    helper_double_22_recursive(buf + 1048576, 20);
-    helper_double_22_recursive(buf + 2097152, 20);
-    helper_double_22_recursive(buf + 3145728, 20);
+    helper_double_sse_22_recursive(buf + 0, 20);
+    helper_double_sse_22_recursive(buf + 1048576, 20);
+    helper_double_sse_22_recursive(buf + 2097152, 20);
+    helper_double_sse_22_recursive(buf + 3145728, 20);
     for (int j = 0; j < 4194304; j += 4194304) {
       for (int k = 0; k < 1048576; k += 2) {
         __asm__ volatile (
@@ -20426,12 +20460,12 @@ void helper_double_22_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_22(double *buf);
-void helper_double_22(double *buf) {
-  helper_double_22_recursive(buf, 22);
+FHT_TARGET("sse4.1") void helper_double_sse_22(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_22(double *buf) {
+  helper_double_sse_22_recursive(buf, 22);
 }
-void helper_double_23_recursive(double *buf, int depth);
-void helper_double_23_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_23_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_23_recursive(double *buf, int depth) {
   if (depth == 2) {
     for (int j = 0; j < 4; j += 4) {
       for (int k = 0; k < 2; k += 2) {
@@ -20463,14 +20497,14 @@ void helper_double_23_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 5) {
-    helper_double_23_recursive(buf + 0, 2);
-    helper_double_23_recursive(buf + 4, 2);
-    helper_double_23_recursive(buf + 8, 2);
-    helper_double_23_recursive(buf + 12, 2);
-    helper_double_23_recursive(buf + 16, 2);
-    helper_double_23_recursive(buf + 20, 2);
-    helper_double_23_recursive(buf + 24, 2);
-    helper_double_23_recursive(buf + 28, 2);
+    helper_double_sse_23_recursive(buf + 0, 2);
+    helper_double_sse_23_recursive(buf + 4, 2);
+    helper_double_sse_23_recursive(buf + 8, 2);
+    helper_double_sse_23_recursive(buf + 12, 2);
+    helper_double_sse_23_recursive(buf + 16, 2);
+    helper_double_sse_23_recursive(buf + 20, 2);
+    helper_double_sse_23_recursive(buf + 24, 2);
+    helper_double_sse_23_recursive(buf + 28, 2);
     for (int j = 0; j < 32; j += 32) {
       for (int k = 0; k < 4; k += 2) {
         __asm__ volatile (
@@ -20545,14 +20579,14 @@ void helper_double_23_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 8) {
-    helper_double_23_recursive(buf + 0, 5);
-    helper_double_23_recursive(buf + 32, 5);
-    helper_double_23_recursive(buf + 64, 5);
-    helper_double_23_recursive(buf + 96, 5);
-    helper_double_23_recursive(buf + 128, 5);
-    helper_double_23_recursive(buf + 160, 5);
-    helper_double_23_recursive(buf + 192, 5);
-    helper_double_23_recursive(buf + 224, 5);
+    helper_double_sse_23_recursive(buf + 0, 5);
+    helper_double_sse_23_recursive(buf + 32, 5);
+    helper_double_sse_23_recursive(buf + 64, 5);
+    helper_double_sse_23_recursive(buf + 96, 5);
+    helper_double_sse_23_recursive(buf + 128, 5);
+    helper_double_sse_23_recursive(buf + 160, 5);
+    helper_double_sse_23_recursive(buf + 192, 5);
+    helper_double_sse_23_recursive(buf + 224, 5);
     for (int j = 0; j < 256; j += 256) {
       for (int k = 0; k < 32; k += 2) {
         __asm__ volatile (
@@ -20627,14 +20661,14 @@ void helper_double_23_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 11) {
-    helper_double_23_recursive(buf + 0, 8);
-    helper_double_23_recursive(buf + 256, 8);
-    helper_double_23_recursive(buf + 512, 8);
-    helper_double_23_recursive(buf + 768, 8);
-    helper_double_23_recursive(buf + 1024, 8);
-    helper_double_23_recursive(buf + 1280, 8);
-    helper_double_23_recursive(buf + 1536, 8);
-    helper_double_23_recursive(buf + 1792, 8);
+    helper_double_sse_23_recursive(buf + 0, 8);
+    helper_double_sse_23_recursive(buf + 256, 8);
+    helper_double_sse_23_recursive(buf + 512, 8);
+    helper_double_sse_23_recursive(buf + 768, 8);
+    helper_double_sse_23_recursive(buf + 1024, 8);
+    helper_double_sse_23_recursive(buf + 1280, 8);
+    helper_double_sse_23_recursive(buf + 1536, 8);
+    helper_double_sse_23_recursive(buf + 1792, 8);
     for (int j = 0; j < 2048; j += 2048) {
       for (int k = 0; k < 256; k += 2) {
         __asm__ volatile (
@@ -20709,14 +20743,14 @@ void helper_double_23_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_double_23_recursive(buf + 0, 11);
-    helper_double_23_recursive(buf + 2048, 11);
-    helper_double_23_recursive(buf + 4096, 11);
-    helper_double_23_recursive(buf + 6144, 11);
-    helper_double_23_recursive(buf + 8192, 11);
-    helper_double_23_recursive(buf + 10240, 11);
-    helper_double_23_recursive(buf + 12288, 11);
-    helper_double_23_recursive(buf + 14336, 11);
+    helper_double_sse_23_recursive(buf + 0, 11);
+    helper_double_sse_23_recursive(buf + 2048, 11);
+    helper_double_sse_23_recursive(buf + 4096, 11);
+    helper_double_sse_23_recursive(buf + 6144, 11);
+    helper_double_sse_23_recursive(buf + 8192, 11);
+    helper_double_sse_23_recursive(buf + 10240, 11);
+    helper_double_sse_23_recursive(buf + 12288, 11);
+    helper_double_sse_23_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 2) {
         __asm__ volatile (
@@ -20791,14 +20825,14 @@ void helper_double_23_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_double_23_recursive(buf + 0, 14);
-    helper_double_23_recursive(buf + 16384, 14);
-    helper_double_23_recursive(buf + 32768, 14);
-    helper_double_23_recursive(buf + 49152, 14);
-    helper_double_23_recursive(buf + 65536, 14);
-    helper_double_23_recursive(buf + 81920, 14);
-    helper_double_23_recursive(buf + 98304, 14);
-    helper_double_23_recursive(buf + 114688, 14);
+    helper_double_sse_23_recursive(buf + 0, 14);
+    helper_double_sse_23_recursive(buf + 16384, 14);
+    helper_double_sse_23_recursive(buf + 32768, 14);
+    helper_double_sse_23_recursive(buf + 49152, 14);
+    helper_double_sse_23_recursive(buf + 65536, 14);
+    helper_double_sse_23_recursive(buf + 81920, 14);
+    helper_double_sse_23_recursive(buf + 98304, 14);
+    helper_double_sse_23_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 2) {
         __asm__ volatile (
@@ -20873,14 +20907,14 @@ void helper_double_23_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_double_23_recursive(buf + 0, 17);
-    helper_double_23_recursive(buf + 131072, 17);
-    helper_double_23_recursive(buf + 262144, 17);
-    helper_double_23_recursive(buf + 393216, 17);
-    helper_double_23_recursive(buf + 524288, 17);
-    helper_double_23_recursive(buf + 655360, 17);
-    helper_double_23_recursive(buf + 786432, 17);
-    helper_double_23_recursive(buf + 917504, 17);
+    helper_double_sse_23_recursive(buf + 0, 17);
+    helper_double_sse_23_recursive(buf + 131072, 17);
+    helper_double_sse_23_recursive(buf + 262144, 17);
+    helper_double_sse_23_recursive(buf + 393216, 17);
+    helper_double_sse_23_recursive(buf + 524288, 17);
+    helper_double_sse_23_recursive(buf + 655360, 17);
+    helper_double_sse_23_recursive(buf + 786432, 17);
+    helper_double_sse_23_recursive(buf + 917504, 17);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 131072; k += 2) {
         __asm__ volatile (
@@ -20955,14 +20989,14 @@ void helper_double_23_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 23) {
-    helper_double_23_recursive(buf + 0, 20);
-    helper_double_23_recursive(buf + 1048576, 20);
-    helper_double_23_recursive(buf + 2097152, 20);
-    helper_double_23_recursive(buf + 3145728, 20);
-    helper_double_23_recursive(buf + 4194304, 20);
-    helper_double_23_recursive(buf + 5242880, 20);
-    helper_double_23_recursive(buf + 6291456, 20);
-    helper_double_23_recursive(buf + 7340032, 20);
+    helper_double_sse_23_recursive(buf + 0, 20);
+    helper_double_sse_23_recursive(buf + 1048576, 20);
+    helper_double_sse_23_recursive(buf + 2097152, 20);
+    helper_double_sse_23_recursive(buf + 3145728, 20);
+    helper_double_sse_23_recursive(buf + 4194304, 20);
+    helper_double_sse_23_recursive(buf + 5242880, 20);
+    helper_double_sse_23_recursive(buf + 6291456, 20);
+    helper_double_sse_23_recursive(buf + 7340032, 20);
     for (int j = 0; j < 8388608; j += 8388608) {
       for (int k = 0; k < 1048576; k += 2) {
         __asm__ volatile (
@@ -21037,12 +21071,12 @@ void helper_double_23_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_23(double *buf);
-void helper_double_23(double *buf) {
-  helper_double_23_recursive(buf, 23);
+FHT_TARGET("sse4.1") void helper_double_sse_23(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_23(double *buf) {
+  helper_double_sse_23_recursive(buf, 23);
 }
-void helper_double_24_recursive(double *buf, int depth);
-void helper_double_24_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_24_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_24_recursive(double *buf, int depth) {
   if (depth == 13) {
     for (int j = 0; j < 8192; j += 16) {
       for (int k = 0; k < 2; k += 2) {
@@ -21379,14 +21413,14 @@ void helper_double_24_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 16) {
-    helper_double_24_recursive(buf + 0, 13);
-    helper_double_24_recursive(buf + 8192, 13);
-    helper_double_24_recursive(buf + 16384, 13);
-    helper_double_24_recursive(buf + 24576, 13);
-    helper_double_24_recursive(buf + 32768, 13);
-    helper_double_24_recursive(buf + 40960, 13);
-    helper_double_24_recursive(buf + 49152, 13);
-    helper_double_24_recursive(buf + 57344, 13);
+    helper_double_sse_24_recursive(buf + 0, 13);
+    helper_double_sse_24_recursive(buf + 8192, 13);
+    helper_double_sse_24_recursive(buf + 16384, 13);
+    helper_double_sse_24_recursive(buf + 24576, 13);
+    helper_double_sse_24_recursive(buf + 32768, 13);
+    helper_double_sse_24_recursive(buf + 40960, 13);
+    helper_double_sse_24_recursive(buf + 49152, 13);
+    helper_double_sse_24_recursive(buf + 57344, 13);
     for (int j = 0; j < 65536; j += 65536) {
       for (int k = 0; k < 8192; k += 2) {
         __asm__ volatile (
@@ -21461,14 +21495,14 @@ void helper_double_24_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 19) {
-    helper_double_24_recursive(buf + 0, 16);
-    helper_double_24_recursive(buf + 65536, 16);
-    helper_double_24_recursive(buf + 131072, 16);
-    helper_double_24_recursive(buf + 196608, 16);
-    helper_double_24_recursive(buf + 262144, 16);
-    helper_double_24_recursive(buf + 327680, 16);
-    helper_double_24_recursive(buf + 393216, 16);
-    helper_double_24_recursive(buf + 458752, 16);
+    helper_double_sse_24_recursive(buf + 0, 16);
+    helper_double_sse_24_recursive(buf + 65536, 16);
+    helper_double_sse_24_recursive(buf + 131072, 16);
+    helper_double_sse_24_recursive(buf + 196608, 16);
+    helper_double_sse_24_recursive(buf + 262144, 16);
+    helper_double_sse_24_recursive(buf + 327680, 16);
+    helper_double_sse_24_recursive(buf + 393216, 16);
+    helper_double_sse_24_recursive(buf + 458752, 16);
     for (int j = 0; j < 524288; j += 524288) {
       for (int k = 0; k < 65536; k += 2) {
         __asm__ volatile (
@@ -21543,14 +21577,14 @@ void helper_double_24_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 22) {
-    helper_double_24_recursive(buf + 0, 19);
-    helper_double_24_recursive(buf + 524288, 19);
-    helper_double_24_recursive(buf + 1048576, 19);
-    helper_double_24_recursive(buf + 1572864, 19);
-    helper_double_24_recursive(buf + 2097152, 19);
-    helper_double_24_recursive(buf + 2621440, 19);
-    helper_double_24_recursive(buf + 3145728, 19);
-    helper_double_24_recursive(buf + 3670016, 19);
+    helper_double_sse_24_recursive(buf + 0, 19);
+    helper_double_sse_24_recursive(buf + 524288, 19);
+    helper_double_sse_24_recursive(buf + 1048576, 19);
+    helper_double_sse_24_recursive(buf + 1572864, 19);
+    helper_double_sse_24_recursive(buf + 2097152, 19);
+    helper_double_sse_24_recursive(buf + 2621440, 19);
+    helper_double_sse_24_recursive(buf + 3145728, 19);
+    helper_double_sse_24_recursive(buf + 3670016, 19);
     for (int j = 0; j < 4194304; j += 4194304) {
       for (int k = 0; k < 524288; k += 2) {
         __asm__ volatile (
@@ -21625,10 +21659,10 @@ void helper_double_24_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 24) {
-    helper_double_24_recursive(buf + 0, 22);
-    helper_double_24_recursive(buf + 4194304, 22);
-    helper_double_24_recursive(buf + 8388608, 22);
-    helper_double_24_recursive(buf + 12582912, 22);
+    helper_double_sse_24_recursive(buf + 0, 22);
+    helper_double_sse_24_recursive(buf + 4194304, 22);
+    helper_double_sse_24_recursive(buf + 8388608, 22);
+    helper_double_sse_24_recursive(buf + 12582912, 22);
     for (int j = 0; j < 16777216; j += 16777216) {
       for (int k = 0; k < 4194304; k += 2) {
         __asm__ volatile (
@@ -21663,12 +21697,12 @@ void helper_double_24_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_24(double *buf);
-void helper_double_24(double *buf) {
-  helper_double_24_recursive(buf, 24);
+FHT_TARGET("sse4.1") void helper_double_sse_24(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_24(double *buf) {
+  helper_double_sse_24_recursive(buf, 24);
 }
-void helper_double_25_recursive(double *buf, int depth);
-void helper_double_25_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_25_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_25_recursive(double *buf, int depth) {
   if (depth == 10) {
     for (int j = 0; j < 1024; j += 16) {
       for (int k = 0; k < 2; k += 2) {
@@ -21934,14 +21968,14 @@ void helper_double_25_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 13) {
-    helper_double_25_recursive(buf + 0, 10);
-    helper_double_25_recursive(buf + 1024, 10);
-    helper_double_25_recursive(buf + 2048, 10);
-    helper_double_25_recursive(buf + 3072, 10);
-    helper_double_25_recursive(buf + 4096, 10);
-    helper_double_25_recursive(buf + 5120, 10);
-    helper_double_25_recursive(buf + 6144, 10);
-    helper_double_25_recursive(buf + 7168, 10);
+    helper_double_sse_25_recursive(buf + 0, 10);
+    helper_double_sse_25_recursive(buf + 1024, 10);
+    helper_double_sse_25_recursive(buf + 2048, 10);
+    helper_double_sse_25_recursive(buf + 3072, 10);
+    helper_double_sse_25_recursive(buf + 4096, 10);
+    helper_double_sse_25_recursive(buf + 5120, 10);
+    helper_double_sse_25_recursive(buf + 6144, 10);
+    helper_double_sse_25_recursive(buf + 7168, 10);
     for (int j = 0; j < 8192; j += 8192) {
       for (int k = 0; k < 1024; k += 2) {
         __asm__ volatile (
@@ -22016,14 +22050,14 @@ void helper_double_25_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 16) {
-    helper_double_25_recursive(buf + 0, 13);
-    helper_double_25_recursive(buf + 8192, 13);
-    helper_double_25_recursive(buf + 16384, 13);
-    helper_double_25_recursive(buf + 24576, 13);
-    helper_double_25_recursive(buf + 32768, 13);
-    helper_double_25_recursive(buf + 40960, 13);
-    helper_double_25_recursive(buf + 49152, 13);
-    helper_double_25_recursive(buf + 57344, 13);
+    helper_double_sse_25_recursive(buf + 0, 13);
+    helper_double_sse_25_recursive(buf + 8192, 13);
+    helper_double_sse_25_recursive(buf + 16384, 13);
+    helper_double_sse_25_recursive(buf + 24576, 13);
+    helper_double_sse_25_recursive(buf + 32768, 13);
+    helper_double_sse_25_recursive(buf + 40960, 13);
+    helper_double_sse_25_recursive(buf + 49152, 13);
+    helper_double_sse_25_recursive(buf + 57344, 13);
     for (int j = 0; j < 65536; j += 65536) {
       for (int k = 0; k < 8192; k += 2) {
         __asm__ volatile (
@@ -22098,14 +22132,14 @@ void helper_double_25_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 19) {
-    helper_double_25_recursive(buf + 0, 16);
-    helper_double_25_recursive(buf + 65536, 16);
-    helper_double_25_recursive(buf + 131072, 16);
-    helper_double_25_recursive(buf + 196608, 16);
-    helper_double_25_recursive(buf + 262144, 16);
-    helper_double_25_recursive(buf + 327680, 16);
-    helper_double_25_recursive(buf + 393216, 16);
-    helper_double_25_recursive(buf + 458752, 16);
+    helper_double_sse_25_recursive(buf + 0, 16);
+    helper_double_sse_25_recursive(buf + 65536, 16);
+    helper_double_sse_25_recursive(buf + 131072, 16);
+    helper_double_sse_25_recursive(buf + 196608, 16);
+    helper_double_sse_25_recursive(buf + 262144, 16);
+    helper_double_sse_25_recursive(buf + 327680, 16);
+    helper_double_sse_25_recursive(buf + 393216, 16);
+    helper_double_sse_25_recursive(buf + 458752, 16);
     for (int j = 0; j < 524288; j += 524288) {
       for (int k = 0; k < 65536; k += 2) {
         __asm__ volatile (
@@ -22180,14 +22214,14 @@ void helper_double_25_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 22) {
-    helper_double_25_recursive(buf + 0, 19);
-    helper_double_25_recursive(buf + 524288, 19);
-    helper_double_25_recursive(buf + 1048576, 19);
-    helper_double_25_recursive(buf + 1572864, 19);
-    helper_double_25_recursive(buf + 2097152, 19);
-    helper_double_25_recursive(buf + 2621440, 19);
-    helper_double_25_recursive(buf + 3145728, 19);
-    helper_double_25_recursive(buf + 3670016, 19);
+    helper_double_sse_25_recursive(buf + 0, 19);
+    helper_double_sse_25_recursive(buf + 524288, 19);
+    helper_double_sse_25_recursive(buf + 1048576, 19);
+    helper_double_sse_25_recursive(buf + 1572864, 19);
+    helper_double_sse_25_recursive(buf + 2097152, 19);
+    helper_double_sse_25_recursive(buf + 2621440, 19);
+    helper_double_sse_25_recursive(buf + 3145728, 19);
+    helper_double_sse_25_recursive(buf + 3670016, 19);
     for (int j = 0; j < 4194304; j += 4194304) {
       for (int k = 0; k < 524288; k += 2) {
         __asm__ volatile (
@@ -22262,14 +22296,14 @@ void helper_double_25_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 25) {
-    helper_double_25_recursive(buf + 0, 22);
-    helper_double_25_recursive(buf + 4194304, 22);
-    helper_double_25_recursive(buf + 8388608, 22);
-    helper_double_25_recursive(buf + 12582912, 22);
-    helper_double_25_recursive(buf + 16777216, 22);
-    helper_double_25_recursive(buf + 20971520, 22);
-    helper_double_25_recursive(buf + 25165824, 22);
-    helper_double_25_recursive(buf + 29360128, 22);
+    helper_double_sse_25_recursive(buf + 0, 22);
+    helper_double_sse_25_recursive(buf + 4194304, 22);
+    helper_double_sse_25_recursive(buf + 8388608, 22);
+    helper_double_sse_25_recursive(buf + 12582912, 22);
+    helper_double_sse_25_recursive(buf + 16777216, 22);
+    helper_double_sse_25_recursive(buf + 20971520, 22);
+    helper_double_sse_25_recursive(buf + 25165824, 22);
+    helper_double_sse_25_recursive(buf + 29360128, 22);
     for (int j = 0; j < 33554432; j += 33554432) {
       for (int k = 0; k < 4194304; k += 2) {
         __asm__ volatile (
@@ -22344,12 +22378,12 @@ void helper_double_25_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_25(double *buf);
-void helper_double_25(double *buf) {
-  helper_double_25_recursive(buf, 25);
+FHT_TARGET("sse4.1") void helper_double_sse_25(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_25(double *buf) {
+  helper_double_sse_25_recursive(buf, 25);
 }
-void helper_double_26_recursive(double *buf, int depth);
-void helper_double_26_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_26_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_26_recursive(double *buf, int depth) {
   if (depth == 5) {
     for (int j = 0; j < 32; j += 16) {
       for (int k = 0; k < 2; k += 2) {
@@ -22488,14 +22522,14 @@ void helper_double_26_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 8) {
-    helper_double_26_recursive(buf + 0, 5);
-    helper_double_26_recursive(buf + 32, 5);
-    helper_double_26_recursive(buf + 64, 5);
-    helper_double_26_recursive(buf + 96, 5);
-    helper_double_26_recursive(buf + 128, 5);
-    helper_double_26_recursive(buf + 160, 5);
-    helper_double_26_recursive(buf + 192, 5);
-    helper_double_26_recursive(buf + 224, 5);
+    helper_double_sse_26_recursive(buf + 0, 5);
+    helper_double_sse_26_recursive(buf + 32, 5);
+    helper_double_sse_26_recursive(buf + 64, 5);
+    helper_double_sse_26_recursive(buf + 96, 5);
+    helper_double_sse_26_recursive(buf + 128, 5);
+    helper_double_sse_26_recursive(buf + 160, 5);
+    helper_double_sse_26_recursive(buf + 192, 5);
+    helper_double_sse_26_recursive(buf + 224, 5);
     for (int j = 0; j < 256; j += 256) {
       for (int k = 0; k < 32; k += 2) {
         __asm__ volatile (
@@ -22570,14 +22604,14 @@ void helper_double_26_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 11) {
-    helper_double_26_recursive(buf + 0, 8);
-    helper_double_26_recursive(buf + 256, 8);
-    helper_double_26_recursive(buf + 512, 8);
-    helper_double_26_recursive(buf + 768, 8);
-    helper_double_26_recursive(buf + 1024, 8);
-    helper_double_26_recursive(buf + 1280, 8);
-    helper_double_26_recursive(buf + 1536, 8);
-    helper_double_26_recursive(buf + 1792, 8);
+    helper_double_sse_26_recursive(buf + 0, 8);
+    helper_double_sse_26_recursive(buf + 256, 8);
+    helper_double_sse_26_recursive(buf + 512, 8);
+    helper_double_sse_26_recursive(buf + 768, 8);
+    helper_double_sse_26_recursive(buf + 1024, 8);
+    helper_double_sse_26_recursive(buf + 1280, 8);
+    helper_double_sse_26_recursive(buf + 1536, 8);
+    helper_double_sse_26_recursive(buf + 1792, 8);
     for (int j = 0; j < 2048; j += 2048) {
       for (int k = 0; k < 256; k += 2) {
         __asm__ volatile (
@@ -22652,14 +22686,14 @@ void helper_double_26_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 14) {
-    helper_double_26_recursive(buf + 0, 11);
-    helper_double_26_recursive(buf + 2048, 11);
-    helper_double_26_recursive(buf + 4096, 11);
-    helper_double_26_recursive(buf + 6144, 11);
-    helper_double_26_recursive(buf + 8192, 11);
-    helper_double_26_recursive(buf + 10240, 11);
-    helper_double_26_recursive(buf + 12288, 11);
-    helper_double_26_recursive(buf + 14336, 11);
+    helper_double_sse_26_recursive(buf + 0, 11);
+    helper_double_sse_26_recursive(buf + 2048, 11);
+    helper_double_sse_26_recursive(buf + 4096, 11);
+    helper_double_sse_26_recursive(buf + 6144, 11);
+    helper_double_sse_26_recursive(buf + 8192, 11);
+    helper_double_sse_26_recursive(buf + 10240, 11);
+    helper_double_sse_26_recursive(buf + 12288, 11);
+    helper_double_sse_26_recursive(buf + 14336, 11);
     for (int j = 0; j < 16384; j += 16384) {
       for (int k = 0; k < 2048; k += 2) {
         __asm__ volatile (
@@ -22734,14 +22768,14 @@ void helper_double_26_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_double_26_recursive(buf + 0, 14);
-    helper_double_26_recursive(buf + 16384, 14);
-    helper_double_26_recursive(buf + 32768, 14);
-    helper_double_26_recursive(buf + 49152, 14);
-    helper_double_26_recursive(buf + 65536, 14);
-    helper_double_26_recursive(buf + 81920, 14);
-    helper_double_26_recursive(buf + 98304, 14);
-    helper_double_26_recursive(buf + 114688, 14);
+    helper_double_sse_26_recursive(buf + 0, 14);
+    helper_double_sse_26_recursive(buf + 16384, 14);
+    helper_double_sse_26_recursive(buf + 32768, 14);
+    helper_double_sse_26_recursive(buf + 49152, 14);
+    helper_double_sse_26_recursive(buf + 65536, 14);
+    helper_double_sse_26_recursive(buf + 81920, 14);
+    helper_double_sse_26_recursive(buf + 98304, 14);
+    helper_double_sse_26_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 2) {
         __asm__ volatile (
@@ -22816,14 +22850,14 @@ void helper_double_26_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_double_26_recursive(buf + 0, 17);
-    helper_double_26_recursive(buf + 131072, 17);
-    helper_double_26_recursive(buf + 262144, 17);
-    helper_double_26_recursive(buf + 393216, 17);
-    helper_double_26_recursive(buf + 524288, 17);
-    helper_double_26_recursive(buf + 655360, 17);
-    helper_double_26_recursive(buf + 786432, 17);
-    helper_double_26_recursive(buf + 917504, 17);
+    helper_double_sse_26_recursive(buf + 0, 17);
+    helper_double_sse_26_recursive(buf + 131072, 17);
+    helper_double_sse_26_recursive(buf + 262144, 17);
+    helper_double_sse_26_recursive(buf + 393216, 17);
+    helper_double_sse_26_recursive(buf + 524288, 17);
+    helper_double_sse_26_recursive(buf + 655360, 17);
+    helper_double_sse_26_recursive(buf + 786432, 17);
+    helper_double_sse_26_recursive(buf + 917504, 17);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 131072; k += 2) {
         __asm__ volatile (
@@ -22898,14 +22932,14 @@ void helper_double_26_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 23) {
-    helper_double_26_recursive(buf + 0, 20);
-    helper_double_26_recursive(buf + 1048576, 20);
-    helper_double_26_recursive(buf + 2097152, 20);
-    helper_double_26_recursive(buf + 3145728, 20);
-    helper_double_26_recursive(buf + 4194304, 20);
-    helper_double_26_recursive(buf + 5242880, 20);
-    helper_double_26_recursive(buf + 6291456, 20);
-    helper_double_26_recursive(buf + 7340032, 20);
+    helper_double_sse_26_recursive(buf + 0, 20);
+    helper_double_sse_26_recursive(buf + 1048576, 20);
+    helper_double_sse_26_recursive(buf + 2097152, 20);
+    helper_double_sse_26_recursive(buf + 3145728, 20);
+    helper_double_sse_26_recursive(buf + 4194304, 20);
+    helper_double_sse_26_recursive(buf + 5242880, 20);
+    helper_double_sse_26_recursive(buf + 6291456, 20);
+    helper_double_sse_26_recursive(buf + 7340032, 20);
     for (int j = 0; j < 8388608; j += 8388608) {
       for (int k = 0; k < 1048576; k += 2) {
         __asm__ volatile (
@@ -22980,14 +23014,14 @@ void helper_double_26_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 26) {
-    helper_double_26_recursive(buf + 0, 23);
-    helper_double_26_recursive(buf + 8388608, 23);
-    helper_double_26_recursive(buf + 16777216, 23);
-    helper_double_26_recursive(buf + 25165824, 23);
-    helper_double_26_recursive(buf + 33554432, 23);
-    helper_double_26_recursive(buf + 41943040, 23);
-    helper_double_26_recursive(buf + 50331648, 23);
-    helper_double_26_recursive(buf + 58720256, 23);
+    helper_double_sse_26_recursive(buf + 0, 23);
+    helper_double_sse_26_recursive(buf + 8388608, 23);
+    helper_double_sse_26_recursive(buf + 16777216, 23);
+    helper_double_sse_26_recursive(buf + 25165824, 23);
+    helper_double_sse_26_recursive(buf + 33554432, 23);
+    helper_double_sse_26_recursive(buf + 41943040, 23);
+    helper_double_sse_26_recursive(buf + 50331648, 23);
+    helper_double_sse_26_recursive(buf + 58720256, 23);
     for (int j = 0; j < 67108864; j += 67108864) {
       for (int k = 0; k < 8388608; k += 2) {
         __asm__ volatile (
@@ -23062,12 +23096,12 @@ void helper_double_26_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_26(double *buf);
-void helper_double_26(double *buf) {
-  helper_double_26_recursive(buf, 26);
+FHT_TARGET("sse4.1") void helper_double_sse_26(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_26(double *buf) {
+  helper_double_sse_26_recursive(buf, 26);
 }
-void helper_double_27_recursive(double *buf, int depth);
-void helper_double_27_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_27_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_27_recursive(double *buf, int depth) {
   if (depth == 6) {
     for (int j = 0; j < 64; j += 16) {
       for (int k = 0; k < 2; k += 2) {
@@ -23222,14 +23256,14 @@ void helper_double_27_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 9) {
-    helper_double_27_recursive(buf + 0, 6);
-    helper_double_27_recursive(buf + 64, 6);
-    helper_double_27_recursive(buf + 128, 6);
-    helper_double_27_recursive(buf + 192, 6);
-    helper_double_27_recursive(buf + 256, 6);
-    helper_double_27_recursive(buf + 320, 6);
-    helper_double_27_recursive(buf + 384, 6);
-    helper_double_27_recursive(buf + 448, 6);
+    helper_double_sse_27_recursive(buf + 0, 6);
+    helper_double_sse_27_recursive(buf + 64, 6);
+    helper_double_sse_27_recursive(buf + 128, 6);
+    helper_double_sse_27_recursive(buf + 192, 6);
+    helper_double_sse_27_recursive(buf + 256, 6);
+    helper_double_sse_27_recursive(buf + 320, 6);
+    helper_double_sse_27_recursive(buf + 384, 6);
+    helper_double_sse_27_recursive(buf + 448, 6);
     for (int j = 0; j < 512; j += 512) {
       for (int k = 0; k < 64; k += 2) {
         __asm__ volatile (
@@ -23304,14 +23338,14 @@ void helper_double_27_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 12) {
-    helper_double_27_recursive(buf + 0, 9);
-    helper_double_27_recursive(buf + 512, 9);
-    helper_double_27_recursive(buf + 1024, 9);
-    helper_double_27_recursive(buf + 1536, 9);
-    helper_double_27_recursive(buf + 2048, 9);
-    helper_double_27_recursive(buf + 2560, 9);
-    helper_double_27_recursive(buf + 3072, 9);
-    helper_double_27_recursive(buf + 3584, 9);
+    helper_double_sse_27_recursive(buf + 0, 9);
+    helper_double_sse_27_recursive(buf + 512, 9);
+    helper_double_sse_27_recursive(buf + 1024, 9);
+    helper_double_sse_27_recursive(buf + 1536, 9);
+    helper_double_sse_27_recursive(buf + 2048, 9);
+    helper_double_sse_27_recursive(buf + 2560, 9);
+    helper_double_sse_27_recursive(buf + 3072, 9);
+    helper_double_sse_27_recursive(buf + 3584, 9);
     for (int j = 0; j < 4096; j += 4096) {
       for (int k = 0; k < 512; k += 2) {
         __asm__ volatile (
@@ -23386,14 +23420,14 @@ void helper_double_27_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_double_27_recursive(buf + 0, 12);
-    helper_double_27_recursive(buf + 4096, 12);
-    helper_double_27_recursive(buf + 8192, 12);
-    helper_double_27_recursive(buf + 12288, 12);
-    helper_double_27_recursive(buf + 16384, 12);
-    helper_double_27_recursive(buf + 20480, 12);
-    helper_double_27_recursive(buf + 24576, 12);
-    helper_double_27_recursive(buf + 28672, 12);
+    helper_double_sse_27_recursive(buf + 0, 12);
+    helper_double_sse_27_recursive(buf + 4096, 12);
+    helper_double_sse_27_recursive(buf + 8192, 12);
+    helper_double_sse_27_recursive(buf + 12288, 12);
+    helper_double_sse_27_recursive(buf + 16384, 12);
+    helper_double_sse_27_recursive(buf + 20480, 12);
+    helper_double_sse_27_recursive(buf + 24576, 12);
+    helper_double_sse_27_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 2) {
         __asm__ volatile (
@@ -23468,14 +23502,14 @@ void helper_double_27_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_double_27_recursive(buf + 0, 15);
-    helper_double_27_recursive(buf + 32768, 15);
-    helper_double_27_recursive(buf + 65536, 15);
-    helper_double_27_recursive(buf + 98304, 15);
-    helper_double_27_recursive(buf + 131072, 15);
-    helper_double_27_recursive(buf + 163840, 15);
-    helper_double_27_recursive(buf + 196608, 15);
-    helper_double_27_recursive(buf + 229376, 15);
+    helper_double_sse_27_recursive(buf + 0, 15);
+    helper_double_sse_27_recursive(buf + 32768, 15);
+    helper_double_sse_27_recursive(buf + 65536, 15);
+    helper_double_sse_27_recursive(buf + 98304, 15);
+    helper_double_sse_27_recursive(buf + 131072, 15);
+    helper_double_sse_27_recursive(buf + 163840, 15);
+    helper_double_sse_27_recursive(buf + 196608, 15);
+    helper_double_sse_27_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 2) {
         __asm__ volatile (
@@ -23550,14 +23584,14 @@ void helper_double_27_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_double_27_recursive(buf + 0, 18);
-    helper_double_27_recursive(buf + 262144, 18);
-    helper_double_27_recursive(buf + 524288, 18);
-    helper_double_27_recursive(buf + 786432, 18);
-    helper_double_27_recursive(buf + 1048576, 18);
-    helper_double_27_recursive(buf + 1310720, 18);
-    helper_double_27_recursive(buf + 1572864, 18);
-    helper_double_27_recursive(buf + 1835008, 18);
+    helper_double_sse_27_recursive(buf + 0, 18);
+    helper_double_sse_27_recursive(buf + 262144, 18);
+    helper_double_sse_27_recursive(buf + 524288, 18);
+    helper_double_sse_27_recursive(buf + 786432, 18);
+    helper_double_sse_27_recursive(buf + 1048576, 18);
+    helper_double_sse_27_recursive(buf + 1310720, 18);
+    helper_double_sse_27_recursive(buf + 1572864, 18);
+    helper_double_sse_27_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 2) {
         __asm__ volatile (
@@ -23632,14 +23666,14 @@ void helper_double_27_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 24) {
-    helper_double_27_recursive(buf + 0, 21);
-    helper_double_27_recursive(buf + 2097152, 21);
-    helper_double_27_recursive(buf + 4194304, 21);
-    helper_double_27_recursive(buf + 6291456, 21);
-    helper_double_27_recursive(buf + 8388608, 21);
-    helper_double_27_recursive(buf + 10485760, 21);
-    helper_double_27_recursive(buf + 12582912, 21);
-    helper_double_27_recursive(buf + 14680064, 21);
+    helper_double_sse_27_recursive(buf + 0, 21);
+    helper_double_sse_27_recursive(buf + 2097152, 21);
+    helper_double_sse_27_recursive(buf + 4194304, 21);
+    helper_double_sse_27_recursive(buf + 6291456, 21);
+    helper_double_sse_27_recursive(buf + 8388608, 21);
+    helper_double_sse_27_recursive(buf + 10485760, 21);
+    helper_double_sse_27_recursive(buf + 12582912, 21);
+    helper_double_sse_27_recursive(buf + 14680064, 21);
     for (int j = 0; j < 16777216; j += 16777216) {
       for (int k = 0; k < 2097152; k += 2) {
         __asm__ volatile (
@@ -23714,14 +23748,14 @@ void helper_double_27_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 27) {
-    helper_double_27_recursive(buf + 0, 24);
-    helper_double_27_recursive(buf + 16777216, 24);
-    helper_double_27_recursive(buf + 33554432, 24);
-    helper_double_27_recursive(buf + 50331648, 24);
-    helper_double_27_recursive(buf + 67108864, 24);
-    helper_double_27_recursive(buf + 83886080, 24);
-    helper_double_27_recursive(buf + 100663296, 24);
-    helper_double_27_recursive(buf + 117440512, 24);
+    helper_double_sse_27_recursive(buf + 0, 24);
+    helper_double_sse_27_recursive(buf + 16777216, 24);
+    helper_double_sse_27_recursive(buf + 33554432, 24);
+    helper_double_sse_27_recursive(buf + 50331648, 24);
+    helper_double_sse_27_recursive(buf + 67108864, 24);
+    helper_double_sse_27_recursive(buf + 83886080, 24);
+    helper_double_sse_27_recursive(buf + 100663296, 24);
+    helper_double_sse_27_recursive(buf + 117440512, 24);
     for (int j = 0; j < 134217728; j += 134217728) {
       for (int k = 0; k < 16777216; k += 2) {
         __asm__ volatile (
@@ -23796,12 +23830,12 @@ void helper_double_27_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_27(double *buf);
-void helper_double_27(double *buf) {
-  helper_double_27_recursive(buf, 27);
+FHT_TARGET("sse4.1") void helper_double_sse_27(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_27(double *buf) {
+  helper_double_sse_27_recursive(buf, 27);
 }
-void helper_double_28_recursive(double *buf, int depth);
-void helper_double_28_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_28_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_28_recursive(double *buf, int depth) {
   if (depth == 14) {
     for (int j = 0; j < 16384; j += 16) {
       for (int k = 0; k < 2; k += 2) {
@@ -24153,14 +24187,14 @@ void helper_double_28_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 17) {
-    helper_double_28_recursive(buf + 0, 14);
-    helper_double_28_recursive(buf + 16384, 14);
-    helper_double_28_recursive(buf + 32768, 14);
-    helper_double_28_recursive(buf + 49152, 14);
-    helper_double_28_recursive(buf + 65536, 14);
-    helper_double_28_recursive(buf + 81920, 14);
-    helper_double_28_recursive(buf + 98304, 14);
-    helper_double_28_recursive(buf + 114688, 14);
+    helper_double_sse_28_recursive(buf + 0, 14);
+    helper_double_sse_28_recursive(buf + 16384, 14);
+    helper_double_sse_28_recursive(buf + 32768, 14);
+    helper_double_sse_28_recursive(buf + 49152, 14);
+    helper_double_sse_28_recursive(buf + 65536, 14);
+    helper_double_sse_28_recursive(buf + 81920, 14);
+    helper_double_sse_28_recursive(buf + 98304, 14);
+    helper_double_sse_28_recursive(buf + 114688, 14);
     for (int j = 0; j < 131072; j += 131072) {
       for (int k = 0; k < 16384; k += 2) {
         __asm__ volatile (
@@ -24235,14 +24269,14 @@ void helper_double_28_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 20) {
-    helper_double_28_recursive(buf + 0, 17);
-    helper_double_28_recursive(buf + 131072, 17);
-    helper_double_28_recursive(buf + 262144, 17);
-    helper_double_28_recursive(buf + 393216, 17);
-    helper_double_28_recursive(buf + 524288, 17);
-    helper_double_28_recursive(buf + 655360, 17);
-    helper_double_28_recursive(buf + 786432, 17);
-    helper_double_28_recursive(buf + 917504, 17);
+    helper_double_sse_28_recursive(buf + 0, 17);
+    helper_double_sse_28_recursive(buf + 131072, 17);
+    helper_double_sse_28_recursive(buf + 262144, 17);
+    helper_double_sse_28_recursive(buf + 393216, 17);
+    helper_double_sse_28_recursive(buf + 524288, 17);
+    helper_double_sse_28_recursive(buf + 655360, 17);
+    helper_double_sse_28_recursive(buf + 786432, 17);
+    helper_double_sse_28_recursive(buf + 917504, 17);
     for (int j = 0; j < 1048576; j += 1048576) {
       for (int k = 0; k < 131072; k += 2) {
         __asm__ volatile (
@@ -24317,14 +24351,14 @@ void helper_double_28_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 23) {
-    helper_double_28_recursive(buf + 0, 20);
-    helper_double_28_recursive(buf + 1048576, 20);
-    helper_double_28_recursive(buf + 2097152, 20);
-    helper_double_28_recursive(buf + 3145728, 20);
-    helper_double_28_recursive(buf + 4194304, 20);
-    helper_double_28_recursive(buf + 5242880, 20);
-    helper_double_28_recursive(buf + 6291456, 20);
-    helper_double_28_recursive(buf + 7340032, 20);
+    helper_double_sse_28_recursive(buf + 0, 20);
+    helper_double_sse_28_recursive(buf + 1048576, 20);
+    helper_double_sse_28_recursive(buf + 2097152, 20);
+    helper_double_sse_28_recursive(buf + 3145728, 20);
+    helper_double_sse_28_recursive(buf + 4194304, 20);
+    helper_double_sse_28_recursive(buf + 5242880, 20);
+    helper_double_sse_28_recursive(buf + 6291456, 20);
+    helper_double_sse_28_recursive(buf + 7340032, 20);
     for (int j = 0; j < 8388608; j += 8388608) {
       for (int k = 0; k < 1048576; k += 2) {
         __asm__ volatile (
@@ -24399,14 +24433,14 @@ void helper_double_28_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 26) {
-    helper_double_28_recursive(buf + 0, 23);
-    helper_double_28_recursive(buf + 8388608, 23);
-    helper_double_28_recursive(buf + 16777216, 23);
-    helper_double_28_recursive(buf + 25165824, 23);
-    helper_double_28_recursive(buf + 33554432, 23);
-    helper_double_28_recursive(buf + 41943040, 23);
-    helper_double_28_recursive(buf + 50331648, 23);
-    helper_double_28_recursive(buf + 58720256, 23);
+    helper_double_sse_28_recursive(buf + 0, 23);
+    helper_double_sse_28_recursive(buf + 8388608, 23);
+    helper_double_sse_28_recursive(buf + 16777216, 23);
+    helper_double_sse_28_recursive(buf + 25165824, 23);
+    helper_double_sse_28_recursive(buf + 33554432, 23);
+    helper_double_sse_28_recursive(buf + 41943040, 23);
+    helper_double_sse_28_recursive(buf + 50331648, 23);
+    helper_double_sse_28_recursive(buf + 58720256, 23);
     for (int j = 0; j < 67108864; j += 67108864) {
       for (int k = 0; k < 8388608; k += 2) {
         __asm__ volatile (
@@ -24481,10 +24515,10 @@ void helper_double_28_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 28) {
-    helper_double_28_recursive(buf + 0, 26);
-    helper_double_28_recursive(buf + 67108864, 26);
-    helper_double_28_recursive(buf + 134217728, 26);
-    helper_double_28_recursive(buf + 201326592, 26);
+    helper_double_sse_28_recursive(buf + 0, 26);
+    helper_double_sse_28_recursive(buf + 67108864, 26);
+    helper_double_sse_28_recursive(buf + 134217728, 26);
+    helper_double_sse_28_recursive(buf + 201326592, 26);
     for (int j = 0; j < 268435456; j += 268435456) {
       for (int k = 0; k < 67108864; k += 2) {
         __asm__ volatile (
@@ -24519,12 +24553,12 @@ void helper_double_28_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_28(double *buf);
-void helper_double_28(double *buf) {
-  helper_double_28_recursive(buf, 28);
+FHT_TARGET("sse4.1") void helper_double_sse_28(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_28(double *buf) {
+  helper_double_sse_28_recursive(buf, 28);
 }
-void helper_double_29_recursive(double *buf, int depth);
-void helper_double_29_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_29_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_29_recursive(double *buf, int depth) {
   if (depth == 9) {
     for (int j = 0; j < 512; j += 16) {
       for (int k = 0; k < 2; k += 2) {
@@ -24750,14 +24784,14 @@ void helper_double_29_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 12) {
-    helper_double_29_recursive(buf + 0, 9);
-    helper_double_29_recursive(buf + 512, 9);
-    helper_double_29_recursive(buf + 1024, 9);
-    helper_double_29_recursive(buf + 1536, 9);
-    helper_double_29_recursive(buf + 2048, 9);
-    helper_double_29_recursive(buf + 2560, 9);
-    helper_double_29_recursive(buf + 3072, 9);
-    helper_double_29_recursive(buf + 3584, 9);
+    helper_double_sse_29_recursive(buf + 0, 9);
+    helper_double_sse_29_recursive(buf + 512, 9);
+    helper_double_sse_29_recursive(buf + 1024, 9);
+    helper_double_sse_29_recursive(buf + 1536, 9);
+    helper_double_sse_29_recursive(buf + 2048, 9);
+    helper_double_sse_29_recursive(buf + 2560, 9);
+    helper_double_sse_29_recursive(buf + 3072, 9);
+    helper_double_sse_29_recursive(buf + 3584, 9);
     for (int j = 0; j < 4096; j += 4096) {
       for (int k = 0; k < 512; k += 2) {
         __asm__ volatile (
@@ -24832,14 +24866,14 @@ void helper_double_29_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_double_29_recursive(buf + 0, 12);
-    helper_double_29_recursive(buf + 4096, 12);
-    helper_double_29_recursive(buf + 8192, 12);
-    helper_double_29_recursive(buf + 12288, 12);
-    helper_double_29_recursive(buf + 16384, 12);
-    helper_double_29_recursive(buf + 20480, 12);
-    helper_double_29_recursive(buf + 24576, 12);
-    helper_double_29_recursive(buf + 28672, 12);
+    helper_double_sse_29_recursive(buf + 0, 12);
+    helper_double_sse_29_recursive(buf + 4096, 12);
+    helper_double_sse_29_recursive(buf + 8192, 12);
+    helper_double_sse_29_recursive(buf + 12288, 12);
+    helper_double_sse_29_recursive(buf + 16384, 12);
+    helper_double_sse_29_recursive(buf + 20480, 12);
+    helper_double_sse_29_recursive(buf + 24576, 12);
+    helper_double_sse_29_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 2) {
         __asm__ volatile (
@@ -24914,14 +24948,14 @@ void helper_double_29_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_double_29_recursive(buf + 0, 15);
-    helper_double_29_recursive(buf + 32768, 15);
-    helper_double_29_recursive(buf + 65536, 15);
-    helper_double_29_recursive(buf + 98304, 15);
-    helper_double_29_recursive(buf + 131072, 15);
-    helper_double_29_recursive(buf + 163840, 15);
-    helper_double_29_recursive(buf + 196608, 15);
-    helper_double_29_recursive(buf + 229376, 15);
+    helper_double_sse_29_recursive(buf + 0, 15);
+    helper_double_sse_29_recursive(buf + 32768, 15);
+    helper_double_sse_29_recursive(buf + 65536, 15);
+    helper_double_sse_29_recursive(buf + 98304, 15);
+    helper_double_sse_29_recursive(buf + 131072, 15);
+    helper_double_sse_29_recursive(buf + 163840, 15);
+    helper_double_sse_29_recursive(buf + 196608, 15);
+    helper_double_sse_29_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 2) {
         __asm__ volatile (
@@ -24996,14 +25030,14 @@ void helper_double_29_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_double_29_recursive(buf + 0, 18);
-    helper_double_29_recursive(buf + 262144, 18);
-    helper_double_29_recursive(buf + 524288, 18);
-    helper_double_29_recursive(buf + 786432, 18);
-    helper_double_29_recursive(buf + 1048576, 18);
-    helper_double_29_recursive(buf + 1310720, 18);
-    helper_double_29_recursive(buf + 1572864, 18);
-    helper_double_29_recursive(buf + 1835008, 18);
+    helper_double_sse_29_recursive(buf + 0, 18);
+    helper_double_sse_29_recursive(buf + 262144, 18);
+    helper_double_sse_29_recursive(buf + 524288, 18);
+    helper_double_sse_29_recursive(buf + 786432, 18);
+    helper_double_sse_29_recursive(buf + 1048576, 18);
+    helper_double_sse_29_recursive(buf + 1310720, 18);
+    helper_double_sse_29_recursive(buf + 1572864, 18);
+    helper_double_sse_29_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 2) {
         __asm__ volatile (
@@ -25078,14 +25112,14 @@ void helper_double_29_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 24) {
-    helper_double_29_recursive(buf + 0, 21);
-    helper_double_29_recursive(buf + 2097152, 21);
-    helper_double_29_recursive(buf + 4194304, 21);
-    helper_double_29_recursive(buf + 6291456, 21);
-    helper_double_29_recursive(buf + 8388608, 21);
-    helper_double_29_recursive(buf + 10485760, 21);
-    helper_double_29_recursive(buf + 12582912, 21);
-    helper_double_29_recursive(buf + 14680064, 21);
+    helper_double_sse_29_recursive(buf + 0, 21);
+    helper_double_sse_29_recursive(buf + 2097152, 21);
+    helper_double_sse_29_recursive(buf + 4194304, 21);
+    helper_double_sse_29_recursive(buf + 6291456, 21);
+    helper_double_sse_29_recursive(buf + 8388608, 21);
+    helper_double_sse_29_recursive(buf + 10485760, 21);
+    helper_double_sse_29_recursive(buf + 12582912, 21);
+    helper_double_sse_29_recursive(buf + 14680064, 21);
     for (int j = 0; j < 16777216; j += 16777216) {
       for (int k = 0; k < 2097152; k += 2) {
         __asm__ volatile (
@@ -25160,14 +25194,14 @@ void helper_double_29_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 27) {
-    helper_double_29_recursive(buf + 0, 24);
-    helper_double_29_recursive(buf + 16777216, 24);
-    helper_double_29_recursive(buf + 33554432, 24);
-    helper_double_29_recursive(buf + 50331648, 24);
-    helper_double_29_recursive(buf + 67108864, 24);
-    helper_double_29_recursive(buf + 83886080, 24);
-    helper_double_29_recursive(buf + 100663296, 24);
-    helper_double_29_recursive(buf + 117440512, 24);
+    helper_double_sse_29_recursive(buf + 0, 24);
+    helper_double_sse_29_recursive(buf + 16777216, 24);
+    helper_double_sse_29_recursive(buf + 33554432, 24);
+    helper_double_sse_29_recursive(buf + 50331648, 24);
+    helper_double_sse_29_recursive(buf + 67108864, 24);
+    helper_double_sse_29_recursive(buf + 83886080, 24);
+    helper_double_sse_29_recursive(buf + 100663296, 24);
+    helper_double_sse_29_recursive(buf + 117440512, 24);
     for (int j = 0; j < 134217728; j += 134217728) {
       for (int k = 0; k < 16777216; k += 2) {
         __asm__ volatile (
@@ -25242,10 +25276,10 @@ void helper_double_29_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 29) {
-    helper_double_29_recursive(buf + 0, 27);
-    helper_double_29_recursive(buf + 134217728, 27);
-    helper_double_29_recursive(buf + 268435456, 27);
-    helper_double_29_recursive(buf + 402653184, 27);
+    helper_double_sse_29_recursive(buf + 0, 27);
+    helper_double_sse_29_recursive(buf + 134217728, 27);
+    helper_double_sse_29_recursive(buf + 268435456, 27);
+    helper_double_sse_29_recursive(buf + 402653184, 27);
     for (int j = 0; j < 536870912; j += 536870912) {
       for (int k = 0; k < 134217728; k += 2) {
         __asm__ volatile (
@@ -25280,12 +25314,12 @@ void helper_double_29_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_29(double *buf);
-void helper_double_29(double *buf) {
-  helper_double_29_recursive(buf, 29);
+FHT_TARGET("sse4.1") void helper_double_sse_29(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_29(double *buf) {
+  helper_double_sse_29_recursive(buf, 29);
 }
-void helper_double_30_recursive(double *buf, int depth);
-void helper_double_30_recursive(double *buf, int depth) {
+FHT_TARGET("sse4.1") void helper_double_sse_30_recursive(double *buf, int depth);
+FHT_TARGET("sse4.1") void helper_double_sse_30_recursive(double *buf, int depth) {
   if (depth == 3) {
     for (int j = 0; j < 8; j += 8) {
       for (int k = 0; k < 2; k += 2) {
@@ -25345,14 +25379,14 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 6) {
-    helper_double_30_recursive(buf + 0, 3);
-    helper_double_30_recursive(buf + 8, 3);
-    helper_double_30_recursive(buf + 16, 3);
-    helper_double_30_recursive(buf + 24, 3);
-    helper_double_30_recursive(buf + 32, 3);
-    helper_double_30_recursive(buf + 40, 3);
-    helper_double_30_recursive(buf + 48, 3);
-    helper_double_30_recursive(buf + 56, 3);
+    helper_double_sse_30_recursive(buf + 0, 3);
+    helper_double_sse_30_recursive(buf + 8, 3);
+    helper_double_sse_30_recursive(buf + 16, 3);
+    helper_double_sse_30_recursive(buf + 24, 3);
+    helper_double_sse_30_recursive(buf + 32, 3);
+    helper_double_sse_30_recursive(buf + 40, 3);
+    helper_double_sse_30_recursive(buf + 48, 3);
+    helper_double_sse_30_recursive(buf + 56, 3);
     for (int j = 0; j < 64; j += 64) {
       for (int k = 0; k < 8; k += 2) {
         __asm__ volatile (
@@ -25427,14 +25461,14 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 9) {
-    helper_double_30_recursive(buf + 0, 6);
-    helper_double_30_recursive(buf + 64, 6);
-    helper_double_30_recursive(buf + 128, 6);
-    helper_double_30_recursive(buf + 192, 6);
-    helper_double_30_recursive(buf + 256, 6);
-    helper_double_30_recursive(buf + 320, 6);
-    helper_double_30_recursive(buf + 384, 6);
-    helper_double_30_recursive(buf + 448, 6);
+    helper_double_sse_30_recursive(buf + 0, 6);
+    helper_double_sse_30_recursive(buf + 64, 6);
+    helper_double_sse_30_recursive(buf + 128, 6);
+    helper_double_sse_30_recursive(buf + 192, 6);
+    helper_double_sse_30_recursive(buf + 256, 6);
+    helper_double_sse_30_recursive(buf + 320, 6);
+    helper_double_sse_30_recursive(buf + 384, 6);
+    helper_double_sse_30_recursive(buf + 448, 6);
     for (int j = 0; j < 512; j += 512) {
       for (int k = 0; k < 64; k += 2) {
         __asm__ volatile (
@@ -25509,14 +25543,14 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 12) {
-    helper_double_30_recursive(buf + 0, 9);
-    helper_double_30_recursive(buf + 512, 9);
-    helper_double_30_recursive(buf + 1024, 9);
-    helper_double_30_recursive(buf + 1536, 9);
-    helper_double_30_recursive(buf + 2048, 9);
-    helper_double_30_recursive(buf + 2560, 9);
-    helper_double_30_recursive(buf + 3072, 9);
-    helper_double_30_recursive(buf + 3584, 9);
+    helper_double_sse_30_recursive(buf + 0, 9);
+    helper_double_sse_30_recursive(buf + 512, 9);
+    helper_double_sse_30_recursive(buf + 1024, 9);
+    helper_double_sse_30_recursive(buf + 1536, 9);
+    helper_double_sse_30_recursive(buf + 2048, 9);
+    helper_double_sse_30_recursive(buf + 2560, 9);
+    helper_double_sse_30_recursive(buf + 3072, 9);
+    helper_double_sse_30_recursive(buf + 3584, 9);
     for (int j = 0; j < 4096; j += 4096) {
       for (int k = 0; k < 512; k += 2) {
         __asm__ volatile (
@@ -25591,14 +25625,14 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 15) {
-    helper_double_30_recursive(buf + 0, 12);
-    helper_double_30_recursive(buf + 4096, 12);
-    helper_double_30_recursive(buf + 8192, 12);
-    helper_double_30_recursive(buf + 12288, 12);
-    helper_double_30_recursive(buf + 16384, 12);
-    helper_double_30_recursive(buf + 20480, 12);
-    helper_double_30_recursive(buf + 24576, 12);
-    helper_double_30_recursive(buf + 28672, 12);
+    helper_double_sse_30_recursive(buf + 0, 12);
+    helper_double_sse_30_recursive(buf + 4096, 12);
+    helper_double_sse_30_recursive(buf + 8192, 12);
+    helper_double_sse_30_recursive(buf + 12288, 12);
+    helper_double_sse_30_recursive(buf + 16384, 12);
+    helper_double_sse_30_recursive(buf + 20480, 12);
+    helper_double_sse_30_recursive(buf + 24576, 12);
+    helper_double_sse_30_recursive(buf + 28672, 12);
     for (int j = 0; j < 32768; j += 32768) {
       for (int k = 0; k < 4096; k += 2) {
         __asm__ volatile (
@@ -25673,14 +25707,14 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 18) {
-    helper_double_30_recursive(buf + 0, 15);
-    helper_double_30_recursive(buf + 32768, 15);
-    helper_double_30_recursive(buf + 65536, 15);
-    helper_double_30_recursive(buf + 98304, 15);
-    helper_double_30_recursive(buf + 131072, 15);
-    helper_double_30_recursive(buf + 163840, 15);
-    helper_double_30_recursive(buf + 196608, 15);
-    helper_double_30_recursive(buf + 229376, 15);
+    helper_double_sse_30_recursive(buf + 0, 15);
+    helper_double_sse_30_recursive(buf + 32768, 15);
+    helper_double_sse_30_recursive(buf + 65536, 15);
+    helper_double_sse_30_recursive(buf + 98304, 15);
+    helper_double_sse_30_recursive(buf + 131072, 15);
+    helper_double_sse_30_recursive(buf + 163840, 15);
+    helper_double_sse_30_recursive(buf + 196608, 15);
+    helper_double_sse_30_recursive(buf + 229376, 15);
     for (int j = 0; j < 262144; j += 262144) {
       for (int k = 0; k < 32768; k += 2) {
         __asm__ volatile (
@@ -25755,14 +25789,14 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 21) {
-    helper_double_30_recursive(buf + 0, 18);
-    helper_double_30_recursive(buf + 262144, 18);
-    helper_double_30_recursive(buf + 524288, 18);
-    helper_double_30_recursive(buf + 786432, 18);
-    helper_double_30_recursive(buf + 1048576, 18);
-    helper_double_30_recursive(buf + 1310720, 18);
-    helper_double_30_recursive(buf + 1572864, 18);
-    helper_double_30_recursive(buf + 1835008, 18);
+    helper_double_sse_30_recursive(buf + 0, 18);
+    helper_double_sse_30_recursive(buf + 262144, 18);
+    helper_double_sse_30_recursive(buf + 524288, 18);
+    helper_double_sse_30_recursive(buf + 786432, 18);
+    helper_double_sse_30_recursive(buf + 1048576, 18);
+    helper_double_sse_30_recursive(buf + 1310720, 18);
+    helper_double_sse_30_recursive(buf + 1572864, 18);
+    helper_double_sse_30_recursive(buf + 1835008, 18);
     for (int j = 0; j < 2097152; j += 2097152) {
       for (int k = 0; k < 262144; k += 2) {
         __asm__ volatile (
@@ -25837,14 +25871,14 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 24) {
-    helper_double_30_recursive(buf + 0, 21);
-    helper_double_30_recursive(buf + 2097152, 21);
-    helper_double_30_recursive(buf + 4194304, 21);
-    helper_double_30_recursive(buf + 6291456, 21);
-    helper_double_30_recursive(buf + 8388608, 21);
-    helper_double_30_recursive(buf + 10485760, 21);
-    helper_double_30_recursive(buf + 12582912, 21);
-    helper_double_30_recursive(buf + 14680064, 21);
+    helper_double_sse_30_recursive(buf + 0, 21);
+    helper_double_sse_30_recursive(buf + 2097152, 21);
+    helper_double_sse_30_recursive(buf + 4194304, 21);
+    helper_double_sse_30_recursive(buf + 6291456, 21);
+    helper_double_sse_30_recursive(buf + 8388608, 21);
+    helper_double_sse_30_recursive(buf + 10485760, 21);
+    helper_double_sse_30_recursive(buf + 12582912, 21);
+    helper_double_sse_30_recursive(buf + 14680064, 21);
     for (int j = 0; j < 16777216; j += 16777216) {
       for (int k = 0; k < 2097152; k += 2) {
         __asm__ volatile (
@@ -25919,14 +25953,14 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 27) {
-    helper_double_30_recursive(buf + 0, 24);
-    helper_double_30_recursive(buf + 16777216, 24);
-    helper_double_30_recursive(buf + 33554432, 24);
-    helper_double_30_recursive(buf + 50331648, 24);
-    helper_double_30_recursive(buf + 67108864, 24);
-    helper_double_30_recursive(buf + 83886080, 24);
-    helper_double_30_recursive(buf + 100663296, 24);
-    helper_double_30_recursive(buf + 117440512, 24);
+    helper_double_sse_30_recursive(buf + 0, 24);
+    helper_double_sse_30_recursive(buf + 16777216, 24);
+    helper_double_sse_30_recursive(buf + 33554432, 24);
+    helper_double_sse_30_recursive(buf + 50331648, 24);
+    helper_double_sse_30_recursive(buf + 67108864, 24);
+    helper_double_sse_30_recursive(buf + 83886080, 24);
+    helper_double_sse_30_recursive(buf + 100663296, 24);
+    helper_double_sse_30_recursive(buf + 117440512, 24);
     for (int j = 0; j < 134217728; j += 134217728) {
       for (int k = 0; k < 16777216; k += 2) {
         __asm__ volatile (
@@ -26001,14 +26035,14 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
   if (depth == 30) {
-    helper_double_30_recursive(buf + 0, 27);
-    helper_double_30_recursive(buf + 134217728, 27);
-    helper_double_30_recursive(buf + 268435456, 27);
-    helper_double_30_recursive(buf + 402653184, 27);
-    helper_double_30_recursive(buf + 536870912, 27);
-    helper_double_30_recursive(buf + 671088640, 27);
-    helper_double_30_recursive(buf + 805306368, 27);
-    helper_double_30_recursive(buf + 939524096, 27);
+    helper_double_sse_30_recursive(buf + 0, 27);
+    helper_double_sse_30_recursive(buf + 134217728, 27);
+    helper_double_sse_30_recursive(buf + 268435456, 27);
+    helper_double_sse_30_recursive(buf + 402653184, 27);
+    helper_double_sse_30_recursive(buf + 536870912, 27);
+    helper_double_sse_30_recursive(buf + 671088640, 27);
+    helper_double_sse_30_recursive(buf + 805306368, 27);
+    helper_double_sse_30_recursive(buf + 939524096, 27);
     for (int j = 0; j < 1073741824; j += 1073741824) {
       for (int k = 0; k < 134217728; k += 2) {
         __asm__ volatile (
@@ -26083,133 +26117,167 @@ void helper_double_30_recursive(double *buf, int depth) {
     return;
   }
 }
-void helper_double_30(double *buf);
-void helper_double_30(double *buf) {
-  helper_double_30_recursive(buf, 30);
+FHT_TARGET("sse4.1") void helper_double_sse_30(double *buf);
+FHT_TARGET("sse4.1") void helper_double_sse_30(double *buf) {
+  helper_double_sse_30_recursive(buf, 30);
 }
-int fht_double(double *buf, int log_n) {
+FHT_TARGET("sse4.1") int fht_double_sse(double *buf, int log_n);
+FHT_TARGET("sse4.1") int fht_double_sse(double *buf, int log_n) {
   if (log_n == 0) {
     return 0;
   }
   if (log_n == 1) {
-    helper_double_1(buf);
+    helper_double_sse_1(buf);
     return 0;
   }
   if (log_n == 2) {
-    helper_double_2(buf);
+    helper_double_sse_2(buf);
     return 0;
   }
   if (log_n == 3) {
-    helper_double_3(buf);
+    helper_double_sse_3(buf);
     return 0;
   }
   if (log_n == 4) {
-    helper_double_4(buf);
+    helper_double_sse_4(buf);
     return 0;
   }
   if (log_n == 5) {
-    helper_double_5(buf);
+    helper_double_sse_5(buf);
     return 0;
   }
   if (log_n == 6) {
-    helper_double_6(buf);
+    helper_double_sse_6(buf);
     return 0;
   }
   if (log_n == 7) {
-    helper_double_7(buf);
+    helper_double_sse_7(buf);
     return 0;
   }
   if (log_n == 8) {
-    helper_double_8(buf);
+    helper_double_sse_8(buf);
     return 0;
   }
   if (log_n == 9) {
-    helper_double_9(buf);
+    helper_double_sse_9(buf);
     return 0;
   }
   if (log_n == 10) {
-    helper_double_10(buf);
+    helper_double_sse_10(buf);
     return 0;
   }
   if (log_n == 11) {
-    helper_double_11(buf);
+    helper_double_sse_11(buf);
     return 0;
   }
   if (log_n == 12) {
-    helper_double_12(buf);
+    helper_double_sse_12(buf);
     return 0;
   }
   if (log_n == 13) {
-    helper_double_13(buf);
+    helper_double_sse_13(buf);
     return 0;
   }
   if (log_n == 14) {
-    helper_double_14(buf);
+    helper_double_sse_14(buf);
     return 0;
   }
   if (log_n == 15) {
-    helper_double_15(buf);
+    helper_double_sse_15(buf);
     return 0;
   }
   if (log_n == 16) {
-    helper_double_16(buf);
+    helper_double_sse_16(buf);
     return 0;
   }
   if (log_n == 17) {
-    helper_double_17(buf);
+    helper_double_sse_17(buf);
     return 0;
   }
   if (log_n == 18) {
-    helper_double_18(buf);
+    helper_double_sse_18(buf);
     return 0;
   }
   if (log_n == 19) {
-    helper_double_19(buf);
+    helper_double_sse_19(buf);
     return 0;
   }
   if (log_n == 20) {
-    helper_double_20(buf);
+    helper_double_sse_20(buf);
     return 0;
   }
   if (log_n == 21) {
-    helper_double_21(buf);
+    helper_double_sse_21(buf);
     return 0;
   }
   if (log_n == 22) {
-    helper_double_22(buf);
+    helper_double_sse_22(buf);
     return 0;
   }
   if (log_n == 23) {
-    helper_double_23(buf);
+    helper_double_sse_23(buf);
     return 0;
   }
   if (log_n == 24) {
-    helper_double_24(buf);
+    helper_double_sse_24(buf);
     return 0;
   }
   if (log_n == 25) {
-    helper_double_25(buf);
+    helper_double_sse_25(buf);
     return 0;
   }
   if (log_n == 26) {
-    helper_double_26(buf);
+    helper_double_sse_26(buf);
     return 0;
   }
   if (log_n == 27) {
-    helper_double_27(buf);
+    helper_double_sse_27(buf);
     return 0;
   }
   if (log_n == 28) {
-    helper_double_28(buf);
+    helper_double_sse_28(buf);
     return 0;
   }
   if (log_n == 29) {
-    helper_double_29(buf);
+    helper_double_sse_29(buf);
     return 0;
   }
   if (log_n == 30) {
-    helper_double_30(buf);
+    helper_double_sse_30(buf);
     return 0;
   }
   return 1;
 }
+static void (*const fht_double_sse_helpers[31])(double *) = {
+  0,
+  helper_double_sse_1,
+  helper_double_sse_2,
+  helper_double_sse_3,
+  helper_double_sse_4,
+  helper_double_sse_5,
+  helper_double_sse_6,
+  helper_double_sse_7,
+  helper_double_sse_8,
+  helper_double_sse_9,
+  helper_double_sse_10,
+  helper_double_sse_11,
+  helper_double_sse_12,
+  helper_double_sse_13,
+  helper_double_sse_14,
+  helper_double_sse_15,
+  helper_double_sse_16,
+  helper_double_sse_17,
+  helper_double_sse_18,
+  helper_double_sse_19,
+  helper_double_sse_20,
+  helper_double_sse_21,
+  helper_double_sse_22,
+  helper_double_sse_23,
+  helper_double_sse_24,
+  helper_double_sse_25,
+  helper_double_sse_26,
+  helper_double_sse_27,
+  helper_double_sse_28,
+  helper_double_sse_29,
+  helper_double_sse_30,
+};
@@ -1,3 +1,4 @@
+import argparse
 import csv
 import os
 import sys
@@ -259,6 +260,71 @@ def double_sse_1_etc(from_register_0,
     return res
 
 
+# The in-register steps for AVX-512 have the same shape: permute the register
+# so that every element meets its partner, compute the sums everywhere and
+# overwrite the upper half of every pair with the differences (the mask
+# operand selects the upper halves).
+def avx512_step(name, permutation, add_instruction, sub_instruction,
+                move_instruction, register, aux_registers, ident, mask):
+    if not is_distinct(aux_registers):
+        raise Exception('auxiliary registers must be distinct')
+    if register in aux_registers:
+        raise Exception(
+            'the main register can\'t be one of the auxiliary ones')
+    if len(aux_registers) < 2:
+        raise Exception('%s needs at least two auxiliary registers' % name)
+    if mask is None:
+        raise Exception('%s needs a mask operand' % name)
+    res = ident + '"%s, %%%%%s, %%%%%s\\n"\n' % (permutation, register,
+                                                 aux_registers[0])
+    res += ident + '"%s %%%%%s, %%%%%s, %%%%%s\\n"\n' % (
+        add_instruction, aux_registers[0], register, aux_registers[1])
+    res += ident + '"%s %%%%%s, %%%%%s, %%%%%s%%{%s%%}\\n"\n' % (
+        sub_instruction, register, aux_registers[0], aux_registers[1], mask)
+    res += ident + '"%s %%%%%s, %%%%%s\\n"\n' % (move_instruction,
+                                                 aux_registers[1], register)
+    return res
+
+
+def float_avx512_0(register, aux_registers, ident='', mask=None):
+    return avx512_step('float_avx512_0', 'vpermilps $177', 'vaddps', 'vsubps',
+                       'vmovaps', register, aux_registers, ident, mask)
+
+
+def float_avx512_1(register, aux_registers, ident='', mask=None):
+    return avx512_step('float_avx512_1', 'vpermilps $78', 'vaddps', 'vsubps',
+                       'vmovaps', register, aux_registers, ident, mask)
+
+
+def float_avx512_2(register, aux_registers, ident='', mask=None):
+    return avx512_step('float_avx512_2', 'vshuff32x4 $177, %%%%%s' % register,
+                       'vaddps', 'vsubps', 'vmovaps', register, aux_registers,
+                       ident, mask)
+
+
+def float_avx512_3(register, aux_registers, ident='', mask=None):
+    return avx512_step('float_avx512_3', 'vshuff32x4 $78, %%%%%s' % register,
+                       'vaddps', 'vsubps', 'vmovaps', register, aux_registers,
+                       ident, mask)
+
+
+def double_avx512_0(register, aux_registers, ident='', mask=None):
+    return avx512_step('double_avx512_0', 'vpermilpd $85', 'vaddpd', 'vsubpd',
+                       'vmovapd', register, aux_registers, ident, mask)
+
+
+def double_avx512_1(register, aux_registers, ident='', mask=None):
+    return avx512_step('double_avx512_1', 'vshuff64x2 $177, %%%%%s' % register,
+                       'vaddpd', 'vsubpd', 'vmovapd', register, aux_registers,
+                       ident, mask)
+
+
+def double_avx512_2(register, aux_registers, ident='', mask=None):
+    return avx512_step('double_avx512_2', 'vshuff64x2 $78, %%%%%s' % register,
+                       'vaddpd', 'vsubpd', 'vmovapd', register, aux_registers,
+                       ident, mask)
+
+
 def plain_step(type_name, buf_name, log_n, it, ident=''):
     if log_n <= 0:
         raise Exception("log_n must be positive")
@@ -288,7 +354,9 @@ def composite_step(buf_name,
                    move_instruction,
                    special_steps,
                    main_step,
-                   ident=''):
+                   ident='',
+                   masks=None,
+                   element_size=None):
     if log_n < log_w:
         raise Exception('need at least %d elements' % (1 << log_w))
     num_registers = len(registers)
@@ -309,18 +377,47 @@ def composite_step(buf_name,
         else:
             output_registers.append(registers[i])
     clobber = ', '.join(['"%%%s"' % x for x in registers])
+    # If element_size is given, all loads and stores of one iteration use a
+    # single address operand with constant displacements (there are not enough
+    # general purpose registers for one address per vector register with
+    # AVX-512). Displacements are 32-bit, so huge strides still need one
+    # address per vector register. The masks of the in-register steps (if
+    # any) are passed as "Yk" operands after the addresses, so the compiler
+    # loads them once outside of the loop.
+    use_displacements = element_size is not None and (
+        ((1 << num_nontrivial_levels) - 1) *
+        (1 << (to_it - num_nontrivial_levels)) * element_size < 1 << 31)
+    if (element_size is not None and not use_displacements and
+            1 << num_nontrivial_levels > 4):
+        raise Exception('not enough general purpose registers')
+    num_addresses = 1
+    if num_nontrivial_levels > 0 and not use_displacements:
+        num_addresses = 1 << num_nontrivial_levels
+    mask_operands = {}
+    mask_inputs = ''
+    if masks is not None:
+        for it in range(from_it, min(to_it, log_w)):
+            mask_operands[it] = '%%%d' % (num_addresses + len(mask_operands))
+            mask_inputs += ', "Yk"((unsigned short)%d)' % masks[it]
+
+    def special_step(it, register, aux_registers, ident):
+        if masks is None:
+            return special_steps[it](register, aux_registers, ident)
+        return special_steps[it](register, aux_registers, ident,
+                                 mask_operands[it])
+
     if num_nontrivial_levels == 0:
         res = ident + 'for (int j = 0; j < %d; j += %d) {\n' % (n, 1 << log_w)
         res += ident + '  __asm__ volatile (\n'
         res += ident + '    "%s (%%0), %%%%%s\\n"\n' % (move_instruction,
                                                         input_registers[0])
         for it in range(from_it, to_it):
-            res += special_steps[it](input_registers[0], output_registers,
-                                     ident + '    ')
+            res += special_step(it, input_registers[0], output_registers,
+                                ident + '    ')
         res += ident + '    "%s %%%%%s, (%%0)\\n"\n' % (move_instruction,
                                                         input_registers[0])
-        res += ident + '    :: "r"(%s + j) : %s, "memory"\n' % (buf_name,
-                                                                clobber)
+        res += ident + '    :: "r"(%s + j)%s : %s, "memory"\n' % (
+            buf_name, mask_inputs, clobber)
         res += ident + '  );\n'
         res += ident + '}\n'
         return res
@@ -332,13 +429,22 @@ def composite_step(buf_name,
         subcube.append('j + k + ' + str(l * (1 <<
                                              (to_it - num_nontrivial_levels))))
     res += ident + '    __asm__ volatile (\n'
+
+    def address(l):
+        if not use_displacements:
+            return '(%%%d)' % l
+        offset = l * (1 << (to_it - num_nontrivial_levels)) * element_size
+        if offset == 0:
+            return '(%0)'
+        return '%d(%%0)' % offset
+
     for l in range(1 << num_nontrivial_levels):
-        res += ident + '      "%s (%%%d), %%%%%s\\n"\n' % (move_instruction, l,
-                                                           input_registers[l])
+        res += ident + '      "%s %s, %%%%%s\\n"\n' % (
+            move_instruction, address(l), input_registers[l])
     for it in range(from_it, log_w):
         for ii in range(1 << num_nontrivial_levels):
-            res += special_steps[it](input_registers[ii], output_registers,
-                                     ident + '      ')
+            res += special_step(it, input_registers[ii], output_registers,
+                                ident + '      ')
     for it in range(num_nontrivial_levels):
         for ii in range(0, 1 << num_nontrivial_levels, 1 << (it + 1)):
             for jj in range(1 << it):
@@ -351,10 +457,11 @@ def composite_step(buf_name,
         input_registers = output_registers
         output_registers = tmp
     for l in range(1 << num_nontrivial_levels):
-        res += ident + '      "%s %%%%%s, (%%%d)\\n"\n' % (
-            move_instruction, input_registers[l], l)
-    res += ident + '      :: %s : %s, "memory"\n' % (
-        ', '.join(['"r"(%s + %s)' % (buf_name, x) for x in subcube]), clobber)
+        res += ident + '      "%s %%%%%s, %s\\n"\n' % (
+            move_instruction, input_registers[l], address(l))
+    res += ident + '      :: %s%s : %s, "memory"\n' % (
+        ', '.join(['"r"(%s + %s)' % (buf_name, x)
+                   for x in subcube[:num_addresses]]), mask_inputs, clobber)
     res += ident + '    );\n'
     res += ident + '  }\n'
     res += ident + '}\n'
@@ -386,9 +493,44 @@ def double_sse_composite_step(buf_name, log_n, from_it, to_it, ident=''):
                           [double_sse_0], double_sse_1_etc, ident)
 
 
-def plain_unmerged(type_name, log_n):
-    signature = "static inline void helper_%s_%d(%s *buf)" % (type_name, log_n,
-                                                       type_name)
+def float_avx512_composite_step(buf_name, log_n, from_it, to_it, ident=''):
+    return composite_step(buf_name, log_n, from_it, to_it, 4,
+                          ['zmm%d' % x for x in range(32)], 'vmovups', [
+                              float_avx512_0, float_avx512_1, float_avx512_2,
+                              float_avx512_3
+                          ], float_avx_3_etc, ident,
+                          [0xAAAA, 0xCCCC, 0xF0F0, 0xFF00], 4)
+
+
+def double_avx512_composite_step(buf_name, log_n, from_it, to_it, ident=''):
+    return composite_step(buf_name, log_n, from_it, to_it, 3,
+                          ['zmm%d' % x for x in range(32)], 'vmovupd',
+                          [double_avx512_0, double_avx512_1, double_avx512_2],
+                          double_avx_2_etc, ident, [0xAA, 0xCC, 0xF0], 8)
+
+
+# For every instruction set: the target passed to FHT_TARGET (which lets
+# fht_impl.h compile the kernels for all instruction sets into one binary and
+# pick one at runtime) and the composite steps for float and double.
+isas = {
+    'sse': ('sse4.1', float_sse_composite_step, double_sse_composite_step),
+    'avx': ('avx', float_avx_composite_step, double_avx_composite_step),
+    'avx512': ('avx512f', float_avx512_composite_step,
+               double_avx512_composite_step)
+}
+
+
+def helper_name(type_name, isa, log_n):
+    return 'helper_%s_%s_%d' % (type_name, isa, log_n)
+
+
+def target(isa):
+    return 'FHT_TARGET("%s")' % isas[isa][0]
+
+
+def plain_unmerged(type_name, log_n, isa):
+    signature = '%s static inline void %s(%s *buf)' % (
+        target(isa), helper_name(type_name, isa, log_n), type_name)
     res = '%s;\n' % signature
     res += '%s {\n' % signature
     for i in range(log_n):
@@ -397,13 +539,13 @@ def plain_unmerged(type_name, log_n):
     return res
 
 
-def greedy_merged(type_name, log_n, composite_step):
+def greedy_merged(type_name, log_n, composite_step, isa):
     try:
         composite_step('buf', log_n, 0, 0)
     except Exception:
         raise Exception('log_n is too small: %d' % log_n)
-    signature = 'static inline void helper_%s_%d(%s *buf)' % (type_name, log_n,
-                                                       type_name)
+    signature = '%s static inline void %s(%s *buf)' % (
+        target(isa), helper_name(type_name, isa, log_n), type_name)
     res = '%s;\n' % signature
     res += '%s {\n' % signature
     cur_it = 0
@@ -422,16 +564,16 @@ def greedy_merged(type_name, log_n, composite_step):
     return res
 
 
-def greedy_merged_recursive(type_name, log_n, threshold_step, composite_step):
+def greedy_merged_recursive(type_name, log_n, threshold_step, composite_step,
+                            isa):
     if threshold_step > log_n:
         raise Exception('threshold_step must be at most log_n')
     try:
         composite_step('buf', threshold_step, 0, 0)
     except Exception:
         raise Exception('threshold_step is too small: %d' % threshold_step)
-    signature = 'void helper_%s_%d_recursive(%s *buf, int depth)' % (type_name,
-                                                                     log_n,
-                                                                     type_name)
+    signature = '%s void %s_recursive(%s *buf, int depth)' % (
+        target(isa), helper_name(type_name, isa, log_n), type_name)
     res = '%s;\n' % signature
     res += '%s {\n' % signature
     res += '  if (depth == %d) {\n' % threshold_step
@@ -461,17 +603,19 @@ def greedy_merged_recursive(type_name, log_n, threshold_step, composite_step):
                 continue
         res += '  if (depth == %d) {\n' % cur_to_it
         for i in range(1 << (cur_to_it - cur_it)):
-            res += '    helper_%s_%d_recursive(buf + %d, %d);\n' % (
-                type_name, log_n, i * (1 << cur_it), cur_it)
+            res += '    %s_recursive(buf + %d, %d);\n' % (
+                helper_name(type_name, isa, log_n), i * (1 << cur_it), cur_it)
         res += composite_step('buf', cur_to_it, cur_it, cur_to_it, '    ')
         res += '    return;\n'
         res += '  }\n'
         cur_it = cur_to_it
     res += '}\n'
-    signature = 'void helper_%s_%d(%s *buf)' % (type_name, log_n, type_name)
+    signature = '%s void %s(%s *buf)' % (
+        target(isa), helper_name(type_name, isa, log_n), type_name)
     res += '%s;\n' % signature
     res += '%s {\n' % signature
-    res += '  helper_%s_%d_recursive(buf, %d);\n' % (type_name, log_n, log_n)
+    res += '  %s_recursive(buf, %d);\n' % (helper_name(type_name, isa, log_n),
+                                            log_n)
     res += '}\n'
     return res
 
@@ -507,6 +651,7 @@ def measure_time(code, log_n, type_name, method_name, num_it=3):
     if num_it % 2 == 0:
         raise Exception('even number of runs: %d' % num_it)
     with open('measurements/to_run.h', 'w') as output:
+        output.write('#define FHT_TARGET(isa) __attribute__((target(isa)))\n')
         output.write(code)
         output.write('const int log_n = %d;\n' % log_n)
         signature = 'void run(%s *buf)' % type_name
@@ -531,63 +676,173 @@ def measure_time(code, log_n, type_name, method_name, num_it=3):
     return get_mean_stddev()
 
 
-if __name__ == '__main__':
-    final_code = '#include "fht.h"\n'
+def generate(type_name, log_n, desc, isa):
+    composite_step_generator = isas[isa][1 if type_name == 'float' else 2]
+    if desc == 'plain_unmerged':
+        return plain_unmerged(type_name, log_n, isa)
+    if desc == 'greedy_merged':
+        return greedy_merged(type_name, log_n, composite_step_generator, isa)
+    (method, threshold_step) = desc.split()
+    if method != 'greedy_merged_recursive':
+        raise Exception('unknown method: %s' % desc)
+    return greedy_merged_recursive(type_name, log_n, int(threshold_step),
+                                   composite_step_generator, isa)
+
+
+def read_hall_of_fame(isa):
     hall_of_fame = []
-    for (type_name,
-         composite_step_generator) in [('float', float_avx_composite_step),
-                                       ('double', double_avx_composite_step)]:
+    with open('hall_of_fame_%s.txt' % isa, 'r') as hof:
+        for line in hof:
+            fields = {}
+            for field in line.strip().split(';'):
+                (key, value) = field.strip().split(' = ')
+                fields[key] = value
+            hall_of_fame.append(
+                (fields['type_name'], int(fields['log_n']),
+                 float(fields['best_time']), fields['best_desc']))
+    return hall_of_fame
+
+
+# A reasonable choice for an instruction set that has not been measured yet:
+# iterative up to 2^11 elements (which fits into L1 for both types), recursive
+# with the same threshold beyond that.
+def untuned_hall_of_fame(isa):
+    hall_of_fame = []
+    for type_name in ['float', 'double']:
         for log_n in range(1, max_log_n + 1):
-            sys.stdout.write('log_n = %d\n' % log_n)
-            times = []
             try:
-                (res, desc) = (greedy_merged(type_name, log_n,
-                                             composite_step_generator),
-                               'greedy_merged')
+                generate(type_name, log_n, 'greedy_merged', isa)
+                if log_n <= 11:
+                    desc = 'greedy_merged'
+                else:
+                    desc = 'greedy_merged_recursive 11'
             except Exception:
-                (res, desc) = (plain_unmerged(type_name, log_n),
-                               'plain_unmerged')
-            time = measure_time(res, log_n, type_name,
-                                'helper_%s_%d' % (type_name, log_n))
-            times.append((time, res, desc))
-            sys.stdout.write('log_n = %d; iterative; time = %.10e\n' % (log_n,
-                                                                        time))
-            for threshold_step in range(1, log_n + 1):
-                try:
-                    res = greedy_merged_recursive(type_name, log_n,
-                                                  threshold_step,
-                                                  composite_step_generator)
-                    time = measure_time(res, log_n, type_name,
-                                        'helper_%s_%d' % (type_name, log_n))
-                    times.append(
-                        (time, res,
-                         'greedy_merged_recursive %d' % threshold_step))
-                    sys.stdout.write(
-                        'log_n = %d; threshold_step = %d; time = %.10e\n' %
-                        (log_n, threshold_step, time))
-                except Exception:
-                    sys.stdout.write('FAIL: %d\n' % threshold_step)
-            (best_time, best_code, best_desc) = min(times)
-            hall_of_fame.append((type_name, log_n, best_time, best_desc))
-            final_code += best_code
-            sys.stdout.write('log_n = %d; best_time = %.10e; %s\n' %
-                             (log_n, best_time, best_desc))
-        final_code += 'int fht_%s(%s *buf, int log_n) {\n' % (type_name,
-                                                              type_name)
-        final_code += '  if (log_n == 0) {\n'
-        final_code += '    return 0;\n'
-        final_code += '  }\n'
-        for i in range(1, max_log_n + 1):
-            final_code += '  if (log_n == %d) {\n' % i
-            final_code += '    helper_%s_%d(buf);\n' % (type_name, i)
-            final_code += '    return 0;\n'
-            final_code += '  }\n'
-        final_code += '  return 1;\n'
-        final_code += '}\n'
-    with open('fht_avx.c', 'w') as output:
+                desc = 'plain_unmerged'
+            hall_of_fame.append((type_name, log_n, 0.0, desc))
+    return hall_of_fame
+
+
+def entry_point(type_name, isa):
+    signature = '%s int fht_%s_%s(%s *buf, int log_n)' % (target(isa), type_name,
+                                                         isa, type_name)
+    res = '%s;\n' % signature
+    res += '%s {\n' % signature
+    res += '  if (log_n == 0) {\n'
+    res += '    return 0;\n'
+    res += '  }\n'
+    for i in range(1, max_log_n + 1):
+        res += '  if (log_n == %d) {\n' % i
+        res += '    %s(buf);\n' % helper_name(type_name, isa, i)
+        res += '    return 0;\n'
+        res += '  }\n'
+    res += '  return 1;\n'
+    res += '}\n'
+    return res
+
+
+# helpers[log_n] transforms vectors of length 2^log_n (fht_impl.h hands these
+# out to callers that transform many vectors of the same length).
+def fixed_length_helpers(type_name, isa):
+    res = 'static void (*const fht_%s_%s_helpers[%d])(%s *) = {\n' % (
+        type_name, isa, max_log_n + 1, type_name)
+    res += '  0,\n'
+    for i in range(1, max_log_n + 1):
+        res += '  %s,\n' % helper_name(type_name, isa, i)
+    res += '};\n'
+    return res
+
+
+# Lengths above max_measured_log_n (which may not fit into memory on the
+# machine doing the measurements) reuse the best variant for the largest
+# measured length: beyond the last-level cache, the best threshold does not
+# depend on log_n much.
+def measure(type_name, isa, max_measured_log_n=max_log_n):
+    composite_step_generator = isas[isa][1 if type_name == 'float' else 2]
+    hall_of_fame = []
+    for log_n in range(1, max_log_n + 1):
+        if log_n > max_measured_log_n:
+            (_, _, _, best_desc) = hall_of_fame[-1]
+            hall_of_fame.append((type_name, log_n, 0.0, best_desc))
+            sys.stdout.write('log_n = %d; not measured; %s\n' % (log_n,
+                                                                  best_desc))
+            continue
+        sys.stdout.write('log_n = %d\n' % log_n)
+        times = []
+        try:
+            (res, desc) = (greedy_merged(type_name, log_n,
+                                         composite_step_generator, isa),
+                           'greedy_merged')
+        except Exception:
+            (res, desc) = (plain_unmerged(type_name, log_n, isa),
+                           'plain_unmerged')
+        time = measure_time(res, log_n, type_name,
+                            helper_name(type_name, isa, log_n))
+        times.append((time, res, desc))
+        sys.stdout.write('log_n = %d; iterative; time = %.10e\n' % (log_n,
+                                                                    time))
+        for threshold_step in range(1, log_n + 1):
+            try:
+                res = greedy_merged_recursive(type_name, log_n, threshold_step,
+                                              composite_step_generator, isa)
+                time = measure_time(res, log_n, type_name,
+                                    helper_name(type_name, isa, log_n))
+                times.append((time, res,
+                              'greedy_merged_recursive %d' % threshold_step))
+                sys.stdout.write(
+                    'log_n = %d; threshold_step = %d; time = %.10e\n' %
+                    (log_n, threshold_step, time))
+            except Exception:
+                sys.stdout.write('FAIL: %d\n' % threshold_step)
+        (best_time, best_code, best_desc) = min(times)
+        hall_of_fame.append((type_name, log_n, best_time, best_desc))
+        sys.stdout.write('log_n = %d; best_time = %.10e; %s\n' %
+                         (log_n, best_time, best_desc))
+    return hall_of_fame
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Generates fht_<isa>.c. By default, every variant is '
+        'measured and the fastest ones are recorded in hall_of_fame_<isa>.txt.')
+    parser.add_argument('--isa', choices=sorted(isas.keys()), default='avx')
+    parser.add_argument(
+        '--rebuild',
+        action='store_true',
+        help='regenerate the code from hall_of_fame_<isa>.txt without '
+        'measuring anything')
+    parser.add_argument(
+        '--untuned',
+        action='store_true',
+        help='generate the code without measuring anything and without a '
+        'hall of fame')
+    parser.add_argument(
+        '--max-measured-log-n',
+        type=int,
+        default=max_log_n,
+        help='measure lengths up to 2^MAX_MEASURED_LOG_N only; longer ones '
+        'use the best variant for the longest measured one')
+    args = parser.parse_args()
+    if args.rebuild:
+        hall_of_fame = read_hall_of_fame(args.isa)
+    elif args.untuned:
+        hall_of_fame = untuned_hall_of_fame(args.isa)
+    else:
+        hall_of_fame = (
+            measure('float', args.isa, args.max_measured_log_n) +
+            measure('double', args.isa, args.max_measured_log_n))
+    final_code = '#include "fht.h"\n'
+    for type_name in ['float', 'double']:
+        for (hof_type_name, log_n, best_time, best_desc) in hall_of_fame:
+            if hof_type_name == type_name:
+                final_code += generate(type_name, log_n, best_desc, args.isa)
+        final_code += entry_point(type_name, args.isa)
+        final_code += fixed_length_helpers(type_name, args.isa)
+    with open('fht_%s.c' % args.isa, 'w') as output:
         output.write(final_code)
+    if args.rebuild or args.untuned:
+        sys.exit(0)
     sys.stdout.write('hall of fame\n')
-    with open('hall_of_fame_avx.txt', 'w') as hof:
+    with open('hall_of_fame_%s.txt' % args.isa, 'w') as hof:
         for (type_name, log_n, best_time, best_desc) in hall_of_fame:
             s = 'type_name = %s; log_n = %d; best_time = %.10e; best_desc = %s\n' % (
                 type_name, log_n, best_time, best_desc)
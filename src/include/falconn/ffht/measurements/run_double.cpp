@@ -9,7 +9,7 @@
 
 static void benchmark_fht(benchmark::State &state) {
   double *buf;
-  if (posix_memalign((void**)&buf, 32, sizeof(double) * (1 << log_n))) {
+  if (posix_memalign((void**)&buf, 64, sizeof(double) * (1 << log_n))) {
     throw std::runtime_error("posix_memalign failed");
   }
   while (state.KeepRunning()) {
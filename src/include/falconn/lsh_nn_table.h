@@ -343,6 +343,25 @@ enum class StorageHashTable {
   LinearProbingHashTable = 4
 };
 
+///
+/// Order in which the queries retrieve the buckets of the probing sequence.
+/// The order matters if the number of candidates is limited (see
+/// LSHNearestNeighborQuery::set_max_num_candidates).
+///
+enum class RetrievalOrder {
+  ///
+  /// All probes of the first table, then all probes of the second table, etc.
+  /// A limited number of candidates mostly comes from the first tables.
+  ///
+  ByTable = 0,
+  ///
+  /// The probes of all tables interleaved in the order of the probing sequence
+  /// (i.e., by their score), so a limited number of candidates comes from the
+  /// best buckets overall.
+  ///
+  ByScore = 1
+};
+
 ///
 /// Contains the parameters for constructing a LSH table wrapper. Not all fields
 /// are necessary for all types of LSH tables.
@@ -406,6 +425,92 @@ struct LSHConstructionParameters {
   /// The value -1 indicates that no feature hashing is performed.
   ///
   int_fast32_t feature_hashing_dimension = -1;
+  ///
+  /// If true, the feature hashing for sparse data computes the target index
+  /// and sign of each coordinate from a seeded hash instead of storing them in
+  /// tables with k * l * dimension entries. Recommended for large dimensions
+  /// (e.g., vocabularies of text data), where the tables would take a lot of
+  /// memory and cause cache misses during hashing.
+  ///
+  bool computed_feature_hashing = false;
+  ///
+  /// If true, the table stores a copy of the points sorted by their hash in
+  /// the first table. The points of a bucket then lie in adjacent memory, so
+  /// the candidate distance computations read fewer cache lines and pages.
+  /// This is most useful for large data sets (e.g., memory-mapped or on a
+  /// remote NUMA node). The copy needs as much memory as the point set. All
+  /// keys returned by the queries are still indices into the original point
+  /// set.
+  ///
+  bool reorder_points = false;
+  ///
+  /// Length of the precomputed probing template of the hyperplane hash.
+  /// Ignored for the cross-polytope hash. If positive, the order of the bit
+  /// flips for multiprobe queries is computed once (by the expected score of
+  /// each set of flipped bits) and only mapped to the rank order of each
+  /// query's projections, so the probing sequence is a table walk instead of
+  /// a heap of candidates. The probes then follow the expected instead of the
+  /// exact scores of the query. Queries with more than
+  /// l * (hyperplane_probing_template_size + 1) probes (or an unlimited
+  /// number) fall back to the exact probing sequence. The template has at
+  /// most 2^k - 1 entries.
+  ///
+  int_fast64_t hyperplane_probing_template_size = 0;
+  ///
+  /// Order in which all query objects of the table retrieve the buckets of
+  /// the probing sequence.
+  ///
+  RetrievalOrder retrieval_order = RetrievalOrder::ByTable;
+  ///
+  /// Maximum number of candidates a query retrieves from each table (in
+  /// addition to the overall maximum number of candidates of the query
+  /// object). The value -1 indicates no limit.
+  ///
+  int_fast64_t max_num_candidates_per_table = -1;
+  ///
+  /// If true, each table stores a compact summary of its non-empty buckets
+  /// (an exact bitmap if the hash values are small enough relative to the
+  /// number of points, a blocked Bloom filter otherwise). Multiprobe queries
+  /// then skip the probes of empty buckets without a lookup in the table, and
+  /// these probes do not count toward the number of probes. This helps when
+  /// most buckets are empty, i.e., when the number of hash bits is large
+  /// relative to log2 of the number of points. A few false positives of the
+  /// Bloom filter still count as probes, and a query considers at most 16
+  /// times its number of probes from the probing sequence. The summaries need
+  /// at most 8 bytes (2 bytes for the Bloom filter) per point and table.
+  ///
+  bool skip_empty_buckets = false;
+  ///
+  /// Weight of the bucket sizes in the order in which the queries retrieve
+  /// the probed buckets. If positive, a bucket is retrieved at its position
+  /// in the retrieval order plus bucket_size_penalty times its number of
+  /// points. For instance, with a penalty of 0.01, a bucket with 1000 points
+  /// is retrieved after the next ten (smaller) buckets of the probing
+  /// sequence. This only matters if the number of candidates is limited.
+  ///
+  double bucket_size_penalty = 0.0;
+  ///
+  /// Maximum number of points the queries retrieve from a single bucket.
+  /// Larger buckets are subsampled (evenly over the bucket), which bounds the
+  /// query time on data sets with a few huge buckets. The value -1 indicates
+  /// no limit.
+  ///
+  int_fast64_t max_bucket_size = -1;
+  ///
+  /// Minimum number of tables in which a candidate must collide with the
+  /// query (i.e., the number of probed buckets containing it) to be passed on
+  /// to the distance computations. True neighbors tend to collide in several
+  /// tables and false positives in only one, so with many tables a small
+  /// threshold removes many candidates at almost no cost. The value 1 keeps
+  /// all candidates. Must be at most l.
+  ///
+  int_fast32_t min_num_collisions = 1;
+  ///
+  /// Fraction of the unique candidates (that pass min_num_collisions) that
+  /// the queries keep, namely the ones with the most collisions (ties are
+  /// broken by the retrieval order). Must be in (0, 1]; 1.0 keeps all.
+  ///
+  double kept_candidate_fraction = 1.0;
 };
 
 ///
@@ -48,13 +48,24 @@ class PointTypeTraitsInternal<DenseVector<CoordinateType>> {
         params.last_cp_dimension, params.seed ^ 93384688));
     return std::move(res);
   }
+
+  // The dense distances use kernels specialized for params.dimension if it
+  // is one of the common dimensions (see core::cpu_kernels(dimension)).
+  template <typename DistanceFunction>
+  static DistanceFunction construct_distance(
+      const LSHConstructionParameters& params) {
+    return DistanceFunction(params.dimension);
+  }
 };
 
 template <typename CoordinateType, typename IndexType>
 class PointTypeTraitsInternal<SparseVector<CoordinateType, IndexType>> {
  public:
-  typedef core::CosineDistanceSparse<CoordinateType, IndexType> CosineDistance;
-  typedef core::EuclideanDistanceSparse<CoordinateType, IndexType>
+  // The scatter variants load each query into a dense buffer once, which is
+  // faster than merging with every candidate.
+  typedef core::CosineDistanceSparseScatter<CoordinateType, IndexType>
+      CosineDistance;
+  typedef core::EuclideanDistanceSparseScatter<CoordinateType, IndexType>
       EuclideanDistance;
   template <typename HashType>
   using HPHash =
@@ -69,9 +80,14 @@ class PointTypeTraitsInternal<SparseVector<CoordinateType, IndexType>> {
     std::unique_ptr<CPHash<HashType>> res(new CPHash<HashType>(
         params.dimension, params.k, params.l, params.num_rotations,
         params.feature_hashing_dimension, params.last_cp_dimension,
-        params.seed ^ 93384688));
+        params.seed ^ 93384688, params.computed_feature_hashing));
     return std::move(res);
   }
+
+  template <typename DistanceFunction>
+  static DistanceFunction construct_distance(const LSHConstructionParameters&) {
+    return DistanceFunction();
+  }
 };
 
 template <typename PointType>
@@ -278,6 +294,28 @@ struct GetDefaultParameters<SparseVector<CoordinateType>> {
   }
 };
 
+// Maps the internal keys of a table built with reorder_points = true back to
+// the indices of the points in the original point set. external_keys is
+// nullptr if the points were not reordered.
+template <typename KeyType>
+KeyType translate_key(const std::vector<KeyType>* external_keys, KeyType key) {
+  if (external_keys == nullptr || key < 0) {
+    return key;
+  }
+  return (*external_keys)[key];
+}
+
+template <typename KeyType>
+void translate_keys(const std::vector<KeyType>* external_keys,
+                    std::vector<KeyType>* keys) {
+  if (external_keys == nullptr) {
+    return;
+  }
+  for (KeyType& key : *keys) {
+    key = (*external_keys)[key];
+  }
+}
+
 template <typename PointType, typename KeyType, typename DistanceType,
           typename LSHTable, typename ScalarType, typename DistanceFunction,
           typename DataStorage>
@@ -290,43 +328,53 @@ class LSHNNQueryWrapper : public LSHNearestNeighborQuery<PointType, KeyType> {
  public:
   LSHNNQueryWrapper(const LSHTable& parent, int_fast64_t num_probes,
                     int_fast64_t max_num_candidates,
-                    const DataStorage& data_storage)
-      : num_probes_(num_probes), max_num_candidates_(max_num_candidates) {
+                    const DataStorage& data_storage,
+                    const std::vector<KeyType>* external_keys = nullptr,
+                    const DistanceFunction& distance_function =
+                        DistanceFunction())
+      : num_probes_(num_probes),
+        max_num_candidates_(max_num_candidates),
+        external_keys_(external_keys) {
     if (num_probes <= 0) {
       throw LSHNearestNeighborTableError(
           "Number of probes must be at least 1.");
     }
     internal_query_.reset(new typename LSHTable::Query(parent));
-    internal_nn_query_.reset(
-        new NNQueryType(internal_query_.get(), data_storage));
+    internal_nn_query_.reset(new NNQueryType(internal_query_.get(),
+                                             data_storage, distance_function));
   }
 
   KeyType find_nearest_neighbor(const PointType& q) {
-    return internal_nn_query_->find_nearest_neighbor(q, q, num_probes_,
-                                                     max_num_candidates_);
+    return translate_key(external_keys_,
+                         internal_nn_query_->find_nearest_neighbor(
+                             q, q, num_probes_, max_num_candidates_));
   }
 
   void find_k_nearest_neighbors(const PointType& q, int_fast64_t k,
                                 std::vector<KeyType>* result) {
     internal_nn_query_->find_k_nearest_neighbors(q, q, k, num_probes_,
                                                  max_num_candidates_, result);
+    translate_keys(external_keys_, result);
   }
 
   void find_near_neighbors(const PointType& q, DistanceType threshold,
                            std::vector<KeyType>* result) {
     internal_nn_query_->find_near_neighbors(q, q, threshold, num_probes_,
                                             max_num_candidates_, result);
+    translate_keys(external_keys_, result);
   }
 
   void get_candidates_with_duplicates(const PointType& q,
                                       std::vector<KeyType>* result) {
     internal_nn_query_->get_candidates_with_duplicates(
         q, num_probes_, max_num_candidates_, result);
+    translate_keys(external_keys_, result);
   }
 
   void get_unique_candidates(const PointType& q, std::vector<KeyType>* result) {
     internal_nn_query_->get_unique_candidates(q, num_probes_,
                                               max_num_candidates_, result);
+    translate_keys(external_keys_, result);
   }
 
   int_fast64_t get_num_probes() { return num_probes_; }
@@ -360,6 +408,7 @@ class LSHNNQueryWrapper : public LSHNearestNeighborQuery<PointType, KeyType> {
   std::unique_ptr<NNQueryType> internal_nn_query_;
   int_fast64_t num_probes_;
   int_fast64_t max_num_candidates_;
+  const std::vector<KeyType>* external_keys_;
 };
 
 template <typename PointType, typename KeyType, typename DistanceType,
@@ -375,10 +424,13 @@ class LSHNNQueryPool : public LSHNearestNeighborQueryPool<PointType, KeyType> {
   LSHNNQueryPool(const LSHTable& parent, int_fast64_t num_probes,
                  int_fast64_t max_num_candidates,
                  const DataStorage& data_storage,
-                 int_fast64_t num_query_objects)
+                 int_fast64_t num_query_objects,
+                 const std::vector<KeyType>* external_keys = nullptr,
+                 const DistanceFunction& distance_function = DistanceFunction())
       : locks_(num_query_objects),
         num_probes_(num_probes),
-        max_num_candidates_(max_num_candidates) {
+        max_num_candidates_(max_num_candidates),
+        external_keys_(external_keys) {
     if (num_probes <= 0) {
       throw LSHNearestNeighborTableError(
           "Number of probes must be at least 1.");
@@ -391,7 +443,7 @@ class LSHNNQueryPool : public LSHNearestNeighborQueryPool<PointType, KeyType> {
       std::unique_ptr<typename LSHTable::Query> cur_query(
           new typename LSHTable::Query(parent));
       std::unique_ptr<NNQueryType> cur_nn_query(
-          new NNQueryType(cur_query.get(), data_storage));
+          new NNQueryType(cur_query.get(), data_storage, distance_function));
       internal_queries_.push_back(std::move(cur_query));
       internal_nn_queries_.push_back(std::move(cur_nn_query));
       locks_[ii].clear(std::memory_order_release);
@@ -403,7 +455,7 @@ class LSHNNQueryPool : public LSHNearestNeighborQueryPool<PointType, KeyType> {
     KeyType res = internal_nn_queries_[query_index]->find_nearest_neighbor(
         q, q, num_probes_, max_num_candidates_);
     unlock_query(query_index);
-    return res;
+    return translate_key(external_keys_, res);
   }
 
   void find_k_nearest_neighbors(const PointType& q, int_fast64_t k,
@@ -412,6 +464,7 @@ class LSHNNQueryPool : public LSHNearestNeighborQueryPool<PointType, KeyType> {
     internal_nn_queries_[query_index]->find_k_nearest_neighbors(
         q, q, k, num_probes_, max_num_candidates_, result);
     unlock_query(query_index);
+    translate_keys(external_keys_, result);
   }
 
   void find_near_neighbors(const PointType& q, DistanceType threshold,
@@ -420,6 +473,7 @@ class LSHNNQueryPool : public LSHNearestNeighborQueryPool<PointType, KeyType> {
     internal_nn_queries_[query_index]->find_near_neighbors(
         q, q, threshold, num_probes_, max_num_candidates_, result);
     unlock_query(query_index);
+    translate_keys(external_keys_, result);
   }
 
   void get_candidates_with_duplicates(const PointType& q,
@@ -428,6 +482,7 @@ class LSHNNQueryPool : public LSHNearestNeighborQueryPool<PointType, KeyType> {
     internal_nn_queries_[query_index]->get_candidates_with_duplicates(
         q, num_probes_, max_num_candidates_, result);
     unlock_query(query_index);
+    translate_keys(external_keys_, result);
   }
 
   void get_unique_candidates(const PointType& q, std::vector<KeyType>* result) {
@@ -435,6 +490,7 @@ class LSHNNQueryPool : public LSHNearestNeighborQueryPool<PointType, KeyType> {
     internal_nn_queries_[query_index]->get_unique_candidates(
         q, num_probes_, max_num_candidates_, result);
     unlock_query(query_index);
+    translate_keys(external_keys_, result);
   }
 
   int_fast64_t get_num_probes() { return num_probes_; }
@@ -507,24 +563,35 @@ class LSHNNQueryPool : public LSHNearestNeighborQueryPool<PointType, KeyType> {
   std::vector<std::atomic_flag> locks_;
   int_fast64_t num_probes_;
   int_fast64_t max_num_candidates_;
+  const std::vector<KeyType>* external_keys_;
 };
 
 template <typename PointType, typename KeyType, typename DistanceType,
           typename DistanceFunction, typename LSHTable, typename LSHFunction,
           typename HashTableFactory, typename CompositeHashTable,
-          typename DataStorage>
+          typename DataStorage, typename ReorderedPointSet>
 class LSHNNTableWrapper : public LSHNearestNeighborTable<PointType, KeyType> {
  public:
+  // If the points were reordered, reordered_points holds the copy that
+  // data_storage refers to, and external_keys[ii] is the original index of
+  // the point at position ii. Otherwise both are empty. Every query object
+  // gets a copy of distance_function.
   LSHNNTableWrapper(std::unique_ptr<LSHFunction> lsh,
                     std::unique_ptr<LSHTable> lsh_table,
                     std::unique_ptr<HashTableFactory> hash_table_factory,
                     std::unique_ptr<CompositeHashTable> composite_hash_table,
-                    std::unique_ptr<DataStorage> data_storage)
+                    std::unique_ptr<ReorderedPointSet> reordered_points,
+                    std::unique_ptr<DataStorage> data_storage,
+                    std::vector<KeyType> external_keys,
+                    const DistanceFunction& distance_function)
       : lsh_(std::move(lsh)),
         lsh_table_(std::move(lsh_table)),
         hash_table_factory_(std::move(hash_table_factory)),
         composite_hash_table_(std::move(composite_hash_table)),
-        data_storage_(std::move(data_storage)) {}
+        reordered_points_(std::move(reordered_points)),
+        data_storage_(std::move(data_storage)),
+        external_keys_(std::move(external_keys)),
+        distance_function_(distance_function) {}
 
   void add_table() {
     lsh_->add_table();
@@ -545,7 +612,8 @@ class LSHNNTableWrapper : public LSHNearestNeighborTable<PointType, KeyType> {
         nn_query(
             new LSHNNQueryWrapper<PointType, KeyType, DistanceType, LSHTable,
                                   ScalarType, DistanceFunction, DataStorage>(
-                *lsh_table_, num_probes, max_num_candidates, *data_storage_));
+                *lsh_table_, num_probes, max_num_candidates, *data_storage_,
+                get_external_keys(), distance_function_));
     return std::move(nn_query);
   }
 
@@ -566,18 +634,29 @@ class LSHNNTableWrapper : public LSHNearestNeighborTable<PointType, KeyType> {
             new LSHNNQueryPool<PointType, KeyType, DistanceType, LSHTable,
                                ScalarType, DistanceFunction, DataStorage>(
                 *lsh_table_, num_probes, max_num_candidates, *data_storage_,
-                num_query_objects));
+                num_query_objects, get_external_keys(), distance_function_));
     return std::move(nn_query_pool);
   }
 
   ~LSHNNTableWrapper() {}
 
  protected:
+  const std::vector<KeyType>* get_external_keys() const {
+    if (reordered_points_ == nullptr) {
+      return nullptr;
+    }
+    return &external_keys_;
+  }
+
+
   std::unique_ptr<LSHFunction> lsh_;
   std::unique_ptr<LSHTable> lsh_table_;
   std::unique_ptr<HashTableFactory> hash_table_factory_;
   std::unique_ptr<CompositeHashTable> composite_hash_table_;
+  std::unique_ptr<ReorderedPointSet> reordered_points_;
   std::unique_ptr<DataStorage> data_storage_;
+  std::vector<KeyType> external_keys_;
+  DistanceFunction distance_function_;
 };
 
 template <typename PointType, typename KeyType, typename PointSet>
@@ -587,6 +666,8 @@ class StaticTableFactory {
 
   typedef typename DataStorageAdapter<PointSet>::template DataStorage<KeyType>
       DataStorageType;
+  typedef typename DataStorageAdapter<PointSet>::ReorderedPointSet
+      ReorderedPointSetType;
 
   StaticTableFactory(const PointSet& points,
                      const LSHConstructionParameters& params)
@@ -663,10 +744,27 @@ class StaticTableFactory {
       typedef uint64_t HashType;
       HashType tmp;
       setup1(std::make_tuple(tmp));
+#ifdef FALCONN_HAVE_UINT128
+    } else if (num_bits_ <= 128) {
+      if (params_.storage_hash_table == StorageHashTable::FlatHashTable ||
+          params_.storage_hash_table ==
+              StorageHashTable::BitPackedFlatHashTable) {
+        throw LSHNNTableSetupError(
+            "The flat hash tables do not support more than 64 hash bits.");
+      }
+      typedef uint128_t HashType;
+      HashType tmp;
+      setup1(std::make_tuple(tmp));
+    } else {
+      throw LSHNNTableSetupError(
+          "More than 128 hash bits are currently not "
+          "supported.");
+#else
     } else {
       throw LSHNNTableSetupError(
           "More than 64 hash bits are currently not "
           "supported.");
+#endif
     }
   }
 
@@ -678,8 +776,10 @@ class StaticTableFactory {
       typedef typename wrapper::PointTypeTraitsInternal<
           PointType>::template HPHash<HashType>
           LSH;
-      std::unique_ptr<LSH> lsh(new LSH(params_.dimension, params_.k, params_.l,
-                                       params_.seed ^ 93384688));
+      std::unique_ptr<LSH> lsh(
+          new LSH(params_.dimension, params_.k, params_.l,
+                  params_.seed ^ 93384688,
+                  params_.hyperplane_probing_template_size));
       setup2(std::tuple_cat(vals, std::make_tuple(std::move(lsh))));
     } else if (params_.lsh_family == LSHFamily::CrossPolytope) {
       if (params_.num_rotations < 0) {
@@ -719,13 +819,17 @@ class StaticTableFactory {
       typedef
           typename wrapper::PointTypeTraitsInternal<PointType>::CosineDistance
               DistanceFunc;
-      DistanceFunc tmp;
+      DistanceFunc tmp(wrapper::PointTypeTraitsInternal<
+                       PointType>::template construct_distance<DistanceFunc>(
+          params_));
       setup3(std::tuple_cat(std::move(vals), std::make_tuple(tmp)));
     } else if (params_.distance_function ==
                DistanceFunction::EuclideanSquared) {
       typedef typename wrapper::PointTypeTraitsInternal<
           PointType>::EuclideanDistance DistanceFunc;
-      DistanceFunc tmp;
+      DistanceFunc tmp(wrapper::PointTypeTraitsInternal<
+                       PointType>::template construct_distance<DistanceFunc>(
+          params_));
       setup3(std::tuple_cat(std::move(vals), std::make_tuple(tmp)));
     } else {
       throw LSHNNTableSetupError(
@@ -827,19 +931,56 @@ class StaticTableFactory {
     std::unique_ptr<CompositeHashTableType>& composite_table =
         std::get<kCompositeHashTableIndex>(vals);
 
+    std::unique_ptr<ReorderedPointSetType> reordered_points;
+    std::vector<KeyType> external_keys;
+    if (params_.reorder_points) {
+      typename LSHType::template BatchHash<DataStorageType> bh(*lsh);
+      std::vector<HashType> first_table_hashes;
+      bh.batch_hash_single_table(*data_storage_, 0, &first_table_hashes);
+      core::compute_bucket_order(first_table_hashes, &external_keys);
+      reordered_points.reset(new ReorderedPointSetType());
+      data_storage_ = std::move(
+          DataStorageAdapter<PointSet>::template construct_reordered_data_storage<
+              KeyType>(points_, external_keys, reordered_points.get()));
+    }
+
+    composite_table->set_use_occupancy_filters(params_.skip_empty_buckets);
+
     typedef core::StaticLSHTable<PointType, KeyType, LSHType, HashType,
                                  CompositeHashTableType, DataStorageType>
         LSHTableType;
     std::unique_ptr<LSHTableType> lsh_table(
         new LSHTableType(lsh.get(), composite_table.get(), *data_storage_,
                          params_.num_setup_threads));
-
-    table_.reset(new LSHNNTableWrapper<PointType, KeyType, ScalarType,
-                                       DistanceFunctionType, LSHTableType,
-                                       LSHType, HashTableFactoryType,
-                                       CompositeHashTableType, DataStorageType>(
-        std::move(lsh), std::move(lsh_table), std::move(factory),
-        std::move(composite_table), std::move(data_storage_)));
+    if (params_.retrieval_order != RetrievalOrder::ByTable &&
+        params_.retrieval_order != RetrievalOrder::ByScore) {
+      throw LSHNNTableSetupError("Unknown retrieval order.");
+    }
+    lsh_table->set_retrieval_order(
+        params_.retrieval_order == RetrievalOrder::ByScore,
+        params_.max_num_candidates_per_table);
+    if (params_.bucket_size_penalty < 0.0) {
+      throw LSHNNTableSetupError(
+          "The bucket size penalty cannot be negative.");
+    }
+    if (params_.max_bucket_size < -1) {
+      throw LSHNNTableSetupError(
+          "The maximum bucket size must be -1 (no limit) or non-negative.");
+    }
+    lsh_table->set_bucket_size_policy(params_.bucket_size_penalty,
+                                      params_.max_bucket_size);
+    lsh_table->set_collision_filter(params_.min_num_collisions,
+                                    params_.kept_candidate_fraction);
+
+    table_.reset(
+        new LSHNNTableWrapper<PointType, KeyType, ScalarType,
+                              DistanceFunctionType, LSHTableType, LSHType,
+                              HashTableFactoryType, CompositeHashTableType,
+                              DataStorageType, ReorderedPointSetType>(
+            std::move(lsh), std::move(lsh_table), std::move(factory),
+            std::move(composite_table), std::move(reordered_points),
+            std::move(data_storage_), std::move(external_keys),
+            std::get<kDistanceFunctionIndex>(vals)));
   }
 
   const static int_fast32_t kHashTypeIndex = 0;
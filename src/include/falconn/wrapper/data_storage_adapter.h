@@ -4,6 +4,7 @@
 #include "../core/data_storage.h"
 #include "../falconn_global.h"
 
+#include <algorithm>
 #include <memory>
 #include <type_traits>
 #include <vector>
@@ -29,12 +30,31 @@ class DataStorageAdapter<std::vector<PointType>> {
   template <typename KeyType>
   using DataStorage = core::ArrayDataStorage<PointType, KeyType>;
 
+  // Owns the copy of the points made by construct_reordered_data_storage.
+  typedef std::vector<PointType> ReorderedPointSet;
+
   template <typename KeyType>
   static std::unique_ptr<DataStorage<KeyType>> construct_data_storage(
       const std::vector<PointType>& points) {
     std::unique_ptr<DataStorage<KeyType>> res(new DataStorage<KeyType>(points));
     return std::move(res);
   }
+
+  // Copies the points into *reordered so that point order[ii] is at position
+  // ii, and returns a data storage for the copy.
+  template <typename KeyType>
+  static std::unique_ptr<DataStorage<KeyType>> construct_reordered_data_storage(
+      const std::vector<PointType>& points, const std::vector<KeyType>& order,
+      ReorderedPointSet* reordered) {
+    reordered->clear();
+    reordered->reserve(order.size());
+    for (KeyType key : order) {
+      reordered->push_back(points[key]);
+    }
+    std::unique_ptr<DataStorage<KeyType>> res(
+        new DataStorage<KeyType>(*reordered));
+    return std::move(res);
+  }
 };
 
 template <typename CoordinateType>
@@ -44,6 +64,8 @@ class DataStorageAdapter<PlainArrayPointSet<CoordinateType>> {
   using DataStorage =
       core::PlainArrayDataStorage<DenseVector<CoordinateType>, KeyType>;
 
+  typedef std::vector<CoordinateType> ReorderedPointSet;
+
   template <typename KeyType>
   static std::unique_ptr<DataStorage<KeyType>> construct_data_storage(
       const PlainArrayPointSet<CoordinateType>& points) {
@@ -51,6 +73,71 @@ class DataStorageAdapter<PlainArrayPointSet<CoordinateType>> {
         points.data, points.num_points, points.dimension));
     return std::move(res);
   }
+
+  template <typename KeyType>
+  static std::unique_ptr<DataStorage<KeyType>> construct_reordered_data_storage(
+      const PlainArrayPointSet<CoordinateType>& points,
+      const std::vector<KeyType>& order, ReorderedPointSet* reordered) {
+    int_fast64_t dim = points.dimension;
+    reordered->resize(order.size() * dim);
+    for (int_fast64_t ii = 0; ii < static_cast<int_fast64_t>(order.size());
+         ++ii) {
+      std::copy(points.data + order[ii] * dim,
+                points.data + (order[ii] + 1) * dim,
+                reordered->data() + ii * dim);
+    }
+    std::unique_ptr<DataStorage<KeyType>> res(new DataStorage<KeyType>(
+        reordered->data(), order.size(), dim));
+    return std::move(res);
+  }
+};
+
+template <typename CoordinateType, typename IndexType>
+class DataStorageAdapter<CSRPointSet<CoordinateType, IndexType>> {
+ public:
+  template <typename KeyType>
+  using DataStorage = core::CSRDataStorage<CoordinateType, IndexType, KeyType>;
+
+  struct ReorderedPointSet {
+    std::vector<int64_t> indptr;
+    std::vector<IndexType> indices;
+    std::vector<CoordinateType> values;
+  };
+
+  template <typename KeyType>
+  static std::unique_ptr<DataStorage<KeyType>> construct_data_storage(
+      const CSRPointSet<CoordinateType, IndexType>& points) {
+    std::unique_ptr<DataStorage<KeyType>> res(new DataStorage<KeyType>(
+        points.indptr, points.indices, points.values, points.num_points));
+    return std::move(res);
+  }
+
+  template <typename KeyType>
+  static std::unique_ptr<DataStorage<KeyType>> construct_reordered_data_storage(
+      const CSRPointSet<CoordinateType, IndexType>& points,
+      const std::vector<KeyType>& order, ReorderedPointSet* reordered) {
+    reordered->indptr.resize(order.size() + 1);
+    reordered->indptr[0] = 0;
+    for (size_t ii = 0; ii < order.size(); ++ii) {
+      reordered->indptr[ii + 1] = reordered->indptr[ii] +
+                                  points.indptr[order[ii] + 1] -
+                                  points.indptr[order[ii]];
+    }
+    reordered->indices.resize(reordered->indptr.back());
+    reordered->values.resize(reordered->indptr.back());
+    for (size_t ii = 0; ii < order.size(); ++ii) {
+      int64_t begin = points.indptr[order[ii]];
+      int64_t end = points.indptr[order[ii] + 1];
+      std::copy(points.indices + begin, points.indices + end,
+                reordered->indices.data() + reordered->indptr[ii]);
+      std::copy(points.values + begin, points.values + end,
+                reordered->values.data() + reordered->indptr[ii]);
+    }
+    std::unique_ptr<DataStorage<KeyType>> res(new DataStorage<KeyType>(
+        reordered->indptr.data(), reordered->indices.data(),
+        reordered->values.data(), order.size()));
+    return std::move(res);
+  }
 };
 
 }  // namespace wrapper
@@ -0,0 +1,72 @@
+#include <falconn/core/polytope_hash.h>
+
+#include <iostream>
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using std::cout;
+using std::endl;
+using std::mt19937_64;
+using std::normal_distribution;
+using std::vector;
+
+using std::chrono::high_resolution_clock;
+using std::chrono::duration;
+using std::chrono::duration_cast;
+
+using falconn::core::CrossPolytopeHashDense;
+
+typedef CrossPolytopeHashDense<float, uint32_t> Hash;
+
+int main() {
+  const int D = 128;
+  const int K = 3;
+  const int L = 50;
+  const int LAST_CP_DIM = 16;
+  const int NUM_ROTATIONS = 2;
+  const int Q = 200;
+  cout << D << " dimensions, k = " << K << ", l = " << L
+       << ", last cp dimension = " << LAST_CP_DIM << endl;
+  cout << Q << " queries" << endl;
+
+  Hash hash(D, K, L, NUM_ROTATIONS, LAST_CP_DIM, 4057218);
+  mt19937_64 gen(1239087);
+  normal_distribution<float> g(0.0, 1.0);
+  vector<Hash::TransformedVectorType> transformed(Q);
+  Hash::HashTransformation transformation(hash);
+  for (int i = 0; i < Q; ++i) {
+    Hash::VectorType q(D);
+    for (int j = 0; j < D; ++j) {
+      q[j] = g(gen);
+    }
+    q.normalize();
+    hash.reserve_transformed_vector_memory(&transformed[i]);
+    transformation.apply(q, &transformed[i]);
+  }
+
+  Hash::MultiProbeLookup lookup(hash);
+  vector<int_fast64_t> num_probes = {L,     2 * L,  5 * L,  10 * L,
+                                     1000,  3000,   10000,  30000,
+                                     100000};
+  for (int_fast64_t T : num_probes) {
+    uint64_t dummy = 0;
+    auto t1 = high_resolution_clock::now();
+    for (int i = 0; i < Q; ++i) {
+      lookup.setup_probing(transformed[i], T);
+      uint32_t probe;
+      int_fast32_t table;
+      while (lookup.get_next_probe(&probe, &table)) {
+        dummy += probe + table;
+      }
+    }
+    auto t2 = high_resolution_clock::now();
+    double t = duration_cast<duration<double>>(t2 - t1).count();
+    cout << T << " probes: " << t / Q * 1e6 << " us per query, "
+         << t / (Q * T) * 1e9 << " ns per probe (" << dummy % 10 << ")"
+         << endl;
+  }
+  return 0;
+}
@@ -6,8 +6,8 @@ meant to be easy to use. It exposes classes `LSHIndex`,
 helper functions `get_default_parameters()` and
 `compute_number_of_hash_functions()`.
 
-For now, the Python wrapper supports only _static dense_ datasets,
-but more to come.
+For now, the Python wrapper supports only _static_ datasets: dense
+ones given as NumPy arrays and sparse ones given as SciPy CSR matrices.
 
 FALCONN is based on Locality-Sensitive Hashing (LSH), which is briefly
 covered [here](https://github.com/FALCONN-LIB/FALCONN/wiki/LSH-Primer)
@@ -70,7 +70,22 @@ distance in this case.
 """
 import numpy as _numpy
 import _falconn as _internal
-from _falconn import LSHConstructionParameters, QueryStatistics, DistanceFunction, LSHFamily, StorageHashTable, get_default_parameters, compute_number_of_hash_functions
+from _falconn import LSHConstructionParameters, QueryStatistics, DistanceFunction, LSHFamily, StorageHashTable, RetrievalOrder, get_default_parameters, compute_number_of_hash_functions
+
+
+def _is_sparse_matrix(x):
+    # SciPy is optional, so we do not import it unless we are given a
+    # sparse matrix
+    return hasattr(x, 'tocsr') and hasattr(x, 'nnz')
+
+
+def _canonical_csr(x):
+    # the sparse distance functions need sorted indices without duplicates
+    x = x.tocsr()
+    if not x.has_canonical_format:
+        x = x.copy()
+        x.sum_duplicates()
+    return x
 
 
 class Queryable:
@@ -86,6 +101,8 @@ class Queryable:
         self._parent = parent
 
     def _check_query(self, query):
+        if self._parent._is_sparse:
+            return self._check_sparse_query(query)
         if not isinstance(query, _numpy.ndarray):
             raise TypeError('query must be an instance of numpy.ndarray')
         if len(query.shape) != 1:
@@ -96,6 +113,20 @@ class Queryable:
             raise ValueError(
                 'query dimension mismatch: {} expected, but {} found'.format(
                     self._parent._params.dimension, query.shape[0]))
+        return query
+
+    def _check_sparse_query(self, query):
+        if not _is_sparse_matrix(query):
+            raise TypeError('query must be a SciPy sparse matrix')
+        if query.shape[0] != 1:
+            raise ValueError('query must consist of a single row')
+        if query.shape[1] != self._parent._params.dimension:
+            raise ValueError(
+                'query dimension mismatch: {} expected, but {} found'.format(
+                    self._parent._params.dimension, query.shape[1]))
+        query = _canonical_csr(query)
+        return (query.indices.astype(_numpy.int32, copy=False),
+                query.data.astype(_numpy.float32, copy=False))
 
     def find_k_nearest_neighbors(self, query, k):
         """Retrieve the closest `k` neighbors to `query`.
@@ -111,7 +142,7 @@ class Queryable:
         the second dimension of the dataset;
         * `k`: the number of closest candidates to retrieve.
         """
-        self._check_query(query)
+        query = self._check_query(query)
         if k <= 0:
             raise ValueError('k must be positive rather than {}'.format(k))
         return self._inner_entity.find_k_nearest_neighbors(query, k)
@@ -131,7 +162,7 @@ class Queryable:
         the candidates; note that it can be negative, and for the distance
         function `'negative_inner_product'` it actually makes sense.
         """
-        self._check_query(query)
+        query = self._check_query(query)
         if threshold < 0:
             raise ValueError('threshold must be non-negative rather than {}'.
                              format(threshold))
@@ -149,7 +180,7 @@ class Queryable:
         `dtype` as the dataset; the dimension of `query` much match
         the second dimension of the dataset.
         """
-        self._check_query(query)
+        query = self._check_query(query)
         return self._inner_entity.find_nearest_neighbor(query)
 
     def get_candidates_with_duplicates(self, query):
@@ -167,7 +198,7 @@ class Queryable:
         `dtype` as the dataset; the dimension of `query` much match
         the second dimension of the dataset.
         """
-        self._check_query(query)
+        query = self._check_query(query)
         return self._inner_entity.get_candidates_with_duplicates(query)
 
     def get_max_num_candidates(self):
@@ -201,7 +232,7 @@ class Queryable:
         `dtype` as the dataset; the dimension of `query` much match
         the second dimension of the dataset.
         """
-        self._check_query(query)
+        query = self._check_query(query)
         return self._inner_entity.get_unique_candidates(query)
 
     def reset_query_statistics(self):
@@ -321,6 +352,8 @@ class LSHIndex:
         #TODO check params for correctness
         self._params = params
         self._dataset = None
+        self._sparse_arrays = None
+        self._is_sparse = False
         self._table = None
 
     def setup(self, dataset):
@@ -337,6 +370,12 @@ class LSHIndex:
         dimension of the array must match the dimension from parameters
         (`self._params.dimension`).
 
+        Alternatively, a dataset can be a SciPy sparse matrix (preferably
+        in CSR format with `float32` values and sorted indices, so that
+        no copy is made). Then the queries must be sparse matrices with
+        a single row, and for the cross-polytope LSH family
+        `self._params.feature_hashing_dimension` must be set.
+
         An important caveat: **DON'T DELETE THE DATASET WHILE USING
         `LSHIndex`**. This can lead to silent crashes and can be very
         confusing.
@@ -344,11 +383,15 @@ class LSHIndex:
         Arguments:
 
         * `dataset`: a two-dimensional NumPy array with dtype
-        `numpy.float32` or `numpy.float64`; the second dimension must match
+        `numpy.float32` or `numpy.float64`, or a SciPy sparse matrix;
+        the second dimension must match
         dimension from the LSH parameters (`self._params.dimension`)
         """
         if self._dataset is not None or self._table is not None:
             raise RuntimeError('setup() has already been called')
+        if _is_sparse_matrix(dataset):
+            self._setup_sparse(dataset)
+            return
         if not isinstance(dataset, _numpy.ndarray):
             raise TypeError('dataset must be an instance of numpy.ndarray')
         if len(dataset.shape) != 2:
@@ -367,6 +410,24 @@ class LSHIndex:
             self._table = _internal.construct_table_dense_double(
                 dataset, self._params)
 
+    def _setup_sparse(self, dataset):
+        if dataset.shape[1] != self._params.dimension:
+            raise ValueError(
+                'dataset dimension mismatch: {} expected, but {} found'.format(
+                    self._params.dimension, dataset.shape[1]))
+        dataset = _canonical_csr(dataset)
+        # The arrays are passed to FALCONN without copying if they already
+        # have the right dtypes. We keep references to them, since the
+        # table points into their memory.
+        self._sparse_arrays = (dataset.indptr.astype(_numpy.int64, copy=False),
+                               dataset.indices.astype(_numpy.int32, copy=False),
+                               dataset.data.astype(_numpy.float32, copy=False))
+        self._dataset = dataset
+        self._is_sparse = True
+        self._table = _internal.construct_table_sparse_float(
+            self._sparse_arrays[0], self._sparse_arrays[1],
+            self._sparse_arrays[2], self._params)
+
     def _check_built(self):
         if self._dataset is None or self._table is None:
             raise RuntimeError('LSH table is not built (use setup())')
@@ -13,7 +13,10 @@ except ImportError:
     sys.stderr.write('Setuptools not found!\n')
     raise
 
-extra_args = ['-std=c++11', '-march=native', '-O3']
+# Set FALCONN_ARCH_FLAGS (e.g., to -march=x86-64) to build a portable module;
+# the performance-critical kernels pick the instruction set at runtime.
+extra_args = ['-std=c++11', '-O3'] + os.environ.get('FALCONN_ARCH_FLAGS',
+                                                    '-march=native').split()
 if sys.platform == 'darwin':
     extra_args += ['-mmacosx-version-min=10.9', '-stdlib=libc++']
     os.environ['LDFLAGS'] = '-mmacosx-version-min=10.9'
@@ -48,6 +48,54 @@ PlainArrayPointSet<T> numpy_to_plain_dataset(NumPyArray<T> dataset) {
   return converted_points;
 }
 
+// The arrays are referenced, not copied, so they must outlive the table.
+template <typename T>
+CSRPointSet<T> numpy_to_csr_dataset(NumPyArray<int64_t> indptr,
+                                    NumPyArray<int32_t> indices,
+                                    NumPyArray<T> values,
+                                    int_fast32_t dimension) {
+  py::buffer_info indptr_buf = indptr.request();
+  py::buffer_info indices_buf = indices.request();
+  py::buffer_info values_buf = values.request();
+  if (indptr_buf.ndim != 1 || indices_buf.ndim != 1 || values_buf.ndim != 1) {
+    throw PyLSHNearestNeighborTableError("expected one-dimensional arrays");
+  }
+  if (indptr_buf.shape[0] < 1 || indices_buf.shape[0] != values_buf.shape[0]) {
+    throw PyLSHNearestNeighborTableError("inconsistent CSR arrays");
+  }
+  CSRPointSet<T> converted_points;
+  converted_points.indptr = (int64_t *)indptr_buf.ptr;
+  converted_points.indices = (int32_t *)indices_buf.ptr;
+  converted_points.values = (T *)values_buf.ptr;
+  converted_points.num_points = indptr_buf.shape[0] - 1;
+  converted_points.dimension = dimension;
+  return converted_points;
+}
+
+// A sparse query is passed as a pair (indices, values) of NumPy arrays.
+template <typename T>
+using SparseQuery = std::pair<NumPyArray<int32_t>, NumPyArray<T>>;
+
+template <typename T>
+SparseVector<T> numpy_to_sparse_vector(SparseQuery<T> q) {
+  py::buffer_info indices_buf = q.first.request();
+  py::buffer_info values_buf = q.second.request();
+  if (indices_buf.ndim != 1 || values_buf.ndim != 1) {
+    throw PyLSHNearestNeighborTableError("expected one-dimensional arrays");
+  }
+  if (indices_buf.shape[0] != values_buf.shape[0]) {
+    throw PyLSHNearestNeighborTableError(
+        "indices and values must have the same length");
+  }
+  const int32_t *indices = (int32_t *)indices_buf.ptr;
+  const T *values = (T *)values_buf.ptr;
+  SparseVector<T> result(indices_buf.shape[0]);
+  for (size_t ii = 0; ii < result.size(); ++ii) {
+    result[ii] = std::make_pair(indices[ii], values[ii]);
+  }
+  return result;
+}
+
 template <typename T>
 using LSHTable = LSHNearestNeighborTable<DenseVector<T>>;
 template <typename T>
@@ -489,6 +537,225 @@ std::unique_ptr<OuterLSHTable> construct_table_dense_double(
 
 }  // namespace double_precision
 
+namespace sparse_single_precision {
+
+typedef float ScalarType;
+typedef SparseVector<ScalarType> InnerVector;
+typedef CSRPointSet<ScalarType> InnerCSRPointSet;
+typedef LSHNearestNeighborTable<InnerVector> InnerLSHTable;
+typedef LSHNearestNeighborQuery<InnerVector> InnerLSHQueryObject;
+typedef LSHNearestNeighborQueryPool<InnerVector> InnerLSHQueryPool;
+
+typedef NumPyArray<ScalarType> OuterNumPyArray;
+typedef SparseQuery<ScalarType> OuterSparseQuery;
+
+class PyLSHNearestNeighborQuerySparseFloat {
+ public:
+  PyLSHNearestNeighborQuerySparseFloat(
+      std::shared_ptr<InnerLSHQueryObject> query_object)
+      : inner_entity_(query_object) {}
+
+  void set_num_probes(int_fast64_t num_probes) {
+    py::gil_scoped_release release;
+    inner_entity_->set_num_probes(num_probes);
+  }
+
+  int_fast64_t get_num_probes() {
+    py::gil_scoped_release release;
+    return inner_entity_->get_num_probes();
+  }
+
+  void set_max_num_candidates(int_fast64_t max_num_candidates) {
+    py::gil_scoped_release release;
+    return inner_entity_->set_max_num_candidates(max_num_candidates);
+  }
+
+  int_fast64_t get_max_num_candidates() {
+    py::gil_scoped_release release;
+    return inner_entity_->get_max_num_candidates();
+  }
+
+  int32_t find_nearest_neighbor(OuterSparseQuery q) {
+    InnerVector converted_query = numpy_to_sparse_vector(q);
+    py::gil_scoped_release release;
+    return inner_entity_->find_nearest_neighbor(converted_query);
+  }
+
+  std::vector<int32_t> find_k_nearest_neighbors(OuterSparseQuery q,
+                                                int_fast64_t k) {
+    InnerVector converted_query = numpy_to_sparse_vector(q);
+    py::gil_scoped_release release;
+    std::vector<int32_t> result;
+    inner_entity_->find_k_nearest_neighbors(converted_query, k, &result);
+    return result;
+  }
+
+  std::vector<int32_t> find_near_neighbors(OuterSparseQuery q,
+                                           ScalarType threshold) {
+    InnerVector converted_query = numpy_to_sparse_vector(q);
+    py::gil_scoped_release release;
+    std::vector<int32_t> result;
+    inner_entity_->find_near_neighbors(converted_query, threshold, &result);
+    return result;
+  }
+
+  std::vector<int32_t> get_unique_candidates(OuterSparseQuery q) {
+    InnerVector converted_query = numpy_to_sparse_vector(q);
+    py::gil_scoped_release release;
+    std::vector<int32_t> result;
+    inner_entity_->get_unique_candidates(converted_query, &result);
+    return result;
+  }
+
+  std::vector<int32_t> get_candidates_with_duplicates(OuterSparseQuery q) {
+    InnerVector converted_query = numpy_to_sparse_vector(q);
+    py::gil_scoped_release release;
+    std::vector<int32_t> result;
+    inner_entity_->get_candidates_with_duplicates(converted_query, &result);
+    return result;
+  }
+
+  void reset_query_statistics() {
+    py::gil_scoped_release release;
+    inner_entity_->reset_query_statistics();
+  }
+
+  QueryStatistics get_query_statistics() {
+    py::gil_scoped_release release;
+    return inner_entity_->get_query_statistics();
+  }
+
+ private:
+  std::shared_ptr<InnerLSHQueryObject> inner_entity_;
+};
+
+class PyLSHNearestNeighborQueryPoolSparseFloat {
+ public:
+  PyLSHNearestNeighborQueryPoolSparseFloat(
+      std::shared_ptr<InnerLSHQueryPool> query_pool)
+      : inner_entity_(query_pool) {}
+
+  void set_num_probes(int_fast64_t num_probes) {
+    py::gil_scoped_release release;
+    inner_entity_->set_num_probes(num_probes);
+  }
+
+  int_fast64_t get_num_probes() {
+    py::gil_scoped_release release;
+    return inner_entity_->get_num_probes();
+  }
+
+  void set_max_num_candidates(int_fast64_t max_num_candidates) {
+    py::gil_scoped_release release;
+    return inner_entity_->set_max_num_candidates(max_num_candidates);
+  }
+
+  int_fast64_t get_max_num_candidates() {
+    py::gil_scoped_release release;
+    return inner_entity_->get_max_num_candidates();
+  }
+
+  int32_t find_nearest_neighbor(OuterSparseQuery q) {
+    InnerVector converted_query = numpy_to_sparse_vector(q);
+    py::gil_scoped_release release;
+    return inner_entity_->find_nearest_neighbor(converted_query);
+  }
+
+  std::vector<int32_t> find_k_nearest_neighbors(OuterSparseQuery q,
+                                                int_fast64_t k) {
+    InnerVector converted_query = numpy_to_sparse_vector(q);
+    py::gil_scoped_release release;
+    std::vector<int32_t> result;
+    inner_entity_->find_k_nearest_neighbors(converted_query, k, &result);
+    return result;
+  }
+
+  std::vector<int32_t> find_near_neighbors(OuterSparseQuery q,
+                                           ScalarType threshold) {
+    InnerVector converted_query = numpy_to_sparse_vector(q);
+    py::gil_scoped_release release;
+    std::vector<int32_t> result;
+    inner_entity_->find_near_neighbors(converted_query, threshold, &result);
+    return result;
+  }
+
+  std::vector<int32_t> get_unique_candidates(OuterSparseQuery q) {
+    InnerVector converted_query = numpy_to_sparse_vector(q);
+    py::gil_scoped_release release;
+    std::vector<int32_t> result;
+    inner_entity_->get_unique_candidates(converted_query, &result);
+    return result;
+  }
+
+  std::vector<int32_t> get_candidates_with_duplicates(OuterSparseQuery q) {
+    InnerVector converted_query = numpy_to_sparse_vector(q);
+    py::gil_scoped_release release;
+    std::vector<int32_t> result;
+    inner_entity_->get_candidates_with_duplicates(converted_query, &result);
+    return result;
+  }
+
+  void reset_query_statistics() {
+    py::gil_scoped_release release;
+    inner_entity_->reset_query_statistics();
+  }
+
+  QueryStatistics get_query_statistics() {
+    py::gil_scoped_release release;
+    return inner_entity_->get_query_statistics();
+  }
+
+ private:
+  std::shared_ptr<InnerLSHQueryPool> inner_entity_;
+};
+
+typedef PyLSHNearestNeighborQuerySparseFloat OuterLSHQueryObject;
+typedef PyLSHNearestNeighborQueryPoolSparseFloat OuterLSHQueryPool;
+
+class PyLSHNearestNeighborTableSparseFloat {
+ public:
+  PyLSHNearestNeighborTableSparseFloat(std::shared_ptr<InnerLSHTable> table)
+      : table_(table) {}
+
+  std::unique_ptr<OuterLSHQueryObject> construct_query_object(
+      int_fast64_t num_probes = -1,
+      int_fast64_t max_num_candidates = -1) const {
+    std::unique_ptr<InnerLSHQueryObject> inner_query_object =
+        table_->construct_query_object(num_probes, max_num_candidates);
+    return std::unique_ptr<OuterLSHQueryObject>(
+        new OuterLSHQueryObject(std::move(inner_query_object)));
+  }
+
+  std::unique_ptr<OuterLSHQueryPool> construct_query_pool(
+      int_fast64_t num_probes = -1, int_fast64_t max_num_candidates = -1,
+      int_fast64_t num_query_objects = 0) const {
+    std::unique_ptr<InnerLSHQueryPool> inner_query_pool =
+        table_->construct_query_pool(num_probes, max_num_candidates,
+                                     num_query_objects);
+    return std::unique_ptr<OuterLSHQueryPool>(
+        new OuterLSHQueryPool(std::move(inner_query_pool)));
+  }
+
+ private:
+  std::shared_ptr<InnerLSHTable> table_;
+};
+
+typedef PyLSHNearestNeighborTableSparseFloat OuterLSHTable;
+
+std::unique_ptr<OuterLSHTable> construct_table_sparse_float(
+    NumPyArray<int64_t> indptr, NumPyArray<int32_t> indices,
+    OuterNumPyArray values, const LSHConstructionParameters &params) {
+  InnerCSRPointSet converted_points =
+      numpy_to_csr_dataset(indptr, indices, values, params.dimension);
+  std::unique_ptr<InnerLSHTable> inner_table =
+      construct_table<InnerVector, int32_t, InnerCSRPointSet>(converted_points,
+                                                              params);
+  return std::unique_ptr<OuterLSHTable>(
+      new OuterLSHTable(std::move(inner_table)));
+}
+
+}  // namespace sparse_single_precision
+
 PYBIND11_MODULE(_falconn, m) {
   using single_precision::PyLSHNearestNeighborTableDenseFloat;
   using single_precision::PyLSHNearestNeighborQueryDenseFloat;
@@ -498,6 +765,10 @@ PYBIND11_MODULE(_falconn, m) {
   using double_precision::PyLSHNearestNeighborQueryDenseDouble;
   using double_precision::PyLSHNearestNeighborQueryPoolDenseDouble;
   using double_precision::construct_table_dense_double;
+  using sparse_single_precision::PyLSHNearestNeighborTableSparseFloat;
+  using sparse_single_precision::PyLSHNearestNeighborQuerySparseFloat;
+  using sparse_single_precision::PyLSHNearestNeighborQueryPoolSparseFloat;
+  using sparse_single_precision::construct_table_sparse_float;
 
   py::enum_<LSHFamily>(m, "LSHFamily")
       .value("Unknown", LSHFamily::Unknown)
@@ -514,8 +785,9 @@ PYBIND11_MODULE(_falconn, m) {
       .value("STLHashTable", StorageHashTable::STLHashTable)
       .value("LinearProbingHashTable",
              StorageHashTable::LinearProbingHashTable);
-  // we do not expose feature_hashing_dimension, since the wrapper does
-  // not support sparse datasets yet
+  py::enum_<RetrievalOrder>(m, "RetrievalOrder")
+      .value("ByTable", RetrievalOrder::ByTable)
+      .value("ByScore", RetrievalOrder::ByScore);
   py::class_<LSHConstructionParameters>(m, "LSHConstructionParameters")
       .def(py::init<>())
       .def_readwrite("dimension", &LSHConstructionParameters::dimension)
@@ -529,10 +801,33 @@ PYBIND11_MODULE(_falconn, m) {
       .def_readwrite("num_setup_threads",
                      &LSHConstructionParameters::num_setup_threads)
       .def_readwrite("seed", &LSHConstructionParameters::seed)
+      .def_readwrite("feature_hashing_dimension",
+                     &LSHConstructionParameters::feature_hashing_dimension)
+      .def_readwrite("computed_feature_hashing",
+                     &LSHConstructionParameters::computed_feature_hashing)
       .def_readwrite("last_cp_dimension",
                      &LSHConstructionParameters::last_cp_dimension)
       .def_readwrite("num_rotations",
-                     &LSHConstructionParameters::num_rotations);
+                     &LSHConstructionParameters::num_rotations)
+      .def_readwrite("reorder_points",
+                     &LSHConstructionParameters::reorder_points)
+      .def_readwrite(
+          "hyperplane_probing_template_size",
+          &LSHConstructionParameters::hyperplane_probing_template_size)
+      .def_readwrite("retrieval_order",
+                     &LSHConstructionParameters::retrieval_order)
+      .def_readwrite("max_num_candidates_per_table",
+                     &LSHConstructionParameters::max_num_candidates_per_table)
+      .def_readwrite("skip_empty_buckets",
+                     &LSHConstructionParameters::skip_empty_buckets)
+      .def_readwrite("bucket_size_penalty",
+                     &LSHConstructionParameters::bucket_size_penalty)
+      .def_readwrite("max_bucket_size",
+                     &LSHConstructionParameters::max_bucket_size)
+      .def_readwrite("min_num_collisions",
+                     &LSHConstructionParameters::min_num_collisions)
+      .def_readwrite("kept_candidate_fraction",
+                     &LSHConstructionParameters::kept_candidate_fraction);
   // we do not expose a constructor and make all the members read-only
   py::class_<QueryStatistics>(m, "QueryStatistics")
       .def_readonly("average_total_query_time",
@@ -567,8 +862,19 @@ PYBIND11_MODULE(_falconn, m) {
            &PyLSHNearestNeighborTableDenseDouble::construct_query_pool,
            py::arg("num_probes") = -1, py::arg("max_num_candidates") = -1,
            py::arg("num_query_objects") = 0);
+  // we do not expose a constructor
+  py::class_<PyLSHNearestNeighborTableSparseFloat>(
+      m, "PyLSHNearestNeighborTableSparseFloat")
+      .def("construct_query_object",
+           &PyLSHNearestNeighborTableSparseFloat::construct_query_object,
+           py::arg("num_probes") = -1, py::arg("max_num_candidates") = -1)
+      .def("construct_query_pool",
+           &PyLSHNearestNeighborTableSparseFloat::construct_query_pool,
+           py::arg("num_probes") = -1, py::arg("max_num_candidates") = -1,
+           py::arg("num_query_objects") = 0);
   m.def("construct_table_dense_float", &construct_table_dense_float, "");
   m.def("construct_table_dense_double", &construct_table_dense_double, "");
+  m.def("construct_table_sparse_float", &construct_table_sparse_float, "");
 
   // we do not expose a constructor
   py::class_<PyLSHNearestNeighborQueryDenseFloat>(
@@ -676,6 +982,63 @@ PYBIND11_MODULE(_falconn, m) {
            &PyLSHNearestNeighborQueryPoolDenseDouble::reset_query_statistics)
       .def("get_query_statistics",
            &PyLSHNearestNeighborQueryPoolDenseDouble::get_query_statistics);
+  // we do not expose a constructor
+  py::class_<PyLSHNearestNeighborQuerySparseFloat>(
+      m, "PyLSHNearestNeighborQuerySparseFloat")
+      .def("set_num_probes",
+           &PyLSHNearestNeighborQuerySparseFloat::set_num_probes)
+      .def("get_num_probes",
+           &PyLSHNearestNeighborQuerySparseFloat::get_num_probes)
+      .def("set_max_num_candidates",
+           &PyLSHNearestNeighborQuerySparseFloat::set_max_num_candidates)
+      .def("get_max_num_candidates",
+           &PyLSHNearestNeighborQuerySparseFloat::get_max_num_candidates)
+      .def("find_nearest_neighbor",
+           &PyLSHNearestNeighborQuerySparseFloat::find_nearest_neighbor)
+      .def("find_k_nearest_neighbors",
+           &PyLSHNearestNeighborQuerySparseFloat::find_k_nearest_neighbors)
+      .def("find_near_neighbors",
+           &PyLSHNearestNeighborQuerySparseFloat::find_near_neighbors)
+      .def("get_unique_candidates",
+           &PyLSHNearestNeighborQuerySparseFloat::get_unique_candidates)
+      .def("get_candidates_with_duplicates",
+           &PyLSHNearestNeighborQuerySparseFloat::
+               get_candidates_with_duplicates)
+      .def("reset_query_statistics",
+           &PyLSHNearestNeighborQuerySparseFloat::reset_query_statistics)
+      .def("get_query_statistics",
+           &PyLSHNearestNeighborQuerySparseFloat::get_query_statistics);
+
+  // we do not expose a constructor
+  py::class_<PyLSHNearestNeighborQueryPoolSparseFloat>(
+      m, "PyLSHNearestNeighborQueryPoolSparseFloat")
+      .def("set_num_probes",
+           &PyLSHNearestNeighborQueryPoolSparseFloat::set_num_probes)
+      .def("get_num_probes",
+           &PyLSHNearestNeighborQueryPoolSparseFloat::get_num_probes)
+      .def("set_max_num_candidates",
+           &PyLSHNearestNeighborQueryPoolSparseFloat::
+               set_max_num_candidates)
+      .def("get_max_num_candidates",
+           &PyLSHNearestNeighborQueryPoolSparseFloat::
+               get_max_num_candidates)
+      .def("find_nearest_neighbor",
+           &PyLSHNearestNeighborQueryPoolSparseFloat::find_nearest_neighbor)
+      .def("find_k_nearest_neighbors",
+           &PyLSHNearestNeighborQueryPoolSparseFloat::
+               find_k_nearest_neighbors)
+      .def("find_near_neighbors",
+           &PyLSHNearestNeighborQueryPoolSparseFloat::find_near_neighbors)
+      .def("get_unique_candidates",
+           &PyLSHNearestNeighborQueryPoolSparseFloat::get_unique_candidates)
+      .def("get_candidates_with_duplicates",
+           &PyLSHNearestNeighborQueryPoolSparseFloat::
+               get_candidates_with_duplicates)
+      .def("reset_query_statistics",
+           &PyLSHNearestNeighborQueryPoolSparseFloat::
+               reset_query_statistics)
+      .def("get_query_statistics",
+           &PyLSHNearestNeighborQueryPoolSparseFloat::get_query_statistics);
 
   m.def("compute_number_of_hash_functions",
         &compute_number_of_hash_functions<DenseVector<float>>, "",
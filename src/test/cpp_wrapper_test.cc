@@ -1,6 +1,8 @@
 #include "falconn/lsh_nn_table.h"
 
+#include <algorithm>
 #include <memory>
+#include <random>
 #include <utility>
 #include <vector>
 
@@ -8,6 +10,7 @@
 
 using falconn::compute_number_of_hash_functions;
 using falconn::construct_table;
+using falconn::CSRPointSet;
 using falconn::DenseVector;
 using falconn::DistanceFunction;
 using falconn::LSHConstructionParameters;
@@ -15,6 +18,7 @@ using falconn::LSHFamily;
 using falconn::LSHNearestNeighborTable;
 using falconn::LSHNearestNeighborQuery;
 using falconn::LSHNearestNeighborQueryPool;
+using falconn::PlainArrayPointSet;
 using falconn::get_default_parameters;
 using falconn::SparseVector;
 using falconn::StorageHashTable;
@@ -114,6 +118,39 @@ void basic_test_sparse_1(const LSHConstructionParameters& params) {
   EXPECT_EQ(1, res4);
 }
 
+void basic_test_sparse_csr_1(const LSHConstructionParameters& params) {
+  typedef SparseVector<float> Point;
+  // the same points as in basic_test_sparse_1
+  vector<int64_t> indptr = {0, 1, 3, 4};
+  vector<int32_t> indices = {24, 7, 24, 50};
+  vector<float> values = {1.0, 0.8, 0.6, 1.0};
+  CSRPointSet<float> points;
+  points.indptr = indptr.data();
+  points.indices = indices.data();
+  points.values = values.data();
+  points.num_points = 3;
+  points.dimension = params.dimension;
+
+  unique_ptr<LSHNearestNeighborTable<Point>> table(
+      construct_table<Point>(points, params));
+  unique_ptr<LSHNearestNeighborQuery<Point>> query(
+      table->construct_query_object());
+
+  Point p1;
+  p1.push_back(make_pair(24, 1.0));
+  Point p2;
+  p2.push_back(make_pair(7, 0.8));
+  p2.push_back(make_pair(24, 0.6));
+  Point p3;
+  p3.push_back(make_pair(50, 1.0));
+  Point p4;
+  p4.push_back(make_pair(7, 1.0));
+  EXPECT_EQ(0, query->find_nearest_neighbor(p1));
+  EXPECT_EQ(1, query->find_nearest_neighbor(p2));
+  EXPECT_EQ(2, query->find_nearest_neighbor(p3));
+  EXPECT_EQ(1, query->find_nearest_neighbor(p4));
+}
+
 TEST(WrapperTest, DenseHPTest1) {
   int dim = 4;
   LSHConstructionParameters params;
@@ -231,6 +268,147 @@ TEST(WrapperTest, LinearProbingHashTableTest1) {
   basic_test_dense_1(params);
 }
 
+// Building the table on a reordered copy of the points must not change the
+// results (which are reported with the original keys).
+template <typename PointSet>
+void reorder_points_test_1(const PointSet& points,
+                           const vector<DenseVector<float>>& queries,
+                           LSHConstructionParameters params) {
+  typedef DenseVector<float> Point;
+  params.reorder_points = false;
+  unique_ptr<LSHNearestNeighborTable<Point>> table(
+      construct_table<Point>(points, params));
+  params.reorder_points = true;
+  unique_ptr<LSHNearestNeighborTable<Point>> reordered_table(
+      construct_table<Point>(points, params));
+
+  unique_ptr<LSHNearestNeighborQuery<Point>> query(
+      table->construct_query_object());
+  unique_ptr<LSHNearestNeighborQuery<Point>> reordered_query(
+      reordered_table->construct_query_object());
+  unique_ptr<LSHNearestNeighborQueryPool<Point>> reordered_pool(
+      reordered_table->construct_query_pool());
+
+  for (const Point& q : queries) {
+    EXPECT_EQ(query->find_nearest_neighbor(q),
+              reordered_query->find_nearest_neighbor(q));
+    EXPECT_EQ(query->find_nearest_neighbor(q),
+              reordered_pool->find_nearest_neighbor(q));
+
+    vector<int32_t> expected;
+    vector<int32_t> result;
+    query->find_k_nearest_neighbors(q, 5, &expected);
+    reordered_query->find_k_nearest_neighbors(q, 5, &result);
+    EXPECT_EQ(expected, result);
+    reordered_pool->find_k_nearest_neighbors(q, 5, &result);
+    EXPECT_EQ(expected, result);
+
+    query->find_near_neighbors(q, -0.5, &expected);
+    reordered_query->find_near_neighbors(q, -0.5, &result);
+    std::sort(expected.begin(), expected.end());
+    std::sort(result.begin(), result.end());
+    EXPECT_EQ(expected, result);
+
+    query->get_unique_candidates(q, &expected);
+    reordered_query->get_unique_candidates(q, &result);
+    std::sort(expected.begin(), expected.end());
+    std::sort(result.begin(), result.end());
+    EXPECT_EQ(expected, result);
+  }
+}
+
+TEST(WrapperTest, ReorderPointsTest1) {
+  typedef DenseVector<float> Point;
+  int dim = 8;
+  int num_points = 500;
+  std::mt19937_64 gen(3391852);
+  std::normal_distribution<float> gauss(0.0, 1.0);
+  vector<Point> points(num_points, Point(dim));
+  vector<float> plain_points(num_points * dim);
+  for (int ii = 0; ii < num_points; ++ii) {
+    for (int jj = 0; jj < dim; ++jj) {
+      points[ii][jj] = gauss(gen);
+    }
+    points[ii].normalize();
+    for (int jj = 0; jj < dim; ++jj) {
+      plain_points[ii * dim + jj] = points[ii][jj];
+    }
+  }
+  vector<Point> queries(points.begin(), points.begin() + 10);
+
+  LSHConstructionParameters params;
+  params.dimension = dim;
+  params.lsh_family = LSHFamily::Hyperplane;
+  params.distance_function = DistanceFunction::NegativeInnerProduct;
+  params.storage_hash_table = StorageHashTable::BitPackedFlatHashTable;
+  params.k = 4;
+  params.l = 6;
+  params.num_setup_threads = 0;
+
+  reorder_points_test_1(points, queries, params);
+
+  PlainArrayPointSet<float> plain_point_set;
+  plain_point_set.data = plain_points.data();
+  plain_point_set.num_points = num_points;
+  plain_point_set.dimension = dim;
+  reorder_points_test_1(plain_point_set, queries, params);
+}
+
+TEST(WrapperTest, SparseCSRTest1) {
+  LSHConstructionParameters params;
+  params.dimension = 100;
+  params.lsh_family = LSHFamily::Hyperplane;
+  params.distance_function = DistanceFunction::NegativeInnerProduct;
+  params.storage_hash_table = StorageHashTable::BitPackedFlatHashTable;
+  params.k = 2;
+  params.l = 4;
+  params.num_setup_threads = 0;
+  basic_test_sparse_csr_1(params);
+
+  params.lsh_family = LSHFamily::CrossPolytope;
+  params.feature_hashing_dimension = 8;
+  params.last_cp_dimension = 8;
+  params.num_rotations = 3;
+  basic_test_sparse_csr_1(params);
+
+  params.reorder_points = true;
+  basic_test_sparse_csr_1(params);
+}
+
+// The dimension is one of the dimensions with specialized distance kernels.
+TEST(WrapperTest, FixedDimensionTest1) {
+  typedef DenseVector<float> Point;
+  int dim = 128;
+  int n = 1000;
+  std::mt19937_64 gen(81237712);
+  std::normal_distribution<float> gauss(0.0, 1.0);
+  vector<Point> points(n, Point(dim));
+  for (Point& p : points) {
+    for (int ii = 0; ii < dim; ++ii) {
+      p[ii] = gauss(gen);
+    }
+    p.normalize();
+  }
+
+  for (DistanceFunction distance_function :
+       {DistanceFunction::NegativeInnerProduct,
+        DistanceFunction::EuclideanSquared}) {
+    LSHConstructionParameters params = get_default_parameters<Point>(
+        n, dim, distance_function, true);
+    unique_ptr<LSHNearestNeighborTable<Point>> table(
+        construct_table<Point>(points, params));
+    unique_ptr<LSHNearestNeighborQuery<Point>> query(
+        table->construct_query_object());
+    unique_ptr<LSHNearestNeighborQueryPool<Point>> pool(
+        table->construct_query_pool());
+    // every point collides with itself in all tables
+    for (int32_t ii = 0; ii < n; ii += 37) {
+      EXPECT_EQ(ii, query->find_nearest_neighbor(points[ii]));
+      EXPECT_EQ(ii, pool->find_nearest_neighbor(points[ii]));
+    }
+  }
+}
+
 TEST(WrapperTest, ComputeNumberOfHashFunctionsTest) {
   typedef DenseVector<float> VecDense;
   typedef SparseVector<float> VecSparse;
@@ -0,0 +1,244 @@
+#include "falconn/core/cpu_dispatch.h"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "falconn/core/cosine_distance.h"
+#include "falconn/core/euclidean_distance.h"
+#include "falconn/ffht/fht_header_only.h"
+
+namespace fc = falconn::core;
+namespace fh = falconn::core::cpu_dispatch_helpers;
+
+using fc::CosineDistanceDense;
+using fc::CpuKernels;
+using fc::EuclideanDistanceDense;
+using fc::InstructionSet;
+using std::vector;
+
+static const InstructionSet all_instruction_sets[] = {
+    InstructionSet::AVX512, InstructionSet::AVX2, InstructionSet::Generic};
+
+static vector<float> random_vector(int_fast64_t n, std::mt19937_64* gen) {
+  std::normal_distribution<float> gauss(0.0, 1.0);
+  vector<float> res(n);
+  for (auto& x : res) {
+    x = gauss(*gen);
+  }
+  return res;
+}
+
+TEST(CpuDispatchTest, InstructionSetTest1) {
+  EXPECT_TRUE(fc::instruction_set_supported(InstructionSet::Generic));
+  EXPECT_TRUE(fc::instruction_set_supported(fc::best_instruction_set()));
+  for (InstructionSet isa : all_instruction_sets) {
+    if (fc::instruction_set_supported(isa)) {
+      EXPECT_LE(static_cast<int>(fc::best_instruction_set()),
+                static_cast<int>(isa));
+    }
+  }
+}
+
+TEST(CpuDispatchTest, DistanceKernelTest1) {
+  std::mt19937_64 gen(4591023);
+  // lengths that exercise the tails of all vector widths
+  vector<int_fast64_t> lengths = {100, 128, 960, 1000};
+  for (int_fast64_t n = 1; n <= 70; ++n) {
+    lengths.push_back(n);
+  }
+  for (InstructionSet isa : all_instruction_sets) {
+    if (!fc::instruction_set_supported(isa)) {
+      continue;
+    }
+    CpuKernels kernels = fc::get_cpu_kernels(isa);
+    for (int_fast64_t n : lengths) {
+      vector<float> a = random_vector(n, &gen);
+      vector<float> b = random_vector(n, &gen);
+      double expected_dot = 0.0;
+      double expected_distance = 0.0;
+      for (int_fast64_t ii = 0; ii < n; ++ii) {
+        expected_dot += static_cast<double>(a[ii]) * b[ii];
+        double diff = static_cast<double>(a[ii]) - b[ii];
+        expected_distance += diff * diff;
+      }
+      EXPECT_NEAR(expected_dot, kernels.dot_product(a.data(), b.data(), n),
+                  1e-4 * n);
+      EXPECT_NEAR(expected_distance,
+                  kernels.squared_distance(a.data(), b.data(), n), 1e-4 * n);
+    }
+  }
+}
+
+TEST(CpuDispatchTest, FixedDimensionKernelTest1) {
+  std::mt19937_64 gen(7712094);
+  for (InstructionSet isa : all_instruction_sets) {
+    if (!fc::instruction_set_supported(isa)) {
+      continue;
+    }
+    CpuKernels kernels = fc::get_cpu_kernels(isa);
+    for (int ii = 0; ii < fc::kNumFixedDimensions; ++ii) {
+      int_fast64_t n = fc::kFixedDimensions[ii];
+      CpuKernels fixed_kernels = fc::get_cpu_kernels(isa, n);
+      EXPECT_NE(kernels.dot_product, fixed_kernels.dot_product);
+      EXPECT_NE(kernels.squared_distance, fixed_kernels.squared_distance);
+      EXPECT_EQ(kernels.decode_cp, fixed_kernels.decode_cp);
+      vector<float> a = random_vector(n, &gen);
+      vector<float> b = random_vector(n, &gen);
+      // the same operations in the same order
+      EXPECT_EQ(kernels.dot_product(a.data(), b.data(), n),
+                fixed_kernels.dot_product(a.data(), b.data(), n));
+      EXPECT_EQ(kernels.squared_distance(a.data(), b.data(), n),
+                fixed_kernels.squared_distance(a.data(), b.data(), n));
+    }
+    CpuKernels other_kernels = fc::get_cpu_kernels(isa, 37);
+    EXPECT_EQ(kernels.dot_product, other_kernels.dot_product);
+    EXPECT_EQ(kernels.squared_distance, other_kernels.squared_distance);
+  }
+  EXPECT_EQ(fc::cpu_kernels().dot_product, fc::cpu_kernels(37).dot_product);
+  EXPECT_EQ(fc::get_cpu_kernels(fc::best_instruction_set(), 960).dot_product,
+            fc::cpu_kernels(960).dot_product);
+}
+
+TEST(CpuDispatchTest, DecodeCPTest1) {
+  std::mt19937_64 gen(77120934);
+  std::uniform_int_distribution<int> small(-3, 3);
+  for (InstructionSet isa : all_instruction_sets) {
+    if (!fc::instruction_set_supported(isa)) {
+      continue;
+    }
+    CpuKernels kernels = fc::get_cpu_kernels(isa);
+    for (int_fast64_t n = 1; n <= 70; ++n) {
+      for (int rep = 0; rep < 20; ++rep) {
+        vector<float> data = random_vector(n, &gen);
+        EXPECT_EQ(fh::decode_cp_generic(data.data(), n),
+                  kernels.decode_cp(data.data(), n));
+        // many ties between positive and negative entries
+        for (auto& x : data) {
+          x = small(gen);
+        }
+        EXPECT_EQ(fh::decode_cp_generic(data.data(), n),
+                  kernels.decode_cp(data.data(), n));
+      }
+    }
+    vector<float> data = {0.0, -0.0, 0.0, 0.0};
+    EXPECT_EQ(0, kernels.decode_cp(data.data(), 4));
+    data = {-0.5, 0.25, -2.0, 2.0, 1.0};
+    EXPECT_EQ(7, kernels.decode_cp(data.data(), 5));
+  }
+}
+
+TEST(CpuDispatchTest, HammingDistanceTest1) {
+  std::mt19937_64 gen(1209341);
+  for (InstructionSet isa : all_instruction_sets) {
+    if (!fc::instruction_set_supported(isa)) {
+      continue;
+    }
+    CpuKernels kernels = fc::get_cpu_kernels(isa);
+    for (int_fast32_t num_chunks = 0; num_chunks <= 9; ++num_chunks) {
+      vector<uint64_t> a(num_chunks), b(num_chunks);
+      int_fast32_t expected = 0;
+      for (int_fast32_t ii = 0; ii < num_chunks; ++ii) {
+        a[ii] = gen();
+        b[ii] = gen();
+        for (int bit = 0; bit < 64; ++bit) {
+          expected += ((a[ii] ^ b[ii]) >> bit) & 1;
+        }
+      }
+      EXPECT_EQ(expected,
+                kernels.hamming_distance(a.data(), b.data(), num_chunks));
+    }
+  }
+}
+
+TEST(CpuDispatchTest, FHTTest1) {
+  std::mt19937_64 gen(5012934);
+  std::uniform_int_distribution<int> sign(0, 1);
+  for (int isa = 0; isa < FHT_NUM_ISAS; ++isa) {
+    if (!fht_isa_supported(isa)) {
+      continue;
+    }
+    for (int log_n = 0; log_n <= 16; ++log_n) {
+      int n = 1 << log_n;
+      vector<float> f1(n), f2(n);
+      vector<double> d1(n), d2(n);
+      for (int ii = 0; ii < n; ++ii) {
+        f1[ii] = f2[ii] = 2 * sign(gen) - 1;
+        d1[ii] = d2[ii] = 2 * sign(gen) - 1;
+      }
+      vector<float> f3 = f1;
+      vector<double> d3 = d1;
+      ASSERT_EQ(0, fht_float_kernel(isa)(f1.data(), log_n));
+      ASSERT_EQ(0, fht_float_generic(f2.data(), log_n));
+      ASSERT_EQ(0, fht_double_kernel(isa)(d1.data(), log_n));
+      ASSERT_EQ(0, fht_double_generic(d2.data(), log_n));
+      // all values are small integers, so the results are exact
+      EXPECT_EQ(f2, f1);
+      EXPECT_EQ(d2, d1);
+
+      fht_float_fixed_function float_fixed = fht_float_fixed_kernel(isa, log_n);
+      fht_double_fixed_function double_fixed =
+          fht_double_fixed_kernel(isa, log_n);
+      if (isa == FHT_ISA_GENERIC || log_n == 0) {
+        EXPECT_TRUE(float_fixed == NULL);
+        EXPECT_TRUE(double_fixed == NULL);
+      } else {
+        ASSERT_TRUE(float_fixed != NULL);
+        ASSERT_TRUE(double_fixed != NULL);
+        float_fixed(f3.data());
+        double_fixed(d3.data());
+        EXPECT_EQ(f2, f3);
+        EXPECT_EQ(d2, d3);
+      }
+    }
+    vector<float> f(4);
+    EXPECT_EQ(1, fht_float_kernel(isa)(f.data(), 31));
+  }
+}
+
+TEST(CpuDispatchTest, DenseDistanceTest1) {
+  std::mt19937_64 gen(9023411);
+  int dim = 37;
+  vector<float> a = random_vector(dim, &gen);
+  vector<float> b = random_vector(dim, &gen);
+  Eigen::Map<const Eigen::VectorXf> map_a(a.data(), dim);
+  Eigen::Map<const Eigen::VectorXf> map_b(b.data(), dim);
+  Eigen::VectorXf vec_a = map_a;
+  Eigen::VectorXf vec_b = map_b;
+
+  CosineDistanceDense<float> cosine;
+  EuclideanDistanceDense<float> euclidean;
+  float dot = map_a.dot(map_b);
+  float distance = (map_a - map_b).squaredNorm();
+  EXPECT_NEAR(-dot, cosine(vec_a, vec_b), 1e-4);
+  EXPECT_NEAR(-dot, cosine(map_a, vec_b), 1e-4);
+  EXPECT_NEAR(distance, euclidean(vec_a, vec_b), 1e-4);
+  EXPECT_NEAR(distance, euclidean(vec_a, map_b), 1e-4);
+
+  // kernels for a dimension without specialized ones
+  CosineDistanceDense<float> cosine_37(dim);
+  EuclideanDistanceDense<float> euclidean_37(dim);
+  EXPECT_EQ(cosine(vec_a, vec_b), cosine_37(vec_a, vec_b));
+  EXPECT_EQ(euclidean(vec_a, vec_b), euclidean_37(vec_a, vec_b));
+
+  int fixed_dim = 96;
+  Eigen::VectorXf fixed_a = Eigen::Map<const Eigen::VectorXf>(
+      random_vector(fixed_dim, &gen).data(), fixed_dim);
+  Eigen::VectorXf fixed_b = Eigen::Map<const Eigen::VectorXf>(
+      random_vector(fixed_dim, &gen).data(), fixed_dim);
+  CosineDistanceDense<float> cosine_96(fixed_dim);
+  EuclideanDistanceDense<float> euclidean_96(fixed_dim);
+  EXPECT_NEAR(-fixed_a.dot(fixed_b), cosine_96(fixed_a, fixed_b), 1e-4);
+  EXPECT_NEAR((fixed_a - fixed_b).squaredNorm(),
+              euclidean_96(fixed_a, fixed_b), 1e-3);
+  // expressions without direct access take the Eigen path
+  EXPECT_NEAR(-2.0 * dot, cosine(2.0f * vec_a, vec_b), 1e-4);
+
+  Eigen::VectorXd double_a = vec_a.cast<double>();
+  Eigen::VectorXd double_b = vec_b.cast<double>();
+  CosineDistanceDense<double> double_cosine;
+  EXPECT_NEAR(-dot, double_cosine(double_a, double_b), 1e-4);
+}
@@ -144,3 +144,54 @@ TEST(DataStorageTest, PlainArrayTest2) {
     EXPECT_EQ(data[ii], ii + 1.0);
   }
 }
+
+TEST(DataStorageTest, BucketOrderTest1) {
+  std::vector<uint32_t> hashes = {5, 1, 5, 0, 1, 5};
+  std::vector<int32_t> order;
+  fc::compute_bucket_order(hashes, &order);
+  std::vector<int32_t> expected_order = {3, 1, 4, 0, 2, 5};
+  EXPECT_EQ(expected_order, order);
+}
+
+TEST(DataStorageTest, CSRTest1) {
+  // three points: {0: 1.0, 3: 2.0}, {}, {1: 3.0}
+  int64_t indptr[] = {0, 2, 2, 3};
+  int32_t indices[] = {0, 3, 1};
+  float values[] = {1.0, 2.0, 3.0};
+  fc::CSRDataStorage<float> ds(indptr, indices, values, 3);
+
+  ASSERT_EQ(3, ds.size());
+
+  auto iter = ds.get_full_sequence();
+  ASSERT_TRUE(iter.is_valid());
+  EXPECT_EQ(0, iter.get_key());
+  ASSERT_EQ(2, iter.get_point().size());
+  EXPECT_EQ(0, iter.get_point()[0].first);
+  EXPECT_EQ(1.0, iter.get_point()[0].second);
+  EXPECT_EQ(3, iter.get_point()[1].first);
+  EXPECT_EQ(2.0, iter.get_point()[1].second);
+  ++iter;
+  ASSERT_TRUE(iter.is_valid());
+  EXPECT_EQ(1, iter.get_key());
+  EXPECT_EQ(0, iter.get_point().size());
+  ++iter;
+  ASSERT_TRUE(iter.is_valid());
+  EXPECT_EQ(2, iter.get_key());
+  ASSERT_EQ(1, iter.get_point().size());
+  EXPECT_EQ(1, iter.get_point()[0].first);
+  EXPECT_EQ(3.0, iter.get_point()[0].second);
+  ++iter;
+  ASSERT_FALSE(iter.is_valid());
+
+  std::vector<int32_t> keys = {2, 0};
+  auto sub_iter = ds.get_subsequence(keys);
+  ASSERT_TRUE(sub_iter.is_valid());
+  EXPECT_EQ(2, sub_iter.get_key());
+  EXPECT_EQ(3.0, sub_iter.get_point()[0].second);
+  ++sub_iter;
+  ASSERT_TRUE(sub_iter.is_valid());
+  EXPECT_EQ(0, sub_iter.get_key());
+  EXPECT_EQ(2, sub_iter.get_point().size());
+  ++sub_iter;
+  ASSERT_FALSE(sub_iter.is_valid());
+}
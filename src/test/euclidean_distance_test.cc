@@ -1,14 +1,20 @@
 #include "falconn/core/euclidean_distance.h"
 
+#include <algorithm>
+#include <random>
 #include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
 
+#include "falconn/core/data_storage.h"
+
 namespace fc = falconn::core;
 
 using fc::EuclideanDistanceDense;
 using fc::EuclideanDistanceSparse;
+using fc::EuclideanDistanceSparseScatter;
+using fc::SparseVectorView;
 using std::make_pair;
 using std::vector;
 
@@ -77,3 +83,50 @@ TEST(EuclideanDistanceTest, DenseDistanceFunctionTest2) {
   float distance = distance_function(v1, v2);
   ASSERT_NEAR(distance, 101.25, eps);
 }
+
+static SparseVector random_sparse_vector(int max_nnz, int dim,
+                                         std::mt19937_64* gen) {
+  std::uniform_int_distribution<int> nnz_dist(0, max_nnz);
+  std::uniform_int_distribution<int> index_dist(0, dim - 1);
+  std::normal_distribution<float> value_dist(0.0, 1.0);
+  int nnz = nnz_dist(*gen);
+  vector<int> indices;
+  for (int ii = 0; ii < nnz; ++ii) {
+    indices.push_back(index_dist(*gen));
+  }
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+  SparseVector res;
+  for (int index : indices) {
+    res.push_back(make_pair(index, value_dist(*gen)));
+  }
+  return res;
+}
+
+TEST(EuclideanDistanceTest, SparseScatterTest1) {
+  // queries with a larger index range than the points and vice versa, and
+  // enough nonzeros to use the SIMD gather
+  std::mt19937_64 gen(4452391);
+  vector<SparseVector> points;
+  for (int ii = 0; ii < 20; ++ii) {
+    points.push_back(random_sparse_vector(40, 100, &gen));
+  }
+  EuclideanDistanceSparse<float> merge_distance;
+  EuclideanDistanceSparseScatter<float> scatter_distance;
+  for (int qq = 0; qq < 10; ++qq) {
+    SparseVector q = random_sparse_vector(40, qq % 2 == 0 ? 50 : 200, &gen);
+    scatter_distance.load_query(q);
+    for (const SparseVector& p : points) {
+      vector<int32_t> indices;
+      vector<float> values;
+      for (const auto& entry : p) {
+        indices.push_back(entry.first);
+        values.push_back(entry.second);
+      }
+      SparseVectorView<float> view(indices.data(), values.data(), p.size());
+      float expected = merge_distance(q, p);
+      ASSERT_NEAR(expected, scatter_distance(q, p), 1e-4);
+      ASSERT_NEAR(expected, scatter_distance(q, view), 1e-4);
+    }
+  }
+}
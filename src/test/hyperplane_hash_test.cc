@@ -1,6 +1,7 @@
 #include "falconn/core/hyperplane_hash.h"
 
 #include <algorithm>
+#include <cmath>
 #include <utility>
 #include <vector>
 
@@ -10,6 +11,7 @@
 #include "test_utils.h"
 
 namespace fc = falconn::core;
+namespace fh = falconn::core::hp_hash_helpers;
 namespace ft = falconn::test;
 
 using ft::count_bits;
@@ -475,6 +477,116 @@ TEST(HyperplaneHashTest, SparseHyperplaneMultiProbeTest2) {
   }
 }
 
+TEST(HyperplaneHashTest, ProbingTemplateTest1) {
+  for (int k : {1, 3, 8, 20}) {
+    vector<double> e = fh::expected_squared_order_statistics(k);
+    ASSERT_EQ(static_cast<size_t>(k), e.size());
+    double sum = 0.0;
+    for (int ii = 0; ii < k; ++ii) {
+      if (ii > 0) {
+        EXPECT_LT(e[ii - 1], e[ii]);
+      }
+      sum += e[ii];
+    }
+    // the squared absolute values have expectation 1 each
+    EXPECT_NEAR(k, sum, 1e-6 * k);
+  }
+
+  int k = 5;
+  vector<double> e = fh::expected_squared_order_statistics(k);
+  vector<uint32_t> probing_template;
+  fh::compute_probing_template(k, 100, &probing_template);
+  ASSERT_EQ(31u, probing_template.size());
+  ASSERT_EQ(1u, probing_template[0]);
+  ASSERT_EQ(2u, probing_template[1]);
+  double last_score = 0.0;
+  for (uint32_t mask : probing_template) {
+    double score = 0.0;
+    for (int ii = 0; ii < k; ++ii) {
+      if ((mask >> ii) & 1) {
+        score += e[ii];
+      }
+    }
+    EXPECT_LE(last_score, score + 1e-12);
+    last_score = score;
+  }
+  sort(probing_template.begin(), probing_template.end());
+  for (uint32_t ii = 0; ii < 31; ++ii) {
+    ASSERT_EQ(ii + 1, probing_template[ii]);
+  }
+
+  fh::compute_probing_template(k, 7, &probing_template);
+  ASSERT_EQ(7u, probing_template.size());
+  fh::compute_probing_template(k, 0, &probing_template);
+  ASSERT_EQ(0u, probing_template.size());
+}
+
+TEST(HyperplaneHashTest, DenseHyperplaneMultiProbeTest6) {
+  int dim = 10;
+  int k = 4;
+  int l = 3;
+  uint64_t seed = 4401923;
+  DenseVector v(dim);
+  for (int ii = 0; ii < dim; ++ii) {
+    v[ii] = (ii % 3) - 0.7 * ii;
+  }
+  vector<uint32_t> probing_template;
+  fh::compute_probing_template(k, 15, &probing_template);
+
+  for (int template_size : {15, 5, 4}) {
+    HyperplaneHashDense<float> hash(dim, k, l, seed, template_size);
+    DenseQuery query(hash);
+    vector<uint32_t> hash_val;
+    hash.hash(v, &hash_val);
+    DenseVector ips = hash.get_hyperplanes() * v;
+
+    // 16 probes per table if the template is long enough (the last hash uses
+    // the exact probing sequence)
+    for (int num_probes : {l * 16, l * 5 + 1}) {
+      vector<vector<uint32_t>> probes_by_table;
+      query.get_probes_by_table(v, &probes_by_table, num_probes);
+      ASSERT_EQ(static_cast<size_t>(l), probes_by_table.size());
+      bool use_template = (num_probes - 1) / l <= template_size;
+      for (int table = 0; table < l; ++table) {
+        vector<uint32_t>& probes = probes_by_table[table];
+        ASSERT_EQ(hash_val[table], probes[0]);
+        vector<int> ranks(k);
+        for (int ii = 0; ii < k; ++ii) {
+          ranks[ii] = ii;
+        }
+        sort(ranks.begin(), ranks.end(), [&](int a, int b) {
+          return std::abs(ips[table * k + a]) < std::abs(ips[table * k + b]);
+        });
+        for (size_t ii = 1; ii < probes.size(); ++ii) {
+          uint32_t diff = probes[0] ^ probes[ii];
+          if (use_template) {
+            uint32_t expected = 0;
+            for (int rank = 0; rank < k; ++rank) {
+              if ((probing_template[ii - 1] >> rank) & 1) {
+                expected |= 1u << (k - ranks[rank] - 1);
+              }
+            }
+            ASSERT_EQ(expected, diff);
+          } else if (ii == 1) {
+            // the exact sequence also flips the smallest projection first
+            ASSERT_EQ(1u << (k - ranks[0] - 1), diff);
+          }
+        }
+        if (num_probes == l * 16) {
+          ASSERT_EQ(16u, probes.size());
+          sort(probes.begin(), probes.end());
+          for (uint32_t ii = 0; ii < 16; ++ii) {
+            ASSERT_EQ(ii, probes[ii]);
+          }
+        }
+      }
+    }
+  }
+
+  ASSERT_THROW(HyperplaneHashDense<float>(dim, k, l, seed, -1),
+               fc::LSHFunctionError);
+}
+
 TEST(HyperplaneHashTest, DenseHyperplaneBatchHashTest1) {
   DenseVector v1(4);
   v1[0] = 1.0;
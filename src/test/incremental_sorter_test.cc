@@ -67,3 +67,17 @@ TEST(IncrementalSorterTest, SorterTest3) {
 
   check_sorter<std::pair<float, int>>(v, 10);
 }
+
+TEST(IncrementalSorterTest, SorterTest4) {
+  // sorting a part of a larger array leaves the rest untouched
+  vector<int> v = {9, 7, 2, 3, 1, 8, 0};
+  IncrementalSorter<int> sorter;
+  sorter.reset(v.data() + 1, v.data() + 6, 2);
+  ASSERT_EQ(sorter.get(0), 1);
+  ASSERT_EQ(sorter.get(1), 2);
+  ASSERT_EQ(sorter.get(2), 3);
+  ASSERT_EQ(sorter.get(3), 7);
+  ASSERT_EQ(sorter.get(4), 8);
+  ASSERT_EQ(9, v[0]);
+  ASSERT_EQ(0, v[6]);
+}
@@ -1,5 +1,8 @@
 #include "falconn/core/lsh_table.h"
 
+#include <algorithm>
+#include <cmath>
+#include <random>
 #include <utility>
 #include <vector>
 
@@ -8,12 +11,15 @@
 #include "falconn/core/composite_hash_table.h"
 #include "falconn/core/data_storage.h"
 #include "falconn/core/hyperplane_hash.h"
+#include "falconn/core/polytope_hash.h"
+#include "falconn/core/prefix_hash_table.h"
 #include "falconn/core/probing_hash_table.h"
 #include "test_utils.h"
 
 namespace fc = falconn::core;
 namespace ft = falconn::test;
 
+using fc::CrossPolytopeHashDense;
 using fc::DynamicCompositeHashTable;
 using fc::DynamicLinearProbingHashTable;
 // using lsh::DynamicLSHTable;
@@ -22,6 +28,7 @@ using fc::HyperplaneHashSparse;
 using fc::PlainArrayDataStorage;
 using fc::StaticLSHTable;
 using fc::StaticLinearProbingHashTable;
+using fc::StaticPrefixHashTable;
 using fc::StaticCompositeHashTable;
 using ft::check_result;
 using std::make_pair;
@@ -521,3 +528,509 @@ TEST(LSHTableTest, LSHTableMultithreadedTest1) {
   vector<int32_t> expected4 = {0, 1};
   check_result(make_pair(res4.begin(), res4.end()), expected4);
 }
+
+// Without multiprobing and with a candidate limit, the tables are hashed one at
+// a time. The candidates must be a prefix of the ones without a limit.
+template <typename LSH>
+void run_lazy_hashing_test(LSH* lsh_object, int dim, int l) {
+  int num_points = 300;
+  std::mt19937_64 gen(90134512);
+  std::normal_distribution<float> gauss(0.0, 1.0);
+  vector<DenseVector> points(num_points, DenseVector(dim));
+  for (DenseVector& p : points) {
+    for (int ii = 0; ii < dim; ++ii) {
+      p[ii] = gauss(gen);
+    }
+    p.normalize();
+  }
+
+  StaticLinearProbingHashTable<uint32_t>::Factory table_factory(2 *
+                                                                num_points);
+  typedef StaticCompositeHashTable<uint32_t, int32_t,
+                                   StaticLinearProbingHashTable<uint32_t>>
+      CompositeTableType;
+  CompositeTableType hash_table(l, &table_factory);
+  typedef StaticLSHTable<DenseVector, int32_t, LSH, uint32_t,
+                         CompositeTableType>
+      LSHTableType;
+  LSHTableType lsh_table(lsh_object, &hash_table, points, default_num_threads);
+  typename LSHTableType::Query query(lsh_table);
+
+  for (int jj = 0; jj < 10; ++jj) {
+    const DenseVector& q = points[jj];
+    vector<int32_t> all;
+    query.get_candidates_with_duplicates(q, l, -1, &all);
+    ASSERT_GE(all.size(), static_cast<size_t>(l));
+    for (int max_num_candidates : {0, 1, 3, 10, 50, 1000}) {
+      vector<int32_t> expected(
+          all.begin(),
+          all.begin() + std::min<size_t>(max_num_candidates, all.size()));
+      vector<int32_t> res;
+      query.get_candidates_with_duplicates(q, l, max_num_candidates, &res);
+      ASSERT_EQ(expected, res);
+
+      vector<int32_t> expected_unique;
+      for (int32_t x : expected) {
+        if (std::find(expected_unique.begin(), expected_unique.end(), x) ==
+            expected_unique.end()) {
+          expected_unique.push_back(x);
+        }
+      }
+      query.get_unique_candidates(q, l, max_num_candidates, &res);
+      ASSERT_EQ(expected_unique, res);
+    }
+  }
+}
+
+TEST(LSHTableTest, LSHTableLazyHashingTest1) {
+  int dim = 16;
+  int k = 3;
+  int l = 8;
+  HyperplaneHashDense<float> hp(dim, k, l, 4401273);
+  run_lazy_hashing_test(&hp, dim, l);
+
+  CrossPolytopeHashDense<float> cp(dim, 1, l, 2, 8, 7712031);
+  run_lazy_hashing_test(&cp, dim, l);
+}
+
+TEST(LSHTableTest, LSHTableRetrievalOrderTest1) {
+  int dim = 16;
+  int k = 4;
+  int l = 6;
+  int num_points = 300;
+  std::mt19937_64 gen(5012390);
+  std::normal_distribution<float> gauss(0.0, 1.0);
+  vector<DenseVector> points(num_points, DenseVector(dim));
+  for (DenseVector& p : points) {
+    for (int ii = 0; ii < dim; ++ii) {
+      p[ii] = gauss(gen);
+    }
+    p.normalize();
+  }
+
+  typedef HyperplaneHashDense<float> LSH;
+  LSH lsh_object(dim, k, l, 9012341);
+  StaticLinearProbingHashTable<uint32_t>::Factory table_factory(2 *
+                                                                num_points);
+  typedef StaticCompositeHashTable<uint32_t, int32_t,
+                                   StaticLinearProbingHashTable<uint32_t>>
+      CompositeTableType;
+  CompositeTableType hash_table(l, &table_factory);
+  typedef StaticLSHTable<DenseVector, int32_t, LSH, uint32_t,
+                         CompositeTableType>
+      LSHTableType;
+  LSHTableType lsh_table(&lsh_object, &hash_table, points, default_num_threads);
+  LSHTableType::Query query(lsh_table);
+  LSH::Query lsh_query(lsh_object);
+
+  // one probe per table (the tables are hashed lazily) and multiprobing
+  for (int num_probes : {l, 5 * l}) {
+    for (bool interleave : {false, true}) {
+      for (int max_per_table : {-1, 0, 2, 10}) {
+        lsh_table.set_retrieval_order(interleave, max_per_table);
+        for (int jj = 0; jj < 10; ++jj) {
+          const DenseVector& q = points[jj];
+          // the probes in retrieval order
+          vector<std::pair<uint32_t, int_fast32_t>> probes;
+          if (interleave) {
+            lsh_query.get_probes_in_order(q, &probes, num_probes);
+          } else {
+            vector<vector<uint32_t>> probes_by_table;
+            lsh_query.get_probes_by_table(q, &probes_by_table, num_probes);
+            for (int table = 0; table < l; ++table) {
+              for (uint32_t probe : probes_by_table[table]) {
+                probes.push_back(make_pair(probe, table));
+              }
+            }
+          }
+          ASSERT_EQ(static_cast<size_t>(num_probes), probes.size());
+          vector<int32_t> all;
+          vector<int> per_table(l, 0);
+          for (const auto& probe : probes) {
+            auto iters =
+                hash_table.retrieve_individual(probe.first, probe.second);
+            for (; iters.first != iters.second; ++iters.first) {
+              if (max_per_table < 0 ||
+                  per_table[probe.second] < max_per_table) {
+                per_table[probe.second] += 1;
+                all.push_back(*iters.first);
+              }
+            }
+          }
+
+          for (int max_num_candidates : {-1, 0, 5, 40}) {
+            vector<int32_t> expected = all;
+            if (max_num_candidates >= 0 &&
+                static_cast<size_t>(max_num_candidates) < all.size()) {
+              expected.resize(max_num_candidates);
+            }
+            vector<int32_t> res;
+            query.get_candidates_with_duplicates(q, num_probes,
+                                                 max_num_candidates, &res);
+            ASSERT_EQ(expected, res);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(LSHTableTest, LSHTableSkipEmptyBucketsTest1) {
+  int dim = 16;
+  int l = 4;
+  int num_points = 300;
+  std::mt19937_64 gen(7120934);
+  std::normal_distribution<float> gauss(0.0, 1.0);
+  vector<DenseVector> points(num_points, DenseVector(dim));
+  for (DenseVector& p : points) {
+    for (int ii = 0; ii < dim; ++ii) {
+      p[ii] = gauss(gen);
+    }
+    p.normalize();
+  }
+
+  typedef HyperplaneHashDense<float> LSH;
+  typedef StaticCompositeHashTable<uint32_t, int32_t,
+                                   StaticLinearProbingHashTable<uint32_t>>
+      CompositeTableType;
+  typedef StaticLSHTable<DenseVector, int32_t, LSH, uint32_t,
+                         CompositeTableType>
+      LSHTableType;
+  // an exact bitmap (k = 10) and a Bloom filter (k = 16)
+  for (int k : {10, 16}) {
+    LSH lsh_object(dim, k, l, 4509123);
+    StaticLinearProbingHashTable<uint32_t>::Factory table_factory(2 *
+                                                                  num_points);
+    CompositeTableType hash_table(l, &table_factory);
+    hash_table.set_use_occupancy_filters(true);
+    LSHTableType lsh_table(&lsh_object, &hash_table, points,
+                           default_num_threads);
+    ASSERT_TRUE(hash_table.has_occupancy_filters());
+    LSHTableType::Query query(lsh_table);
+    LSH::Query lsh_query(lsh_object);
+
+    int num_probes = 5 * l;
+    for (bool interleave : {false, true}) {
+      lsh_table.set_retrieval_order(interleave, -1);
+      for (int jj = 0; jj < 10; ++jj) {
+        DenseVector q = points[jj];
+        for (int ii = 0; ii < dim; ++ii) {
+          q[ii] += 0.3 * gauss(gen);
+        }
+        // the first num_probes probes that pass the filter
+        vector<std::pair<uint32_t, int_fast32_t>> probes;
+        int num_generated = 0;
+        int num_empty = 0;
+        auto sequence = lsh_query.get_probing_sequence(q);
+        for (auto iter = sequence.first;
+             iter != sequence.second &&
+             static_cast<int>(probes.size()) < num_probes &&
+             num_generated < 16 * num_probes;
+             ++iter, ++num_generated) {
+          auto iters = hash_table.retrieve_individual(iter->first,
+                                                      iter->second);
+          bool may_contain = hash_table.may_contain(iter->first, iter->second);
+          // no false negatives
+          if (iters.first != iters.second) {
+            ASSERT_TRUE(may_contain);
+          } else {
+            num_empty += 1;
+          }
+          if (may_contain) {
+            probes.push_back(make_pair(iter->first, iter->second));
+          }
+        }
+        if (k == 16) {
+          EXPECT_GT(num_empty, 0);
+        }
+        if (!interleave) {
+          std::stable_sort(probes.begin(), probes.end(),
+                           [](const std::pair<uint32_t, int_fast32_t>& a,
+                              const std::pair<uint32_t, int_fast32_t>& b) {
+                             return a.second < b.second;
+                           });
+        }
+        vector<int32_t> expected;
+        for (const auto& probe : probes) {
+          auto iters =
+              hash_table.retrieve_individual(probe.first, probe.second);
+          for (; iters.first != iters.second; ++iters.first) {
+            expected.push_back(*iters.first);
+          }
+        }
+
+        vector<int32_t> res;
+        query.get_candidates_with_duplicates(q, num_probes, -1, &res);
+        ASSERT_EQ(expected, res);
+        // one probe per table does not take the lazy path
+        query.get_candidates_with_duplicates(q, l, 1, &res);
+        ASSERT_LE(res.size(), 1u);
+      }
+    }
+  }
+}
+
+TEST(LSHTableTest, LSHTableBucketSizePolicyTest1) {
+  int dim = 16;
+  int k = 3;
+  int l = 4;
+  int num_points = 400;
+  std::mt19937_64 gen(3401923);
+  std::normal_distribution<float> gauss(0.0, 1.0);
+  vector<DenseVector> points(num_points, DenseVector(dim));
+  for (DenseVector& p : points) {
+    for (int ii = 0; ii < dim; ++ii) {
+      p[ii] = gauss(gen);
+    }
+    p.normalize();
+  }
+  // a few huge buckets
+  for (int ii = 1; ii < 150; ++ii) {
+    points[ii] = points[0];
+  }
+
+  typedef HyperplaneHashDense<float> LSH;
+  LSH lsh_object(dim, k, l, 1290342);
+  StaticLinearProbingHashTable<uint32_t>::Factory table_factory(2 *
+                                                                num_points);
+  typedef StaticCompositeHashTable<uint32_t, int32_t,
+                                   StaticLinearProbingHashTable<uint32_t>>
+      CompositeTableType;
+  CompositeTableType hash_table(l, &table_factory);
+  typedef StaticLSHTable<DenseVector, int32_t, LSH, uint32_t,
+                         CompositeTableType>
+      LSHTableType;
+  LSHTableType lsh_table(&lsh_object, &hash_table, points, default_num_threads);
+  LSHTableType::Query query(lsh_table);
+  LSH::Query lsh_query(lsh_object);
+
+  for (int num_probes : {l, 3 * l}) {
+    for (double penalty : {0.0, 0.05}) {
+      for (int max_bucket_size : {-1, 0, 7, 1000}) {
+        lsh_table.set_retrieval_order(true, -1);
+        lsh_table.set_bucket_size_policy(penalty, max_bucket_size);
+        for (int jj = 0; jj < 200; jj += 10) {
+          const DenseVector& q = points[jj];
+          vector<std::pair<uint32_t, int_fast32_t>> probes;
+          lsh_query.get_probes_in_order(q, &probes, num_probes);
+          // the (possibly subsampled) buckets in the order of the penalized
+          // bucket sizes
+          vector<std::pair<double, vector<int32_t>>> buckets;
+          for (size_t ii = 0; ii < probes.size(); ++ii) {
+            auto iters =
+                hash_table.retrieve_individual(probes[ii].first,
+                                               probes[ii].second);
+            vector<int32_t> bucket(iters.first, iters.second);
+            int size = bucket.size();
+            if (max_bucket_size >= 0 && size > max_bucket_size) {
+              vector<int32_t> sample;
+              for (int kk = 0; kk < max_bucket_size; ++kk) {
+                sample.push_back(bucket[kk * size / max_bucket_size]);
+              }
+              bucket = sample;
+            }
+            buckets.push_back(make_pair(ii + penalty * size, bucket));
+          }
+          std::stable_sort(buckets.begin(), buckets.end(),
+                           [](const std::pair<double, vector<int32_t>>& a,
+                              const std::pair<double, vector<int32_t>>& b) {
+                             return a.first < b.first;
+                           });
+          vector<int32_t> all;
+          for (const auto& bucket : buckets) {
+            all.insert(all.end(), bucket.second.begin(), bucket.second.end());
+          }
+
+          for (int max_num_candidates : {-1, 10, 100}) {
+            vector<int32_t> expected = all;
+            if (max_num_candidates >= 0 &&
+                static_cast<size_t>(max_num_candidates) < all.size()) {
+              expected.resize(max_num_candidates);
+            }
+            vector<int32_t> res;
+            query.get_candidates_with_duplicates(q, num_probes,
+                                                 max_num_candidates, &res);
+            ASSERT_EQ(expected, res);
+          }
+        }
+      }
+    }
+  }
+  EXPECT_THROW(lsh_table.set_bucket_size_policy(-1.0, -1), fc::LSHTableError);
+}
+
+TEST(LSHTableTest, LSHTableCollisionFilterTest1) {
+  int dim = 16;
+  int k = 3;
+  int l = 8;
+  int num_points = 500;
+  std::mt19937_64 gen(8812340);
+  std::normal_distribution<float> gauss(0.0, 1.0);
+  vector<DenseVector> points(num_points, DenseVector(dim));
+  for (DenseVector& p : points) {
+    for (int ii = 0; ii < dim; ++ii) {
+      p[ii] = gauss(gen);
+    }
+    p.normalize();
+  }
+
+  typedef HyperplaneHashDense<float> LSH;
+  LSH lsh_object(dim, k, l, 5591023);
+  StaticLinearProbingHashTable<uint32_t>::Factory table_factory(2 *
+                                                                num_points);
+  typedef StaticCompositeHashTable<uint32_t, int32_t,
+                                   StaticLinearProbingHashTable<uint32_t>>
+      CompositeTableType;
+  CompositeTableType hash_table(l, &table_factory);
+  typedef StaticLSHTable<DenseVector, int32_t, LSH, uint32_t,
+                         CompositeTableType>
+      LSHTableType;
+  LSHTableType lsh_table(&lsh_object, &hash_table, points, default_num_threads);
+  LSHTableType::Query query(lsh_table);
+
+  for (int num_probes : {l, 4 * l}) {
+    for (int min_num_collisions : {1, 2, 5, l}) {
+      for (double fraction : {1.0, 0.5, 0.1}) {
+        lsh_table.set_collision_filter(min_num_collisions, fraction);
+        for (int jj = 0; jj < 20; ++jj) {
+          const DenseVector& q = points[jj];
+          for (int max_num_candidates : {-1, 100}) {
+            vector<int32_t> all;
+            query.get_candidates_with_duplicates(q, num_probes,
+                                                 max_num_candidates, &all);
+            // the unique candidates in the order of their first occurrence
+            vector<int32_t> unique;
+            vector<int> counts(num_points, 0);
+            for (int32_t cur : all) {
+              if (counts[cur] == 0) {
+                unique.push_back(cur);
+              }
+              counts[cur] += 1;
+            }
+            vector<int32_t> frequent;
+            for (int32_t cur : unique) {
+              ASSERT_LE(counts[cur], l);
+              if (counts[cur] >= min_num_collisions) {
+                frequent.push_back(cur);
+              }
+            }
+            size_t num_kept = static_cast<size_t>(
+                std::ceil(fraction * frequent.size()));
+            vector<int32_t> by_count = frequent;
+            std::stable_sort(by_count.begin(), by_count.end(),
+                             [&counts](int32_t a, int32_t b) {
+                               return counts[a] > counts[b];
+                             });
+            by_count.resize(num_kept);
+            vector<bool> kept(num_points, false);
+            for (int32_t cur : by_count) {
+              kept[cur] = true;
+            }
+            vector<int32_t> expected;
+            for (int32_t cur : frequent) {
+              if (kept[cur]) {
+                expected.push_back(cur);
+              }
+            }
+
+            vector<int32_t> res;
+            query.get_unique_candidates(q, num_probes, max_num_candidates,
+                                        &res);
+            ASSERT_EQ(expected, res);
+          }
+        }
+      }
+    }
+  }
+  EXPECT_THROW(lsh_table.set_collision_filter(l + 1, 1.0), fc::LSHTableError);
+  EXPECT_THROW(lsh_table.set_collision_filter(1, 0.0), fc::LSHTableError);
+  EXPECT_THROW(lsh_table.set_collision_filter(1, 1.5), fc::LSHTableError);
+}
+
+TEST(LSHTableTest, LSHTablePrefixQueryTest1) {
+  int dim = 16;
+  int k = 12;
+  int l = 3;
+  int num_points = 1000;
+  std::mt19937_64 gen(4401239);
+  std::normal_distribution<float> gauss(0.0, 1.0);
+  vector<DenseVector> points(num_points, DenseVector(dim));
+  for (DenseVector& p : points) {
+    for (int ii = 0; ii < dim; ++ii) {
+      p[ii] = gauss(gen);
+    }
+    p.normalize();
+  }
+
+  typedef HyperplaneHashDense<float> LSH;
+  LSH lsh_object(dim, k, l, 7812093);
+  StaticPrefixHashTable<uint32_t>::Factory table_factory(k);
+  typedef StaticCompositeHashTable<uint32_t, int32_t,
+                                   StaticPrefixHashTable<uint32_t>>
+      CompositeTableType;
+  CompositeTableType hash_table(l, &table_factory);
+  typedef StaticLSHTable<DenseVector, int32_t, LSH, uint32_t,
+                         CompositeTableType>
+      LSHTableType;
+  LSHTableType lsh_table(&lsh_object, &hash_table, points, default_num_threads);
+  LSHTableType::Query query(lsh_table);
+  LSH::Query lsh_query(lsh_object);
+
+  vector<vector<uint32_t>> hashes(num_points);
+  for (int ii = 0; ii < num_points; ++ii) {
+    vector<vector<uint32_t>> probes;
+    lsh_query.get_probes_by_table(points[ii], &probes, l);
+    for (int table = 0; table < l; ++table) {
+      hashes[ii].push_back(probes[table][0]);
+    }
+  }
+
+  for (int jj = 0; jj < 20; ++jj) {
+    const DenseVector& q = points[jj];
+    // the full hash gives the same candidates as the regular query
+    vector<int32_t> res;
+    query.get_unique_candidates_by_prefix(q, k, 0, -1, &res);
+    vector<int32_t> expected;
+    query.get_unique_candidates(q, l, -1, &expected);
+    std::sort(res.begin(), res.end());
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(expected, res);
+
+    for (int prefix_length : {k, 8, 3}) {
+      for (int min_num_candidates : {0, 10, 100, 2000}) {
+        // the longest prefix (at most prefix_length) with enough candidates
+        int cur_length = prefix_length;
+        while (true) {
+          expected.clear();
+          int shift = k - cur_length;
+          for (int ii = 0; ii < num_points; ++ii) {
+            for (int table = 0; table < l; ++table) {
+              if ((hashes[ii][table] >> shift) ==
+                  (hashes[jj][table] >> shift)) {
+                expected.push_back(ii);
+                break;
+              }
+            }
+          }
+          if (static_cast<int>(expected.size()) >= min_num_candidates ||
+              cur_length == 0) {
+            break;
+          }
+          cur_length -= 1;
+        }
+        query.get_unique_candidates_by_prefix(q, prefix_length,
+                                              min_num_candidates, -1, &res);
+        std::sort(res.begin(), res.end());
+        ASSERT_EQ(expected, res);
+
+        query.get_unique_candidates_by_prefix(q, prefix_length,
+                                              min_num_candidates, 5, &res);
+        ASSERT_LE(res.size(), 5u);
+      }
+    }
+  }
+  vector<int32_t> res;
+  EXPECT_THROW(query.get_unique_candidates_by_prefix(points[0], -1, 0, -1,
+                                                     &res),
+               fc::LSHTableError);
+}
@@ -0,0 +1,86 @@
+#include "falconn/core/occupancy_filter.h"
+
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using falconn::core::OccupancyFilter;
+using std::set;
+using std::vector;
+
+TEST(OccupancyFilterTest, ExactTest1) {
+  vector<uint32_t> keys = {5, 0, 17, 5, 63, 64, 200};
+  OccupancyFilter<uint32_t> filter;
+  filter.build(keys);
+  EXPECT_TRUE(filter.is_exact());
+  set<uint32_t> key_set(keys.begin(), keys.end());
+  for (uint32_t key = 0; key < 1000; ++key) {
+    EXPECT_EQ(key_set.count(key) > 0, filter.may_contain(key));
+  }
+  EXPECT_FALSE(filter.may_contain(4000000000u));
+}
+
+TEST(OccupancyFilterTest, ExactTest2) {
+  OccupancyFilter<uint64_t> filter;
+  filter.build(vector<uint64_t>());
+  EXPECT_TRUE(filter.is_exact());
+  EXPECT_EQ(0u, filter.memory_usage());
+  EXPECT_FALSE(filter.may_contain(0));
+  EXPECT_FALSE(filter.may_contain(12345));
+}
+
+TEST(OccupancyFilterTest, BloomTest1) {
+  std::mt19937_64 gen(9012354);
+  int num_keys = 10000;
+  vector<uint64_t> keys(num_keys);
+  for (uint64_t& key : keys) {
+    key = gen();
+  }
+  // key 0 and repeated keys
+  keys[0] = 0;
+  keys[1] = keys[2];
+
+  OccupancyFilter<uint64_t> filter;
+  filter.build(keys);
+  EXPECT_FALSE(filter.is_exact());
+  EXPECT_LE(filter.memory_usage(), num_keys * 2 + 64u);
+  for (uint64_t key : keys) {
+    ASSERT_TRUE(filter.may_contain(key));
+  }
+
+  set<uint64_t> key_set(keys.begin(), keys.end());
+  int num_tests = 100000;
+  int num_false_positives = 0;
+  for (int ii = 0; ii < num_tests; ++ii) {
+    uint64_t key = gen();
+    if (key_set.count(key) == 0 && filter.may_contain(key)) {
+      num_false_positives += 1;
+    }
+  }
+  EXPECT_LT(num_false_positives, 0.005 * num_tests);
+}
+
+TEST(OccupancyFilterTest, BloomTest2) {
+  // few keys spread over a large range (e.g., the buckets of a flat hash
+  // table with many bits)
+  vector<uint32_t> keys;
+  for (uint32_t ii = 0; ii < 100; ++ii) {
+    keys.push_back(ii * 40000);
+  }
+  OccupancyFilter<uint32_t> filter;
+  filter.build(keys);
+  EXPECT_FALSE(filter.is_exact());
+  int num_false_positives = 0;
+  for (uint32_t key = 0; key < 4000000; ++key) {
+    bool contained = key % 40000 == 0;
+    if (contained) {
+      ASSERT_TRUE(filter.may_contain(key));
+    } else if (filter.may_contain(key)) {
+      num_false_positives += 1;
+    }
+  }
+  EXPECT_LT(num_false_positives, 0.005 * 4000000);
+}
@@ -1,5 +1,6 @@
 #include "falconn/core/polytope_hash.h"
 
+#include <algorithm>
 #include <cmath>
 #include <random>
 #include <utility>
@@ -18,6 +19,8 @@ using fc::CrossPolytopeHashDense;
 using fc::CrossPolytopeHashSparse;
 using fc::cp_hash_helpers::FHTHelper;
 using fc::cp_hash_helpers::compute_k_parameters_for_bits;
+using fc::cp_hash_helpers::computed_feature_hashing;
+using fc::cp_hash_helpers::computed_feature_hashing_scalar;
 using fc::log2ceil;
 using ft::count_bits;
 using std::make_pair;
@@ -106,6 +109,33 @@ TEST(PolytopeHashTest, FHTHelperTest3) {
   }
 }
 
+TEST(PolytopeHashTest, FHTHelperTest4) {
+  EXPECT_EQ(fht_float_kernel(fht_best_isa()),
+            fc::cp_hash_helpers::FHTFunction<float>::kernel());
+  EXPECT_EQ(fht_double_kernel(fht_best_isa()),
+            fc::cp_hash_helpers::FHTFunction<double>::kernel());
+  std::mt19937_64 gen(3401923);
+  std::uniform_int_distribution<int> sign(0, 1);
+  for (int log_dim = 0; log_dim <= 14; ++log_dim) {
+    int dim = 1 << log_dim;
+    FHTHelper<float> float_fht(dim);
+    FHTHelper<double> double_fht(dim);
+    vector<float> f1(dim), f2(dim);
+    vector<double> d1(dim), d2(dim);
+    for (int ii = 0; ii < dim; ++ii) {
+      f1[ii] = f2[ii] = 2 * sign(gen) - 1;
+      d1[ii] = d2[ii] = 2 * sign(gen) - 1;
+    }
+    float_fht.apply(f1.data());
+    double_fht.apply(d1.data());
+    ASSERT_EQ(0, fht_float_generic(f2.data(), log_dim));
+    ASSERT_EQ(0, fht_double_generic(d2.data(), log_dim));
+    // all values are small integers, so the results are exact
+    EXPECT_EQ(f2, f1);
+    EXPECT_EQ(d2, d1);
+  }
+}
+
 TEST(PolytopeHashTest, KParametersForBitsTest) {
   int dim = 8;
   int bits = 8;
@@ -277,6 +307,88 @@ TEST(PolytopeHashTest, SparseHashTest1) {
   }
 }
 
+TEST(PolytopeHashTest, ComputedFeatureHashingTest1) {
+  // an odd number of coordinates to exercise the scalar tail
+  int num_coordinates = 37;
+  std::mt19937_64 gen(99120345);
+  vector<uint32_t> coordinates(num_coordinates);
+  for (int ii = 0; ii < num_coordinates; ++ii) {
+    coordinates[ii] = gen();
+  }
+  coordinates[0] = 0;
+  coordinates[1] = 0xffffffffu;
+  for (int shift : {33, 52, 63}) {
+    uint64_t a = gen() | 1;
+    uint64_t b = gen();
+    vector<uint32_t> expected(num_coordinates), result(num_coordinates);
+    computed_feature_hashing_scalar(coordinates.data(), num_coordinates, a, b,
+                                    shift, expected.data());
+    computed_feature_hashing(coordinates.data(), num_coordinates, a, b, shift,
+                             result.data());
+    for (int ii = 0; ii < num_coordinates; ++ii) {
+      EXPECT_EQ(static_cast<uint32_t>((a * coordinates[ii] + b) >> shift),
+                expected[ii]);
+      EXPECT_EQ(expected[ii], result[ii]);
+    }
+  }
+}
+
+TEST(PolytopeHashTest, SparseComputedFeatureHashingTest1) {
+  // With lookup tables, this would need k * l * dim = 2^28 entries.
+  int dim = 1 << 22;
+  int k = 2;
+  int l = 64;
+  int num_rotations = 2;
+  int feature_hashing_dim = 16;
+  uint64_t seed = 5523091;
+  SparseCPHash hash(dim, k, l, num_rotations, feature_hashing_dim,
+                    feature_hashing_dim, seed, true);
+
+  SparseVector v;
+  for (int ii = 0; ii < 40; ++ii) {
+    v.push_back(make_pair(ii * 100003, 1.0 + ii));
+  }
+  v.push_back(make_pair(dim - 1, 0.5));
+
+  SparseCPHash::HashedVectorT embedded(feature_hashing_dim);
+  SparseCPHash::HashedVectorT single(feature_hashing_dim);
+  SparseCPHash::HashedVectorT sum(feature_hashing_dim);
+  for (int table = 0; table < l; table += 7) {
+    for (int function = 0; function < k; ++function) {
+      hash.embed(v, table, function, &embedded);
+      sum.setZero();
+      for (const auto& entry : v) {
+        // every coordinate is mapped to a single signed coordinate
+        hash.embed(SparseVector(1, entry), table, function, &single);
+        int num_nonzero = 0;
+        for (int ii = 0; ii < feature_hashing_dim; ++ii) {
+          if (single[ii] != 0.0) {
+            num_nonzero += 1;
+            EXPECT_EQ(entry.second, std::abs(single[ii]));
+          }
+        }
+        EXPECT_EQ(1, num_nonzero);
+        sum += single;
+      }
+      for (int ii = 0; ii < feature_hashing_dim; ++ii) {
+        EXPECT_NEAR(sum[ii], embedded[ii], 1e-4);
+      }
+    }
+  }
+
+  vector<uint32_t> hashes1(l), hashes2(l);
+  hash.hash(v, &hashes1);
+  hash.hash(v, &hashes2);
+  EXPECT_EQ(hashes1, hashes2);
+  SparseQuery query(hash);
+  vector<vector<uint32_t>> probes_by_table;
+  query.get_probes_by_table(v, &probes_by_table, l);
+  for (int ii = 0; ii < l; ++ii) {
+    ASSERT_EQ(1u, probes_by_table[ii].size());
+    EXPECT_EQ(hashes1[ii], probes_by_table[ii][0]);
+  }
+}
+
 TEST(PolytopeHashTest, DenseMultiprobeTest1) {
   DenseVector v1(4);
   v1[0] = 1.0;
@@ -622,6 +734,75 @@ TEST(PolytopeHashTest, DenseMultiprobeTest8) {
   }
 }
 
+TEST(PolytopeHashTest, DenseMultiprobeTest9) {
+  // The probing sequence (which sets up the sorted order of each CP lazily)
+  // against the scores of all probes.
+  int dim = 8;
+  int k = 2;
+  int l = 3;
+  int num_rotations = 3;
+  uint64_t seed = 7190234;
+  std::mt19937_64 gen(seed);
+  std::normal_distribution<float> gauss(0.0, 1.0);
+
+  for (int last_cp_dim : {1, 2, 8}) {
+    CrossPolytopeHashDense<float> hash(dim, k, l, num_rotations, last_cp_dim,
+                                       seed);
+    DenseVector v(dim);
+    for (int ii = 0; ii < dim; ++ii) {
+      v[ii] = gauss(gen);
+    }
+    CPHD::TransformedVectorType transformed;
+    hash.reserve_transformed_vector_memory(&transformed);
+    CPHD::HashTransformation transformation(hash);
+    transformation.apply(v, &transformed);
+
+    // score of the hash value index in the given CP
+    auto coord_score = [&](int cp_index, int index) {
+      int cur_dim = (cp_index % k == k - 1 ? last_cp_dim : dim);
+      auto cur_vec = transformed.col(cp_index).head(cur_dim);
+      float max_abs = cur_vec.cwiseAbs().maxCoeff();
+      float score = (index < cur_dim ? max_abs - cur_vec[index]
+                                     : max_abs + cur_vec[index - cur_dim]);
+      return score * score;
+    };
+    int last_bits = log2ceil(last_cp_dim) + 1;
+    int num_probes_per_table = 2 * dim * 2 * last_cp_dim;
+    vector<vector<float>> scores(l, vector<float>(1 << (4 + last_bits), -1.0));
+    vector<float> all_scores;
+    for (int table = 0; table < l; ++table) {
+      for (int ii = 0; ii < 2 * dim; ++ii) {
+        for (int jj = 0; jj < 2 * last_cp_dim; ++jj) {
+          float score =
+              coord_score(table * k, ii) + coord_score(table * k + 1, jj);
+          scores[table][(ii << last_bits) | jj] = score;
+          all_scores.push_back(score);
+        }
+      }
+    }
+    std::sort(all_scores.begin(), all_scores.end());
+
+    int num_probes = l * num_probes_per_table;
+    CPHD::MultiProbeLookup lookup(hash);
+    for (int probes : {num_probes, l + 5}) {
+      lookup.setup_probing(transformed, probes);
+      vector<vector<bool>> seen(l, vector<bool>(scores[0].size(), false));
+      uint32_t probe;
+      int_fast32_t table;
+      for (int ii = 0; ii < probes; ++ii) {
+        ASSERT_TRUE(lookup.get_next_probe(&probe, &table));
+        ASSERT_LT(probe, scores[table].size());
+        ASSERT_GE(scores[table][probe], 0.0);
+        ASSERT_FALSE(seen[table][probe]);
+        seen[table][probe] = true;
+        EXPECT_NEAR(all_scores[ii], scores[table][probe],
+                    1e-5 * std::max(1.0f, all_scores[ii]));
+      }
+      ASSERT_FALSE(lookup.get_next_probe(&probe, &table));
+    }
+  }
+}
+
 TEST(PolytopeHashTest, SparseMultiprobeTest1) {
   SparseVector v1;
   v1.push_back(make_pair(0, 1.0));
@@ -795,6 +976,47 @@ TEST(PolytopeHashTest, DenseBatchHashTest1) {
   }
 }
 
+TEST(PolytopeHashTest, DenseBatchHashTest2) {
+  // The rotated vectors of all cross-polytopes share one matrix in the query
+  // path and use a separate vector in the batch path.
+  int dim = 100;
+  int k = 3;
+  int l = 4;
+  int num_rotations = 2;
+  int last_cp_dim = 8;
+  uint64_t seed = 90713411;
+  CrossPolytopeHashDense<float> hash(dim, k, l, num_rotations, last_cp_dim,
+                                     seed);
+  CPHD::TransformedVectorType transformed;
+  hash.reserve_transformed_vector_memory(&transformed);
+  ASSERT_EQ(128, transformed.rows());
+  ASSERT_EQ(k * l, transformed.cols());
+
+  std::mt19937_64 gen(seed);
+  std::normal_distribution<float> gauss(0.0, 1.0);
+  vector<DenseVector> vs(50, DenseVector(dim));
+  for (DenseVector& v : vs) {
+    for (int ii = 0; ii < dim; ++ii) {
+      v[ii] = gauss(gen);
+    }
+  }
+  vector<vector<uint32_t>> results(vs.size());
+  for (size_t ii = 0; ii < vs.size(); ++ii) {
+    hash.hash(vs[ii], &results[ii], &transformed);
+  }
+
+  typedef ArrayDataStorage<DenseVector> BatchVectorType;
+  BatchVectorType batch_data(vs);
+  CPHD::BatchHash<BatchVectorType> bh(hash);
+  vector<uint32_t> hashes;
+  for (int ii = 0; ii < l; ++ii) {
+    bh.batch_hash_single_table(batch_data, ii, &hashes);
+    for (size_t jj = 0; jj < vs.size(); ++jj) {
+      ASSERT_EQ(results[jj][ii], hashes[jj]);
+    }
+  }
+}
+
 TEST(PolytopeHashTest, SparseBatchHashTest1) {
   SparseVector v1;
   v1.push_back(make_pair(0, 1.0));
@@ -0,0 +1,219 @@
+#include "falconn/core/pq_data_storage.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "falconn/core/composite_hash_table.h"
+#include "falconn/core/cosine_distance.h"
+#include "falconn/core/data_storage.h"
+#include "falconn/core/euclidean_distance.h"
+#include "falconn/core/hyperplane_hash.h"
+#include "falconn/core/lsh_table.h"
+#include "falconn/core/nn_query.h"
+#include "falconn/core/probing_hash_table.h"
+
+namespace fc = falconn::core;
+namespace fp = falconn::core::pq_helpers;
+
+using falconn::DenseVector;
+using fc::ArrayDataStorage;
+using fc::CosineDistanceDense;
+using fc::EuclideanDistanceDense;
+using fc::HyperplaneHashDense;
+using fc::NearestNeighborQuery;
+using fc::PQDataStorage;
+using fc::PQDataStorageError;
+using fc::PQDistanceScorer;
+using fc::RerankingNearestNeighborQuery;
+using fc::ScorerNearestNeighborQuery;
+using fc::StaticCompositeHashTable;
+using fc::StaticLSHTable;
+using fc::StaticLinearProbingHashTable;
+using std::vector;
+
+typedef DenseVector<float> Vec;
+
+static vector<Vec> generate_random_points(int num_points, int dim, int seed) {
+  std::mt19937_64 gen(seed);
+  std::normal_distribution<float> gauss(0.0, 1.0);
+  vector<Vec> points(num_points, Vec(dim));
+  for (int ii = 0; ii < num_points; ++ii) {
+    for (int jj = 0; jj < dim; ++jj) {
+      points[ii][jj] = gauss(gen);
+    }
+    points[ii].normalize();
+  }
+  return points;
+}
+
+TEST(PQDataStorageTest, EncodingTest1) {
+  // With at most 16 distinct points, every point becomes a centroid.
+  int dim = 10;
+  vector<Vec> points = generate_random_points(16, dim, 4410984);
+  ArrayDataStorage<Vec> ds(points);
+  PQDataStorage<float> pq(ds, 4);
+
+  ASSERT_EQ(16, pq.size());
+  ASSERT_EQ(dim, pq.dimension());
+  ASSERT_EQ(4, pq.num_subspaces());
+  ASSERT_EQ(2, pq.code_size());
+  // uneven split of 10 coordinates into 4 subspaces
+  EXPECT_EQ(0, pq.subspace_begin(0));
+  EXPECT_EQ(2, pq.subspace_dimension(0));
+  EXPECT_EQ(3, pq.subspace_dimension(1));
+  EXPECT_EQ(10, pq.subspace_begin(4));
+
+  Vec decoded;
+  for (int ii = 0; ii < 16; ++ii) {
+    pq.decode(ii, &decoded);
+    ASSERT_EQ(dim, decoded.size());
+    for (int jj = 0; jj < dim; ++jj) {
+      EXPECT_EQ(points[ii][jj], decoded[jj]);
+    }
+  }
+}
+
+TEST(PQDataStorageTest, InvalidParametersTest1) {
+  vector<Vec> points = generate_random_points(20, 8, 1234);
+  ArrayDataStorage<Vec> ds(points);
+  ASSERT_THROW(PQDataStorage<float>(ds, 3), PQDataStorageError);
+  ASSERT_THROW(PQDataStorage<float>(ds, 0), PQDataStorageError);
+  ASSERT_THROW(PQDataStorage<float>(ds, 10), PQDataStorageError);
+  ASSERT_THROW(PQDataStorage<float>(ds, 2, -1), PQDataStorageError);
+}
+
+TEST(PQDataStorageTest, ScanBlockTest1) {
+  int code_size = 7;
+  std::mt19937_64 gen(8374912);
+  std::uniform_int_distribution<int> byte(0, 255);
+  vector<uint8_t> block(code_size * fp::kBlockSize);
+  vector<uint8_t> lut(2 * code_size * fp::kNumCentroids);
+  for (auto& x : block) {
+    x = byte(gen);
+  }
+  for (auto& x : lut) {
+    x = byte(gen);
+  }
+  uint16_t expected[fp::kBlockSize];
+  uint16_t result[fp::kBlockSize];
+  fp::adc_scan_block_scalar(block.data(), lut.data(), code_size, expected);
+  fp::adc_scan_block(block.data(), lut.data(), code_size, result);
+  for (int pp = 0; pp < fp::kBlockSize; ++pp) {
+    EXPECT_EQ(expected[pp], result[pp]);
+  }
+}
+
+template <typename DistanceFunction>
+void run_scorer_test() {
+  int dim = 32;
+  int num_subspaces = 8;
+  // not a multiple of the block size
+  int num_points = 301;
+  vector<Vec> points = generate_random_points(num_points, dim, 2398111);
+  vector<Vec> queries = generate_random_points(5, dim, 56199);
+  ArrayDataStorage<Vec> ds(points);
+  PQDataStorage<float> pq(ds, num_subspaces);
+  PQDistanceScorer<DistanceFunction> scorer(pq);
+  DistanceFunction dst;
+
+  vector<int32_t> keys;
+  for (int ii = num_points - 1; ii >= 0; ii -= 2) {
+    keys.push_back(ii);
+  }
+  vector<float> scores;
+  Vec decoded;
+  for (const Vec& q : queries) {
+    scorer.load_query(q);
+    scorer.score_batch(keys, &scores);
+    ASSERT_EQ(keys.size(), scores.size());
+    float max_error = num_subspaces * scorer.get_table_scale() / 2 + 1e-5;
+    for (size_t ii = 0; ii < keys.size(); ++ii) {
+      pq.decode(keys[ii], &decoded);
+      float exact_adc = scorer.get_score(keys[ii]);
+      EXPECT_NEAR(dst(q, decoded), exact_adc, 1e-5);
+      EXPECT_NEAR(exact_adc, scores[ii], max_error);
+    }
+  }
+}
+
+TEST(PQDataStorageTest, ScorerTest1) {
+  run_scorer_test<EuclideanDistanceDense<float>>();
+}
+
+TEST(PQDataStorageTest, ScorerTest2) {
+  run_scorer_test<CosineDistanceDense<float>>();
+}
+
+TEST(PQDataStorageTest, PrerankingQueryTest1) {
+  int dim = 16;
+  int num_points = 200;
+  int k = 2;
+  int l = 4;
+  int num_neighbors = 5;
+  vector<Vec> points = generate_random_points(num_points, dim, 5540931);
+  vector<Vec> queries = generate_random_points(10, dim, 772100);
+
+  typedef ArrayDataStorage<Vec> ExactStorage;
+  ExactStorage exact_storage(points);
+  PQDataStorage<float> pq_storage(exact_storage, 4);
+  typedef PQDistanceScorer<EuclideanDistanceDense<float>> Scorer;
+  Scorer scorer(pq_storage);
+
+  HyperplaneHashDense<float> lsh_object(dim, k, l, 884213);
+  typedef StaticLinearProbingHashTable<uint32_t> HashTable;
+  HashTable::Factory table_factory(2 * num_points);
+  typedef StaticCompositeHashTable<uint32_t, int32_t, HashTable>
+      CompositeTableType;
+  CompositeTableType hash_table(l, &table_factory);
+  typedef StaticLSHTable<Vec, int32_t, HyperplaneHashDense<float>, uint32_t,
+                         CompositeTableType, ExactStorage>
+      LSHTableType;
+  LSHTableType lsh_table(&lsh_object, &hash_table, exact_storage, 1);
+
+  LSHTableType::Query exact_table_query(lsh_table);
+  NearestNeighborQuery<LSHTableType::Query, Vec, int32_t, Vec, float,
+                       EuclideanDistanceDense<float>, ExactStorage>
+      exact_query(&exact_table_query, exact_storage);
+
+  typedef ScorerNearestNeighborQuery<LSHTableType::Query, Vec, int32_t, Vec,
+                                     Scorer>
+      PQNNQuery;
+  LSHTableType::Query pq_table_query(lsh_table);
+  PQNNQuery pq_query(&pq_table_query, &scorer);
+  // re-ranking all candidates must give exactly the full-precision result
+  RerankingNearestNeighborQuery<PQNNQuery, Vec, int32_t, Vec, float,
+                                EuclideanDistanceDense<float>, ExactStorage>
+      reranking_query(&pq_query, exact_storage, num_points);
+
+  for (const Vec& q : queries) {
+    vector<int32_t> expected;
+    vector<int32_t> result;
+    vector<int32_t> candidates;
+    exact_query.find_k_nearest_neighbors(q, q, num_neighbors, l, -1,
+                                         &expected);
+    reranking_query.find_k_nearest_neighbors(q, q, num_neighbors, l, -1,
+                                             &result);
+    EXPECT_EQ(expected, result);
+    EXPECT_EQ(exact_query.find_nearest_neighbor(q, q, l, -1),
+              reranking_query.find_nearest_neighbor(q, q, l, -1));
+
+    // the pre-ranking stage alone returns candidates ordered by ADC score
+    exact_query.get_unique_candidates(q, l, -1, &candidates);
+    pq_query.find_k_nearest_neighbors(q, q, num_neighbors, l, -1, &result);
+    ASSERT_EQ(std::min<size_t>(num_neighbors, candidates.size()),
+              result.size());
+    vector<float> scores;
+    scorer.load_query(q);
+    scorer.score_batch(result, &scores);
+    for (size_t ii = 1; ii < scores.size(); ++ii) {
+      EXPECT_LE(scores[ii - 1], scores[ii]);
+    }
+  }
+
+  // the inner table query also counts the direct pre-ranking queries
+  falconn::QueryStatistics stats = reranking_query.get_query_statistics();
+  EXPECT_EQ(30, stats.num_queries);
+  EXPECT_GT(stats.average_distance_time, 0.0);
+}
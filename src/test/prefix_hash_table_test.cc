@@ -0,0 +1,96 @@
+#include "falconn/core/prefix_hash_table.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "test_utils.h"
+
+namespace fc = falconn::core;
+namespace ft = falconn::test;
+
+using fc::PrefixHashTableError;
+using fc::StaticPrefixHashTable;
+using std::vector;
+
+TEST(PrefixHashTableTest, RetrieveTest1) {
+  StaticPrefixHashTable<uint32_t> table(4);
+  ft::run_retrieve_test_1(&table);
+}
+
+TEST(PrefixHashTableTest, RetrieveTest2) {
+  StaticPrefixHashTable<uint64_t> table(64);
+  ft::run_retrieve_test_2(&table);
+}
+
+TEST(PrefixHashTableTest, RetrieveTest3) {
+  StaticPrefixHashTable<uint32_t> table(3);
+  ft::run_retrieve_test_3(&table);
+}
+
+TEST(PrefixHashTableTest, RetrieveTest4) {
+  int num_trials = 100;
+  std::mt19937_64 gen(1290341);
+  for (int ii = 0; ii < num_trials; ++ii) {
+    StaticPrefixHashTable<uint32_t> table(6);
+    ft::run_retrieve_test_4(&table, gen());
+  }
+}
+
+TEST(PrefixHashTableTest, PrefixTest1) {
+  std::mt19937_64 gen(7712093);
+  for (int num_bits : {1, 5, 12, 20, 32}) {
+    for (int num_items : {0, 1, 7, 300, 5000}) {
+      std::uniform_int_distribution<uint64_t> dis(
+          0, (uint64_t(1) << num_bits) - 1);
+      vector<uint32_t> keys(num_items);
+      for (uint32_t& key : keys) {
+        key = dis(gen);
+      }
+      StaticPrefixHashTable<uint32_t>::Factory factory(num_bits);
+      std::unique_ptr<StaticPrefixHashTable<uint32_t>> table(
+          factory.new_hash_table());
+      table->add_entries(keys);
+
+      for (int query = 0; query < 20; ++query) {
+        uint32_t key = num_items > 0 && query % 2 == 0
+                           ? keys[query % num_items]
+                           : static_cast<uint32_t>(dis(gen));
+        for (int prefix_length = 0; prefix_length <= num_bits;
+             ++prefix_length) {
+          int shift = num_bits - prefix_length;
+          vector<int32_t> expected;
+          for (int ii = 0; ii < num_items; ++ii) {
+            if (static_cast<uint64_t>(keys[ii]) >> shift ==
+                static_cast<uint64_t>(key) >> shift) {
+              expected.push_back(ii);
+            }
+          }
+          auto range = table->retrieve_prefix(key, prefix_length);
+          vector<int32_t> result(range.first, range.second);
+          std::sort(result.begin(), result.end());
+          ASSERT_EQ(expected, result);
+        }
+      }
+    }
+  }
+}
+
+TEST(PrefixHashTableTest, ErrorTest1) {
+  EXPECT_THROW(StaticPrefixHashTable<uint32_t>::Factory(33),
+               PrefixHashTableError);
+  EXPECT_THROW(StaticPrefixHashTable<uint32_t>::Factory(0),
+               PrefixHashTableError);
+  StaticPrefixHashTable<uint32_t> table(4);
+  vector<uint32_t> keys = {3, 16};
+  EXPECT_THROW(table.add_entries(keys), PrefixHashTableError);
+  StaticPrefixHashTable<uint32_t> table2(4);
+  keys = {3, 15};
+  table2.add_entries(keys);
+  EXPECT_THROW(table2.retrieve_prefix(3, 5), PrefixHashTableError);
+  EXPECT_THROW(table2.add_entries(keys), PrefixHashTableError);
+}
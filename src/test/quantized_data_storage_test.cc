@@ -0,0 +1,193 @@
+#include "falconn/core/quantized_data_storage.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "falconn/core/composite_hash_table.h"
+#include "falconn/core/cosine_distance.h"
+#include "falconn/core/data_storage.h"
+#include "falconn/core/euclidean_distance.h"
+#include "falconn/core/hyperplane_hash.h"
+#include "falconn/core/lsh_table.h"
+#include "falconn/core/nn_query.h"
+#include "falconn/core/probing_hash_table.h"
+
+namespace fc = falconn::core;
+namespace fq = falconn::core::quantization_helpers;
+
+using falconn::DenseVector;
+using fc::ArrayDataStorage;
+using fc::CosineDistanceDense;
+using fc::CosineDistanceQuantized;
+using fc::EuclideanDistanceDense;
+using fc::EuclideanDistanceQuantized;
+using fc::HalfPrecisionDataStorage;
+using fc::HyperplaneHashDense;
+using fc::Int8QuantizedDataStorage;
+using fc::NearestNeighborQuery;
+using fc::PlainArrayDataStorage;
+using fc::RerankingNearestNeighborQuery;
+using fc::StaticCompositeHashTable;
+using fc::StaticLSHTable;
+using fc::StaticLinearProbingHashTable;
+using std::vector;
+
+typedef DenseVector<float> Vec;
+
+static vector<Vec> generate_random_points(int num_points, int dim, int seed) {
+  std::mt19937_64 gen(seed);
+  std::normal_distribution<float> gauss(0.0, 1.0);
+  vector<Vec> points(num_points, Vec(dim));
+  for (int ii = 0; ii < num_points; ++ii) {
+    for (int jj = 0; jj < dim; ++jj) {
+      points[ii][jj] = gauss(gen);
+    }
+    points[ii].normalize();
+  }
+  return points;
+}
+
+TEST(QuantizedDataStorageTest, HalfConversionTest1) {
+  vector<float> exact = {0.0,    1.0,  -1.0,     0.5,    -2.0,
+                         1024.0, 0.25, 65504.0, -0.125, 3.0};
+  for (float x : exact) {
+    EXPECT_EQ(x, fq::half_to_float(fq::float_to_half(x)));
+  }
+  // 2^-24 is the smallest positive subnormal half
+  float tiny = std::ldexp(1.0f, -24);
+  EXPECT_EQ(tiny, fq::half_to_float(fq::float_to_half(tiny)));
+
+  float x = 0.1;
+  EXPECT_NEAR(x, fq::half_to_float(fq::float_to_half(x)), 1e-4);
+}
+
+TEST(QuantizedDataStorageTest, Int8StorageTest1) {
+  float data[] = {-1.0, 1.0, 1.0, 2.0, 1.0, 4.0, 0.5, 1.0, 3.0};
+  PlainArrayDataStorage<Vec> ds(data, 3, 3);
+  Int8QuantizedDataStorage<float> qs(ds);
+
+  ASSERT_EQ(3, qs.size());
+  ASSERT_EQ(3, qs.dimension());
+
+  auto iter = qs.get_full_sequence();
+  int num_points = 0;
+  for (; iter.is_valid(); ++iter) {
+    const auto& p = iter.get_point();
+    ASSERT_EQ(3, p.dim);
+    for (int jj = 0; jj < 3; ++jj) {
+      float decoded = p.offsets[jj] + p.scales[jj] * p.codes[jj];
+      EXPECT_NEAR(data[num_points * 3 + jj], decoded, 0.02);
+    }
+    num_points += 1;
+  }
+  EXPECT_EQ(3, num_points);
+
+  // the second coordinate is constant, so it has a zero scale
+  std::vector<int32_t> keys = {2, 0};
+  auto sub_iter = qs.get_subsequence(keys);
+  ASSERT_TRUE(sub_iter.is_valid());
+  EXPECT_EQ(2, sub_iter.get_key());
+  EXPECT_EQ(0.0, sub_iter.get_point().scales[1]);
+  EXPECT_NEAR(1.0, sub_iter.get_point().offsets[1], 1e-6);
+  ++sub_iter;
+  ASSERT_TRUE(sub_iter.is_valid());
+  EXPECT_EQ(0, sub_iter.get_key());
+  ++sub_iter;
+  EXPECT_FALSE(sub_iter.is_valid());
+}
+
+TEST(QuantizedDataStorageTest, DistanceKernelTest1) {
+  // odd dimension to exercise the scalar tail of the SIMD kernels
+  int dim = 37;
+  vector<Vec> points = generate_random_points(50, dim, 12834543);
+  vector<Vec> queries = generate_random_points(5, dim, 9284710);
+  ArrayDataStorage<Vec> ds(points);
+  Int8QuantizedDataStorage<float> int8_storage(ds);
+  HalfPrecisionDataStorage<> half_storage(ds);
+
+  CosineDistanceDense<float> cosine_exact;
+  EuclideanDistanceDense<float> euclidean_exact;
+  CosineDistanceQuantized<float> cosine_quantized;
+  EuclideanDistanceQuantized<float> euclidean_quantized;
+
+  for (const Vec& q : queries) {
+    auto int8_iter = int8_storage.get_full_sequence();
+    auto half_iter = half_storage.get_full_sequence();
+    for (const Vec& p : points) {
+      ASSERT_TRUE(int8_iter.is_valid());
+      ASSERT_TRUE(half_iter.is_valid());
+      EXPECT_NEAR(cosine_exact(q, p), cosine_quantized(q, int8_iter.get_point()),
+                  0.02);
+      EXPECT_NEAR(euclidean_exact(q, p),
+                  euclidean_quantized(q, int8_iter.get_point()), 0.04);
+      EXPECT_NEAR(cosine_exact(q, p), cosine_quantized(q, half_iter.get_point()),
+                  1e-3);
+      EXPECT_NEAR(euclidean_exact(q, p),
+                  euclidean_quantized(q, half_iter.get_point()), 2e-3);
+      ++int8_iter;
+      ++half_iter;
+    }
+    EXPECT_FALSE(int8_iter.is_valid());
+    EXPECT_FALSE(half_iter.is_valid());
+  }
+}
+
+TEST(QuantizedDataStorageTest, RerankingQueryTest1) {
+  int dim = 16;
+  int num_points = 200;
+  int k = 2;
+  int l = 4;
+  int num_neighbors = 5;
+  vector<Vec> points = generate_random_points(num_points, dim, 5540931);
+  vector<Vec> queries = generate_random_points(10, dim, 772100);
+
+  typedef ArrayDataStorage<Vec> ExactStorage;
+  typedef Int8QuantizedDataStorage<float> QuantizedStorage;
+  ExactStorage exact_storage(points);
+  QuantizedStorage quantized_storage(exact_storage);
+
+  HyperplaneHashDense<float> lsh_object(dim, k, l, 884213);
+  typedef StaticLinearProbingHashTable<uint32_t> HashTable;
+  HashTable::Factory table_factory(2 * num_points);
+  typedef StaticCompositeHashTable<uint32_t, int32_t, HashTable>
+      CompositeTableType;
+  CompositeTableType hash_table(l, &table_factory);
+  typedef StaticLSHTable<Vec, int32_t, HyperplaneHashDense<float>, uint32_t,
+                         CompositeTableType, ExactStorage>
+      LSHTableType;
+  LSHTableType lsh_table(&lsh_object, &hash_table, exact_storage, 1);
+
+  LSHTableType::Query exact_table_query(lsh_table);
+  NearestNeighborQuery<LSHTableType::Query, Vec, int32_t, Vec, float,
+                       EuclideanDistanceDense<float>, ExactStorage>
+      exact_query(&exact_table_query, exact_storage);
+
+  typedef NearestNeighborQuery<LSHTableType::Query, Vec, int32_t, Vec, float,
+                               EuclideanDistanceQuantized<float>,
+                               QuantizedStorage>
+      QuantizedNNQuery;
+  LSHTableType::Query quantized_table_query(lsh_table);
+  QuantizedNNQuery quantized_query(&quantized_table_query, quantized_storage);
+  // re-ranking all candidates must give exactly the full-precision result
+  RerankingNearestNeighborQuery<QuantizedNNQuery, Vec, int32_t, Vec, float,
+                                EuclideanDistanceDense<float>, ExactStorage>
+      reranking_query(&quantized_query, exact_storage, num_points);
+
+  for (const Vec& q : queries) {
+    vector<int32_t> expected;
+    vector<int32_t> result;
+    exact_query.find_k_nearest_neighbors(q, q, num_neighbors, l, -1,
+                                         &expected);
+    reranking_query.find_k_nearest_neighbors(q, q, num_neighbors, l, -1,
+                                             &result);
+    EXPECT_EQ(expected, result);
+    EXPECT_EQ(exact_query.find_nearest_neighbor(q, q, l, -1),
+              reranking_query.find_nearest_neighbor(q, q, l, -1));
+  }
+
+  falconn::QueryStatistics stats = reranking_query.get_query_statistics();
+  EXPECT_EQ(20, stats.num_queries);
+  EXPECT_GT(stats.average_distance_time, 0.0);
+}